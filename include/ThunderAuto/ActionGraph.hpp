@@ -0,0 +1,86 @@
+#pragma once
+
+#include <ThunderAuto/StateChangeSet.hpp>
+#include <ThunderLibCore/Auto/ThunderAutoProject.hpp>
+#include <cstddef>
+#include <list>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+using namespace thunder::core;
+
+/**
+ * Which actions each action group runs, kept in a topological order so that checking whether adding an
+ * action to a group would make an action call itself doesn't have to walk every group in the project.
+ *
+ * The order is maintained as groups change (Pearce-Kelly), so an edge that already goes forwards in the order
+ * is known not to create a cycle right away, and otherwise only the actions between the two ends of the edge
+ * in the order are visited.
+ *
+ * Also keeps the commands each group ends up running once every nested group is expanded.
+ */
+class ActionGraph final {
+  struct Node {
+    ThunderAutoActionType type = ThunderAutoActionType::COMMAND;
+
+    // The actions in the group, including ones that don't exist.
+    std::vector<std::string> children;
+
+    // Position in the topological order. Every group comes before the actions it runs.
+    size_t order = 0;
+  };
+
+  std::unordered_map<std::string, Node> m_nodes;
+
+  // Action name -> groups with the action in them, including for actions that don't exist.
+  std::unordered_map<std::string, std::unordered_set<std::string>> m_parents;
+
+  size_t m_nextOrder = 0;
+
+  // Set if the state already had a cycle, in which case the order is meaningless.
+  bool m_hasCycle = false;
+
+  // Action name -> commands it runs, in the order they are first run. Filled in lazily.
+  mutable std::unordered_map<std::string, std::vector<std::string>> m_leafActions;
+
+ public:
+  void rebuild(const ThunderAutoProjectState& state);
+
+  /**
+   * Updates the actions that changed.
+   */
+  void update(const ThunderAutoProjectState& state, const StateChangeSet& changes);
+
+  void clear() noexcept;
+
+  /**
+   * Finds the path an action would take back to itself if it were added to a group.
+   *
+   * The state should be the one with the action already added to the group, which is used with
+   * ThunderAutoProjectState::findActionRecursionPath() if the graph doesn't know about either action.
+   *
+   * @return The path from the added action back to itself, or an empty list if adding it is fine.
+   */
+  std::list<std::string> findRecursionPathIfAdded(const ThunderAutoProjectState& state,
+                                                  const std::string& groupActionName,
+                                                  const std::string& addedActionName) const;
+
+  /**
+   * Returns the commands an action runs once every nested group is expanded, each listed once in the order
+   * it first runs. A command runs just itself.
+   */
+  std::span<const std::string> leafActions(const std::string& actionName) const;
+
+ private:
+  void addNode(const std::string& actionName, const ThunderAutoAction& action, size_t order);
+  void removeNode(const std::string& actionName);
+
+  // Moves things around in the order so that the group comes before the action. Returns false if the edge
+  // creates a cycle.
+  bool insertEdge(const std::string& groupActionName, const std::string& actionName);
+
+  void invalidateLeafActions(const std::string& actionName);
+};
@@ -3,14 +3,17 @@
 #include <ThunderAuto/DocumentEditManager.hpp>
 #include <ThunderAuto/DocumentManager.hpp>
 #include <ThunderAuto/FontLibrary.hpp>
+#include <ThunderAuto/ProjectLoadTask.hpp>
 
 #include <ThunderAuto/Popups/NewFieldPopup.hpp>
 #include <ThunderAuto/Popups/NewProjectPopup.hpp>
 #include <ThunderAuto/Popups/UnsavedPopup.hpp>
 #include <ThunderAuto/Popups/WelcomePopup.hpp>
 #include <ThunderAuto/Popups/OpenProjectErrorPopup.hpp>
+#include <ThunderAuto/Popups/ProjectLoadingPopup.hpp>
 #include <ThunderAuto/Popups/SaveProjectErrorPopup.hpp>
 #include <ThunderAuto/Popups/ProjectVersionPopup.hpp>
+#include <ThunderAuto/Popups/RecoveredEditsPopup.hpp>
 #include <ThunderAuto/Popups/CSVExportPopup.hpp>
 #include <ThunderAuto/Popups/NewTrajectoryPopup.hpp>
 #include <ThunderAuto/Popups/RenameTrajectoryPopup.hpp>
@@ -32,6 +35,13 @@
 #include <ThunderAuto/Pages/PropertiesPage.hpp>
 #include <ThunderAuto/Pages/ProjectSettingsPage.hpp>
 #include <ThunderAuto/Pages/RemoteUpdatePage.hpp>
+#include <ThunderAuto/Pages/HistoryPage.hpp>
+#include <ThunderAuto/Pages/AutoModeAnalysisPage.hpp>
+#include <ThunderAuto/Pages/TelemetryPage.hpp>
+#include <ThunderAuto/Pages/RobotLogReplayPage.hpp>
+#include <ThunderAuto/Pages/SpeedConstraintTunerPage.hpp>
+#include <ThunderAuto/Pages/WaypointOptimizerPage.hpp>
+#include <ThunderAuto/Pages/ImageExportPage.hpp>
 
 #include <ThunderLibCore/RecentItemList.hpp>
 
@@ -40,6 +50,8 @@
 
 #include <string>
 #include <filesystem>
+#include <memory>
+#include <vector>
 
 using namespace thunder::core;
 
@@ -59,6 +71,7 @@ class App {
     CLOSE_PROJECT,
     CLOSE_EVERYTHING,
     OPEN_PROJECT_ERROR,
+    LOADING_PROJECT,
   };
 
   EventState m_eventState = EventState::WELCOME;
@@ -69,6 +82,7 @@ class App {
     UNSAVED,
     SAVE_ERROR,
     VERSION_DIFFERENT,
+    RECOVERED_EDITS,
     CSV_EXPORT,
 
     NEW_TRAJECTORY,
@@ -96,6 +110,19 @@ class App {
 
   RecentItemList<std::filesystem::path, 15> m_recentProjects;
 
+  std::unique_ptr<ProjectLoadTask> m_projectLoadTask;
+
+  // Cancelled project loads that are still finishing up in the background.
+  std::vector<std::unique_ptr<ProjectLoadTask>> m_cancelledProjectLoadTasks;
+
+  // The section of the app save ini file currently being read.
+  enum class DataSection {
+    RECENT_PROJECTS,
+    PREFERENCES,
+  };
+
+  DataSection m_dataSection = DataSection::RECENT_PROJECTS;
+
   bool m_wasUnsaved = false;
   std::string m_titlebarFilename;
 
@@ -106,8 +133,10 @@ class App {
   UnsavedPopup m_unsavedPopup;
   WelcomePopup m_welcomePopup{m_recentProjects};
   OpenProjectErrorPopup m_openProjectErrorPopup;
+  ProjectLoadingPopup m_projectLoadingPopup;
   SaveProjectErrorPopup m_saveProjectErrorPopup;
   ProjectVersionPopup m_projectVersionPopup;
+  RecoveredEditsPopup m_recoveredEditsPopup;
   CSVExportPopup m_csvExportPopup;
 
   NewTrajectoryPopup m_newTrajectoryPopup{m_documentEditManager, m_editorPage};
@@ -131,7 +160,14 @@ class App {
   PropertiesPage m_propertiesPage{m_documentEditManager, m_editorPage};
   ActionsPage m_actionsPage{m_documentEditManager};
   ProjectSettingsPage m_projectSettingsPage{m_documentManager, m_editorPage};
-  RemoteUpdatePage m_remoteUpdatePage{m_documentManager, m_documentEditManager};
+  RemoteUpdatePage m_remoteUpdatePage{m_documentManager, m_documentEditManager, m_editorPage};
+  HistoryPage m_historyPage{m_documentManager, m_documentEditManager};
+  AutoModeAnalysisPage m_autoModeAnalysisPage{m_documentEditManager};
+  TelemetryPage m_telemetryPage{m_documentEditManager, m_editorPage};
+  RobotLogReplayPage m_robotLogReplayPage{m_editorPage};
+  SpeedConstraintTunerPage m_speedConstraintTunerPage{m_documentEditManager};
+  WaypointOptimizerPage m_waypointOptimizerPage{m_documentManager, m_documentEditManager, m_editorPage};
+  ImageExportPage m_imageExportPage{m_documentManager, m_documentEditManager};
 
   // bool m_showEditor = true;
   // bool m_showTrajectoryManager = true;
@@ -140,6 +176,13 @@ class App {
   bool m_showActions = true;
   bool m_showProjectSettings = false;
   bool m_showRemoteUpdate = false;
+  bool m_showHistory = false;
+  bool m_showAutoModeAnalysis = false;
+  bool m_showTelemetry = false;
+  bool m_showRobotLogReplay = false;
+  bool m_showSpeedConstraintTuner = false;
+  bool m_showWaypointOptimizer = false;
+  bool m_showImageExport = false;
 #ifdef THUNDERAUTO_DEBUG
   bool m_showImGuiDemoWindow = false;
 #endif
@@ -170,6 +213,10 @@ class App {
   // Project stuff
 
   void openFromPath(const std::filesystem::path& path);
+
+  // Opens a project in the background, showing a loading indicator until it is ready.
+  void openFromPathAsync(const std::filesystem::path& path);
+
   void close();
 
   // Data handling
@@ -181,6 +228,9 @@ class App {
   void dataWrite(const char* typeName, ImGuiTextBuffer* buf);
 
  private:
+  void dataReadRecentProjectLine(const char* line);
+  void dataReadPreferenceLine(const char* line);
+
   void presentProjectPages();
   void presentProjectEventPopups();
 
@@ -200,11 +250,19 @@ class App {
   void presentNewProjectPopup();
   void presentNewFieldPopup();
   void openProject();
+  void finishOpeningProject(const std::filesystem::path& path,
+                            ThunderAutoProjectVersion projectVersion,
+                            const TextureImage* fieldImage = nullptr);
 
   void presentUnsavedPopup();
   void presentOpenProjectErrorPopup();
+  void presentProjectLoadingPopup();
+  void cancelProjectLoad();
+  void reapCancelledProjectLoads();
+  void waitForCancelledProjectLoads();
   void presentSaveProjectErrorPopup();
   void presentProjectVersionDifferentPopup();
+  void presentRecoveredEditsPopup();
   void presentCSVExportedPopup();
   void presentNewTrajectoryPopup();
   void presentRenameTrajectoryPopup();
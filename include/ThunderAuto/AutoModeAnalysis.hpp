@@ -0,0 +1,98 @@
+#pragma once
+
+#include <ThunderLibCore/Auto/ThunderAutoProject.hpp>
+#include <ThunderLibCore/Types.hpp>
+#include <units/time.h>
+#include <atomic>
+#include <future>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace thunder::core;
+
+/**
+ * Works out how long every possible run of every auto mode takes, i.e. every combination of branches that
+ * can be taken through the auto mode's branch steps.
+ *
+ * Runs in the background. The trajectories used by the auto modes are each built once, and the combinations
+ * of each auto mode are enumerated in parallel on the thread pool. Combinations are enumerated depth first,
+ * so the steps before a branch are only accounted for once no matter how many combinations share them.
+ *
+ * Only trajectory steps take time, since the length of an action is not known to the editor.
+ */
+class AutoModeAnalysis final {
+ public:
+  static constexpr units::second_t kAutonomousPeriod = units::second_t(15.0);
+
+  // Enumeration of an auto mode stops after this many combinations.
+  static constexpr size_t kMaxCombinationsPerAutoMode = 10000;
+
+  struct Combination {
+    std::string autoModeName;
+
+    // The branch taken at each branch step, e.g. "2: TRUE, 3.true.0: CASE 4"
+    std::string branches;
+
+    units::second_t totalTime = units::second_t(0.0);
+
+    // Where the last trajectory ends, if any trajectories run.
+    std::optional<Point2d> finalPosition;
+    std::optional<CanonicalAngle> finalRotation;
+
+    bool exceedsAutonomousPeriod() const noexcept { return totalTime > kAutonomousPeriod; }
+  };
+
+  struct Result {
+    std::vector<Combination> combinations;
+
+    // Auto modes that had more than kMaxCombinationsPerAutoMode combinations.
+    std::vector<std::string> truncatedAutoModes;
+
+    bool cancelled = false;
+    std::string error;  // Empty if successful.
+  };
+
+ private:
+  struct SharedState {
+    std::atomic<size_t> numTasks = 0;
+    std::atomic<size_t> numFinishedTasks = 0;
+    std::atomic<bool> cancelled = false;
+  };
+
+  std::shared_ptr<SharedState> m_sharedState;
+  std::future<Result> m_future;
+
+ public:
+  /**
+   * Starts analyzing the auto modes of a project state in the background.
+   */
+  explicit AutoModeAnalysis(ThunderAutoProjectState state);
+
+  // Cancels the analysis and waits for it to stop.
+  ~AutoModeAnalysis() { cancel(); }
+
+  AutoModeAnalysis(const AutoModeAnalysis&) = delete;
+  AutoModeAnalysis& operator=(const AutoModeAnalysis&) = delete;
+
+  /**
+   * Returns the approximate progress of the analysis, from 0 to 1.
+   */
+  float progress() const noexcept;
+
+  void cancel() noexcept { m_sharedState->cancelled = true; }
+
+  /**
+   * Returns whether the analysis has finished (successfully or not). Does not block.
+   */
+  bool isFinished() const;
+
+  /**
+   * Takes the result of the analysis. Blocks until the analysis is finished, and can only be called once.
+   */
+  Result takeResult();
+
+ private:
+  static Result Run(ThunderAutoProjectState state, std::shared_ptr<SharedState> sharedState);
+};
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <ThunderLibCore/Auto/ThunderAutoProject.hpp>
+#include <cstddef>
+#include <span>
+#include <string>
+#include <vector>
+
+using namespace thunder::core;
+
+/**
+ * Every step of an auto mode in one flat list, so that the editor and the properties page can go through the
+ * steps without walking the step directories, building step paths, or formatting labels every frame.
+ *
+ * Steps are listed in preorder (the order the properties page shows them), so the steps nested inside a
+ * branch step come right after it, followed by its next sibling.
+ */
+class AutoModeStepIndex final {
+ public:
+  static constexpr size_t kNone = static_cast<size_t>(-1);
+
+  struct Entry {
+    ThunderAutoModeStepPath path;
+    ThunderAutoModeStepType type = ThunderAutoModeStepType::ACTION;
+
+    // Number of branches the step is nested in.
+    size_t depth = 0;
+
+    // The branch step that the step is in, and which of its branches, or kNone for top level steps.
+    size_t parent = kNone;
+    size_t branch = kNone;
+
+    // One past the last step nested inside this step.
+    size_t subtreeEnd = 0;
+
+    // The branches of a branch step, as indices in branches().
+    size_t firstBranch = 0;
+    size_t branchesEnd = 0;
+
+    // Index among the trajectory steps in the order the editor draws them, or kNone if not a trajectory step.
+    size_t trajectorySlot = kNone;
+
+    // Whether the editor is displaying every branch the step is in.
+    bool isActive = true;
+
+    // The trajectory, action, or condition name of the step.
+    std::string itemName;
+
+    // Icon and item name, for the step tree.
+    std::string label;
+
+    // ThunderAutoModeStepPathToString(path).
+    std::string pathString;
+  };
+
+  struct Branch {
+    enum class Type {
+      BOOL_TRUE,
+      BOOL_ELSE,
+      SWITCH_CASE,
+      SWITCH_DEFAULT,
+    };
+
+    Type type = Type::BOOL_TRUE;
+    int caseValue = 0;  // For SWITCH_CASE.
+
+    ThunderAutoModeStepDirectoryPath path;
+
+    // "TRUE", "FALSE", "CASE <value>", or "DEFAULT".
+    std::string label;
+
+    // The steps in the branch, including nested ones.
+    size_t begin = 0;
+    size_t end = 0;
+
+    bool isDisplayedInEditor = false;
+  };
+
+ private:
+  std::vector<Entry> m_entries;
+  std::vector<Branch> m_branches;
+  std::vector<size_t> m_editorOrder;
+  size_t m_numTrajectorySlots = 0;
+
+ public:
+  void rebuild(const ThunderAutoMode& autoMode);
+
+  void clear() noexcept;
+
+  std::span<const Entry> entries() const noexcept { return m_entries; }
+  std::span<const Branch> branches() const noexcept { return m_branches; }
+
+  /**
+   * Indices of every entry in the order the editor draws them. The branches the editor isn't displaying
+   * come before the one it is, so that the displayed trajectories are drawn on top.
+   */
+  std::span<const size_t> editorOrder() const noexcept { return m_editorOrder; }
+
+  size_t numTrajectorySlots() const noexcept { return m_numTrajectorySlots; }
+
+ private:
+  void addSteps(const ThunderAutoModeStepDirectoryPath& directoryPath,
+                const ThunderAutoMode::StepDirectory& steps,
+                size_t parent,
+                size_t branch,
+                size_t depth);
+
+  void addBranch(Branch::Type type,
+                 int caseValue,
+                 ThunderAutoModeStepDirectoryPath path,
+                 std::string label,
+                 bool isDisplayedInEditor);
+
+  void addBranchSteps(size_t branchIndex,
+                      const ThunderAutoMode::StepDirectory& steps,
+                      size_t parent,
+                      size_t depth);
+
+  // Sets which steps are active and gives trajectory steps their slots on the way.
+  void addEditorOrder(size_t begin, size_t end, bool isActive);
+};
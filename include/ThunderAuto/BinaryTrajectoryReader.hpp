@@ -0,0 +1,305 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <numbers>
+#include <optional>
+#include <span>
+
+/**
+ * Binary trajectory files (.tatraj), an alternative to CSV for robot code that wants to load trajectories
+ * quickly at startup. Values are stored column by column, so a file can be memory mapped and read in place
+ * without parsing anything.
+ *
+ * This header only uses the standard library, so that robot code can copy it as is.
+ *
+ * Layout, all little endian:
+ *
+ *   BinaryTrajectoryHeader         64 bytes
+ *   BinaryTrajectoryColumn[n]      16 bytes each, at header.columnTableOffset
+ *   Column values                  numPoints values each, starting on a 64 byte boundary
+ *
+ * The columns are the values selected in the project's export settings (the same ones as a CSV export), plus
+ * time, which is always written. Positions are in meters, angles in radians, and times in seconds. The
+ * actions column is a bit field of the actions that run at each point, with bit i being action i of the
+ * project's actions.
+ *
+ * Readers should skip columns they don't know. New columns are a minor version change, and anything else is a
+ * major version change.
+ */
+
+inline constexpr std::array<char, 8> kBinaryTrajectoryMagic = {'T', 'A', 'T', 'R', 'A', 'J', '\0', '\0'};
+inline constexpr uint16_t kBinaryTrajectoryVersionMajor = 1;
+inline constexpr uint16_t kBinaryTrajectoryVersionMinor = 0;
+
+// Column values start on a boundary this big (a cache line), from the start of the file.
+inline constexpr uint64_t kBinaryTrajectoryColumnAlignment = 64;
+
+enum class BinaryTrajectoryColumnID : uint32_t {
+  TIME = 0,
+  POSITION_X = 1,
+  POSITION_Y = 2,
+  LINEAR_VELOCITY = 3,
+  VELOCITY_X = 4,
+  VELOCITY_Y = 5,
+  HEADING = 6,
+  ROTATION = 7,
+  ANGULAR_VELOCITY = 8,
+  ACTIONS = 9,
+  DISTANCE = 10,
+  CURVATURE = 11,
+  CENTRIPETAL_ACCELERATION = 12,
+};
+
+inline constexpr size_t kNumBinaryTrajectoryColumnIDs = 13;
+
+enum class BinaryTrajectoryColumnType : uint32_t {
+  FLOAT64 = 0,
+  UINT64 = 1,
+};
+
+// The actions column is UINT64, every other column is FLOAT64.
+constexpr BinaryTrajectoryColumnType BinaryTrajectoryColumnTypeOf(BinaryTrajectoryColumnID id) noexcept {
+  return id == BinaryTrajectoryColumnID::ACTIONS ? BinaryTrajectoryColumnType::UINT64
+                                                 : BinaryTrajectoryColumnType::FLOAT64;
+}
+
+struct BinaryTrajectoryHeader {
+  std::array<char, 8> magic;
+  uint16_t versionMajor;
+  uint16_t versionMinor;
+  uint32_t headerSize;  // sizeof(BinaryTrajectoryHeader) when written.
+  uint32_t numColumns;
+  uint32_t columnTableOffset;
+  uint64_t numPoints;
+  uint64_t fileSize;
+  double totalTime;
+  std::array<uint8_t, 16> reserved;
+};
+
+static_assert(sizeof(BinaryTrajectoryHeader) == 64);
+
+struct BinaryTrajectoryColumn {
+  uint32_t id;    // BinaryTrajectoryColumnID
+  uint32_t type;  // BinaryTrajectoryColumnType
+  uint64_t offset;
+};
+
+static_assert(sizeof(BinaryTrajectoryColumn) == 16);
+
+/**
+ * Reads a binary trajectory file that is already in memory (e.g. memory mapped), without copying it. The
+ * memory must outlive the reader.
+ */
+class BinaryTrajectoryReader final {
+  static_assert(std::endian::native == std::endian::little,
+                "Binary trajectory files are little endian, and are read in place");
+
+ public:
+  /**
+   * Every value at a time. Values of columns that weren't exported are NaN (or 0 for actions).
+   */
+  struct Sample {
+    double time = 0.0;
+    double positionX = kMissing;
+    double positionY = kMissing;
+    double linearVelocity = kMissing;
+    double velocityX = kMissing;
+    double velocityY = kMissing;
+    double heading = kMissing;
+    double rotation = kMissing;
+    double angularVelocity = kMissing;
+    double distance = kMissing;
+    double curvature = kMissing;
+    double centripetalAcceleration = kMissing;
+
+    // The actions of the last point at or before the time.
+    uint64_t actions = 0;
+  };
+
+ private:
+  static constexpr double kMissing = std::numeric_limits<double>::quiet_NaN();
+
+  BinaryTrajectoryHeader m_header{};
+  std::array<const void*, kNumBinaryTrajectoryColumnIDs> m_columns{};
+
+  // Where the last sample landed, so that sampling forward in time is usually constant time.
+  mutable size_t m_cursor = 0;
+
+  BinaryTrajectoryReader() = default;
+
+ public:
+  /**
+   * Checks a file and finds its columns.
+   *
+   * @param data The whole file, aligned to at least 8 bytes (memory mappings always are)
+   *
+   * @return The reader, or std::nullopt if the file isn't a binary trajectory file this reader understands
+   */
+  static std::optional<BinaryTrajectoryReader> Open(std::span<const uint8_t> data) noexcept {
+    BinaryTrajectoryHeader header;
+    if (data.size() < sizeof(header))
+      return std::nullopt;
+
+    std::memcpy(&header, data.data(), sizeof(header));
+
+    if (header.magic != kBinaryTrajectoryMagic || header.versionMajor != kBinaryTrajectoryVersionMajor)
+      return std::nullopt;
+
+    if (header.fileSize > data.size() || header.numPoints == 0)
+      return std::nullopt;
+
+    if (reinterpret_cast<uintptr_t>(data.data()) % alignof(double) != 0)
+      return std::nullopt;
+
+    const uint64_t columnTableEnd =
+        uint64_t(header.columnTableOffset) + uint64_t(header.numColumns) * sizeof(BinaryTrajectoryColumn);
+    if (columnTableEnd > header.fileSize)
+      return std::nullopt;
+
+    // Guard the column size computation below from overflowing.
+    if (header.numPoints > header.fileSize / sizeof(uint64_t))
+      return std::nullopt;
+
+    const uint64_t columnSize = header.numPoints * sizeof(uint64_t);
+
+    BinaryTrajectoryReader reader;
+    reader.m_header = header;
+
+    for (uint32_t i = 0; i < header.numColumns; i++) {
+      BinaryTrajectoryColumn column;
+      std::memcpy(&column, data.data() + header.columnTableOffset + i * sizeof(column), sizeof(column));
+
+      // Added by a newer minor version.
+      if (column.id >= kNumBinaryTrajectoryColumnIDs)
+        continue;
+
+      const auto id = static_cast<BinaryTrajectoryColumnID>(column.id);
+      if (column.type != static_cast<uint32_t>(BinaryTrajectoryColumnTypeOf(id)))
+        return std::nullopt;
+
+      if (column.offset % alignof(uint64_t) != 0 || column.offset > header.fileSize ||
+          header.fileSize - column.offset < columnSize)
+        return std::nullopt;
+
+      reader.m_columns[column.id] = data.data() + column.offset;
+    }
+
+    // Can't sample without times.
+    if (!reader.hasColumn(BinaryTrajectoryColumnID::TIME))
+      return std::nullopt;
+
+    return reader;
+  }
+
+  uint16_t versionMajor() const noexcept { return m_header.versionMajor; }
+  uint16_t versionMinor() const noexcept { return m_header.versionMinor; }
+
+  size_t numPoints() const noexcept { return static_cast<size_t>(m_header.numPoints); }
+
+  // Seconds.
+  double totalTime() const noexcept { return m_header.totalTime; }
+
+  bool hasColumn(BinaryTrajectoryColumnID id) const noexcept {
+    return m_columns[static_cast<size_t>(id)] != nullptr;
+  }
+
+  /**
+   * The values of a FLOAT64 column, or an empty span if the column wasn't exported.
+   */
+  std::span<const double> column(BinaryTrajectoryColumnID id) const noexcept {
+    if (!hasColumn(id) || BinaryTrajectoryColumnTypeOf(id) != BinaryTrajectoryColumnType::FLOAT64)
+      return {};
+
+    return {static_cast<const double*>(m_columns[static_cast<size_t>(id)]), numPoints()};
+  }
+
+  /**
+   * The actions bit field of every point, or an empty span if it wasn't exported.
+   */
+  std::span<const uint64_t> actions() const noexcept {
+    if (!hasColumn(BinaryTrajectoryColumnID::ACTIONS))
+      return {};
+
+    return {static_cast<const uint64_t*>(m_columns[static_cast<size_t>(BinaryTrajectoryColumnID::ACTIONS)]),
+            numPoints()};
+  }
+
+  /**
+   * Interpolates every column at a time. Times outside the trajectory are clamped to it. Not thread safe,
+   * use one reader per thread.
+   *
+   * @param time Seconds since the start of the trajectory
+   */
+  Sample sample(double time) const noexcept {
+    using enum BinaryTrajectoryColumnID;
+
+    std::span<const double> times = column(TIME);
+    time = std::clamp(time, times.front(), times.back());
+
+    const size_t upperIndex = findUpperPoint(times, time);
+    const size_t lowerIndex = upperIndex > 0 ? upperIndex - 1 : 0;
+
+    const double dt = times[upperIndex] - times[lowerIndex];
+    const double t = dt > 0.0 ? std::clamp((time - times[lowerIndex]) / dt, 0.0, 1.0) : 0.0;
+
+    auto lerp = [&](BinaryTrajectoryColumnID id) {
+      std::span<const double> values = column(id);
+      if (values.empty())
+        return kMissing;
+      return values[lowerIndex] + (values[upperIndex] - values[lowerIndex]) * t;
+    };
+
+    // Angles go the short way around.
+    auto lerpAngle = [&](BinaryTrajectoryColumnID id) {
+      std::span<const double> values = column(id);
+      if (values.empty())
+        return kMissing;
+      const double delta = std::remainder(values[upperIndex] - values[lowerIndex], 2.0 * std::numbers::pi);
+      return std::remainder(values[lowerIndex] + delta * t, 2.0 * std::numbers::pi);
+    };
+
+    Sample sample;
+    sample.time = time;
+    sample.positionX = lerp(POSITION_X);
+    sample.positionY = lerp(POSITION_Y);
+    sample.linearVelocity = lerp(LINEAR_VELOCITY);
+    sample.velocityX = lerp(VELOCITY_X);
+    sample.velocityY = lerp(VELOCITY_Y);
+    sample.heading = lerpAngle(HEADING);
+    sample.rotation = lerpAngle(ROTATION);
+    sample.angularVelocity = lerp(ANGULAR_VELOCITY);
+    sample.distance = lerp(DISTANCE);
+    sample.curvature = lerp(CURVATURE);
+    sample.centripetalAcceleration = lerp(CENTRIPETAL_ACCELERATION);
+
+    std::span<const uint64_t> actionValues = actions();
+    if (!actionValues.empty()) {
+      sample.actions = actionValues[(t >= 1.0) ? upperIndex : lowerIndex];
+    }
+
+    return sample;
+  }
+
+ private:
+  // The first point at or after a time, which must be within the trajectory.
+  size_t findUpperPoint(std::span<const double> times, double time) const noexcept {
+    // Usually the same segment as last time, or the next one.
+    for (size_t i = m_cursor; i < std::min(m_cursor + 2, times.size()); i++) {
+      if (times[i] >= time && (i == 0 || times[i - 1] < time)) {
+        m_cursor = i;
+        return i;
+      }
+    }
+
+    m_cursor = static_cast<size_t>(std::lower_bound(times.begin(), times.end(), time) - times.begin());
+    m_cursor = std::min(m_cursor, times.size() - 1);
+    return m_cursor;
+  }
+};
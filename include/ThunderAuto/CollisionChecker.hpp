@@ -0,0 +1,163 @@
+#pragma once
+
+#include <ThunderAuto/KeepOutZones.hpp>
+#include <ThunderAuto/PreviewTrajectoryCache.hpp>
+#include <ThunderAuto/Shapes.hpp>
+#include <ThunderLibCore/Auto/ThunderAutoProject.hpp>
+#include <ThunderLibCore/Auto/ThunderAutoOutputTrajectory.hpp>
+#include <ThunderLibCore/Types.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace thunder::core;
+
+/**
+ * The edges of every keep-out zone, arranged in a bounding volume hierarchy so that a polygon only has to be
+ * tested against the edges near it.
+ *
+ * This doesn't change once built, so it can be shared with background threads.
+ */
+class KeepOutGeometry final {
+ public:
+  struct Box {
+    float minX, minY;
+    float maxX, maxY;
+
+    bool overlaps(const Box& other) const noexcept {
+      return minX <= other.maxX && other.minX <= maxX && minY <= other.maxY && other.minY <= maxY;
+    }
+    bool contains(const Box& other) const noexcept {
+      return minX <= other.minX && other.maxX <= maxX && minY <= other.minY && other.maxY <= maxY;
+    }
+  };
+
+ private:
+  struct Edge {
+    float x0, y0;
+    float x1, y1;
+    uint32_t zoneIndex;
+  };
+
+  struct Zone {
+    Box box;
+    uint32_t firstEdge;
+    uint32_t numEdges;
+  };
+
+  // A leaf if numEdges is not zero. Otherwise the left child is the next node, and the right child is at
+  // rightChild.
+  struct Node {
+    Box box;
+    uint32_t firstEdge;
+    uint32_t numEdges;
+    uint32_t rightChild;
+  };
+
+  static constexpr uint32_t kMaxEdgesPerLeaf = 4;
+
+  // Each zone's edges are next to each other.
+  std::vector<Edge> m_edges;
+  std::vector<Zone> m_zones;
+
+  // Indices into m_edges, reordered while building the tree so that each node's edges are next to each other.
+  std::vector<uint32_t> m_nodeEdges;
+  std::vector<Node> m_nodes;
+
+ public:
+  explicit KeepOutGeometry(const KeepOutZoneList& zones);
+
+  bool empty() const noexcept { return m_edges.empty(); }
+
+  /**
+   * Finds a keep-out zone that a convex polygon overlaps, if any.
+   *
+   * @param x The x coordinates of the polygon's vertices, in meters
+   * @param y The y coordinates of the polygon's vertices, in meters
+   *
+   * @return The index of the overlapping zone, or std::nullopt if the polygon is clear of every zone
+   */
+  std::optional<size_t> findOverlappingZone(std::span<const float> x, std::span<const float> y) const;
+
+ private:
+  uint32_t buildNode(uint32_t firstEdge, uint32_t numEdges);
+
+  bool isPointInsideZone(const Zone& zone, float x, float y) const noexcept;
+};
+
+/**
+ * A part of a trajectory where the robot overlaps a keep-out zone. The point indices are of the trajectory
+ * built with kPreviewOutputTrajectorySettings.
+ */
+struct CollisionSegment {
+  size_t startPointIndex;
+  size_t endPointIndex;
+  size_t zoneIndex;
+};
+
+/**
+ * Checks whether the robot enters any keep-out zones while following each trajectory.
+ *
+ * The robot's footprint is swept between each pair of points of the preview output trajectory, and the swept
+ * area is tested against the keep-out zones. Checks run on the thread pool, and only trajectories that
+ * changed since their last check are checked again. The previews come from a PreviewTrajectoryCache, so a
+ * check waits for its trajectory to be built.
+ */
+class CollisionChecker final {
+  struct Entry {
+    // Incremented whenever the trajectory changes.
+    uint64_t generation = 0;
+    std::optional<uint64_t> checkedGeneration;
+
+    std::vector<CollisionSegment> collisions;
+
+    std::future<std::vector<CollisionSegment>> pendingCollisions;
+    uint64_t pendingGeneration = 0;
+  };
+
+  std::unordered_map<std::string, Entry> m_entries;
+
+  std::shared_ptr<const KeepOutGeometry> m_geometry;
+  std::shared_ptr<const PolygonSoA> m_footprint;
+
+ public:
+  /**
+   * Sets the keep-out zones and robot footprint to check against. Every trajectory will be checked again.
+   */
+  void setGeometry(const KeepOutZoneList& zones, Measurement2d robotSize, units::meter_t robotCornerRadius);
+
+  void invalidateTrajectory(const std::string& trajectoryName) noexcept;
+  void invalidateAll() noexcept;
+
+  void clear() noexcept;
+
+  /**
+   * Collects finished checks, and starts checks for trajectories that changed. Should be called every frame.
+   *
+   * @param state The current project state
+   * @param previewTrajectories The previews of the state's trajectories, already updated this frame
+   */
+  void update(const ThunderAutoProjectState& state, PreviewTrajectoryCache& previewTrajectories);
+
+  /**
+   * The collisions found during the last finished check of a trajectory. Empty if the trajectory hasn't been
+   * checked yet.
+   */
+  std::span<const CollisionSegment> collisions(const std::string& trajectoryName) const noexcept;
+
+  bool isChecking() const noexcept;
+
+  /**
+   * Checks a trajectory that was already built with kPreviewOutputTrajectorySettings. Safe to call from any
+   * thread.
+   */
+  static std::vector<CollisionSegment> CheckTrajectory(const ThunderAutoOutputTrajectory& trajectory,
+                                                       const KeepOutGeometry& geometry,
+                                                       const PolygonSoA& footprint);
+};
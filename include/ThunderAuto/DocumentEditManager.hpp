@@ -1,7 +1,13 @@
 #pragma once
 
+#include <ThunderAuto/ActionGraph.hpp>
+#include <ThunderAuto/AutoModeStepIndex.hpp>
 #include <ThunderAuto/HistoryManager.hpp>
+#include <ThunderAuto/NameSearchIndex.hpp>
+#include <ThunderAuto/StateChangeSet.hpp>
+#include <ThunderAuto/TrajectoryLinkIndex.hpp>
 #include <ThunderLibCore/Auto/ThunderAutoProject.hpp>
+#include <cstdint>
 #include <optional>
 #include <functional>
 #include <unordered_map>
@@ -12,6 +18,29 @@ class DocumentEditManager final {
   HistoryManager& m_history;
   std::optional<ThunderAutoProjectState> m_currentState = std::nullopt;
 
+  // Everything that has changed since the long edit started.
+  StateChangeSet m_longEditChanges;
+
+  // Kept up to date with the current state. Rebuilt when the history is reset (e.g. a project is opened).
+  TrajectoryLinkIndex m_linkIndex;
+  ActionGraph m_actionGraph;
+  NameSearchIndex m_trajectoryNameIndex;
+  NameSearchIndex m_autoModeNameIndex;
+  NameSearchIndex m_actionNameIndex;  // In the same order as the actions list.
+  HistoryManager::NodeID m_indexesRootNode = HistoryManager::kInvalidNodeID;
+
+  // Trajectory name -> version it was given the last time it changed. Trajectories that haven't changed
+  // since everything last changed aren't listed, and have m_allTrajectoriesVersion.
+  std::unordered_map<std::string, uint64_t> m_trajectoryVersions;
+  uint64_t m_allTrajectoriesVersion = 0;
+  uint64_t m_lastTrajectoryVersion = 0;
+
+  // The steps of one auto mode (usually the one being edited). Only rebuilt when it's asked for, so it
+  // doesn't change while a page is going through it.
+  AutoModeStepIndex m_autoModeStepIndex;
+  std::string m_autoModeStepIndexName;
+  bool m_isAutoModeStepIndexValid = false;
+
  public:
   explicit DocumentEditManager(HistoryManager& history) noexcept : m_history(history) {}
 
@@ -21,13 +50,73 @@ class DocumentEditManager final {
 
   const ThunderAutoProjectState& currentState() const noexcept;
 
+  /**
+   * The state being worked on by the current long edit, or nullptr if there isn't one.
+   *
+   * It can be modified in place and then passed back to addState(), which avoids copying the whole project
+   * every time something changes (e.g. every frame of a drag). Only the history is updated when the long
+   * edit finishes. The state is destroyed once the long edit finishes or is discarded.
+   */
+  ThunderAutoProjectState* longEditState() noexcept;
+
+  /**
+   * Which waypoints and trajectory ends are linked to each other in the current state.
+   */
+  const TrajectoryLinkIndex& linkIndex() noexcept;
+
+  /**
+   * Which actions each action group runs in the current state.
+   */
+  const ActionGraph& actionGraph() noexcept;
+
+  /**
+   * The names of the trajectories, auto modes, and actions in the current state, for searching.
+   */
+  const NameSearchIndex& trajectoryNameIndex() noexcept;
+  const NameSearchIndex& autoModeNameIndex() noexcept;
+  const NameSearchIndex& actionNameIndex() noexcept;
+
+  /**
+   * Changes whenever a trajectory changes, so that anything derived from one can tell when it's out of date.
+   */
+  uint64_t trajectoryVersion(const std::string& trajectoryName) noexcept;
+
+  /**
+   * The flattened steps of an auto mode in the current state. Empty if the auto mode doesn't exist.
+   *
+   * The index is rebuilt by this function when the auto mode has changed, so it is safe to keep going
+   * through it after adding a state (although it will be out of date until this is called again).
+   */
+  const AutoModeStepIndex& autoModeStepIndex(const std::string& autoModeName) noexcept;
+
+  /**
+   * Adds a new state. What changed is found by comparing it to the last state in the history, which
+   * serializes every trajectory, auto mode, and action. Edits that happen every frame (e.g. drags) should
+   * pass what changed instead.
+   */
   void addState(const ThunderAutoProjectState& state, bool unsaved = true) noexcept;
+
+  /**
+   * Same as above, but for when the caller already knows what changed, which saves having to compare the
+   * states.
+   */
+  void addState(const ThunderAutoProjectState& state,
+                const StateChangeSet& changes,
+                bool unsaved = true) noexcept;
+
   void modifyLastState(const ThunderAutoProjectState& state, bool unsaved = true) noexcept;
+  void modifyLastState(const ThunderAutoProjectState& state,
+                       const StateChangeSet& changes,
+                       bool unsaved = true) noexcept;
 
   void undo() noexcept;
   void redo() noexcept;
+  void jumpTo(HistoryManager::NodeID node) noexcept;
 
-  using StateUpdateCallbackFunc = std::function<void()>;
+  /**
+   * Subscribers are told what changed whenever the current state changes.
+   */
+  using StateUpdateCallbackFunc = std::function<void(const StateChangeSet& changes)>;
   using StateUpdateSubscriberID = size_t;
 
   [[nodiscard]]
@@ -35,7 +124,14 @@ class DocumentEditManager final {
   void unregisterStateUpdateSubscriber(StateUpdateSubscriberID id) noexcept;
 
  private:
-  void notifyStateUpdateSubscribers() noexcept;
+  // Builds the indexes if the history was reset since they were last updated.
+  void ensureIndexesBuilt() noexcept;
+
+  void updateIndexes(const StateChangeSet& changes) noexcept;
+  void updateNameIndexes(const StateChangeSet& changes);
+  void updateTrajectoryVersions(const StateChangeSet& changes);
+
+  void notifyStateUpdateSubscribers(const StateChangeSet& changes) noexcept;
 
  private:
   std::unordered_map<StateUpdateSubscriberID, StateUpdateCallbackFunc> m_stateUpdateSubscribers;
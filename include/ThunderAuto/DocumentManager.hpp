@@ -1,20 +1,46 @@
 #pragma once
 
 #include <ThunderAuto/HistoryManager.hpp>
+#include <ThunderAuto/EditJournal.hpp>
+#include <ThunderAuto/KeepOutZones.hpp>
+#include <ThunderAuto/TrajectoryExport.hpp>
 #include <ThunderLibCore/Auto/ThunderAutoProject.hpp>
+#include <optional>
 
 using namespace thunder::core;
 
 class DocumentManager final {
   ThunderAutoProjectSettings m_settings;
+  KeepOutZoneList m_keepOutZones;
+  TrajectoryExportFormat m_trajectoryExportFormat = TrajectoryExportFormat::CSV;
   HistoryManager m_history;
+  EditJournal m_journal;
 
   bool m_open = false;
+  bool m_hasRecoveredEdits = false;
 
  public:
+  DocumentManager() { m_history.attachJournal(&m_journal); }
+
+  DocumentManager(const DocumentManager&) = delete;
+  DocumentManager& operator=(const DocumentManager&) = delete;
+
   const ThunderAutoProjectSettings& settings() const noexcept { return m_settings; }
   ThunderAutoProjectSettings& settings() noexcept { return m_settings; }
 
+  /**
+   * Like the project settings, keep-out zones are not part of undo history. Mark the history as unsaved
+   * after changing them.
+   */
+  const KeepOutZoneList& keepOutZones() const noexcept { return m_keepOutZones; }
+  KeepOutZoneList& keepOutZones() noexcept { return m_keepOutZones; }
+
+  /**
+   * The format trajectories are exported in. Not part of undo history either.
+   */
+  TrajectoryExportFormat trajectoryExportFormat() const noexcept { return m_trajectoryExportFormat; }
+  TrajectoryExportFormat& trajectoryExportFormat() noexcept { return m_trajectoryExportFormat; }
+
   const HistoryManager& history() const noexcept { return m_history; }
   HistoryManager& history() noexcept { return m_history; }
 
@@ -33,9 +59,59 @@ class DocumentManager final {
   void newProject(ThunderAutoProjectSettings settings) noexcept;
   ThunderAutoProjectVersion openProject(const std::filesystem::path& path);
 
+  struct LoadedProject {
+    ThunderAutoProjectSettings settings;
+    ThunderAutoProjectState state;
+    KeepOutZoneList keepOutZones;
+    TrajectoryExportFormat trajectoryExportFormat = TrajectoryExportFormat::CSV;
+    ThunderAutoProjectVersion version;
+
+    // Unsaved edits recovered from the project's edit journal, if the app didn't exit cleanly last time.
+    std::optional<ThunderAutoProjectState> recoveredState;
+  };
+
+  /**
+   * Loads and validates a project file without opening it. This does not touch any state, so it is safe to
+   * call from a background thread. Throws if the project could not be loaded.
+   *
+   * @param path The path to the project file
+   *
+   * @return The loaded project
+   */
+  static LoadedProject LoadProject(const std::filesystem::path& path);
+
+  /**
+   * Opens a project that was already loaded using LoadProject(). This only moves the loaded project in, so
+   * it is cheap to call from the main thread.
+   *
+   * @param loadedProject The loaded project
+   *
+   * @return The version of the project file
+   */
+  ThunderAutoProjectVersion openProject(LoadedProject loadedProject);
+
   void save();
 
+  /**
+   * Whether the open project has edits that were recovered from its edit journal and haven't been
+   * acknowledged yet.
+   */
+  bool hasRecoveredEdits() const noexcept { return m_hasRecoveredEdits; }
+
+  void keepRecoveredEdits() noexcept { m_hasRecoveredEdits = false; }
+
+  /**
+   * Reverts the open project back to how it was saved, dropping the recovered edits.
+   */
+  void discardRecoveredEdits() noexcept;
+
   void setProjectPath(const std::filesystem::path& path) noexcept { m_settings.setProjectPath(path); }
 
-  void close() noexcept;
+  /**
+   * Closes the project.
+   *
+   * @param discardJournal Whether to remove the project's edit journal. This should only be false if the
+   *                       project is being closed without being looked at.
+   */
+  void close(bool discardJournal = true) noexcept;
 };
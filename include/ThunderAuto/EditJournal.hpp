@@ -0,0 +1,116 @@
+#pragma once
+
+#include <ThunderLibCore/Auto/ThunderAutoProject.hpp>
+#include <wpi/json.h>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <thread>
+#include <vector>
+
+using namespace thunder::core;
+
+/**
+ * An append-only journal of edits, kept next to the project file so that unsaved work can be recovered if the
+ * app crashes.
+ *
+ * The journal starts with a snapshot of the project state as it is on disk, followed by a delta record for
+ * every change to the current state. Encoding and writing happen on a background thread, and the file is only
+ * synced to disk periodically so that rapid edits don't each wait on the disk.
+ *
+ * The journal is removed when the project is closed normally, so if one exists when a project is opened, the
+ * app must have exited without closing it.
+ */
+class EditJournal final {
+  struct Command {
+    enum class Type {
+      START,
+      RECORD,
+      STOP,
+    };
+
+    Type type;
+    std::filesystem::path path;
+    std::optional<ThunderAutoProjectState> state;
+    bool discard = false;
+  };
+
+  std::mutex m_mutex;
+  std::condition_variable m_condition;
+  std::deque<Command> m_commands;
+  bool m_exit = false;
+
+  bool m_active = false;
+
+  // Only accessed by the worker thread.
+  std::FILE* m_file = nullptr;
+  std::filesystem::path m_filePath;
+  wpi::json m_lastJournaledState;
+  bool m_unsynced = false;
+  std::chrono::steady_clock::time_point m_lastSyncTime;
+
+  std::thread m_thread;  // Declared last so that everything it uses is constructed before it starts.
+
+ public:
+  EditJournal();
+  ~EditJournal();
+
+  EditJournal(const EditJournal&) = delete;
+  EditJournal& operator=(const EditJournal&) = delete;
+
+  /**
+   * Returns the path of the journal for a project file.
+   */
+  static std::filesystem::path PathForProject(const std::filesystem::path& projectPath);
+
+  /**
+   * Replays the journal of a project, if there is one.
+   *
+   * @param projectPath The path to the project file
+   *
+   * @return The last journaled state, or nullopt if there is no journal or it contains no edits.
+   */
+  static std::optional<ThunderAutoProjectState> Replay(const std::filesystem::path& projectPath);
+
+  /**
+   * Starts a new journal for a project, replacing any existing one.
+   *
+   * @param projectPath The path to the project file
+   * @param baseState The state of the project as it is saved on disk
+   */
+  void start(const std::filesystem::path& projectPath, const ThunderAutoProjectState& baseState);
+
+  /**
+   * Records a change to the current state. Does nothing if the journal isn't started.
+   *
+   * @param state The new current state
+   */
+  void record(const ThunderAutoProjectState& state);
+
+  /**
+   * Stops journaling.
+   *
+   * @param discard Whether to remove the journal file (e.g. when the project was closed normally).
+   */
+  void stop(bool discard);
+
+  bool isActive() const noexcept { return m_active; }
+
+ private:
+  void pushCommand(Command command);
+
+  void threadMain();
+
+  void processCommand(Command& command);
+  void openFile(const std::filesystem::path& path, const ThunderAutoProjectState& baseState);
+  void appendState(const ThunderAutoProjectState& state);
+  void closeFile(bool discard);
+
+  void writeRecord(uint8_t type, std::span<const uint8_t> payload);
+  void sync();
+};
@@ -5,6 +5,33 @@
 #include <memory>
 #include <filesystem>
 
+/**
+ * Pixel data decoded from an image file. Decoding does not touch the graphics API, so unlike loading a
+ * Texture it can be done on a background thread.
+ */
+class TextureImage {
+  unsigned char* m_data = nullptr;
+  int m_width = 0, m_height = 0, m_numChannels = 0;
+
+  TextureImage() = default;
+
+ public:
+  ~TextureImage();
+
+  TextureImage(const TextureImage&) = delete;
+  TextureImage& operator=(const TextureImage&) = delete;
+  TextureImage(TextureImage&& other) noexcept;
+  TextureImage& operator=(TextureImage&& other) noexcept;
+
+  static TextureImage DecodeFromMemory(const unsigned char* data, size_t size);
+  static TextureImage DecodeFromFile(const std::filesystem::path& path);
+
+  unsigned char* data() const noexcept { return m_data; }
+  int width() const noexcept { return m_width; }
+  int height() const noexcept { return m_height; }
+  int numChannels() const noexcept { return m_numChannels; }
+};
+
 class Texture {
   bool m_loaded = false;
 
@@ -24,6 +51,13 @@ class Texture {
 
   void loadFromMemory(unsigned char* data, size_t size);
   void loadFromFile(const std::filesystem::path& path);
+  void loadFromImage(const TextureImage& image);
+
+  /**
+   * Replaces the texture's pixels with ones that are already decoded (e.g. drawn on a SoftwareCanvas).
+   * DirectX 11 only supports 4 channels.
+   */
+  void loadFromPixels(unsigned char* data, int width, int height, int numChannels);
 
   virtual int width() const noexcept = 0;
   virtual int height() const noexcept = 0;
@@ -43,4 +77,5 @@ class PlatformTexture {
   static std::unique_ptr<Texture> make();
   static std::unique_ptr<Texture> make(unsigned char* data, size_t size);
   static std::unique_ptr<Texture> make(const std::filesystem::path& path);
+  static std::unique_ptr<Texture> make(const TextureImage& image);
 };
@@ -1,20 +1,92 @@
 #pragma once
 
+#include <ThunderAuto/HistorySpillStore.hpp>
+#include <ThunderAuto/StateChangeSet.hpp>
 #include <ThunderLibCore/Auto/ThunderAutoProject.hpp>
-#include <deque>
+#include <wpi/json.h>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <vector>
 
 using namespace thunder::core;
 
 class DocumentManager;
+class EditJournal;
 
+/**
+ * Undo history, stored as a tree so that making a change after undoing starts a new branch instead of
+ * throwing away the changes that were undone.
+ *
+ * Each node stores JSON patches to and from its parent, so any node can be reached from the current one by
+ * applying the patches along the path between them. Full states are also cached for recently visited nodes
+ * (always including the current one) while they fit in the memory budget. Once nothing more can be evicted
+ * from the cache, the patches of the oldest nodes are written out to a spill store on disk.
+ */
 class HistoryManager final {
-  std::deque<ThunderAutoProjectState> m_history;
-  std::deque<ThunderAutoProjectState>::const_iterator m_currentState;
+ public:
+  using NodeID = uint64_t;
+  static constexpr NodeID kInvalidNodeID = 0;
+
+  static constexpr size_t kDefaultMemoryBudget = 64 * 1024 * 1024;
+  static constexpr size_t kMinMemoryBudget = 1 * 1024 * 1024;
+
+  using Clock = std::chrono::system_clock;
+
+ private:
+  struct Delta {
+    std::vector<uint8_t> data;  // Empty if only on disk.
+    std::optional<HistorySpillStore::Record> spilledRecord;
+  };
+
+  struct Node {
+    NodeID parent = kInvalidNodeID;
+    std::vector<NodeID> children;
+    NodeID lastVisitedChild = kInvalidNodeID;
+    size_t depth = 0;
+
+    Delta toParent;
+    Delta fromParent;
+
+    // What changed from the parent's state to this one.
+    StateChangeSet changes;
+
+    std::optional<ThunderAutoProjectState> cachedState;
+    size_t stateMemoryUsage = 0;
+    uint64_t lastUsed = 0;
+
+    Clock::time_point timestamp;
+  };
+
+  // Ordered by ID, which is also creation order.
+  std::map<NodeID, Node> m_nodes;
+
+  NodeID m_rootNode = kInvalidNodeID;
+  NodeID m_currentNode = kInvalidNodeID;
+  NodeID m_nextNodeID = 1;
+
+  // JSON form of the current state. Only computed when it's needed.
+  mutable std::optional<wpi::json> m_currentJson;
+
+  uint64_t m_useCounter = 0;
+  uint64_t m_treeVersion = 0;
+
+  size_t m_memoryBudget = kDefaultMemoryBudget;
+  size_t m_residentMemoryUsage = 0;
+  size_t m_spilledSize = 0;
+
+  HistorySpillStore m_spillStore;
 
   bool m_unsaved = false;
   bool m_locked = false;
 
+  EditJournal* m_journal = nullptr;
+
  public:
+  // Every change to the current state is recorded to the journal (if set).
+  void attachJournal(EditJournal* journal) noexcept { m_journal = journal; }
+
   void markUnsaved() noexcept { m_unsaved = true; }
   void markSaved() noexcept { m_unsaved = false; }
 
@@ -22,15 +94,94 @@ class HistoryManager final {
 
   void reset(ThunderAutoProjectState state, bool unsaved = false) noexcept;
 
-  const ThunderAutoProjectState& currentState() const noexcept { return *m_currentState; }
+  const ThunderAutoProjectState& currentState() const noexcept {
+    return *m_nodes.at(m_currentNode).cachedState;
+  }
+
+  /**
+   * Adds a state as a child of the current one, and makes it current.
+   *
+   * @param state The new state
+   * @param changes What changed from the current state to the new one
+   * @param unsaved Whether the project should be marked as unsaved
+   */
+  void addState(ThunderAutoProjectState state, const StateChangeSet& changes, bool unsaved = true) noexcept;
 
-  void addState(ThunderAutoProjectState state, bool unsaved = true) noexcept;
-  void modifyLastState(ThunderAutoProjectState state, bool unsaved = true) noexcept;
+  /**
+   * Replaces the current state, without adding a new node.
+   */
+  void modifyLastState(ThunderAutoProjectState state,
+                       const StateChangeSet& changes,
+                       bool unsaved = true) noexcept;
 
-  void undo() noexcept;
-  void redo() noexcept;
+  //
+  // Moving around the tree. Each returns what changed between the old and the new current state (empty if
+  // nothing moved).
+  //
+
+  // Moves to the parent node.
+  StateChangeSet undo() noexcept;
+
+  // Moves to the child node that was visited most recently.
+  StateChangeSet redo() noexcept;
+
+  // Moves to any node in the tree.
+  StateChangeSet jumpTo(NodeID node) noexcept;
+
+  bool canUndo() const noexcept { return !m_locked && m_currentNode != m_rootNode; }
+  bool canRedo() const noexcept { return !m_locked && !m_nodes.at(m_currentNode).children.empty(); }
+
+  //
+  // Tree inspection, for displaying the history.
+  //
+
+  NodeID rootNode() const noexcept { return m_rootNode; }
+  NodeID currentNode() const noexcept { return m_currentNode; }
+
+  NodeID parentOf(NodeID node) const { return m_nodes.at(node).parent; }
+  const std::vector<NodeID>& childrenOf(NodeID node) const { return m_nodes.at(node).children; }
+  Clock::time_point timestampOf(NodeID node) const { return m_nodes.at(node).timestamp; }
+  bool contains(NodeID node) const { return m_nodes.contains(node); }
+
+  // Incremented whenever nodes are added or removed.
+  uint64_t treeVersion() const noexcept { return m_treeVersion; }
+
+  //
+  // Memory budget.
+  //
+
+  /**
+   * Sets roughly how much memory the undo history may use before older entries are moved to disk.
+   */
+  void setMemoryBudget(size_t bytes) noexcept;
+  size_t memoryBudget() const noexcept { return m_memoryBudget; }
+
+  size_t residentMemoryUsage() const noexcept { return m_residentMemoryUsage; }
+  size_t spilledSize() const noexcept { return m_spilledSize; }
+  size_t numEntries() const noexcept { return m_nodes.size(); }
 
  private:
+  void journalCurrentState() noexcept;
+
+  const wpi::json& currentJson() const;
+
+  NodeID createNode(NodeID parent, ThunderAutoProjectState state, size_t stateMemoryUsage);
+  void setDeltas(Node& node, std::vector<uint8_t> toParent, std::vector<uint8_t> fromParent);
+  void removeSubtree(NodeID node) noexcept;
+  void releaseDelta(Delta& delta) noexcept;
+
+  StateChangeSet moveTo(NodeID target);
+  void touch(Node& node) noexcept { node.lastUsed = ++m_useCounter; }
+
+  std::vector<uint8_t>& loadDelta(Delta& delta);
+
+  void enforceMemoryBudget() noexcept;
+  bool evictLeastRecentlyUsedState() noexcept;
+  bool spillOldestDelta() noexcept;
+  bool pruneOldest() noexcept;
+
+  static size_t EstimateMemoryUsage(const wpi::json& stateJson);
+
   friend class DocumentEditManager;
 
   // Lock undo/redo actions.
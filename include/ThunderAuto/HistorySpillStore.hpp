@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <vector>
+
+/**
+ * A scratch file that undo history entries are written out to when they no longer fit in memory.
+ *
+ * The file is append-only while in use, lives in the system temp directory, and is removed when the store is
+ * destroyed.
+ */
+class HistorySpillStore final {
+  std::filesystem::path m_path;
+  std::fstream m_file;
+  uint64_t m_fileSize = 0;
+
+ public:
+  struct Record {
+    uint64_t offset = 0;
+    uint32_t size = 0;
+    uint32_t crc = 0;
+  };
+
+  HistorySpillStore() = default;
+  ~HistorySpillStore();
+
+  HistorySpillStore(const HistorySpillStore&) = delete;
+  HistorySpillStore& operator=(const HistorySpillStore&) = delete;
+
+  /**
+   * Writes data to the store. Throws if the data could not be written.
+   *
+   * @param data The data to write
+   *
+   * @return The record to read the data back with
+   */
+  Record write(std::span<const uint8_t> data);
+
+  /**
+   * Reads data back from the store. Throws if the data could not be read or is corrupt.
+   *
+   * @param record The record returned by write()
+   *
+   * @return The data
+   */
+  std::vector<uint8_t> read(const Record& record);
+
+  /**
+   * Empties the store. All existing records become invalid.
+   */
+  void clear() noexcept;
+
+  uint64_t fileSize() const noexcept { return m_fileSize; }
+
+ private:
+  void open();
+};
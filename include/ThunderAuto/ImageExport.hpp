@@ -0,0 +1,108 @@
+#pragma once
+
+#include <ThunderAuto/OffscreenRenderer.hpp>
+#include <ThunderLibCore/Auto/ThunderAutoProject.hpp>
+#include <atomic>
+#include <cstddef>
+#include <filesystem>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace thunder::core;
+
+/**
+ * Exports a picture of every trajectory and auto mode in a project as PNG images, or every frame of their
+ * playback as a sequence of PNG images.
+ *
+ * Runs in the background. Trajectories are built once each, then every image is drawn with an
+ * OffscreenRenderer and written on the thread pool. Images are written to:
+ *
+ *   <output directory>/trajectories/<trajectory name>.png
+ *   <output directory>/auto_modes/<auto mode name>.png
+ *
+ * or, when exporting frames:
+ *
+ *   <output directory>/trajectories/<trajectory name>/frame_0000.png, ...
+ *   <output directory>/auto_modes/<auto mode name>/frame_0000.png, ...
+ *
+ * Characters that can't be in file names are replaced with '_'. An image that can't be written is reported
+ * in the result without stopping the others.
+ *
+ * Auto modes are drawn the way the editor draws them, with the branches the editor isn't displaying in gray,
+ * and are played back along the branches it is displaying.
+ */
+class ImageExport final {
+ public:
+  struct Options {
+    OffscreenRenderer::Options render;
+
+    bool exportFrames = false;
+    double framesPerSecond = 30.0;
+  };
+
+  struct Result {
+    size_t numImages = 0;
+
+    bool cancelled = false;
+    std::string error;  // Empty if successful.
+
+    // One message for each image (or directory of frames) that could not be written.
+    std::vector<std::string> failures;
+  };
+
+ private:
+  struct SharedState {
+    std::atomic<size_t> numTasks = 0;
+    std::atomic<size_t> numFinishedTasks = 0;
+    std::atomic<bool> cancelled = false;
+  };
+
+  std::shared_ptr<SharedState> m_sharedState;
+  std::future<Result> m_future;
+
+ public:
+  /**
+   * Starts exporting the images of a project in the background.
+   *
+   * @param state The project state to export
+   * @param settings The project settings, for the field image and robot size
+   * @param outputDirectory The directory to write the images to, which is created if it doesn't exist
+   * @param options What to export and how to draw it
+   */
+  ImageExport(ThunderAutoProjectState state,
+              ThunderAutoProjectSettings settings,
+              std::filesystem::path outputDirectory,
+              Options options);
+
+  // Cancels the export and waits for it to stop.
+  ~ImageExport() { cancel(); }
+
+  ImageExport(const ImageExport&) = delete;
+  ImageExport& operator=(const ImageExport&) = delete;
+
+  /**
+   * Returns the approximate progress of the export, from 0 to 1.
+   */
+  float progress() const noexcept;
+
+  void cancel() noexcept { m_sharedState->cancelled = true; }
+
+  /**
+   * Returns whether the export has finished (successfully or not). Does not block.
+   */
+  bool isFinished() const;
+
+  /**
+   * Takes the result of the export. Blocks until the export is finished, and can only be called once.
+   */
+  Result takeResult();
+
+ private:
+  static Result Run(ThunderAutoProjectState state,
+                    ThunderAutoProjectSettings settings,
+                    std::filesystem::path outputDirectory,
+                    Options options,
+                    std::shared_ptr<SharedState> sharedState);
+};
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <ThunderLibCore/Types.hpp>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+using namespace thunder::core;
+
+/**
+ * An area of the field that the robot must not enter, such as a field element or the other alliance's zone.
+ */
+struct KeepOutZone {
+  std::string name;
+
+  // Polygon vertices in field coordinates. The polygon may be concave, but its edges should not cross.
+  std::vector<Point2d> vertices;
+};
+
+using KeepOutZoneList = std::vector<KeepOutZone>;
+
+/**
+ * Keep-out zones are stored in a JSON file next to the project file, since the project file format doesn't
+ * have a place for them.
+ */
+std::filesystem::path KeepOutZonesPathForProject(const std::filesystem::path& projectPath);
+
+/**
+ * Loads the keep-out zones of a project. Returns an empty list if the project doesn't have any. Throws if
+ * the file exists but could not be read.
+ */
+KeepOutZoneList LoadKeepOutZones(const std::filesystem::path& projectPath);
+
+/**
+ * Saves the keep-out zones of a project, removing the file if there are none. Throws if the file could not
+ * be written.
+ */
+void SaveKeepOutZones(const std::filesystem::path& projectPath, const KeepOutZoneList& zones);
+
+/**
+ * A square keep-out zone, used when adding a new zone.
+ */
+KeepOutZone MakeDefaultKeepOutZone(std::string name, const Point2d& center);
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <ThunderAuto/SPSCRingBuffer.hpp>
+#include <ThunderLibCore/Types.hpp>
+#include <networktables/NetworkTableInstance.h>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+using namespace thunder::core;
+
+/**
+ * Follows the robot's pose as it is published to a NetworkTables topic, keeping a short trail of where it has
+ * been.
+ *
+ * Poses are decoded on the NetworkTables listener thread and handed to the main thread through a lock-free
+ * ring buffer, so update() never waits on NetworkTables. The topic may be a 'struct:Pose2d', or a 'double[]'
+ * as [x (m), y (m), rotation (deg)] the way Field2d publishes robot poses.
+ */
+class LivePoseSubscriber final {
+ public:
+  struct Sample {
+    double x;         // m
+    double y;         // m
+    double rotation;  // rad
+    int64_t time;     // NetworkTables time, in microseconds
+  };
+
+  // How far back the trail goes.
+  static constexpr int64_t kTrailDuration = 3'000'000;  // us
+
+  // How long to wait for a new pose before the robot is shown as stale.
+  static constexpr auto kStaleTimeout = std::chrono::milliseconds(500);
+
+ private:
+  struct Shared {
+    NT_Topic topic = 0;
+    SPSCRingBuffer<Sample, 1024> samples;
+  };
+
+  // Shared with the listener callback, which may still be running for a moment after the listener is removed.
+  std::shared_ptr<Shared> m_shared;
+  NT_Listener m_listener = 0;
+
+  std::string m_topicName;
+
+  std::deque<Sample> m_trail;
+  std::chrono::steady_clock::time_point m_lastSampleReceivedTime;
+
+ public:
+  LivePoseSubscriber() = default;
+  ~LivePoseSubscriber() { unsubscribe(); }
+
+  LivePoseSubscriber(const LivePoseSubscriber&) = delete;
+  LivePoseSubscriber& operator=(const LivePoseSubscriber&) = delete;
+
+  /**
+   * Starts following a topic, replacing the previous one.
+   */
+  void subscribe(nt::NetworkTableInstance instance, std::string_view topicName);
+  void unsubscribe() noexcept;
+
+  bool isSubscribed() const noexcept { return m_listener != 0; }
+  const std::string& topicName() const noexcept { return m_topicName; }
+
+  /**
+   * Takes in any poses that have arrived since the last update, and drops the ones that are too old for the
+   * trail. Call once per frame.
+   */
+  void update();
+
+  std::optional<Sample> latest() const noexcept {
+    return m_trail.empty() ? std::nullopt : std::optional<Sample>(m_trail.back());
+  }
+
+  // Oldest first.
+  const std::deque<Sample>& trail() const noexcept { return m_trail; }
+
+  bool isStale() const noexcept;
+};
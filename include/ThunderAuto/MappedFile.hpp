@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+
+/**
+ * A read-only memory mapping of a whole file. Pages are only read from disk as they are touched, so large
+ * files can be scanned without loading them up front.
+ */
+class MappedFile final {
+  const uint8_t* m_data = nullptr;
+  size_t m_size = 0;
+
+#if THUNDERAUTO_WINDOWS
+  void* m_fileHandle = nullptr;
+  void* m_mappingHandle = nullptr;
+#endif
+
+ public:
+  /**
+   * Maps a file.
+   *
+   * @param path The file to map
+   *
+   * @throws RuntimeError if the file could not be opened or mapped
+   */
+  explicit MappedFile(const std::filesystem::path& path);
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  std::span<const uint8_t> data() const noexcept { return {m_data, m_size}; }
+  size_t size() const noexcept { return m_size; }
+
+ private:
+  void unmap() noexcept;
+};
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Finds names that roughly match a search query, without comparing the query to every name.
+ *
+ * Every three-character sequence (trigram) of every name is indexed when the names are set. A name matches
+ * if it contains most of the trigrams in the query, so small typos in longer queries still match. Queries
+ * shorter than a trigram just look for names containing them.
+ *
+ * Matching ignores case.
+ */
+class NameSearchIndex final {
+  std::vector<std::string> m_names;
+  std::vector<std::string> m_lowercaseNames;
+
+  // Name -> index in m_names.
+  std::unordered_map<std::string, size_t> m_nameIndices;
+
+  // Trigram -> indices of the names that contain it, in ascending order.
+  std::unordered_map<uint32_t, std::vector<uint32_t>> m_trigramNames;
+
+  // Changes every time the names change, so that search results can tell when they're out of date.
+  uint64_t m_version = 0;
+
+ public:
+  /**
+   * Replaces the names. Names are listed in the order given when the query is empty.
+   */
+  void rebuild(std::vector<std::string> names);
+
+  void clear() noexcept;
+
+  const std::vector<std::string>& names() const noexcept { return m_names; }
+
+  bool contains(const std::string& name) const noexcept { return m_nameIndices.contains(name); }
+
+  uint64_t version() const noexcept { return m_version; }
+
+  /**
+   * Finds the names that match a query.
+   *
+   * @param query What to search for. Every name matches an empty query.
+   * @param matches Set to the indices (into names()) of the matching names. Names that contain the query come
+   *                first, then names with the most trigrams in common with the query, each in the order the
+   *                names were given.
+   */
+  void search(std::string_view query, std::vector<size_t>& matches) const;
+};
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <ThunderAuto/Graphics/Texture.hpp>
+#include <ThunderAuto/Pages/EditorPage.hpp>
+#include <ThunderAuto/Shapes.hpp>
+#include <ThunderAuto/SoftwareCanvas.hpp>
+#include <ThunderLibCore/Auto/ThunderAutoProject.hpp>
+#include <ThunderLibCore/Auto/ThunderAutoOutputTrajectory.hpp>
+#include <ThunderLibCore/Types.hpp>
+#include <units/time.h>
+#include <imgui.h>
+#include <optional>
+#include <span>
+
+using namespace thunder::core;
+
+/**
+ * Draws the field with trajectories on it into a SoftwareCanvas, the way the editor draws them, for exporting
+ * images without a window.
+ *
+ * The field image is scaled once when the renderer is created. Rendering doesn't change the renderer, so one
+ * renderer can render many images at once on different threads.
+ */
+class OffscreenRenderer final {
+ public:
+  struct Options {
+    int imageWidth = 1920;  // The height follows the field image's aspect ratio.
+    EditorPageTrajectoryOverlay trajectoryOverlay = EditorPageTrajectoryOverlay::VELOCITY;
+    bool showActions = true;
+    bool showRobotFootprints = false;
+    units::second_t robotFootprintInterval = units::second_t(0.5);
+  };
+
+  struct TrajectoryLayer {
+    const ThunderAutoTrajectorySkeleton* skeleton = nullptr;
+    const ThunderAutoOutputTrajectory* trajectory = nullptr;
+
+    // Inactive layers (e.g. auto mode branches the editor isn't displaying) are drawn in gray, without
+    // actions or footprints.
+    bool isActive = true;
+  };
+
+  struct RobotPose {
+    Point2d position;
+    CanonicalAngle rotation;
+  };
+
+ private:
+  Options m_options;
+
+  Measurement2d m_robotSize;
+
+  SoftwareCanvas m_background;
+
+  // Field to image coordinates, see EditorPage::drawRobotOutlines().
+  ImVec2 m_origin;
+  ImVec2 m_scale;
+
+  PolygonSoA m_robotPolygon;
+
+  float m_lineThickness = 0.f;
+  float m_pointRadius = 0.f;
+
+ public:
+  /**
+   * @param settings The project settings, for the field and robot size
+   * @param fieldImage The decoded field image (see EditorPage::DecodeFieldImage())
+   * @param options How to draw the images
+   */
+  OffscreenRenderer(const ThunderAutoProjectSettings& settings,
+                    const TextureImage& fieldImage,
+                    const Options& options);
+
+  int width() const noexcept { return m_background.width(); }
+  int height() const noexcept { return m_background.height(); }
+
+  const Options& options() const noexcept { return m_options; }
+
+  /**
+   * Draws trajectories over the field, in order, and the robot on top of them.
+   *
+   * @param layers The trajectories to draw
+   * @param robot Where to draw the robot, if anywhere
+   *
+   * @return The image
+   */
+  SoftwareCanvas render(std::span<const TrajectoryLayer> layers, const std::optional<RobotPose>& robot) const;
+
+ private:
+  ImVec2 toImageCoordinate(const Point2d& fieldCoordinate) const noexcept;
+
+  void drawTrajectory(SoftwareCanvas& canvas, const TrajectoryLayer& layer) const;
+  void drawActions(SoftwareCanvas& canvas, const TrajectoryLayer& layer) const;
+  void drawRobotFootprints(SoftwareCanvas& canvas, const TrajectoryLayer& layer) const;
+  void drawRobot(SoftwareCanvas& canvas, const RobotPose& robot) const;
+
+  void drawRobotOutlines(SoftwareCanvas& canvas,
+                         std::span<const PolygonTransform> transforms,
+                         ImU32 color) const;
+};
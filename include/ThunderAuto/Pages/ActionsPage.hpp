@@ -1,13 +1,24 @@
 #pragma once
 
 #include <ThunderAuto/DocumentEditManager.hpp>
+#include <ThunderAuto/Pages/NameSearchBox.hpp>
 #include <ThunderAuto/Pages/Page.hpp>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
 
 using namespace thunder::core;
 
 class ActionsPage : public Page {
   DocumentEditManager& m_history;
 
+  NameSearchBox m_searchBox;
+
+  // Action name -> height of its row the last time it was drawn. Actions that were renamed or removed are
+  // dropped whenever the name index changes.
+  std::unordered_map<std::string, float> m_rowHeights;
+  uint64_t m_rowHeightsNameIndexVersion = 0;
+
  public:
   explicit ActionsPage(DocumentEditManager& history) : m_history(history) {}
 
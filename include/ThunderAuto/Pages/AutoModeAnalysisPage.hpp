@@ -0,0 +1,38 @@
+#pragma once
+
+#include <ThunderAuto/AutoModeAnalysis.hpp>
+#include <ThunderAuto/DocumentEditManager.hpp>
+#include <ThunderAuto/Pages/Page.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * Shows how long every branch combination of every auto mode takes, and which ones don't fit in the
+ * autonomous period.
+ */
+class AutoModeAnalysisPage : public Page {
+  const DocumentEditManager& m_history;
+
+  std::unique_ptr<AutoModeAnalysis> m_analysis;
+
+  AutoModeAnalysis::Result m_result;
+  bool m_hasResult = false;
+
+ public:
+  explicit AutoModeAnalysisPage(const DocumentEditManager& history) : m_history(history) {}
+
+  const char* name() const noexcept override { return "Auto Mode Analysis"; }
+
+  void present(bool* running) override;
+
+  /**
+   * Stops any analysis in progress and forgets the last results (e.g. when the project is closed).
+   */
+  void reset() noexcept;
+
+ private:
+  void presentResultsTable();
+
+  void sortCombinations(const ImGuiTableSortSpecs& sortSpecs);
+};
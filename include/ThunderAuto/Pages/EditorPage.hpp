@@ -1,9 +1,17 @@
 #pragma once
 
+#include <ThunderAuto/AutoModeStepIndex.hpp>
+#include <ThunderAuto/CollisionChecker.hpp>
 #include <ThunderAuto/DocumentEditManager.hpp>
+#include <ThunderAuto/KeepOutZones.hpp>
+#include <ThunderAuto/LivePoseSubscriber.hpp>
 #include <ThunderAuto/Pages/Page.hpp>
+#include <ThunderAuto/PlaybackTimeline.hpp>
+#include <ThunderAuto/PreviewTrajectoryCache.hpp>
+#include <ThunderAuto/RobotLogReplay.hpp>
 #include <ThunderAuto/Graphics/Texture.hpp>
 #include <ThunderAuto/Shapes.hpp>
+#include <ThunderAuto/TrajectoryThumbnails.hpp>
 #include <ThunderAuto/Error.hpp>
 #include <ThunderLibCore/Auto/ThunderAutoProject.hpp>
 #include <ThunderLibCore/Auto/ThunderAutoOutputTrajectory.hpp>
@@ -14,6 +22,9 @@
 #include <string_view>
 #include <string>
 #include <memory>
+#include <optional>
+#include <future>
+#include <vector>
 
 using namespace thunder::core;
 
@@ -79,7 +90,39 @@ class EditorPage : public Page {
   }
 
   std::unique_ptr<ThunderAutoOutputTrajectory> m_cachedTrajectory;
-  std::vector<std::pair<std::unique_ptr<ThunderAutoOutputTrajectory>, bool>> m_cachedAutoModeTrajectories;
+
+  struct CachedAutoModeTrajectory {
+    // Being built on the thread pool. Moved into trajectory once it's done.
+    std::future<std::unique_ptr<ThunderAutoOutputTrajectory>> pendingTrajectory;
+    std::unique_ptr<ThunderAutoOutputTrajectory> trajectory;
+
+    bool isActive = false;
+
+    // Actions along the trajectory (including the start and end actions), for the playback timeline.
+    std::vector<std::pair<ThunderAutoTrajectoryPosition, std::string>> actions;
+  };
+
+  // Indexed by the trajectory slots of the current auto mode's step index.
+  std::vector<CachedAutoModeTrajectory> m_cachedAutoModeTrajectories;
+
+  struct AutoModeTimelineEntry {
+    enum class Type {
+      TRAJECTORY,
+      ACTION,
+      BRANCH,
+    };
+
+    Type type;
+    size_t trajectoryIndex = 0;  // Index in m_cachedAutoModeTrajectories, for trajectories.
+    std::string label;           // For actions and branches.
+  };
+
+  // The active steps of the current auto mode, in the order they run.
+  std::vector<AutoModeTimelineEntry> m_autoModeTimelineEntries;
+
+  // Rebuilt from m_autoModeTimelineEntries whenever a trajectory finishes building.
+  PlaybackTimeline m_autoModeTimeline;
+  bool m_autoModeTimelineDirty = true;
 
   double m_fieldAspectRatio = 1.0;
   std::unique_ptr<Texture> m_fieldTexture;
@@ -93,15 +136,69 @@ class EditorPage : public Page {
 
   EditorPageTrajectoryOverlay m_trajectoryOverlay = EditorPageTrajectoryOverlay::VELOCITY;
 
-  TPolyline m_baseRobotRectangle;
+  RobotLogReplay m_robotLogReplay;
+
+  // Where the planned robot preview was drawn this frame, to compare against the robot log replay.
+  std::optional<Point2d> m_plannedRobotPosition;
+  std::optional<units::meter_t> m_replayTrackingError;
+
+  // Reused every frame.
+  std::vector<ImVec2> m_replayPathScreenPoints;
+
+  LivePoseSubscriber m_livePose;
+
+  // A path drawn over a trajectory to preview changes to it before they're applied (e.g. by the waypoint
+  // optimizer).
+  std::string m_ghostPathTrajectoryName;
+  std::vector<Point2d> m_ghostPath;
+
+  // Reused every frame.
+  std::vector<ImVec2> m_ghostPathScreenPoints;
+
+  bool m_isReadOnly = false;
+
+  const KeepOutZoneList* m_keepOutZones = nullptr;
+  bool m_keepOutZonesChanged = false;
+
+  // Shared by the collision checker and the thumbnails, so each trajectory is only built once per change.
+  PreviewTrajectoryCache m_previewTrajectories;
+
+  CollisionChecker m_collisionChecker;
+  Measurement2d m_collisionRobotSize;
+  units::meter_t m_collisionRobotCornerRadius;
+
+  TrajectoryThumbnails m_trajectoryThumbnails;
+  int m_trajectoryThumbnailsUpdateFrame = -1;
+
+  // Reused every frame.
+  std::vector<ImVec2> m_keepOutZoneScreenPoints;
+
+  // The robot outline relative to the robot's center, rebuilt when the robot size changes.
+  PolygonSoA m_baseRobotPolygon;
   Measurement2d m_robotRectangleSize;
   units::meter_t m_robotRectangleCornerRadius;
 
+  // Reused every time a single robot is drawn.
+  std::vector<float> m_robotOutlineX;
+  std::vector<float> m_robotOutlineY;
+  std::vector<ImVec2> m_robotOutlineScreenPoints;
+
+  // Robot outlines at fixed time intervals along the current trajectory, in field coordinates. Outline i
+  // occupies indices [i * m_baseRobotPolygon.size(), (i + 1) * m_baseRobotPolygon.size()) of x and y.
+  struct RobotFootprints {
+    bool isValid = false;
+    units::second_t interval = 0_s;
+    std::vector<PolygonTransform> transforms;
+    std::vector<float> x;
+    std::vector<float> y;
+  } m_robotFootprints;
+
  public:
   explicit EditorPage(DocumentEditManager& history) noexcept
       : m_history(history),
         m_stateUpdateSubscriberID(
-            history.registerStateUpdateSubscriber(std::bind(&EditorPage::onStateUpdated, this))) {}
+            history.registerStateUpdateSubscriber(
+                std::bind(&EditorPage::onStateUpdated, this, std::placeholders::_1))) {}
 
   ~EditorPage() { m_history.unregisterStateUpdateSubscriber(m_stateUpdateSubscriberID); }
 
@@ -112,6 +209,55 @@ class EditorPage : public Page {
    */
   void setupField(const ThunderAutoProjectSettings& settings);
 
+  /**
+   * Same as above, but uses a field image that was already decoded (e.g. on a background thread).
+   *
+   * @param settings The project settings
+   * @param fieldImage The decoded field image
+   */
+  void setupField(const ThunderAutoProjectSettings& settings, const TextureImage& fieldImage);
+
+  /**
+   * Decodes the configured field image. This does not touch the graphics API, so it is safe to call from a
+   * background thread.
+   *
+   * @param fieldImage The field image to decode
+   *
+   * @return The decoded image
+   */
+  static TextureImage DecodeFieldImage(const ThunderAutoFieldImage& fieldImage);
+
+  /**
+   * Builds the output trajectory that the editor previews for a trajectory skeleton. Safe to call from a
+   * background thread.
+   */
+  static std::unique_ptr<ThunderAutoOutputTrajectory> BuildPreviewTrajectory(
+      const ThunderAutoTrajectorySkeleton& skeleton);
+
+  /**
+   * Converts between field coordinates and the coordinates of a field image drawn to fill a rectangle.
+   */
+  static ImVec2 ToScreenCoordinate(const Point2d& fieldCoordinate,
+                                   const ThunderAutoFieldImage& fieldImage,
+                                   ImRect bb);
+  static Point2d ToFieldCoordinate(const ImVec2& screenCoordinate,
+                                   const ThunderAutoFieldImage& fieldImage,
+                                   const ImRect& bb);
+
+  /**
+   * The hue of the segment of a trajectory between two points, for a trajectory overlay.
+   */
+  static float TrajectoryOverlayHue(EditorPageTrajectoryOverlay overlay,
+                                    const ThunderAutoOutputTrajectoryPoint& startPoint,
+                                    const ThunderAutoOutputTrajectoryPoint& endPoint,
+                                    const ThunderAutoTrajectorySkeleton& skeleton);
+
+  /**
+   * Use an already built preview trajectory for the current trajectory instead of building it on the next
+   * frame.
+   */
+  void setCachedTrajectory(std::unique_ptr<ThunderAutoOutputTrajectory> trajectory) noexcept;
+
   const char* name() const noexcept override { return "Editor"; }
 
   /**
@@ -126,6 +272,9 @@ class EditorPage : public Page {
     bool showRotations = true;
     bool showActions = true;
     bool showTooltip = true;
+    bool showRobotFootprints = false;
+    bool showKeepOutZones = true;
+    float robotFootprintInterval = 0.25f;  // Seconds
     EditorPageTrajectoryOverlay trajectoryOverlay;
   } trajectoryEditorOptions = {};
 
@@ -133,16 +282,76 @@ class EditorPage : public Page {
     // TODO
   } autoModeEditorOptions = {};
 
- private:
+ public:
   void invalidateCachedTrajectories() noexcept {
     m_cachedTrajectory.reset();
-    m_cachedAutoModeTrajectories.clear();
+    m_robotFootprints.isValid = false;
+    invalidateCachedAutoModeTrajectories();
   }
 
+  /**
+   * Forgets everything worked out from the open project. Called when a project is set up or closed.
+   */
+  void clearProjectCaches() noexcept;
+
+  units::second_t playbackTime() const noexcept { return m_playbackTime; }
+  void setPlaybackTime(units::second_t time) noexcept { m_playbackTime = time; }
+
+  RobotLogReplay& robotLogReplay() noexcept { return m_robotLogReplay; }
+
+  LivePoseSubscriber& livePose() noexcept { return m_livePose; }
+
+  /**
+   * Sets a path to draw over a trajectory while it is being edited, to preview changes to it.
+   */
+  void setGhostPath(std::string trajectoryName, std::vector<Point2d> path) noexcept {
+    m_ghostPathTrajectoryName = std::move(trajectoryName);
+    m_ghostPath = std::move(path);
+  }
+  void clearGhostPath() noexcept {
+    m_ghostPathTrajectoryName.clear();
+    m_ghostPath.clear();
+  }
+
+  /**
+   * While read-only, the editor is drawn as usual but ignores edits made on the field (e.g. while another
+   * project is being loaded to replace this one).
+   */
+  void setReadOnly(bool readOnly) noexcept { m_isReadOnly = readOnly; }
+
+  /**
+   * Sets the keep-out zones to draw and check trajectories against. The list must outlive the editor, and
+   * invalidateKeepOutZones() must be called whenever it changes.
+   */
+  void setKeepOutZones(const KeepOutZoneList& zones) noexcept {
+    m_keepOutZones = &zones;
+    m_keepOutZonesChanged = true;
+  }
+  void invalidateKeepOutZones() noexcept { m_keepOutZonesChanged = true; }
+
+  /**
+   * Thumbnails of every trajectory and auto mode, for the pages that list them. Updated the first time it's
+   * called each frame.
+   */
+  const TrajectoryThumbnails& trajectoryThumbnails(const ThunderAutoProjectState& state);
+
+  /**
+   * The distance between the planned robot preview and the robot log replay at the current playback time, if
+   * both are shown.
+   */
+  std::optional<units::meter_t> replayTrackingError() const noexcept { return m_replayTrackingError; }
+
  private:
+  void invalidateCachedAutoModeTrajectories() noexcept {
+    m_cachedAutoModeTrajectories.clear();
+    m_autoModeTimelineEntries.clear();
+    m_autoModeTimeline.clear();
+    m_autoModeTimelineDirty = true;
+  }
+
   void presentEditor();
 
-  void onStateUpdated();
+  void onStateUpdated(const StateChangeSet& changes);
 
   void processPanAndZoomInput(const ImVec2& fieldScreenSize);
   void processFieldInput();
@@ -155,6 +364,10 @@ class EditorPage : public Page {
 
   void presentTrajectory(const ThunderAutoProjectState& state, ImRect bb);
   void presentTrajectoryRobotPreview(ImRect bb);
+  void presentTrajectoryRobotFootprints(ImRect bb);
+  void presentTrajectoryCollisions(const ThunderAutoProjectState& state, ImRect bb);
+  void presentLinkedWaypoints(const ThunderAutoProjectState& state, ImRect bb);
+  void buildTrajectoryRobotFootprints(units::second_t interval);
 
   void presentTrajectoryDragWidgets(const ThunderAutoProjectState& state, ImRect bb);
 
@@ -194,34 +407,47 @@ class EditorPage : public Page {
   void processAutoModeEditorInput(ThunderAutoProjectState& state, ImRect bb);
   void presentAutoModeEditor(ThunderAutoProjectState& state, ImRect bb);
 
-  bool presentAutoModeStepList(const ThunderAutoModeStepDirectoryPath& path,
-                               const ThunderAutoMode::StepDirectory& steps,
-                               size_t& trajectoryIndex,
-                               bool& clickWasCaptured,
-                               bool isActive,
-                               ThunderAutoProjectState& state,
-                               ImRect bb);
-  bool presentAutoModeStep(const ThunderAutoModeStepPath& path,
-                           const ThunderAutoModeStep& step,
-                           size_t& trajectoryIndex,
-                           bool& clickWasCaptured,
-                           bool isActive,
-                           ThunderAutoProjectState& state,
-                           ImRect bb);
-
-  bool presentAutoModeTrajectoryStep(const ThunderAutoModeStepPath& path,
-                                     const ThunderAutoModeTrajectoryStep& step,
-                                     size_t& trajectoryIndex,
+  // Draws the trajectory steps in the order the step index gives, so that the displayed branches end up on
+  // top.
+  bool presentAutoModeSteps(const AutoModeStepIndex& stepIndex,
+                            bool& clickWasCaptured,
+                            ThunderAutoProjectState& state,
+                            ImRect bb);
+
+  bool presentAutoModeTrajectoryStep(const AutoModeStepIndex::Entry& entry,
                                      bool& clickWasCaptured,
-                                     bool isActive,
                                      ThunderAutoProjectState& state,
                                      ImRect bb);
 
   void presentAutoModeRobotPreview(ImRect bb);
 
+  /**
+   * Starts building the trajectories of every trajectory step (including ones in inactive branches) on the
+   * thread pool, each in its trajectory slot from the step index. Active steps are also recorded for the
+   * playback timeline.
+   */
+  void queueAutoModeTrajectoryBuilds(const AutoModeStepIndex& stepIndex,
+                                     const ThunderAutoProjectState& state);
+
+  void collectFinishedAutoModeTrajectories();
+
+  /**
+   * Lays out the active trajectories that have finished building on the playback timeline, along with markers
+   * for the actions and branches between and along them.
+   */
+  void rebuildAutoModeTimeline();
+
   // General Editor Stuff
 
+  void presentRobotLogReplay(ImRect bb);
+  void presentGhostPath(const ThunderAutoProjectState& state, ImRect bb);
+
+  void updateCollisionChecker(const ThunderAutoProjectState& state);
+  void presentKeepOutZones(ImRect bb);
+  void presentLivePose(ImRect bb);
+
   void presentPlaybackSlider(const ThunderAutoProjectState& state);
+  void presentPlaybackSliderMarkers(ImRect sliderBB);
   void processPlaybackInput();
 
   void drawRobot(const Point2d& position,
@@ -236,16 +462,19 @@ class EditorPage : public Page {
                  ImU32 color,
                  ImRect bb);
 
+  void updateBaseRobotPolygon();
+
+  // Draws numOutlines robot outlines, transformed to field coordinates by TransformPolygonBatch().
+  void drawRobotOutlines(std::span<const float> x,
+                         std::span<const float> y,
+                         size_t numOutlines,
+                         ImU32 color,
+                         ImRect bb);
+
   // Utility functions
 
   bool IsMouseHoveringPoint(Point2d point, ImRect bb);
 
   static void SetMouseCursorMoveDirection(CanonicalAngle angle);
 
-  static ImVec2 ToScreenCoordinate(const Point2d& fieldCoordinate,
-                                   const ThunderAutoFieldImage& fieldImage,
-                                   ImRect bb);
-  static Point2d ToFieldCoordinate(const ImVec2& screenCoordinate,
-                                   const ThunderAutoFieldImage& fieldImage,
-                                   const ImRect& bb);
 };
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <ThunderAuto/DocumentManager.hpp>
+#include <ThunderAuto/DocumentEditManager.hpp>
+#include <ThunderAuto/HistoryManager.hpp>
+#include <ThunderAuto/Pages/Page.hpp>
+#include <string>
+#include <vector>
+
+/**
+ * Shows the undo history tree, and lets the user jump to any change in it.
+ */
+class HistoryPage : public Page {
+  const DocumentManager& m_documentManager;
+  DocumentEditManager& m_history;
+
+  struct Row {
+    HistoryManager::NodeID node;
+    size_t indent;
+    std::string label;
+  };
+
+  // The tree flattened into rows, rebuilt only when nodes are added or removed.
+  std::vector<Row> m_rows;
+  uint64_t m_rowsTreeVersion = 0;
+  HistoryManager::NodeID m_rowsRootNode = HistoryManager::kInvalidNodeID;
+
+  HistoryManager::NodeID m_lastCurrentNode = HistoryManager::kInvalidNodeID;
+
+ public:
+  HistoryPage(const DocumentManager& documentManager, DocumentEditManager& history)
+      : m_documentManager(documentManager), m_history(history) {}
+
+  const char* name() const noexcept override { return "History"; }
+
+  void present(bool* running) override;
+
+ private:
+  void rebuildRows(const HistoryManager& history);
+};
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <ThunderAuto/ImageExport.hpp>
+#include <ThunderAuto/DocumentEditManager.hpp>
+#include <ThunderAuto/DocumentManager.hpp>
+#include <ThunderAuto/Pages/Page.hpp>
+#include <filesystem>
+#include <memory>
+
+/**
+ * Exports images of every trajectory and auto mode, or frames of their playback, to the project directory.
+ */
+class ImageExportPage : public Page {
+  const DocumentManager& m_documentManager;
+  const DocumentEditManager& m_history;
+
+  ImageExport::Options m_options;
+
+  std::unique_ptr<ImageExport> m_export;
+  std::filesystem::path m_exportDirectory;
+
+  ImageExport::Result m_result;
+  bool m_hasResult = false;
+
+ public:
+  ImageExportPage(const DocumentManager& documentManager, const DocumentEditManager& history)
+      : m_documentManager(documentManager), m_history(history) {}
+
+  const char* name() const noexcept override { return "Export Images"; }
+
+  void present(bool* running) override;
+
+  /**
+   * Stops any export in progress and forgets the last result (e.g. when the project is closed).
+   */
+  void reset() noexcept;
+
+ private:
+  void presentOptions();
+  void presentResult();
+};
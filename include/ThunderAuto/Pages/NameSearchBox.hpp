@@ -0,0 +1,35 @@
+#pragma once
+
+#include <ThunderAuto/NameSearchIndex.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * A search box for filtering a list of names, for the pages that list trajectories, auto modes, etc.
+ *
+ * The names are only searched again when the query or the names change, so filtering costs nothing on frames
+ * where neither changes.
+ */
+class NameSearchBox final {
+  char m_query[128] = "";
+
+  std::string m_lastQuery;
+  const NameSearchIndex* m_lastIndex = nullptr;
+  uint64_t m_lastIndexVersion = 0;
+
+  std::vector<size_t> m_matches;
+
+ public:
+  void present(const char* hint);
+
+  /**
+   * Returns the indices (into index.names()) of the names matching the query, best matches first.
+   */
+  const std::vector<size_t>& matches(const NameSearchIndex& index);
+
+  bool isSearching() const noexcept { return m_query[0] != '\0'; }
+
+  void clear() noexcept;
+};
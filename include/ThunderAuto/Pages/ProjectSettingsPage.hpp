@@ -15,6 +15,8 @@ class ProjectSettingsPage : public Page {
     ROBOT_SETTINGS,
     CSV_EXPORT_SETTINGS,
     TRAJECTORY_EDITOR_SETTINGS,
+    KEEP_OUT_ZONE_SETTINGS,
+    UNDO_HISTORY_SETTINGS,
   };
   SettingsSubPage m_subPage = SettingsSubPage::ROBOT_SETTINGS;
 
@@ -30,4 +32,7 @@ class ProjectSettingsPage : public Page {
   void presentRobotSettings();
   void presentCSVExportSettings();
   void presentTrajectoryEditorSettings();
+  void presentKeepOutZoneSettings();
+  bool presentKeepOutZone(KeepOutZone& zone, bool* remove);
+  void presentUndoHistorySettings();
 };
@@ -4,6 +4,12 @@
 #include <ThunderAuto/Pages/Page.hpp>
 #include <ThunderAuto/Pages/EditorPage.hpp>
 #include <ThunderLibCore/Auto/ThunderAutoProject.hpp>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 using namespace thunder::core;
 
@@ -20,7 +26,11 @@ class PropertiesPage : public Page {
   PropertiesPage(DocumentEditManager& history, EditorPage& editorPage)
       : m_history(history), m_editorPage(editorPage) {}
 
-  void setup(const ThunderAutoProjectSettings& settings) { m_settings = &settings; }
+  void setup(const ThunderAutoProjectSettings& settings) {
+    m_settings = &settings;
+    m_trajectoryItemLists.clear();
+    m_internedActionNames.clear();
+  }
 
   const char* name() const noexcept override { return "Properties"; }
 
@@ -32,6 +42,7 @@ class PropertiesPage : public Page {
     AUTO_MODE_ADD_STEP,
     TRAJECTORY_START_BEHAVIOR_LINK,
     TRAJECTORY_END_BEHAVIOR_LINK,
+    TRAJECTORY_SPEED_CONSTRAINT_TUNER,
   };
 
   Event lastPresentEvent() const noexcept { return m_event; }
@@ -86,14 +97,19 @@ class PropertiesPage : public Page {
 
   // Draw step tree. Returns true if tree was modified and the rest of the tree should not be drawn (to avoid
   // accessing bad iterators).
-  bool drawAutoModeStepTreeNode(const ThunderAutoModeStepPath& path,
+  bool drawAutoModeStepTreeNode(const AutoModeStepIndex& index,
+                                size_t entryIndex,
                                 std::unique_ptr<ThunderAutoModeStep>& step,
                                 const ThunderAutoModeStepTrajectoryBehaviorTreeNode& behaviorTree,
                                 std::optional<frc::Pose2d> previousStepEndPose,
                                 bool isFirstTrajectoryStep,
                                 bool isLastTrajectoryStep,
                                 ThunderAutoProjectState& state);
-  bool drawAutoModeStepsTree(const ThunderAutoModeStepDirectoryPath& path,
+  // Draws the steps in a directory, which are the entries [begin, end) of the step index.
+  bool drawAutoModeStepsTree(const AutoModeStepIndex& index,
+                             size_t begin,
+                             size_t end,
+                             const ThunderAutoModeStepDirectoryPath& path,
                              std::list<std::unique_ptr<ThunderAutoModeStep>>& steps,
                              const ThunderAutoModeStepTrajectoryBehaviorTreeNode& behaviorTree,
                              std::optional<frc::Pose2d> previousStepEndPose,
@@ -108,7 +124,8 @@ class PropertiesPage : public Page {
   };
 
   bool autoModeStepDragDropTarget(
-      std::variant<ThunderAutoModeStepPath, ThunderAutoModeStepDirectoryPath> closestStepOrDirectoryPath,
+      std::variant<const ThunderAutoModeStepPath*, const ThunderAutoModeStepDirectoryPath*>
+          closestStepOrDirectoryPath,
       AutoModeStepDragDropInsertMethod insertMethod,
       bool acceptAutoModeSteps,
       ThunderAutoProjectState& state);
@@ -163,18 +180,60 @@ class PropertiesPage : public Page {
 
   template <typename T>
   struct TrajectoryItemSelection {
+    ThunderAutoTrajectoryPosition position;
     T item;
     bool editorLocked;
     ThunderAutoTrajectoryEditorState::TrajectorySelection trajectorySelection;
     size_t selectionIndex;
   };
 
-  static std::map<ThunderAutoTrajectoryPosition, TrajectoryItemSelection<CanonicalAngle>>
-  GetAllRotationSelections(const ThunderAutoTrajectorySkeleton& skeleton);
+  struct TrajectoryActionItem {
+    // "<start> ", "<stop> ", "<end> ", or "" for actions along the trajectory.
+    const char* prefix;
+    std::string_view action;
+  };
+
+  // The rotations and actions of a trajectory, sorted by position.
+  struct TrajectoryItemLists {
+    uint64_t trajectoryVersion = 0;
+
+    std::vector<TrajectoryItemSelection<CanonicalAngle>> rotations;
+    std::vector<TrajectoryItemSelection<TrajectoryActionItem>> actions;
+  };
+
+  /**
+   * Returns the rotations and actions of a trajectory, only finding them again when the trajectory has
+   * changed since the last time.
+   */
+  const TrajectoryItemLists& trajectoryItemLists(const std::string& trajectoryName,
+                                                 const ThunderAutoTrajectorySkeleton& skeleton);
 
-  static std::multimap<ThunderAutoTrajectoryPosition, TrajectoryItemSelection<std::string>>
-  GetAllActionSelections(const ThunderAutoTrajectorySkeleton& skeleton);
+  /**
+   * Forgets the item lists of trajectories that were renamed or removed, and the action names no item list
+   * uses anymore. Only does anything when the trajectory or action names have changed.
+   */
+  void pruneTrajectoryItemLists();
+
+  // Only the first rotation at each position is kept.
+  static void GetAllRotationSelections(const ThunderAutoTrajectorySkeleton& skeleton,
+                                       std::vector<TrajectoryItemSelection<CanonicalAngle>>& rotations);
+
+  // Action names point into internedActionNames.
+  static void GetAllActionSelections(const ThunderAutoTrajectorySkeleton& skeleton,
+                                     std::unordered_set<std::string>& internedActionNames,
+                                     std::vector<TrajectoryItemSelection<TrajectoryActionItem>>& actions);
 
  private:
   Event m_event = Event::NONE;
+
+  // Trajectory name -> its item lists.
+  std::unordered_map<std::string, TrajectoryItemLists> m_trajectoryItemLists;
+
+  // Every action name in m_trajectoryItemLists, so each name is only stored once no matter how many
+  // trajectories run it.
+  std::unordered_set<std::string> m_internedActionNames;
+
+  // The versions of the name indexes the last time the item lists were pruned.
+  uint64_t m_itemListsTrajectoryNameIndexVersion = 0;
+  uint64_t m_itemListsActionNameIndexVersion = 0;
 };
@@ -2,6 +2,7 @@
 
 #include <ThunderAuto/DocumentManager.hpp>
 #include <ThunderAuto/DocumentEditManager.hpp>
+#include <ThunderAuto/Pages/EditorPage.hpp>
 #include <ThunderAuto/Pages/Page.hpp>
 #include <networktables/NetworkTable.h>
 #include <networktables/NetworkTableInstance.h>
@@ -9,6 +10,7 @@
 class RemoteUpdatePage : public Page {
   const DocumentManager& m_documentManager;
   const DocumentEditManager& m_history;
+  EditorPage& m_editorPage;
 
   nt::NetworkTableInstance m_networkTableInstance;
   std::shared_ptr<nt::NetworkTable> m_thunderAutoNetworkTable;
@@ -25,8 +27,12 @@ class RemoteUpdatePage : public Page {
   bool m_wasUpdateSent = false;
   bool m_wasLastUpdateSentSuccessfully = false;
 
+  char m_livePoseTopic[128] = "/SmartDashboard/Field/Robot";
+
  public:
-  RemoteUpdatePage(const DocumentManager& documentManager, const DocumentEditManager& history);
+  RemoteUpdatePage(const DocumentManager& documentManager,
+                   const DocumentEditManager& history,
+                   EditorPage& editorPage);
   ~RemoteUpdatePage();
 
   const char* name() const noexcept override { return "Remote Update"; }
@@ -36,6 +42,14 @@ class RemoteUpdatePage : public Page {
  private:
   void presentConnectionTab();
   void presentUpdateTab();
+  void presentLivePoseTab();
+
+  /**
+   * Connects to the server chosen on the connection tab, if the connection tab was just left.
+   */
+  void connectIfNeeded();
+
+  void presentConnectionStatus();
 
   void sendUpdate();
 };
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <ThunderAuto/Pages/EditorPage.hpp>
+#include <ThunderAuto/Pages/Page.hpp>
+#include <string>
+
+/**
+ * Opens a robot log and picks which of its poses the editor replays over the planned trajectory.
+ */
+class RobotLogReplayPage : public Page {
+  EditorPage& m_editorPage;
+
+  std::string m_openError;
+
+ public:
+  explicit RobotLogReplayPage(EditorPage& editorPage) noexcept : m_editorPage(editorPage) {}
+
+  const char* name() const noexcept override { return "Robot Log Replay"; }
+
+  void present(bool* running) override;
+
+ private:
+  void openLog();
+};
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <ThunderAuto/SpeedConstraintTuner.hpp>
+#include <ThunderAuto/DocumentEditManager.hpp>
+#include <ThunderAuto/Pages/Page.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+/**
+ * Searches for the fastest speed constraints for the current trajectory within the robot's limits, and
+ * applies the one the user picks.
+ */
+class SpeedConstraintTunerPage : public Page {
+  DocumentEditManager& m_history;
+
+  SpeedConstraintLimits m_limits;
+
+  std::unique_ptr<SpeedConstraintTuner> m_tuner;
+  std::string m_tunerTrajectoryName;
+  uint64_t m_tunerTrajectoryVersion = 0;
+
+  SpeedConstraintTuner::Result m_result;
+  std::string m_resultTrajectoryName;
+  // The version of the trajectory that was tuned. Candidates can't be applied once it changes.
+  uint64_t m_resultTrajectoryVersion = 0;
+  bool m_hasResult = false;
+
+ public:
+  explicit SpeedConstraintTunerPage(DocumentEditManager& history) : m_history(history) {}
+
+  const char* name() const noexcept override { return "Speed Constraint Tuner"; }
+
+  void present(bool* running) override;
+
+  /**
+   * Stops any tuning in progress and forgets the last results (e.g. when the project is closed).
+   */
+  void reset() noexcept;
+
+ private:
+  void presentLimits();
+  void presentCandidatesTable();
+
+  bool isResultOutOfDate();
+
+  void applyCandidate(const SpeedConstraintTuner::Candidate& candidate);
+};
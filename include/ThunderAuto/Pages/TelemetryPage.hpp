@@ -0,0 +1,70 @@
+#pragma once
+
+#include <ThunderAuto/DocumentEditManager.hpp>
+#include <ThunderAuto/Pages/EditorPage.hpp>
+#include <ThunderAuto/Pages/Page.hpp>
+#include <ThunderAuto/TelemetrySeries.hpp>
+#include <imgui_internal.h>
+#include <array>
+#include <future>
+#include <memory>
+#include <string>
+
+/**
+ * Plots the velocity, acceleration, angular velocity and curvature of the current trajectory (or the active
+ * branches of the current auto mode) against time or distance, with a cursor that follows the editor's
+ * playback.
+ */
+class TelemetryPage : public Page {
+  DocumentEditManager& m_history;
+  DocumentEditManager::StateUpdateSubscriberID m_stateUpdateSubscriberID;
+
+  EditorPage& m_editorPage;
+
+  std::unique_ptr<TelemetrySeries> m_series;
+
+  // Built on the thread pool at export resolution.
+  std::future<std::unique_ptr<TelemetrySeries>> m_pendingSeries;
+
+  // Whether the state changed since the series was last built.
+  bool m_seriesIsStale = true;
+
+  // What the series was built from.
+  ThunderAutoEditorState::View m_seriesView = ThunderAutoEditorState::View::NONE;
+  std::string m_seriesSourceName;
+
+  TelemetrySeries::Axis m_axis = TelemetrySeries::Axis::TIME;
+  std::array<bool, TelemetrySeries::kNumChannels> m_showChannels = {true, true, false, true, false};
+
+  // The visible range of the axis.
+  float m_viewMin = 0.f;
+  float m_viewMax = 0.f;
+
+ public:
+  TelemetryPage(DocumentEditManager& history, EditorPage& editorPage) noexcept
+      : m_history(history),
+        m_stateUpdateSubscriberID(
+            history.registerStateUpdateSubscriber(
+                std::bind(&TelemetryPage::onStateUpdated, this, std::placeholders::_1))),
+        m_editorPage(editorPage) {}
+
+  ~TelemetryPage() { m_history.unregisterStateUpdateSubscriber(m_stateUpdateSubscriberID); }
+
+  const char* name() const noexcept override { return "Telemetry"; }
+
+  void present(bool* running) override;
+
+ private:
+  void onStateUpdated(const StateChangeSet& changes);
+
+  void updateSeries();
+
+  void resetView();
+
+  /**
+   * Handles zooming, panning and seeking over the area that all the plots share.
+   */
+  void processPlotInput(ImRect bb);
+
+  void presentPlot(TelemetrySeries::Channel channel, ImRect bb);
+};
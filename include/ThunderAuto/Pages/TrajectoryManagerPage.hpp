@@ -3,6 +3,7 @@
 #include <ThunderAuto/Pages/Page.hpp>
 #include <ThunderAuto/DocumentEditManager.hpp>
 #include <ThunderAuto/Pages/EditorPage.hpp>
+#include <ThunderAuto/Pages/NameSearchBox.hpp>
 #include <cstddef>
 
 using namespace thunder::core;
@@ -12,6 +13,8 @@ class TrajectoryManagerPage : public Page {
 
   EditorPage& m_editorPage;
 
+  NameSearchBox m_searchBox;
+
  public:
   TrajectoryManagerPage(DocumentEditManager& history, EditorPage& editorPage)
       : m_history(history), m_editorPage(editorPage) {}
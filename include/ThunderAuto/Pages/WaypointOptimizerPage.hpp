@@ -0,0 +1,61 @@
+#pragma once
+
+#include <ThunderAuto/WaypointOptimizer.hpp>
+#include <ThunderAuto/DocumentEditManager.hpp>
+#include <ThunderAuto/DocumentManager.hpp>
+#include <ThunderAuto/Pages/EditorPage.hpp>
+#include <ThunderAuto/Pages/Page.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * Searches for waypoint positions, headings, and weights that make the current trajectory faster or less
+ * curvy, previews the best one found in the editor, and applies it if the user wants.
+ */
+class WaypointOptimizerPage : public Page {
+  DocumentManager& m_documentManager;
+  DocumentEditManager& m_history;
+  EditorPage& m_editorPage;
+
+  WaypointOptimizerSettings m_settings;
+
+  std::unique_ptr<WaypointOptimizer> m_optimizer;
+  std::string m_optimizerTrajectoryName;
+  // The version of the trajectory being optimized. The result is discarded once the trajectory changes.
+  uint64_t m_optimizerTrajectoryVersion = 0;
+  size_t m_previewGeneration = 0;
+  std::vector<Point2d> m_previewPath;
+
+  WaypointOptimizer::Result m_result;
+  std::string m_resultTrajectoryName;
+  uint64_t m_resultTrajectoryVersion = 0;
+  bool m_hasResult = false;
+
+ public:
+  WaypointOptimizerPage(DocumentManager& documentManager,
+                        DocumentEditManager& history,
+                        EditorPage& editorPage)
+      : m_documentManager(documentManager), m_history(history), m_editorPage(editorPage) {}
+
+  const char* name() const noexcept override { return "Waypoint Optimizer"; }
+
+  void present(bool* running) override;
+
+  /**
+   * Stops any optimizing in progress, and forgets and stops previewing the last result (e.g. when the project
+   * is closed).
+   */
+  void reset() noexcept;
+
+ private:
+  void updateOptimizer();
+
+  void presentSettings();
+  void presentResult();
+
+  void startOptimizing(const ThunderAutoProjectState& state);
+  void applyResult();
+  void discardResult();
+};
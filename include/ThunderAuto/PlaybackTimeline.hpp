@@ -0,0 +1,90 @@
+#pragma once
+
+#include <ThunderLibCore/Auto/ThunderAutoOutputTrajectory.hpp>
+#include <units/time.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace thunder::core;
+
+/**
+ * Trajectories laid end to end on a single timeline, for playing back an auto mode.
+ *
+ * Every segment between two consecutive trajectory points is stored in one flat array sorted by global time,
+ * so finding where the robot is at any time is a binary search. Lookups also remember where the last one
+ * landed, so stepping forward during playback usually only looks at the next segment or two.
+ *
+ * The timeline only points to the trajectories it was built from, so it must be rebuilt whenever they change.
+ */
+class PlaybackTimeline final {
+ public:
+  struct Marker {
+    enum class Type {
+      ACTION,
+      BRANCH,
+    };
+
+    Type type;
+    units::second_t time;
+    std::string label;
+  };
+
+  /**
+   * Where the robot is at a given time, as two points to interpolate between.
+   */
+  struct Sample {
+    const ThunderAutoOutputTrajectoryPoint* lowerPoint;
+    const ThunderAutoOutputTrajectoryPoint* upperPoint;
+
+    // How far between the two points, from 0 to 1.
+    double t;
+  };
+
+ private:
+  struct Segment {
+    units::second_t startTime;
+    uint32_t trajectoryIndex;
+    uint32_t pointIndex;  // The segment goes from this point to the next.
+  };
+
+  std::vector<const ThunderAutoOutputTrajectory*> m_trajectories;
+  std::vector<units::second_t> m_trajectoryStartTimes;  // Prefix sums of the trajectory times.
+  units::second_t m_totalTime = units::second_t(0.0);
+
+  std::vector<Segment> m_segments;
+  std::vector<Marker> m_markers;
+
+  mutable size_t m_cursor = 0;
+
+ public:
+  void clear() noexcept;
+
+  /**
+   * Adds a trajectory to the end of the timeline.
+   */
+  void addTrajectory(const ThunderAutoOutputTrajectory& trajectory);
+
+  void addMarker(Marker::Type type, units::second_t time, std::string label);
+
+  bool empty() const noexcept { return m_segments.empty(); }
+
+  units::second_t totalTime() const noexcept { return m_totalTime; }
+
+  size_t numTrajectories() const noexcept { return m_trajectories.size(); }
+  units::second_t trajectoryStartTime(size_t trajectoryIndex) const {
+    return m_trajectoryStartTimes.at(trajectoryIndex);
+  }
+
+  // Sorted by time.
+  const std::vector<Marker>& markers() const noexcept { return m_markers; }
+
+  /**
+   * Finds where the robot is at a time. Times outside the timeline are clamped to it. The timeline must not
+   * be empty.
+   */
+  Sample sample(units::second_t time) const;
+
+ private:
+  size_t findSegment(units::second_t time) const;
+};
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <ThunderAuto/SoftwareCanvas.hpp>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+/**
+ * Encodes a canvas as an RGBA PNG image.
+ *
+ * Each row is filtered with whichever PNG filter suits it best, and compressed with a single fixed Huffman
+ * deflate block. That doesn't compress as well as a full zlib, but the editor has no other use for zlib, and
+ * field images with paths drawn on them still compress well. Safe to call from any thread.
+ */
+std::vector<uint8_t> EncodePNG(const SoftwareCanvas& canvas);
+
+/**
+ * Encodes a canvas as a PNG image and writes it to a file. Throws if the file could not be written.
+ */
+void WritePNG(const std::filesystem::path& path, const SoftwareCanvas& canvas);
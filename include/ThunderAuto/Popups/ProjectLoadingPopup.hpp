@@ -0,0 +1,33 @@
+#pragma once
+
+#include <ThunderAuto/Popups/Popup.hpp>
+#include <string>
+
+class ProjectLoadingPopup : public Popup {
+  std::string m_projectName;
+  std::string m_stage;
+  float m_progress = 0.f;
+
+ public:
+  ProjectLoadingPopup() = default;
+
+  void present(bool* running) override;
+  const char* name() const noexcept override { return "Opening Project"; }
+
+  void setProjectName(const std::string& projectName) { m_projectName = projectName; }
+
+  void setProgress(const std::string& stage, float progress) {
+    m_stage = stage;
+    m_progress = progress;
+  }
+
+  enum class Result {
+    NONE,
+    CANCEL,
+  };
+
+  Result result() const { return m_result; }
+
+ private:
+  Result m_result = Result::NONE;
+};
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <ThunderAuto/Popups/Popup.hpp>
+
+class RecoveredEditsPopup : public Popup {
+ public:
+  RecoveredEditsPopup() = default;
+
+  void present(bool* running) override;
+  const char* name() const noexcept override { return "Recovered Unsaved Changes"; }
+
+  enum class Result {
+    NONE,
+    KEEP,
+    DISCARD,
+  };
+
+  Result result() const noexcept { return m_result; }
+
+ private:
+  Result m_result = Result::NONE;
+};
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <ThunderLibCore/Auto/ThunderAutoProject.hpp>
+#include <ThunderLibCore/Auto/ThunderAutoOutputTrajectory.hpp>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+using namespace thunder::core;
+
+/**
+ * Every trajectory built with kPreviewOutputTrajectorySettings, shared by everything that works from the
+ * preview of each trajectory in the background (collision checks, thumbnails), so that a trajectory is only
+ * built once each time it changes.
+ *
+ * Trajectories are built on the thread pool when they're first requested after changing.
+ */
+class PreviewTrajectoryCache final {
+  struct Entry {
+    // Incremented whenever the trajectory changes.
+    uint64_t generation = 0;
+    std::optional<uint64_t> builtGeneration;
+
+    // Null if the trajectory failed to build.
+    std::shared_ptr<const ThunderAutoOutputTrajectory> trajectory;
+
+    std::future<std::unique_ptr<ThunderAutoOutputTrajectory>> pendingTrajectory;
+    uint64_t pendingGeneration = 0;
+  };
+
+  std::unordered_map<std::string, Entry> m_entries;
+
+ public:
+  void invalidateTrajectory(const std::string& trajectoryName) noexcept;
+  void invalidateAll() noexcept;
+
+  void clear() noexcept;
+
+  /**
+   * Forgets trajectories that are no longer in the state. Should be called before requesting trajectories
+   * each frame.
+   */
+  void update(const ThunderAutoProjectState& state);
+
+  /**
+   * The preview of a trajectory. Starts building it if it changed since it was last built.
+   *
+   * @param trajectoryName The name of the trajectory
+   * @param skeleton The trajectory's current skeleton
+   *
+   * @return The built trajectory (null if it failed to build), or std::nullopt if it's still being built
+   */
+  std::optional<std::shared_ptr<const ThunderAutoOutputTrajectory>> request(
+      const std::string& trajectoryName,
+      const ThunderAutoTrajectorySkeleton& skeleton);
+};
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <ThunderAuto/DocumentManager.hpp>
+#include <ThunderAuto/Graphics/Texture.hpp>
+#include <ThunderLibCore/Auto/ThunderAutoOutputTrajectory.hpp>
+#include <atomic>
+#include <filesystem>
+#include <future>
+#include <memory>
+#include <optional>
+#include <string>
+
+using namespace thunder::core;
+
+/**
+ * Loads a project on a background thread, along with everything else needed to open it that does not need to
+ * happen on the main thread (decoding the field image and building the first preview trajectory).
+ *
+ * The task can be cancelled at any time. Loading the project file itself can not be interrupted, so a
+ * cancelled task stops at the next stage boundary and its result is discarded.
+ */
+class ProjectLoadTask final {
+ public:
+  enum class Stage {
+    LOADING_PROJECT,
+    DECODING_FIELD_IMAGE,
+    BUILDING_TRAJECTORY,
+    DONE,
+  };
+
+  static const char* StageToString(Stage stage) noexcept;
+
+  struct Result {
+    DocumentManager::LoadedProject loadedProject;
+    std::optional<TextureImage> fieldImage;
+    std::unique_ptr<ThunderAutoOutputTrajectory> firstTrajectory;
+
+    bool cancelled = false;
+    std::string error;  // Empty if the project loaded successfully.
+  };
+
+ private:
+  struct SharedState {
+    std::atomic<Stage> stage = Stage::LOADING_PROJECT;
+    std::atomic<bool> cancelled = false;
+  };
+
+  std::filesystem::path m_path;
+  std::shared_ptr<SharedState> m_sharedState;
+  std::future<Result> m_future;
+
+ public:
+  /**
+   * Starts loading the project in the background.
+   *
+   * @param path The path to the project file
+   */
+  explicit ProjectLoadTask(std::filesystem::path path);
+
+  ProjectLoadTask(const ProjectLoadTask&) = delete;
+  ProjectLoadTask& operator=(const ProjectLoadTask&) = delete;
+
+  const std::filesystem::path& path() const noexcept { return m_path; }
+
+  Stage stage() const noexcept { return m_sharedState->stage; }
+
+  /**
+   * Returns the approximate progress of the task, from 0 to 1.
+   */
+  float progress() const noexcept;
+
+  void cancel() noexcept { m_sharedState->cancelled = true; }
+  bool isCancelled() const noexcept { return m_sharedState->cancelled; }
+
+  /**
+   * Returns whether the task has finished (successfully or not). Does not block.
+   */
+  bool isFinished() const;
+
+  /**
+   * Takes the result of the task. Blocks until the task is finished, and can only be called once.
+   */
+  Result takeResult();
+
+ private:
+  static Result Run(std::filesystem::path path, std::shared_ptr<SharedState> sharedState);
+};
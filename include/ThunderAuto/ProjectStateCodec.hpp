@@ -0,0 +1,39 @@
+#pragma once
+
+#include <ThunderLibCore/Auto/ThunderAutoProject.hpp>
+#include <wpi/json.h>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+using namespace thunder::core;
+
+//
+// Helpers for converting project states to and from a compact binary form, and for computing deltas between
+// them. These build on the same JSON conversions that ThunderLibCore uses for project files, so anything that
+// round-trips through a project file round-trips through these as well.
+//
+// None of these touch any global state, so they are safe to call from background threads.
+//
+
+wpi::json ProjectStateToJson(const ThunderAutoProjectState& state);
+ThunderAutoProjectState ProjectStateFromJson(const wpi::json& json);
+
+// Encodes JSON as MessagePack.
+std::vector<uint8_t> EncodeProjectJson(const wpi::json& json);
+
+// Decodes MessagePack produced by EncodeProjectJson(). Throws if the data is malformed.
+wpi::json DecodeProjectJson(std::span<const uint8_t> data);
+
+// Returns a JSON patch (RFC 6902) that transforms `from` into `to`.
+wpi::json DiffProjectJson(const wpi::json& from, const wpi::json& to);
+
+// Applies a JSON patch produced by DiffProjectJson(). Throws if the patch does not apply.
+wpi::json PatchProjectJson(const wpi::json& json, const wpi::json& patch);
+
+// Like PatchProjectJson(), but modifies the JSON instead of copying it. If this throws, the JSON may be left
+// partially patched.
+void PatchProjectJsonInPlace(wpi::json& json, const wpi::json& patch);
+
+// CRC-32 (IEEE 802.3) checksum, used to detect torn writes in on-disk stores.
+uint32_t ComputeCRC32(std::span<const uint8_t> data, uint32_t crc = 0);
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <ThunderAuto/MappedFile.hpp>
+#include <ThunderLibCore/Types.hpp>
+#include <units/time.h>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace thunder::core;
+
+/**
+ * A robot log that poses can be read from, either a WPILib data log (.wpilog) or a CSV file.
+ *
+ * The file is memory mapped and scanned once when it's opened, recording where each record of every pose
+ * entry starts. Poses are only decoded when an entry is read, straight from the mapping.
+ *
+ * Supported WPILib data log entry types are 'struct:Pose2d', and 'double[]' as [x (m), y (m), rotation (deg)]
+ * the way Field2d publishes robot poses. CSV files need a header row with 'time' (s), 'x' (m), 'y' (m), and
+ * 'rotation' (deg) columns, which becomes a single entry named after the file.
+ */
+class RobotLog final {
+ public:
+  struct PoseSample {
+    units::second_t time;
+    Point2d position;
+    CanonicalAngle rotation;
+  };
+
+  struct Entry {
+    std::string name;
+    std::string type;
+
+    // Where each record of the entry starts in the file, in the order they were logged.
+    std::vector<uint64_t> recordOffsets;
+  };
+
+ private:
+  enum class Format {
+    WPILOG,
+    CSV,
+  };
+
+  MappedFile m_file;
+  Format m_format;
+
+  std::vector<Entry> m_entries;
+
+  // CSV column indices.
+  size_t m_csvTimeColumn = 0;
+  size_t m_csvXColumn = 0;
+  size_t m_csvYColumn = 0;
+  size_t m_csvRotationColumn = 0;
+
+ public:
+  /**
+   * Opens and indexes a log.
+   *
+   * @param path The log file, either .wpilog or .csv
+   *
+   * @throws RuntimeError if the file could not be read or is not a valid log
+   */
+  explicit RobotLog(const std::filesystem::path& path);
+
+  /**
+   * The entries that poses can be read from.
+   */
+  const std::vector<Entry>& poseEntries() const noexcept { return m_entries; }
+
+  /**
+   * Decodes every pose of an entry. Records that can't be decoded are skipped.
+   *
+   * @return The poses, sorted by time
+   */
+  std::vector<PoseSample> readPoses(size_t entryIndex) const;
+
+ private:
+  void indexWPILog();
+  void indexCSV(const std::filesystem::path& path);
+
+  bool readWPILogPose(const Entry& entry, uint64_t recordOffset, PoseSample& sample) const;
+  bool readCSVPose(uint64_t lineOffset, PoseSample& sample) const;
+};
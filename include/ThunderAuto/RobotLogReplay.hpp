@@ -0,0 +1,61 @@
+#pragma once
+
+#include <ThunderAuto/RobotLog.hpp>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <vector>
+
+/**
+ * The actual path of the robot from a robot log, played back alongside the planned trajectory in the editor.
+ */
+class RobotLogReplay final {
+  std::filesystem::path m_path;
+  std::unique_ptr<RobotLog> m_log;
+
+  size_t m_entryIndex = 0;
+  std::vector<RobotLog::PoseSample> m_samples;
+
+  // The samples' positions with points that are too close together dropped, for drawing.
+  std::vector<Point2d> m_decimatedPath;
+
+  // The log time that lines up with the start of playback.
+  units::second_t m_startTime = units::second_t(0.0);
+
+ public:
+  bool visible = true;
+
+  bool isOpen() const noexcept { return m_log != nullptr; }
+
+  /**
+   * Opens a robot log and selects its first pose entry.
+   *
+   * @throws RuntimeError if the log could not be read
+   */
+  void open(const std::filesystem::path& path);
+  void close() noexcept;
+
+  const std::filesystem::path& path() const noexcept { return m_path; }
+
+  // Only valid while a log is open.
+  const std::vector<RobotLog::Entry>& entries() const noexcept { return m_log->poseEntries(); }
+
+  size_t entryIndex() const noexcept { return m_entryIndex; }
+  void selectEntry(size_t entryIndex);
+
+  size_t numSamples() const noexcept { return m_samples.size(); }
+
+  units::second_t logStartTime() const noexcept;
+  units::second_t logEndTime() const noexcept;
+
+  units::second_t startTime() const noexcept { return m_startTime; }
+  void setStartTime(units::second_t time) noexcept { m_startTime = time; }
+
+  const std::vector<Point2d>& decimatedPath() const noexcept { return m_decimatedPath; }
+
+  /**
+   * Where the robot was at a playback time, interpolated between samples. Returns nothing if the time is
+   * outside the log.
+   */
+  std::optional<RobotLog::PoseSample> sample(units::second_t playbackTime) const;
+};
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <optional>
+#include <type_traits>
+
+/**
+ * A fixed size, lock-free queue for passing values from exactly one producer thread to exactly one consumer
+ * thread. Neither side ever blocks: pushing to a full buffer fails, and popping from an empty one returns
+ * nothing.
+ *
+ * @tparam T The value type, which must be trivially copyable
+ * @tparam Capacity The number of slots, which must be a power of two
+ */
+template <typename T, size_t Capacity>
+class SPSCRingBuffer final {
+  static_assert(std::is_trivially_copyable_v<T>, "SPSCRingBuffer values must be trivially copyable");
+  static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0,
+                "SPSCRingBuffer capacity must be a power of two");
+
+  static constexpr size_t kMask = Capacity - 1;
+
+  // Keep the indices on separate cache lines, so that the producer and consumer don't fight over them.
+  static constexpr size_t kCacheLineSize = 64;
+
+  // Only written by the consumer.
+  alignas(kCacheLineSize) std::atomic<size_t> m_head = 0;
+
+  // Only written by the producer.
+  alignas(kCacheLineSize) std::atomic<size_t> m_tail = 0;
+
+  alignas(kCacheLineSize) std::array<T, Capacity> m_slots;
+
+ public:
+  /**
+   * Adds a value to the back of the buffer. Only call from the producer thread.
+   *
+   * @return False if the buffer is full, in which case the value is dropped
+   */
+  bool push(const T& value) noexcept {
+    const size_t tail = m_tail.load(std::memory_order_relaxed);
+    if (tail - m_head.load(std::memory_order_acquire) == Capacity)
+      return false;
+
+    m_slots[tail & kMask] = value;
+    m_tail.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * Takes the value at the front of the buffer. Only call from the consumer thread.
+   */
+  std::optional<T> pop() noexcept {
+    const size_t head = m_head.load(std::memory_order_relaxed);
+    if (head == m_tail.load(std::memory_order_acquire))
+      return std::nullopt;
+
+    T value = m_slots[head & kMask];
+    m_head.store(head + 1, std::memory_order_release);
+    return value;
+  }
+
+  static constexpr size_t capacity() noexcept { return Capacity; }
+};
@@ -2,6 +2,7 @@
 
 #include <ThunderLibCore/Types.hpp>
 #include <vector>
+#include <span>
 #include <cstddef>
 
 using namespace thunder::core;
@@ -12,3 +13,38 @@ TPolyline CreateRoundedRectangle(Measurement2d size, units::meter_t cornerRadius
 
 void RotatePolygon(TPolyline& polyline, CanonicalAngle angle);
 void TranslatePolygon(TPolyline& polyline, Displacement2d displacement);
+
+/**
+ * A polygon with its vertices split into separate x and y arrays (in meters), for TransformPolygonBatch().
+ */
+struct PolygonSoA {
+  std::vector<float> x;
+  std::vector<float> y;
+
+  size_t size() const noexcept { return x.size(); }
+};
+
+PolygonSoA PolylineToSoA(const TPolyline& polyline);
+
+/**
+ * A rotation then a translation, with the rotation's sine and cosine computed up front.
+ */
+struct PolygonTransform {
+  float x;
+  float y;
+  float cos;
+  float sin;
+
+  static PolygonTransform FromPose(const Point2d& position, const CanonicalAngle& rotation);
+};
+
+/**
+ * Transforms a polygon by every transform at once. Vertex j of transform i is written to index
+ * (i * polygon.size() + j) of outX and outY, which must already be large enough.
+ *
+ * The inner loop runs over plain float arrays with no branches, so that the compiler can vectorize it.
+ */
+void TransformPolygonBatch(const PolygonSoA& polygon,
+                           std::span<const PolygonTransform> transforms,
+                           std::span<float> outX,
+                           std::span<float> outY);
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <imgui.h>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+/**
+ * An RGBA image drawn on the CPU, for drawing things that aren't drawn every frame (e.g. thumbnails) without
+ * touching the graphics API. Unlike ImGui's draw lists, a canvas can be drawn on any thread.
+ *
+ * Colors are ImU32s (see IM_COL32), and pixels are stored as 8 bit RGBA, row by row from the top.
+ */
+class SoftwareCanvas final {
+  int m_width = 0;
+  int m_height = 0;
+  std::vector<uint8_t> m_pixels;
+
+ public:
+  SoftwareCanvas() = default;
+  SoftwareCanvas(int width, int height);
+
+  int width() const noexcept { return m_width; }
+  int height() const noexcept { return m_height; }
+
+  uint8_t* data() noexcept { return m_pixels.data(); }
+  const uint8_t* data() const noexcept { return m_pixels.data(); }
+
+  /**
+   * Resizes the canvas, keeping the pixels that are still inside it. New pixels are transparent.
+   */
+  void resize(int width, int height);
+
+  void clear(ImU32 color = IM_COL32(0, 0, 0, 0)) noexcept;
+
+  /**
+   * Sets every pixel of a rectangle, without blending.
+   */
+  void fillRect(int x, int y, int width, int height, ImU32 color) noexcept;
+
+  /**
+   * Draws an anti-aliased line with round ends.
+   */
+  void drawLine(ImVec2 a, ImVec2 b, ImU32 color, float thickness) noexcept;
+
+  void drawPolyline(std::span<const ImVec2> points,
+                    ImU32 color,
+                    float thickness,
+                    bool closed = false) noexcept;
+
+  void fillCircle(ImVec2 center, float radius, ImU32 color) noexcept;
+
+  /**
+   * Fills an anti-aliased convex polygon. The vertices can go either way around.
+   */
+  void fillConvexPolygon(std::span<const ImVec2> points, ImU32 color) noexcept;
+
+  /**
+   * Draws an image scaled to fit a rectangle, blending it over what's already drawn.
+   *
+   * @param pixels The image's pixels, row by row from the top
+   * @param width The width of the image
+   * @param height The height of the image
+   * @param numChannels 1 (gray), 2 (gray, alpha), 3 (RGB), or 4 (RGBA)
+   * @param min The top left corner of the rectangle
+   * @param max The bottom right corner of the rectangle
+   */
+  void drawImage(const uint8_t* pixels,
+                 int width,
+                 int height,
+                 int numChannels,
+                 ImVec2 min,
+                 ImVec2 max) noexcept;
+
+  /**
+   * Copies another canvas onto this one, without blending.
+   */
+  void copyFrom(const SoftwareCanvas& source, int x, int y) noexcept;
+
+ private:
+  void blendPixel(int x, int y, ImU32 color, float coverage) noexcept;
+};
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <ThunderLibCore/Auto/ThunderAutoProject.hpp>
+#include <ThunderLibCore/Types.hpp>
+#include <units/time.h>
+#include <units/velocity.h>
+#include <units/acceleration.h>
+#include <units/angular_velocity.h>
+#include <units/angular_acceleration.h>
+#include <atomic>
+#include <cstddef>
+#include <future>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace thunder::core;
+
+/**
+ * What the robot is physically capable of. The tuner never picks a speed constraint above these.
+ */
+struct SpeedConstraintLimits {
+  units::meters_per_second_t maxLinearVelocity = units::meters_per_second_t(4.5);
+  units::meters_per_second_squared_t maxLinearAcceleration = units::meters_per_second_squared_t(4.0);
+
+  // The most the wheels can accelerate the robot in any direction before slipping. Linear and centripetal
+  // acceleration are limited separately when building a trajectory, but they add up at the wheels.
+  units::meters_per_second_squared_t maxTotalAcceleration = units::meters_per_second_squared_t(6.0);
+
+  units::degrees_per_second_t maxAngularVelocity = units::degrees_per_second_t(540.0);
+  units::degrees_per_second_squared_t maxAngularAcceleration = units::degrees_per_second_squared_t(1080.0);
+
+  // Whether to also tune the velocity overrides of waypoints that aren't stopped.
+  bool tuneVelocityOverrides = true;
+};
+
+/**
+ * Searches for the speed constraints (and waypoint velocity overrides) that make a trajectory as fast as
+ * possible without going over the robot's limits.
+ *
+ * Runs in the background. Each round builds a batch of candidate trajectories in parallel on the thread
+ * pool, sampled around the best candidates found so far, and the search area shrinks whenever a round
+ * doesn't improve on them. Candidates that can't possibly beat the best one (judging by path length alone)
+ * are skipped without being built, and the search stops early once it stops improving.
+ */
+class SpeedConstraintTuner final {
+ public:
+  static constexpr size_t kMaxRounds = 16;
+  static constexpr size_t kMaxCandidatesShown = 5;
+
+  struct Candidate {
+    // The trajectory's settings with the tuned speed constraints. Only the speed constraints are applied.
+    ThunderAutoTrajectorySkeletonSettings settings;
+
+    // Waypoint index and new velocity override.
+    std::vector<std::pair<size_t, units::meters_per_second_t>> velocityOverrides;
+
+    units::second_t totalTime = units::second_t(0.0);
+    units::meters_per_second_squared_t peakTotalAcceleration = units::meters_per_second_squared_t(0.0);
+  };
+
+  struct Result {
+    units::second_t originalTime = units::second_t(0.0);
+
+    // Fastest first.
+    std::vector<Candidate> candidates;
+
+    size_t numEvaluated = 0;
+    size_t numSkipped = 0;
+
+    bool cancelled = false;
+    std::string error;  // Empty if successful.
+  };
+
+ private:
+  struct SharedState {
+    std::atomic<size_t> numFinishedRounds = 0;
+    std::atomic<bool> cancelled = false;
+  };
+
+  std::shared_ptr<SharedState> m_sharedState;
+  std::future<Result> m_future;
+
+ public:
+  /**
+   * Starts tuning a trajectory in the background.
+   */
+  SpeedConstraintTuner(ThunderAutoTrajectorySkeleton skeleton, SpeedConstraintLimits limits);
+
+  // Cancels tuning and waits for it to stop.
+  ~SpeedConstraintTuner() { cancel(); }
+
+  SpeedConstraintTuner(const SpeedConstraintTuner&) = delete;
+  SpeedConstraintTuner& operator=(const SpeedConstraintTuner&) = delete;
+
+  /**
+   * Returns the approximate progress of tuning, from 0 to 1.
+   */
+  float progress() const noexcept;
+
+  void cancel() noexcept { m_sharedState->cancelled = true; }
+
+  /**
+   * Returns whether tuning has finished (successfully or not). Does not block.
+   */
+  bool isFinished() const;
+
+  /**
+   * Takes the result of tuning. Blocks until tuning is finished, and can only be called once.
+   */
+  Result takeResult();
+
+  /**
+   * Applies a candidate's speed constraints and velocity overrides to a trajectory, leaving the rest of its
+   * settings as they are.
+   */
+  static void ApplyCandidate(ThunderAutoTrajectorySkeleton& skeleton, const Candidate& candidate);
+
+ private:
+  static Result Run(ThunderAutoTrajectorySkeleton skeleton,
+                    SpeedConstraintLimits limits,
+                    std::shared_ptr<SharedState> sharedState);
+};
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <ThunderAuto/Singleton.hpp>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <optional>
+
+/**
+ * Records how long each phase of application startup takes, so that it can be logged when the app exits.
+ *
+ * Each phase is only recorded the first time it runs (e.g. fonts are rebuilt whenever the DPI scale changes,
+ * but only the first build counts towards startup). Phases may be recorded from background threads.
+ */
+class StartupTimeline final : public Singleton<StartupTimeline> {
+ public:
+  enum class Phase : size_t {
+    WINDOW_CREATION = 0,
+    GRAPHICS_LOAD,
+    FONT_ATLAS,
+    INI_PARSE,
+    PROJECT_LOAD,
+    FIELD_TEXTURE_DECODE,
+    FIRST_TRAJECTORY_BUILD,
+    FIRST_FRAME,
+
+    _COUNT,
+  };
+
+  static const char* PhaseToString(Phase phase) noexcept;
+
+  using Clock = std::chrono::steady_clock;
+
+  StartupTimeline() noexcept : m_launchTime(Clock::now()) {}
+
+  void beginPhase(Phase phase) noexcept;
+  void endPhase(Phase phase) noexcept;
+
+  bool isPhaseRecorded(Phase phase) const noexcept;
+
+  /**
+   * Logs the duration of each recorded phase, as well as when it started relative to launch.
+   */
+  void logSummary() const noexcept;
+
+  class ScopedPhase {
+    Phase m_phase;
+
+   public:
+    explicit ScopedPhase(Phase phase) noexcept : m_phase(phase) { StartupTimeline::get().beginPhase(phase); }
+    ~ScopedPhase() { StartupTimeline::get().endPhase(m_phase); }
+
+    ScopedPhase(const ScopedPhase&) = delete;
+    ScopedPhase& operator=(const ScopedPhase&) = delete;
+  };
+
+ private:
+  struct PhaseRecord {
+    std::optional<Clock::time_point> begin;
+    std::optional<Clock::time_point> end;
+  };
+
+  const Clock::time_point m_launchTime;
+  std::array<PhaseRecord, static_cast<size_t>(Phase::_COUNT)> m_phases;
+
+  mutable std::mutex m_mutex;
+};
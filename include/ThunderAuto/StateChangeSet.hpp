@@ -0,0 +1,61 @@
+#pragma once
+
+#include <ThunderLibCore/Auto/ThunderAutoProject.hpp>
+#include <set>
+#include <string>
+
+using namespace thunder::core;
+
+/**
+ * Describes which parts of the project state changed between two states, so that anything derived from the
+ * state only needs to be recomputed for the parts that actually changed.
+ *
+ * Entities are identified by name. An entity that was added, removed, or modified is listed by its name in
+ * the state where it exists (so a rename lists both the old and the new name).
+ */
+struct StateChangeSet {
+  // Everything should be considered changed (e.g. a new project was opened).
+  bool everything = false;
+
+  std::set<std::string> trajectories;
+  std::set<std::string> autoModes;
+  std::set<std::string> actions;
+
+  bool actionsOrder = false;
+  bool waypointLinks = false;
+  bool trajectoryEndBehaviorLinks = false;
+
+  // Editor state.
+  bool editorView = false;
+  bool currentTrajectory = false;
+  bool trajectorySelection = false;
+  bool currentAutoMode = false;
+  bool autoModeStepSelection = false;
+
+  /**
+   * Compares two states to find what changed between them.
+   */
+  static StateChangeSet Compute(const ThunderAutoProjectState& from, const ThunderAutoProjectState& to);
+
+  static StateChangeSet Everything() noexcept { return StateChangeSet{.everything = true}; }
+
+  /**
+   * Adds all the changes from another change set to this one.
+   */
+  void merge(const StateChangeSet& other);
+
+  bool empty() const noexcept;
+
+  bool affectsTrajectory(const std::string& name) const noexcept {
+    return everything || trajectories.contains(name);
+  }
+  bool affectsAutoMode(const std::string& name) const noexcept {
+    return everything || autoModes.contains(name);
+  }
+  bool affectsAction(const std::string& name) const noexcept { return everything || actions.contains(name); }
+
+  bool affectsEditorState() const noexcept {
+    return everything || editorView || currentTrajectory || trajectorySelection || currentAutoMode ||
+           autoModeStepSelection;
+  }
+};
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <ThunderLibCore/Auto/ThunderAutoOutputTrajectory.hpp>
+#include <array>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+using namespace thunder::core;
+
+/**
+ * The channels of one or more output trajectories laid end to end, for plotting against time or distance.
+ *
+ * Each channel is stored in its own contiguous buffer. A min/max pyramid is built over every channel, where
+ * each level halves the previous one, so the range of a channel over any run of samples can be found in
+ * O(log n). That lets the plot draw one column per pixel no matter how many samples are on screen.
+ */
+class TelemetrySeries final {
+ public:
+  enum class Channel : size_t {
+    LINEAR_VELOCITY = 0,
+    LINEAR_ACCELERATION,
+    CENTRIPETAL_ACCELERATION,
+    ANGULAR_VELOCITY,
+    CURVATURE,
+
+    _COUNT,
+  };
+
+  static constexpr size_t kNumChannels = static_cast<size_t>(Channel::_COUNT);
+
+  static const char* ChannelToString(Channel channel) noexcept;
+  static const char* ChannelUnits(Channel channel) noexcept;
+
+  enum class Axis {
+    TIME,
+    DISTANCE,
+  };
+
+  struct Range {
+    float min;
+    float max;
+  };
+
+ private:
+  std::vector<float> m_times;      // Seconds.
+  std::vector<float> m_distances;  // Meters.
+
+  struct ChannelData {
+    std::vector<float> values;
+
+    // Level i covers 2^(i+1) samples per entry. The values themselves are level 0 of the pyramid.
+    std::vector<std::vector<Range>> levels;
+  };
+
+  std::array<ChannelData, kNumChannels> m_channels;
+
+ public:
+  /**
+   * Adds a trajectory to the end of the series. Call build() once every trajectory has been added.
+   */
+  void addTrajectory(const ThunderAutoOutputTrajectory& trajectory);
+
+  /**
+   * Builds the min/max pyramids.
+   */
+  void build();
+
+  size_t size() const noexcept { return m_times.size(); }
+  bool empty() const noexcept { return m_times.empty(); }
+
+  const std::vector<float>& axisValues(Axis axis) const noexcept {
+    return axis == Axis::TIME ? m_times : m_distances;
+  }
+
+  const std::vector<float>& channelValues(Channel channel) const noexcept {
+    return m_channels.at(static_cast<size_t>(channel)).values;
+  }
+
+  /**
+   * Finds the range of samples whose axis values are within [min, max), as [begin, end) indices.
+   */
+  std::pair<size_t, size_t> findSamples(Axis axis, float min, float max) const;
+
+  /**
+   * The smallest and largest value of a channel over the samples [begin, end). The range must not be empty.
+   */
+  Range channelRange(Channel channel, size_t begin, size_t end) const;
+
+  /**
+   * The smallest and largest value of a channel over all samples.
+   */
+  Range channelRange(Channel channel) const { return channelRange(channel, 0, size()); }
+
+  /**
+   * Converts a value on one axis to the other (e.g. the distance traveled at a time), interpolating between
+   * samples.
+   */
+  float convertAxisValue(Axis from, Axis to, float value) const;
+};
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <ThunderAuto/Singleton.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Worker threads for CPU heavy work that can be split into independent tasks (e.g. building several
+ * trajectories at once).
+ *
+ * Each worker has its own queue, and submitted tasks are spread across them. A worker that runs out of tasks
+ * steals from the back of another worker's queue, so every core stays busy even when some tasks take much
+ * longer than others.
+ */
+class ThreadPool final : public Singleton<ThreadPool> {
+  using Task = std::function<void()>;
+
+  struct WorkerQueue {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  std::vector<std::unique_ptr<WorkerQueue>> m_queues;
+  std::atomic<size_t> m_nextQueue = 0;
+
+  std::mutex m_mutex;
+  std::condition_variable m_condition;
+  size_t m_numQueuedTasks = 0;
+  bool m_stopping = false;
+
+  // Declared last so that everything the workers use exists before they start.
+  std::vector<std::thread> m_workers;
+
+ public:
+  ThreadPool();
+  ~ThreadPool();
+
+  size_t numWorkers() const noexcept { return m_workers.size(); }
+
+  /**
+   * Queues a function to run on a worker thread.
+   *
+   * @param func The function to run
+   *
+   * @return A future for the function's result. Any exception thrown by the function is rethrown from it.
+   */
+  template <typename Func>
+  auto submit(Func&& func) -> std::future<std::invoke_result_t<std::decay_t<Func>>> {
+    using Result = std::invoke_result_t<std::decay_t<Func>>;
+
+    // std::function needs to be copyable, std::packaged_task isn't.
+    auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<Func>(func));
+    std::future<Result> future = task->get_future();
+
+    push([task] { (*task)(); });
+
+    return future;
+  }
+
+  /**
+   * Gets the results of a batch of submitted functions. Waits for every future before getting any of them, so
+   * that nothing is left running (and referencing the caller's data) if one of them threw.
+   */
+  template <typename T>
+  static std::vector<T> GetAll(std::vector<std::future<T>>& futures) {
+    for (std::future<T>& future : futures) {
+      future.wait();
+    }
+
+    std::vector<T> results;
+    results.reserve(futures.size());
+    for (std::future<T>& future : futures) {
+      results.push_back(future.get());
+    }
+    return results;
+  }
+
+ private:
+  void push(Task task);
+  bool tryPop(size_t workerIndex, Task& task);
+
+  void workerMain(size_t workerIndex);
+};
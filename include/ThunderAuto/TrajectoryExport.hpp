@@ -0,0 +1,66 @@
+#pragma once
+
+#include <ThunderLibCore/Auto/ThunderAutoProject.hpp>
+#include <ThunderLibCore/Auto/ThunderAutoOutputTrajectory.hpp>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <vector>
+
+using namespace thunder::core;
+
+enum class TrajectoryExportFormat {
+  CSV = 0,
+  BINARY = 1,  // See BinaryTrajectoryReader.hpp
+};
+
+const char* TrajectoryExportFormatToString(TrajectoryExportFormat format) noexcept;
+
+/**
+ * The extension of exported trajectory files, including the dot.
+ */
+const char* TrajectoryExportFormatFileExtension(TrajectoryExportFormat format) noexcept;
+
+/**
+ * The export format is stored in a JSON file next to the project file, since the project file format doesn't
+ * have a place for it.
+ */
+std::filesystem::path TrajectoryExportFormatPathForProject(const std::filesystem::path& projectPath);
+
+/**
+ * Loads the export format of a project. Returns CSV if the project doesn't have one. Throws if the file
+ * exists but could not be read.
+ */
+TrajectoryExportFormat LoadTrajectoryExportFormat(const std::filesystem::path& projectPath);
+
+/**
+ * Saves the export format of a project, removing the file if it's CSV. Throws if the file could not be
+ * written.
+ */
+void SaveTrajectoryExportFormat(const std::filesystem::path& projectPath, TrajectoryExportFormat format);
+
+/**
+ * Writes a trajectory to a binary trajectory file, with the columns selected in the CSV export properties.
+ * Throws if the file could not be written.
+ *
+ * @param trajectory The built trajectory
+ * @param skeleton The trajectory's skeleton, for its actions
+ * @param actionsOrder The project's actions, for the actions bit field
+ * @param path The file to write
+ * @param properties Which columns to write
+ */
+void BinaryExportThunderAutoOutputTrajectory(const ThunderAutoOutputTrajectory& trajectory,
+                                             const ThunderAutoTrajectorySkeleton& skeleton,
+                                             std::span<const std::string> actionsOrder,
+                                             const std::filesystem::path& path,
+                                             const ThunderAutoCSVExportProperties& properties);
+
+/**
+ * Builds a trajectory with kHighResOutputTrajectorySettings and exports it in a format, like
+ * BuildAndCSVExportThunderAutoOutputTrajectory(). Throws if the trajectory could not be exported.
+ */
+void BuildAndExportThunderAutoOutputTrajectory(const ThunderAutoTrajectorySkeleton& skeleton,
+                                               const std::vector<std::string>& actionsOrder,
+                                               const std::filesystem::path& path,
+                                               const ThunderAutoCSVExportProperties& properties,
+                                               TrajectoryExportFormat format);
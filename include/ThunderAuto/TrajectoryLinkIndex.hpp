@@ -0,0 +1,92 @@
+#pragma once
+
+#include <ThunderAuto/StateChangeSet.hpp>
+#include <ThunderLibCore/Auto/ThunderAutoProject.hpp>
+#include <cstddef>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace thunder::core;
+
+/**
+ * Finds which waypoints share a waypoint link, and which trajectory ends share an end behavior link, without
+ * going through every trajectory in the project.
+ *
+ * Kept up to date by only reindexing the trajectories that changed, so link propagation only visits the
+ * linked waypoints and trajectories instead of the whole project.
+ */
+class TrajectoryLinkIndex final {
+ public:
+  struct LinkedWaypoint {
+    std::string trajectoryName;
+    size_t waypointIndex;
+  };
+
+  enum class TrajectoryEnd {
+    START,
+    END,
+  };
+
+  struct LinkedTrajectoryEnd {
+    std::string trajectoryName;
+    TrajectoryEnd end;
+  };
+
+ private:
+  // Link name -> everything linked to it.
+  std::unordered_map<std::string, std::vector<LinkedWaypoint>> m_waypointLinks;
+  std::unordered_map<std::string, std::vector<LinkedTrajectoryEnd>> m_endBehaviorLinks;
+
+  // The links each trajectory is indexed under, so that its entries can be found again when it changes.
+  struct TrajectoryLinks {
+    std::vector<std::string> waypointLinkNames;
+    std::string startBehaviorLinkName;
+    std::string endBehaviorLinkName;
+  };
+  std::unordered_map<std::string, TrajectoryLinks> m_trajectoryLinks;
+
+ public:
+  void rebuild(const ThunderAutoProjectState& state);
+
+  /**
+   * Reindexes the trajectories that changed.
+   */
+  void update(const ThunderAutoProjectState& state, const StateChangeSet& changes);
+
+  void clear() noexcept;
+
+  std::span<const LinkedWaypoint> linkedWaypoints(const std::string& linkName) const noexcept;
+  std::span<const LinkedTrajectoryEnd> linkedTrajectoryEnds(const std::string& linkName) const noexcept;
+
+  /**
+   * Moves every waypoint linked to the selected waypoint of the current trajectory to its position.
+   *
+   * Same as ThunderAutoProjectState::trajectoryUpdateAllLinkedWaypointPositionsFromSelectedWaypoint(), which
+   * it falls back to if the index doesn't match the state.
+   *
+   * @param changes If not null, the trajectories that may have changed are added to it
+   */
+  void updateLinkedWaypointPositionsFromSelectedWaypoint(ThunderAutoProjectState& state,
+                                                         StateChangeSet* changes = nullptr) const;
+
+  /**
+   * Sets the start or end rotation of every trajectory end linked to the start and/or end of the current
+   * trajectory.
+   *
+   * Same as ThunderAutoProjectState's
+   * trajectoryUpdateAllLinkedTrajectoryEndBehaviorsFromCurrentTrajectoryEndBehavior(), which it falls back
+   * to if the index doesn't match the state.
+   *
+   * @param changes If not null, the trajectories that may have changed are added to it
+   */
+  void updateLinkedTrajectoryEndBehaviorsFromCurrentTrajectory(ThunderAutoProjectState& state,
+                                                               bool start,
+                                                               bool end,
+                                                               StateChangeSet* changes = nullptr) const;
+
+ private:
+  void addTrajectory(const std::string& trajectoryName, const ThunderAutoTrajectorySkeleton& skeleton);
+  void removeTrajectory(const std::string& trajectoryName);
+};
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <ThunderAuto/Graphics/Texture.hpp>
+#include <ThunderAuto/PreviewTrajectoryCache.hpp>
+#include <ThunderAuto/SoftwareCanvas.hpp>
+#include <ThunderLibCore/Auto/ThunderAutoProject.hpp>
+#include <ThunderLibCore/Types.hpp>
+#include <imgui.h>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using namespace thunder::core;
+
+/**
+ * Small pictures of the path of each trajectory and auto mode, for the lists of trajectories and auto modes.
+ *
+ * Thumbnails are drawn on the thread pool and packed into one texture. Only the thumbnails of trajectories
+ * that changed are drawn again, along with those of the auto modes that use them, and the texture is
+ * uploaded at most once per update. Trajectories are drawn from their previews in a PreviewTrajectoryCache.
+ */
+class TrajectoryThumbnails final {
+ public:
+  static constexpr int kTileWidth = 96;
+  static constexpr int kTileHeight = 48;
+
+  struct Tile {
+    ImTextureID texture;
+    ImVec2 uv0, uv1;
+  };
+
+ private:
+  static constexpr int kAtlasColumns = 16;
+
+  // A trajectory's path, in tile pixels.
+  using Path = std::vector<ImVec2>;
+
+  struct TrajectoryResult {
+    std::shared_ptr<const Path> path;
+    SoftwareCanvas tile;
+  };
+
+  struct TrajectoryEntry {
+    // Incremented whenever the trajectory changes.
+    uint64_t generation = 0;
+    std::optional<uint64_t> drawnGeneration;
+
+    size_t tileIndex = 0;
+    std::shared_ptr<const Path> path;
+
+    std::future<TrajectoryResult> pendingResult;
+    uint64_t pendingGeneration = 0;
+  };
+
+  struct AutoModeEntry {
+    // Incremented whenever the auto mode or a trajectory it uses changes.
+    uint64_t generation = 0;
+    std::optional<uint64_t> drawnGeneration;
+
+    size_t tileIndex = 0;
+
+    // The trajectories of the auto mode's trajectory steps, and whether the editor displays each one, in the
+    // order the editor draws them. Found again whenever the generation changes.
+    std::vector<std::pair<std::string, bool>> trajectorySteps;
+    std::optional<uint64_t> trajectoryStepsGeneration;
+
+    std::future<SoftwareCanvas> pendingTile;
+    uint64_t pendingGeneration = 0;
+  };
+
+  std::unordered_map<std::string, TrajectoryEntry> m_trajectories;
+  std::unordered_map<std::string, AutoModeEntry> m_autoModes;
+
+  Measurement2d m_fieldSize;
+
+  size_t m_numTiles = 0;
+  std::vector<size_t> m_freeTiles;
+
+  SoftwareCanvas m_atlas;
+  bool m_isAtlasChanged = false;
+
+  std::unique_ptr<Texture> m_texture;
+
+ public:
+  void invalidateTrajectory(const std::string& trajectoryName) noexcept;
+  void invalidateAutoMode(const std::string& autoModeName) noexcept;
+  void invalidateAll() noexcept;
+
+  void clear() noexcept;
+
+  /**
+   * Collects finished thumbnails, starts drawing the ones that changed, and uploads the texture if any
+   * thumbnails finished. Should be called once per frame while thumbnails are shown.
+   *
+   * @param state The current project state
+   * @param previewTrajectories The previews of the state's trajectories, already updated this frame
+   * @param fieldSize The size of the field, which the thumbnails are scaled to fit
+   */
+  void update(const ThunderAutoProjectState& state,
+              PreviewTrajectoryCache& previewTrajectories,
+              Measurement2d fieldSize);
+
+  /**
+   * The thumbnail of a trajectory, or std::nullopt if it hasn't been drawn yet.
+   */
+  std::optional<Tile> trajectoryTile(const std::string& trajectoryName) const noexcept;
+
+  /**
+   * The thumbnail of an auto mode, or std::nullopt if it hasn't been drawn yet.
+   */
+  std::optional<Tile> autoModeTile(const std::string& autoModeName) const noexcept;
+
+  /**
+   * Draws a thumbnail at the right end of a row of a list, as tall as the row.
+   */
+  static void DrawTileInRow(ImDrawList* drawList, const Tile& tile, ImVec2 rowMin, ImVec2 rowMax);
+
+ private:
+  void updateTrajectories(const ThunderAutoProjectState& state, PreviewTrajectoryCache& previewTrajectories);
+  void updateAutoModes(const ThunderAutoProjectState& state);
+
+  // Called when a trajectory's path changes or the trajectory is removed.
+  void invalidateAutoModesUsing(const std::string& trajectoryName) noexcept;
+
+  size_t allocateTile();
+  void freeTile(size_t tileIndex) noexcept;
+  void setTile(size_t tileIndex, const SoftwareCanvas& tile);
+
+  void uploadAtlas();
+
+  std::optional<Tile> tile(size_t tileIndex) const noexcept;
+
+  static TrajectoryResult DrawTrajectory(const ThunderAutoOutputTrajectory& trajectory,
+                                         Measurement2d fieldSize);
+
+  static SoftwareCanvas DrawAutoMode(
+      const std::vector<std::pair<std::shared_ptr<const Path>, bool>>& trajectorySteps);
+};
@@ -29,6 +29,22 @@ enum UISize {
   UISIZE_PROJECT_SETTINGS_PAGE_START_HEIGHT,
   UISIZE_REMOTE_UPDATE_PAGE_START_WIDTH,
   UISIZE_REMOTE_UPDATE_PAGE_START_HEIGHT,
+  UISIZE_HISTORY_PAGE_START_WIDTH,
+  UISIZE_HISTORY_PAGE_START_HEIGHT,
+  UISIZE_AUTO_MODE_ANALYSIS_PAGE_START_WIDTH,
+  UISIZE_AUTO_MODE_ANALYSIS_PAGE_START_HEIGHT,
+  UISIZE_TELEMETRY_PAGE_START_WIDTH,
+  UISIZE_TELEMETRY_PAGE_START_HEIGHT,
+  UISIZE_TELEMETRY_PAGE_AXIS_COMBO_WIDTH,
+  UISIZE_TELEMETRY_PAGE_PLOT_PADDING,
+  UISIZE_ROBOT_LOG_REPLAY_PAGE_START_WIDTH,
+  UISIZE_ROBOT_LOG_REPLAY_PAGE_START_HEIGHT,
+  UISIZE_SPEED_CONSTRAINT_TUNER_PAGE_START_WIDTH,
+  UISIZE_SPEED_CONSTRAINT_TUNER_PAGE_START_HEIGHT,
+  UISIZE_WAYPOINT_OPTIMIZER_PAGE_START_WIDTH,
+  UISIZE_WAYPOINT_OPTIMIZER_PAGE_START_HEIGHT,
+  UISIZE_IMAGE_EXPORT_PAGE_START_WIDTH,
+  UISIZE_IMAGE_EXPORT_PAGE_START_HEIGHT,
   UISIZE_WELCOME_POPUP_WIDTH,
   UISIZE_WELCOME_POPUP_HEIGHT,
   UISIZE_WELCOME_POPUP_RECENT_PROJECT_COLUMN_WIDTH,
@@ -41,8 +57,10 @@ enum UISize {
   UISIZE_UNSAVED_POPUP_START_HEIGHT,
   UISIZE_PROJECT_VERSION_POPUP_START_WIDTH,
   UISIZE_PROJECT_VERSION_POPUP_START_HEIGHT,
+  UISIZE_RECOVERED_EDITS_POPUP_START_WIDTH,
   UISIZE_PROJECT_OPEN_ERROR_POPUP_START_WIDTH,
   UISIZE_PROJECT_OPEN_ERROR_POPUP_START_HEIGHT,
+  UISIZE_PROJECT_LOADING_POPUP_START_WIDTH,
   UISIZE_PROJECT_SAVE_ERROR_POPUP_START_WIDTH,
   UISIZE_PROJECT_SAVE_ERROR_POPUP_START_HEIGHT,
   UISIZE_CSV_EXPORT_POPUP_START_WIDTH,
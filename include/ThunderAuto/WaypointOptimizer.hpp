@@ -0,0 +1,183 @@
+#pragma once
+
+#include <ThunderAuto/CollisionChecker.hpp>
+#include <ThunderAuto/KeepOutZones.hpp>
+#include <ThunderAuto/Shapes.hpp>
+#include <ThunderLibCore/Auto/ThunderAutoProject.hpp>
+#include <ThunderLibCore/Types.hpp>
+#include <units/angle.h>
+#include <units/length.h>
+#include <units/time.h>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace thunder::core;
+
+enum class WaypointOptimizerObjective {
+  TIME = 0,
+  PEAK_CURVATURE,
+};
+
+const char* WaypointOptimizerObjectiveToString(WaypointOptimizerObjective objective) noexcept;
+
+/**
+ * How far the optimizer may move things away from where the user put them.
+ */
+struct WaypointOptimizerSettings {
+  WaypointOptimizerObjective objective = WaypointOptimizerObjective::TIME;
+
+  units::meter_t maxPositionChange = units::meter_t(0.5);
+  units::degree_t maxHeadingChange = units::degree_t(30.0);
+
+  // Heading weights are scaled by between 1/maxWeightScale and maxWeightScale.
+  double maxWeightScale = 2.0;
+
+  bool movePositions = true;
+  bool changeHeadings = true;
+  bool changeWeights = true;
+
+  units::second_t timeBudget = units::second_t(5.0);
+};
+
+/**
+ * Where the robot is allowed to go. Doesn't change once made, so it can be shared with background threads.
+ */
+struct WaypointOptimizerBounds {
+  Measurement2d fieldSize;
+
+  PolygonSoA footprint;
+
+  // Null if there are no keep-out zones.
+  std::shared_ptr<const KeepOutGeometry> keepOutGeometry;
+
+  static std::shared_ptr<const WaypointOptimizerBounds> Make(const ThunderAutoProjectSettings& settings,
+                                                             const KeepOutZoneList& keepOutZones);
+};
+
+/**
+ * Searches for waypoint positions, headings, and heading weights that make a trajectory faster (or less
+ * curvy) while keeping the robot inside the field and out of every keep-out zone.
+ *
+ * Waypoints locked in the editor are left alone, as are the positions of the start and end waypoints and of
+ * linked waypoints, since other trajectories and auto modes depend on them.
+ *
+ * Runs in the background until the time budget runs out. Each round builds a batch of candidates in parallel
+ * on the thread pool, sampled around the best candidates found so far. The search area shrinks whenever a
+ * round doesn't improve on them, and starts over wide once it gets too small to make a difference.
+ */
+class WaypointOptimizer final {
+ public:
+  // The changes to one waypoint.
+  struct WaypointChange {
+    size_t waypointIndex;
+
+    Point2d position;
+    ThunderAutoTrajectorySkeletonWaypoint::HeadingAngles headings;
+    ThunderAutoTrajectorySkeletonWaypoint::HeadingWeights headingWeights;
+  };
+
+  struct Score {
+    units::second_t totalTime = units::second_t(0.0);
+    double peakCurvature = 0.0;  // 1/m
+
+    // Whether the robot stays inside the field and out of every keep-out zone.
+    bool isWithinBounds = false;
+  };
+
+  struct Result {
+    Score originalScore;
+    Score bestScore;
+
+    // Empty if nothing better than the original was found.
+    std::vector<WaypointChange> changes;
+
+    // The path of the best trajectory, for previewing.
+    std::vector<Point2d> bestPath;
+
+    size_t numRounds = 0;
+    size_t numEvaluated = 0;
+    size_t numOutOfBounds = 0;
+
+    bool cancelled = false;
+    std::string error;  // Empty if successful.
+  };
+
+ private:
+  struct SharedState {
+    std::atomic<bool> cancelled = false;
+    std::atomic<size_t> numEvaluated = 0;
+
+    // The path of the best candidate so far, so that it can be previewed while the search goes on.
+    std::mutex bestPathMutex;
+    std::vector<Point2d> bestPath;
+    size_t bestPathGeneration = 0;
+  };
+
+  std::shared_ptr<SharedState> m_sharedState;
+
+  std::chrono::steady_clock::time_point m_startTime;
+  units::second_t m_timeBudget;
+
+  std::future<Result> m_future;
+
+ public:
+  /**
+   * Starts optimizing a trajectory in the background.
+   */
+  WaypointOptimizer(ThunderAutoTrajectorySkeleton skeleton,
+                    WaypointOptimizerSettings settings,
+                    std::shared_ptr<const WaypointOptimizerBounds> bounds);
+
+  // Cancels optimizing and waits for it to stop.
+  ~WaypointOptimizer() { cancel(); }
+
+  WaypointOptimizer(const WaypointOptimizer&) = delete;
+  WaypointOptimizer& operator=(const WaypointOptimizer&) = delete;
+
+  /**
+   * Returns how much of the time budget has been used, from 0 to 1.
+   */
+  float progress() const noexcept;
+
+  size_t numEvaluated() const noexcept { return m_sharedState->numEvaluated; }
+
+  /**
+   * Copies the path of the best candidate found so far if it changed since the given generation.
+   *
+   * @return Whether the path was copied.
+   */
+  bool bestPathSoFar(size_t& generation, std::vector<Point2d>& path) const;
+
+  void cancel() noexcept { m_sharedState->cancelled = true; }
+
+  /**
+   * Returns whether optimizing has finished (successfully or not). Does not block.
+   */
+  bool isFinished() const;
+
+  /**
+   * Takes the result of optimizing. Blocks until optimizing is finished, and can only be called once.
+   */
+  Result takeResult();
+
+  /**
+   * Applies changes found by the optimizer to a trajectory. The trajectory must have the same number of
+   * waypoints as the one that was optimized.
+   */
+  static void ApplyChanges(ThunderAutoTrajectorySkeleton& skeleton,
+                           const std::vector<WaypointChange>& changes);
+
+ private:
+  static Result Run(ThunderAutoTrajectorySkeleton skeleton,
+                    WaypointOptimizerSettings settings,
+                    std::shared_ptr<const WaypointOptimizerBounds> bounds,
+                    std::chrono::steady_clock::time_point deadline,
+                    std::shared_ptr<SharedState> sharedState);
+};
@@ -0,0 +1,341 @@
+#include <ThunderAuto/ActionGraph.hpp>
+
+#include <algorithm>
+#include <utility>
+
+static bool IsActionGroup(ThunderAutoActionType type) noexcept {
+  return type == ThunderAutoActionType::SEQUENTIAL_ACTION_GROUP ||
+         type == ThunderAutoActionType::CONCURRENT_ACTION_GROUP;
+}
+
+void ActionGraph::rebuild(const ThunderAutoProjectState& state) {
+  clear();
+
+  for (const auto& [actionName, action] : state.actions) {
+    addNode(actionName, action, 0);
+  }
+
+  // Orders every action with a depth-first search, since adding the edges one at a time could end up moving
+  // the same actions around over and over.
+  enum class Mark { NONE, VISITING, VISITED };
+  std::unordered_map<std::string, Mark> marks;
+  std::vector<const std::string*> postOrder;
+  postOrder.reserve(m_nodes.size());
+
+  auto visit = [&](auto& self, const std::string& actionName) -> void {
+    Mark& mark = marks[actionName];
+    if (mark == Mark::VISITED)
+      return;
+
+    if (mark == Mark::VISITING) {
+      m_hasCycle = true;
+      return;
+    }
+
+    mark = Mark::VISITING;
+
+    for (const std::string& child : m_nodes.at(actionName).children) {
+      if (m_nodes.contains(child)) {
+        self(self, child);
+      }
+    }
+
+    marks[actionName] = Mark::VISITED;
+    postOrder.push_back(&actionName);
+  };
+
+  for (const auto& [actionName, node] : m_nodes) {
+    visit(visit, actionName);
+  }
+
+  for (auto it = postOrder.rbegin(); it != postOrder.rend(); ++it) {
+    m_nodes.at(**it).order = m_nextOrder++;
+  }
+}
+
+void ActionGraph::update(const ThunderAutoProjectState& state, const StateChangeSet& changes) {
+  if (changes.everything || m_hasCycle) {
+    rebuild(state);
+    return;
+  }
+
+  if (changes.actions.empty())
+    return;
+
+  // Actions that are still around keep their place in the order, so that only new edges move anything.
+  std::unordered_map<std::string, size_t> previousOrders;
+  for (const std::string& actionName : changes.actions) {
+    invalidateLeafActions(actionName);
+
+    auto nodeIt = m_nodes.find(actionName);
+    if (nodeIt != m_nodes.end()) {
+      previousOrders.emplace(actionName, nodeIt->second.order);
+    }
+    removeNode(actionName);
+  }
+
+  std::vector<const std::string*> addedActionNames;
+  for (const std::string& actionName : changes.actions) {
+    auto actionIt = state.actions.find(actionName);
+    if (actionIt == state.actions.end())
+      continue;
+
+    auto previousOrderIt = previousOrders.find(actionName);
+    const size_t order = previousOrderIt != previousOrders.end() ? previousOrderIt->second : m_nextOrder++;
+
+    addNode(actionName, actionIt->second, order);
+    addedActionNames.push_back(&actionName);
+  }
+
+  for (const std::string* actionName : addedActionNames) {
+    for (const std::string& child : m_nodes.at(*actionName).children) {
+      if (m_nodes.contains(child) && !insertEdge(*actionName, child)) {
+        m_hasCycle = true;
+      }
+    }
+
+    auto parentsIt = m_parents.find(*actionName);
+    if (parentsIt != m_parents.end()) {
+      for (const std::string& parent : parentsIt->second) {
+        if (m_nodes.contains(parent) && !insertEdge(parent, *actionName)) {
+          m_hasCycle = true;
+        }
+      }
+    }
+
+    // May be in new groups now.
+    invalidateLeafActions(*actionName);
+  }
+}
+
+void ActionGraph::clear() noexcept {
+  m_nodes.clear();
+  m_parents.clear();
+  m_nextOrder = 0;
+  m_hasCycle = false;
+  m_leafActions.clear();
+}
+
+std::list<std::string> ActionGraph::findRecursionPathIfAdded(const ThunderAutoProjectState& state,
+                                                             const std::string& groupActionName,
+                                                             const std::string& addedActionName) const {
+  if (groupActionName == addedActionName)
+    return {addedActionName, addedActionName};
+
+  auto groupIt = m_nodes.find(groupActionName);
+  auto addedIt = m_nodes.find(addedActionName);
+  if (m_hasCycle || groupIt == m_nodes.end() || addedIt == m_nodes.end()) {
+    return state.findActionRecursionPath(addedActionName);
+  }
+
+  // The group can only be reached from the added action if it comes after it in the order.
+  const size_t groupOrder = groupIt->second.order;
+  if (addedIt->second.order > groupOrder)
+    return {};
+
+  // Action name -> the action it was reached from.
+  std::unordered_map<std::string, const std::string*> reachedFrom;
+  reachedFrom.emplace(addedActionName, nullptr);
+
+  std::vector<const std::string*> stack{&addedIt->first};
+  bool foundGroup = false;
+  while (!stack.empty() && !foundGroup) {
+    const std::string* actionName = stack.back();
+    stack.pop_back();
+
+    for (const std::string& child : m_nodes.at(*actionName).children) {
+      auto childIt = m_nodes.find(child);
+      if (childIt == m_nodes.end() || childIt->second.order > groupOrder)
+        continue;
+
+      if (!reachedFrom.emplace(child, actionName).second)
+        continue;
+
+      if (child == groupActionName) {
+        foundGroup = true;
+        break;
+      }
+
+      stack.push_back(&childIt->first);
+    }
+  }
+
+  if (!foundGroup)
+    return {};
+
+  std::list<std::string> path{addedActionName};
+  for (const std::string* actionName = &groupIt->first; actionName;
+       actionName = reachedFrom.at(*actionName)) {
+    path.push_front(*actionName);
+  }
+  return path;
+}
+
+std::span<const std::string> ActionGraph::leafActions(const std::string& actionName) const {
+  auto cachedIt = m_leafActions.find(actionName);
+  if (cachedIt != m_leafActions.end())
+    return cachedIt->second;
+
+  auto nodeIt = m_nodes.find(actionName);
+  if (nodeIt == m_nodes.end())
+    return {};
+
+  const Node& node = nodeIt->second;
+  if (!IsActionGroup(node.type)) {
+    return m_leafActions.emplace(actionName, std::vector<std::string>{actionName}).first->second;
+  }
+
+  // Left empty while expanding the group, so that a cycle doesn't expand forever.
+  m_leafActions.emplace(actionName, std::vector<std::string>{});
+
+  std::vector<std::string> leaves;
+  std::unordered_set<std::string> seenLeaves;
+  for (const std::string& child : node.children) {
+    for (const std::string& leaf : leafActions(child)) {
+      if (seenLeaves.insert(leaf).second) {
+        leaves.push_back(leaf);
+      }
+    }
+  }
+
+  std::vector<std::string>& cachedLeaves = m_leafActions.at(actionName);
+  cachedLeaves = std::move(leaves);
+  return cachedLeaves;
+}
+
+void ActionGraph::addNode(const std::string& actionName, const ThunderAutoAction& action, size_t order) {
+  Node node;
+  node.type = action.type();
+  node.order = order;
+
+  if (IsActionGroup(node.type)) {
+    node.children = action.actionGroup();
+    for (const std::string& child : node.children) {
+      m_parents[child].insert(actionName);
+    }
+  }
+
+  m_nodes[actionName] = std::move(node);
+}
+
+void ActionGraph::removeNode(const std::string& actionName) {
+  auto nodeIt = m_nodes.find(actionName);
+  if (nodeIt == m_nodes.end())
+    return;
+
+  for (const std::string& child : nodeIt->second.children) {
+    auto parentsIt = m_parents.find(child);
+    if (parentsIt == m_parents.end())
+      continue;
+
+    parentsIt->second.erase(actionName);
+    if (parentsIt->second.empty()) {
+      m_parents.erase(parentsIt);
+    }
+  }
+
+  m_nodes.erase(nodeIt);
+}
+
+bool ActionGraph::insertEdge(const std::string& groupActionName, const std::string& actionName) {
+  if (groupActionName == actionName)
+    return false;
+
+  const size_t upperBound = m_nodes.at(groupActionName).order;
+  const size_t lowerBound = m_nodes.at(actionName).order;
+  if (upperBound < lowerBound)
+    return true;
+
+  // Everything reachable from the action that comes before the group in the order. Reaching the group
+  // itself means there's a cycle.
+  std::vector<const std::string*> forward;
+  std::unordered_set<std::string> seen{actionName};
+  std::vector<const std::string*> stack{&m_nodes.find(actionName)->first};
+  while (!stack.empty()) {
+    const std::string* current = stack.back();
+    stack.pop_back();
+    forward.push_back(current);
+
+    for (const std::string& child : m_nodes.at(*current).children) {
+      if (child == groupActionName)
+        return false;
+
+      auto childIt = m_nodes.find(child);
+      if (childIt == m_nodes.end() || childIt->second.order > upperBound || !seen.insert(child).second)
+        continue;
+
+      stack.push_back(&childIt->first);
+    }
+  }
+
+  // Everything that reaches the group that comes after the action in the order.
+  std::vector<const std::string*> backward;
+  stack.push_back(&m_nodes.find(groupActionName)->first);
+  seen.insert(groupActionName);
+  while (!stack.empty()) {
+    const std::string* current = stack.back();
+    stack.pop_back();
+    backward.push_back(current);
+
+    auto parentsIt = m_parents.find(*current);
+    if (parentsIt == m_parents.end())
+      continue;
+
+    for (const std::string& parent : parentsIt->second) {
+      auto parentIt = m_nodes.find(parent);
+      if (parentIt == m_nodes.end() || parentIt->second.order < lowerBound || !seen.insert(parent).second)
+        continue;
+
+      stack.push_back(&parentIt->first);
+    }
+  }
+
+  // Reuse the same positions in the order, with everything reaching the group placed before everything
+  // reachable from the action.
+  auto byOrder = [this](const std::string* a, const std::string* b) {
+    return m_nodes.at(*a).order < m_nodes.at(*b).order;
+  };
+  std::sort(forward.begin(), forward.end(), byOrder);
+  std::sort(backward.begin(), backward.end(), byOrder);
+
+  std::vector<size_t> orders;
+  orders.reserve(forward.size() + backward.size());
+  for (const std::string* name : backward) {
+    orders.push_back(m_nodes.at(*name).order);
+  }
+  for (const std::string* name : forward) {
+    orders.push_back(m_nodes.at(*name).order);
+  }
+  std::sort(orders.begin(), orders.end());
+
+  size_t i = 0;
+  for (const std::string* name : backward) {
+    m_nodes.at(*name).order = orders[i++];
+  }
+  for (const std::string* name : forward) {
+    m_nodes.at(*name).order = orders[i++];
+  }
+
+  return true;
+}
+
+void ActionGraph::invalidateLeafActions(const std::string& actionName) {
+  std::unordered_set<std::string> visited{actionName};
+  std::vector<std::string> stack{actionName};
+  while (!stack.empty()) {
+    std::string current = std::move(stack.back());
+    stack.pop_back();
+
+    m_leafActions.erase(current);
+
+    auto parentsIt = m_parents.find(current);
+    if (parentsIt == m_parents.end())
+      continue;
+
+    for (const std::string& parent : parentsIt->second) {
+      if (visited.insert(parent).second) {
+        stack.push_back(parent);
+      }
+    }
+  }
+}
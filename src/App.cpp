@@ -56,6 +56,8 @@ void App::focusWasChanged(bool focused) {
 }
 
 void App::present() {
+  reapCancelledProjectLoads();
+
   presentMenuBar();
 
 #ifdef THUNDERAUTO_DEBUG
@@ -92,7 +94,9 @@ void App::present() {
       if (settings.autoCSVExport) {
         csvExportAllTrajectories();
       }
+
       m_documentManager.close();
+      m_editorPage.clearProjectCaches();
       updateTitlebarTitle();
       m_eventState = WELCOME;
       break;
@@ -102,6 +106,18 @@ void App::present() {
     case OPEN_PROJECT_ERROR:
       presentOpenProjectErrorPopup();
       break;
+    case LOADING_PROJECT:
+      // Keep showing the current project (if any) until the new one is ready to be swapped in. It's
+      // read-only, since the unsaved changes prompt has already been answered and it'll be closed without
+      // asking again.
+      if (m_documentManager.isOpen()) {
+        auto scopedDisabled = ImGui::Scoped::Disabled(true);
+        m_editorPage.setReadOnly(true);
+        presentProjectPages();
+        m_editorPage.setReadOnly(false);
+      }
+      presentProjectLoadingPopup();
+      break;
     default:
       break;
   }
@@ -122,12 +138,16 @@ void App::present() {
 
 void App::close() {
   if (tryChangeState(EventState::CLOSE_EVERYTHING)) {
+    cancelProjectLoad();
+
     const ThunderAutoProjectSettings& settings = m_documentManager.settings();
     if (settings.autoCSVExport) {
       csvExportAllTrajectories();
     }
 
     m_documentManager.close();
+
+    waitForCancelledProjectLoads();
   }
 }
 
@@ -136,7 +156,15 @@ void App::dataClear() {
 }
 
 bool App::dataShouldOpen(const char* name) {
-  return strcmp(name, "RecentProjects") == 0;
+  if (strcmp(name, "RecentProjects") == 0) {
+    m_dataSection = DataSection::RECENT_PROJECTS;
+    return true;
+  }
+  if (strcmp(name, "Preferences") == 0) {
+    m_dataSection = DataSection::PREFERENCES;
+    return true;
+  }
+  return false;
 }
 
 void App::dataReadLine(const char* line) {
@@ -145,6 +173,20 @@ void App::dataReadLine(const char* line) {
     return;
   }
 
+  switch (m_dataSection) {
+    using enum DataSection;
+    case RECENT_PROJECTS:
+      dataReadRecentProjectLine(line);
+      break;
+    case PREFERENCES:
+      dataReadPreferenceLine(line);
+      break;
+    default:
+      ThunderAutoUnreachable("Unknown app data section");
+  }
+}
+
+void App::dataReadRecentProjectLine(const char* line) {
   // Recent files should be stored oldest to newest, so just add them normally.
 
   std::filesystem::path path(line);
@@ -160,6 +202,16 @@ void App::dataReadLine(const char* line) {
   m_recentProjects.add(path);
 }
 
+void App::dataReadPreferenceLine(const char* line) {
+  unsigned long long value = 0;
+
+  if (sscanf(line, "UndoHistoryMemoryBudget=%llu", &value) == 1) {
+    m_documentManager.history().setMemoryBudget(static_cast<size_t>(value));
+  } else {
+    ThunderAutoLogger::Warn("Unknown preference '{}' in app save ini file, ignoring", line);
+  }
+}
+
 void App::dataApply() {}
 
 void App::dataWrite(const char* typeName, ImGuiTextBuffer* buf) {
@@ -174,6 +226,10 @@ void App::dataWrite(const char* typeName, ImGuiTextBuffer* buf) {
     // Write the path to the buffer
     buf->appendf("%s\n", projectPath.string().c_str());
   }
+
+  buf->appendf("\n[%s][%s]\n", typeName, "Preferences");
+  buf->appendf("UndoHistoryMemoryBudget=%llu\n",
+               static_cast<unsigned long long>(m_documentManager.history().memoryBudget()));
 }
 
 void App::presentProjectPages() {
@@ -227,6 +283,10 @@ void App::presentProjectPages() {
       m_projectEvent = ProjectEvent::LINK_TRAJECTORY_END_BEHAVIOR;
       m_linkTrajectoryEndBehaviorPopup.setupForCurrentTrajectory(false);
       break;
+    case TRAJECTORY_SPEED_CONSTRAINT_TUNER:
+      m_showSpeedConstraintTuner = true;
+      ImGui::SetWindowFocus(m_speedConstraintTunerPage.name());
+      break;
     default:
       ThunderAutoUnreachable("Unknown properties page event");
   }
@@ -284,6 +344,34 @@ void App::presentProjectPages() {
   if (m_showRemoteUpdate) {
     m_remoteUpdatePage.present(&m_showRemoteUpdate);
   }
+
+  if (m_showHistory) {
+    m_historyPage.present(&m_showHistory);
+  }
+
+  if (m_showAutoModeAnalysis) {
+    m_autoModeAnalysisPage.present(&m_showAutoModeAnalysis);
+  }
+
+  if (m_showTelemetry) {
+    m_telemetryPage.present(&m_showTelemetry);
+  }
+
+  if (m_showRobotLogReplay) {
+    m_robotLogReplayPage.present(&m_showRobotLogReplay);
+  }
+
+  if (m_showSpeedConstraintTuner) {
+    m_speedConstraintTunerPage.present(&m_showSpeedConstraintTuner);
+  }
+
+  if (m_showWaypointOptimizer) {
+    m_waypointOptimizerPage.present(&m_showWaypointOptimizer);
+  }
+
+  if (m_showImageExport) {
+    m_imageExportPage.present(&m_showImageExport);
+  }
 }
 
 void App::presentProjectEventPopups() {
@@ -304,6 +392,9 @@ void App::presentProjectEventPopups() {
     case VERSION_DIFFERENT:
       presentProjectVersionDifferentPopup();
       break;
+    case RECOVERED_EDITS:
+      presentRecoveredEditsPopup();
+      break;
     case CSV_EXPORT:
       presentCSVExportedPopup();
       break;
@@ -532,9 +623,12 @@ void App::presentFileMenu() {
 
       ImGui::Separator();
 
-      if (ImGui::MenuItem(ICON_LC_FILE_SPREADSHEET "  Export All Trajectories to CSV")) {
+      if (ImGui::MenuItem(ICON_LC_FILE_SPREADSHEET "  Export All Trajectories")) {
         csvExportAllTrajectories();
       }
+      if (ImGui::MenuItem(ICON_LC_IMAGE "  Export Images...")) {
+        m_showImageExport = true;
+      }
 
       ImGui::Separator();
 
@@ -624,6 +718,13 @@ void App::presentViewMenu() {
       m_showActions = true;
       m_showProjectSettings = false;
       m_showRemoteUpdate = false;
+      m_showHistory = false;
+      m_showAutoModeAnalysis = false;
+      m_showTelemetry = false;
+      m_showRobotLogReplay = false;
+      m_showSpeedConstraintTuner = false;
+      m_showWaypointOptimizer = false;
+      m_showImageExport = false;
       // Reset editor view as well
       m_editorPage.resetView();
     }
@@ -645,7 +746,7 @@ void App::presentTrajectoryMenu() {
   }
 
   if (showMenu) {
-    ImGui::MenuItem(ICON_LC_FILE_SPREADSHEET "  Export to CSV", nullptr, &itemExport);
+    ImGui::MenuItem(ICON_LC_FILE_SPREADSHEET "  Export", nullptr, &itemExport);
     ImGui::MenuItem(ICON_LC_PENCIL "  Rename", nullptr, &itemRename);
     ImGui::MenuItem(ICON_LC_ARROW_RIGHT_LEFT "  Reverse Direction", nullptr, &itemReverse);
     ImGui::MenuItem(ICON_LC_COPY "  Duplicate", nullptr, &itemDuplicate);
@@ -736,12 +837,22 @@ void App::presentToolsMenu() {
     ImGui::MenuItem(ICON_LC_PAPERCLIP "  Actions", nullptr, &m_showActions);
     ImGui::MenuItem(ICON_LC_SETTINGS "  Project Settings", nullptr, &m_showProjectSettings);
     ImGui::MenuItem(ICON_LC_ROUTER "  Remote Update", nullptr, &m_showRemoteUpdate);
+    ImGui::MenuItem(ICON_LC_HISTORY "  History", nullptr, &m_showHistory);
+    ImGui::MenuItem(ICON_LC_LIST_ORDERED "  Auto Mode Analysis", nullptr, &m_showAutoModeAnalysis);
+    ImGui::MenuItem(ICON_LC_ACTIVITY "  Telemetry", nullptr, &m_showTelemetry);
+    ImGui::MenuItem(ICON_LC_CAR "  Robot Log Replay", nullptr, &m_showRobotLogReplay);
+    ImGui::MenuItem(ICON_LC_GAUGE "  Speed Constraint Tuner", nullptr, &m_showSpeedConstraintTuner);
+    ImGui::MenuItem(ICON_LC_WAND_SPARKLES "  Waypoint Optimizer", nullptr, &m_showWaypointOptimizer);
 
     ImGui::EndMenu();
   }
 }
 
 bool App::tryChangeState(EventState desiredState) {
+  if (m_eventState == EventState::LOADING_PROJECT && desiredState != EventState::CLOSE_EVERYTHING) {
+    return false;
+  }
+
   if (m_documentManager.isUnsaved()) {
     m_projectEvent = ProjectEvent::UNSAVED;
     m_nextEventState = desiredState;
@@ -790,7 +901,7 @@ void App::presentWelcomePopup() {
       auto recentPathIt = m_welcomePopup.recentProject();
       ThunderAutoAssert(recentPathIt != m_recentProjects.end());
       std::filesystem::path recentPath = *recentPathIt;
-      openFromPath(recentPath);
+      openFromPathAsync(recentPath);
       break;
     }
     default:
@@ -821,6 +932,7 @@ void App::presentNewProjectPopup() {
       m_documentManager.newProject(m_newProjectPopup.resultProject());
       const ThunderAutoProjectSettings& settings = m_documentManager.settings();
       m_editorPage.setupField(settings);
+      m_editorPage.setKeepOutZones(m_documentManager.keepOutZones());
       m_propertiesPage.setup(settings);
       updateTitlebarTitle();
       m_recentProjects.add(m_documentManager.path());
@@ -867,7 +979,7 @@ void App::openProject() {
     return;
   }
 
-  openFromPath(path);
+  openFromPathAsync(path);
 }
 
 void App::openFromPath(const std::filesystem::path& path) {
@@ -892,11 +1004,65 @@ void App::openFromPath(const std::filesystem::path& path) {
     return;
   }
 
+  finishOpeningProject(path, projectVersion);
+}
+
+void App::openFromPathAsync(const std::filesystem::path& path) {
+  ThunderAutoAssert(!m_projectLoadTask, "A project is already being loaded");
+
+  m_projectLoadTask = std::make_unique<ProjectLoadTask>(path);
+
+  m_projectLoadingPopup.setProjectName(path.stem().string());
+  m_projectLoadingPopup.setProgress("", 0.f);
+
+  m_eventState = EventState::LOADING_PROJECT;
+}
+
+void App::cancelProjectLoad() {
+  if (!m_projectLoadTask)
+    return;
+
+  m_projectLoadTask->cancel();
+  m_cancelledProjectLoadTasks.push_back(std::move(m_projectLoadTask));
+}
+
+void App::reapCancelledProjectLoads() {
+  std::erase_if(m_cancelledProjectLoadTasks,
+                [](const std::unique_ptr<ProjectLoadTask>& task) { return task->isFinished(); });
+}
+
+void App::waitForCancelledProjectLoads() {
+  if (m_cancelledProjectLoadTasks.empty())
+    return;
+
+  // The current stage of a cancelled load can't be interrupted, so wait for it here rather than in the
+  // destructor of whichever task happens to be destroyed last.
+  ThunderAutoLogger::Info("Waiting for {} cancelled project load(s) to finish",
+                          m_cancelledProjectLoadTasks.size());
+
+  for (std::unique_ptr<ProjectLoadTask>& task : m_cancelledProjectLoadTasks) {
+    task->takeResult();
+  }
+  m_cancelledProjectLoadTasks.clear();
+}
+
+void App::finishOpeningProject(const std::filesystem::path& path,
+                               ThunderAutoProjectVersion projectVersion,
+                               const TextureImage* fieldImage) {
   m_eventState = EventState::PROJECT;
 
   const ThunderAutoProjectSettings& settings = m_documentManager.settings();
-  m_editorPage.setupField(settings);
+  if (fieldImage) {
+    m_editorPage.setupField(settings, *fieldImage);
+  } else {
+    m_editorPage.setupField(settings);
+  }
+  m_editorPage.setKeepOutZones(m_documentManager.keepOutZones());
   m_propertiesPage.setup(settings);
+  m_autoModeAnalysisPage.reset();
+  m_speedConstraintTunerPage.reset();
+  m_waypointOptimizerPage.reset();
+  m_imageExportPage.reset();
 
   m_recentProjects.add(path);
 
@@ -904,11 +1070,78 @@ void App::openFromPath(const std::filesystem::path& path) {
       projectVersion.minor != THUNDERAUTO_PROJECT_VERSION_MINOR) {
     m_projectVersionPopup.setProjectVersion(projectVersion);
     m_projectEvent = ProjectEvent::VERSION_DIFFERENT;
+  } else if (m_documentManager.hasRecoveredEdits()) {
+    m_projectEvent = ProjectEvent::RECOVERED_EDITS;
   }
 
   updateTitlebarTitle();
 }
 
+void App::presentProjectLoadingPopup() {
+  ThunderAutoAssert(m_projectLoadTask != nullptr);
+
+  ProjectLoadTask::Stage stage = m_projectLoadTask->stage();
+  m_projectLoadingPopup.setProgress(ProjectLoadTask::StageToString(stage), m_projectLoadTask->progress());
+
+  ImGui::OpenPopup(m_projectLoadingPopup.name());
+
+  bool showingPopup = true;
+
+  m_projectLoadingPopup.present(&showingPopup);
+
+  if (!showingPopup) {
+    ProjectLoadingPopup::Result result = m_projectLoadingPopup.result();
+    ThunderAutoAssert(result == ProjectLoadingPopup::Result::CANCEL, "Unknown project loading popup result");
+
+    cancelProjectLoad();
+    m_eventState = m_documentManager.isOpen() ? EventState::PROJECT : EventState::WELCOME;
+    return;
+  }
+
+  if (!m_projectLoadTask->isFinished())
+    return;
+
+  const std::filesystem::path path = m_projectLoadTask->path();
+  ProjectLoadTask::Result result = m_projectLoadTask->takeResult();
+  m_projectLoadTask.reset();
+
+  m_eventState = EventState::NONE;
+
+  if (result.cancelled) {
+    m_eventState = m_documentManager.isOpen() ? EventState::PROJECT : EventState::WELCOME;
+    return;
+  }
+
+  m_recentProjects.remove(path);
+
+  std::string projectOpenError = std::move(result.error);
+
+  // Only swap in the loaded project once it has been fully loaded.
+  if (projectOpenError.empty()) {
+    try {
+      ThunderAutoProjectVersion projectVersion = m_documentManager.openProject(std::move(result.loadedProject));
+      finishOpeningProject(path, projectVersion, result.fieldImage ? &result.fieldImage.value() : nullptr);
+      m_editorPage.setCachedTrajectory(std::move(result.firstTrajectory));
+    } catch (const ThunderError& e) {
+      projectOpenError = e.message();
+    } catch (const std::exception& e) {
+      projectOpenError = e.what();
+    } catch (...) {
+      projectOpenError = "Unknown error ocurred";
+    }
+
+    if (!projectOpenError.empty()) {
+      m_documentManager.close();
+      updateTitlebarTitle();
+    }
+  }
+
+  if (!projectOpenError.empty()) {
+    m_openProjectErrorPopup.setError(projectOpenError);
+    m_eventState = EventState::OPEN_PROJECT_ERROR;
+  }
+}
+
 void App::presentUnsavedPopup() {
   ImGui::OpenPopup(m_unsavedPopup.name());
 
@@ -988,9 +1221,13 @@ void App::presentProjectVersionDifferentPopup() {
     using enum ProjectVersionPopup::Result;
     case OK:
       // Proceed normally.
+      if (m_documentManager.hasRecoveredEdits()) {
+        m_projectEvent = ProjectEvent::RECOVERED_EDITS;
+      }
       break;
     case CANCEL:
-      m_documentManager.close();
+      // Keep the journal around, since the project was never really opened.
+      m_documentManager.close(false);
       m_eventState = EventState::NONE;
       break;
     default:
@@ -998,6 +1235,34 @@ void App::presentProjectVersionDifferentPopup() {
   }
 }
 
+void App::presentRecoveredEditsPopup() {
+  ImGui::OpenPopup(m_recoveredEditsPopup.name());
+
+  bool showingPopup = true;
+
+  m_recoveredEditsPopup.present(&showingPopup);
+
+  if (showingPopup)
+    return;
+
+  RecoveredEditsPopup::Result result = m_recoveredEditsPopup.result();
+
+  m_projectEvent = ProjectEvent::NONE;
+
+  switch (result) {
+    using enum RecoveredEditsPopup::Result;
+    case KEEP:
+      m_documentManager.keepRecoveredEdits();
+      break;
+    case DISCARD:
+      m_documentManager.discardRecoveredEdits();
+      m_editorPage.invalidateCachedTrajectories();
+      break;
+    default:
+      ThunderAutoUnreachable("Unknown recovered edits popup result");
+  }
+}
+
 void App::presentCSVExportedPopup() {
   ImGui::OpenPopup(m_csvExportPopup.name());
 
@@ -1220,15 +1485,15 @@ void App::csvExportAllTrajectories() {
   const ThunderAutoProjectSettings& projectSettings = m_documentManager.settings();
 
   std::filesystem::path exportDir = m_documentManager.settings().directory;
+  const TrajectoryExportFormat exportFormat = m_documentManager.trajectoryExportFormat();
 
   std::string csvExportStatus;
   for (const auto& [name, skeleton] : projectState.trajectories) {
-    std::filesystem::path exportPath = exportDir / (name + ".csv");
+    std::filesystem::path exportPath = exportDir / (name + TrajectoryExportFormatFileExtension(exportFormat));
 
     try {
-      BuildAndCSVExportThunderAutoOutputTrajectory(skeleton, kHighResOutputTrajectorySettings,
-                                                   projectState.actionsOrder, exportPath,
-                                                   projectSettings.csvExportProps);
+      BuildAndExportThunderAutoOutputTrajectory(skeleton, projectState.actionsOrder, exportPath,
+                                                projectSettings.csvExportProps, exportFormat);
 
     } catch (const ThunderError& e) {
       csvExportStatus = fmt::format("Failed to export trajectory '{}' to '{}': {}", exportPath.string(),
@@ -1274,13 +1539,14 @@ void App::csvExportCurrentTrajectory() {
   const ThunderAutoTrajectorySkeleton& trajectory = projectState.trajectories.at(trajectoryName);
 
   std::filesystem::path exportDir = m_documentManager.settings().directory;
-  std::filesystem::path exportPath = exportDir / (trajectoryName + ".csv");
+  const TrajectoryExportFormat exportFormat = m_documentManager.trajectoryExportFormat();
+  std::filesystem::path exportPath =
+      exportDir / (trajectoryName + TrajectoryExportFormatFileExtension(exportFormat));
 
   std::string csvExportStatus;
   try {
-    BuildAndCSVExportThunderAutoOutputTrajectory(trajectory, kHighResOutputTrajectorySettings,
-                                                 projectState.actionsOrder, exportPath,
-                                                 projectSettings.csvExportProps);
+    BuildAndExportThunderAutoOutputTrajectory(trajectory, projectState.actionsOrder, exportPath,
+                                              projectSettings.csvExportProps, exportFormat);
 
   } catch (const ThunderError& e) {
     csvExportStatus = fmt::format("Failed to export trajectory '{}' to '{}': {}", exportPath.string(),
@@ -0,0 +1,272 @@
+#include <ThunderAuto/AutoModeAnalysis.hpp>
+
+#include <ThunderAuto/AutoModeStepIndex.hpp>
+#include <ThunderAuto/ThreadPool.hpp>
+#include <ThunderAuto/Logger.hpp>
+#include <ThunderAuto/Error.hpp>
+#include <ThunderLibCore/Auto/ThunderAutoOutputTrajectory.hpp>
+#include <chrono>
+#include <iterator>
+#include <map>
+#include <set>
+#include <span>
+
+namespace {
+
+struct TrajectorySummary {
+  units::second_t totalTime = units::second_t(0.0);
+  Point2d endPosition;
+  CanonicalAngle endRotation;
+};
+
+using TrajectorySummaries = std::map<std::string, TrajectorySummary>;
+
+/**
+ * Enumerates the branch combinations of one auto mode.
+ *
+ * The auto mode's steps are walked depth first. Whatever has run so far (the time, the last trajectory, and
+ * the branches taken) is carried down into each branch, so shared prefixes are only walked once.
+ */
+class CombinationEnumerator {
+  const std::string& m_autoModeName;
+  const AutoModeStepIndex& m_stepIndex;
+  const TrajectorySummaries& m_trajectories;
+  const std::atomic<bool>& m_cancelled;
+
+  std::vector<AutoModeAnalysis::Combination> m_combinations;
+  bool m_truncated = false;
+
+  // A range of entries in the step index being run, and where in it the run is.
+  struct Frame {
+    size_t entryIndex;
+    size_t end;
+  };
+
+  struct Progress {
+    units::second_t time = units::second_t(0.0);
+    const TrajectorySummary* lastTrajectory = nullptr;
+    std::string branches;
+  };
+
+ public:
+  CombinationEnumerator(const std::string& autoModeName,
+                        const AutoModeStepIndex& stepIndex,
+                        const TrajectorySummaries& trajectories,
+                        const std::atomic<bool>& cancelled)
+      : m_autoModeName(autoModeName),
+        m_stepIndex(stepIndex),
+        m_trajectories(trajectories),
+        m_cancelled(cancelled) {}
+
+  void enumerate() { run({Frame{0, m_stepIndex.entries().size()}}, Progress{}); }
+
+  std::vector<AutoModeAnalysis::Combination>& combinations() noexcept { return m_combinations; }
+  bool truncated() const noexcept { return m_truncated; }
+
+ private:
+  bool shouldStop() const noexcept { return m_truncated || m_cancelled; }
+
+  // Runs the remaining steps of each frame, innermost (back) first.
+  void run(std::vector<Frame> frames, Progress progress) {
+    std::span<const AutoModeStepIndex::Entry> entries = m_stepIndex.entries();
+
+    while (!frames.empty()) {
+      if (shouldStop())
+        return;
+
+      Frame& frame = frames.back();
+      if (frame.entryIndex == frame.end) {
+        frames.pop_back();
+        continue;
+      }
+
+      const AutoModeStepIndex::Entry& entry = entries[frame.entryIndex];
+
+      // Steps nested in a branch step are run by takeBranch().
+      frame.entryIndex = entry.subtreeEnd;
+
+      switch (entry.type) {
+        using enum ThunderAutoModeStepType;
+        case ACTION:
+          break;
+        case TRAJECTORY: {
+          auto trajectoryIt = m_trajectories.find(entry.itemName);
+          if (trajectoryIt != m_trajectories.end()) {
+            progress.time += trajectoryIt->second.totalTime;
+            progress.lastTrajectory = &trajectoryIt->second;
+          }
+          break;
+        }
+        case BRANCH_BOOL:
+        case BRANCH_SWITCH:
+          for (size_t branchIndex = entry.firstBranch; branchIndex < entry.branchesEnd; branchIndex++) {
+            takeBranch(frames, progress, entry, m_stepIndex.branches()[branchIndex]);
+          }
+          return;
+        default:
+          ThunderAutoUnreachable("Invalid auto mode step type");
+      }
+    }
+
+    finish(progress);
+  }
+
+  void takeBranch(const std::vector<Frame>& frames,
+                  const Progress& progress,
+                  const AutoModeStepIndex::Entry& branchStep,
+                  const AutoModeStepIndex::Branch& branch) {
+    std::vector<Frame> branchFrames = frames;
+    branchFrames.push_back(Frame{branch.begin, branch.end});
+
+    Progress branchProgress = progress;
+    if (!branchProgress.branches.empty()) {
+      branchProgress.branches += ", ";
+    }
+    branchProgress.branches += fmt::format("{}: {}", branchStep.pathString, branch.label);
+
+    run(std::move(branchFrames), std::move(branchProgress));
+  }
+
+  void finish(const Progress& progress) {
+    if (m_combinations.size() >= AutoModeAnalysis::kMaxCombinationsPerAutoMode) {
+      m_truncated = true;
+      return;
+    }
+
+    AutoModeAnalysis::Combination& combination = m_combinations.emplace_back();
+    combination.autoModeName = m_autoModeName;
+    combination.branches = progress.branches;
+    combination.totalTime = progress.time;
+    if (progress.lastTrajectory) {
+      combination.finalPosition = progress.lastTrajectory->endPosition;
+      combination.finalRotation = progress.lastTrajectory->endRotation;
+    }
+  }
+};
+
+}  // namespace
+
+AutoModeAnalysis::AutoModeAnalysis(ThunderAutoProjectState state)
+  : m_sharedState(std::make_shared<SharedState>()),
+    m_future(std::async(std::launch::async, &AutoModeAnalysis::Run, std::move(state), m_sharedState)) {}
+
+float AutoModeAnalysis::progress() const noexcept {
+  const size_t numTasks = m_sharedState->numTasks;
+  if (numTasks == 0)
+    return 0.f;
+
+  return static_cast<float>(m_sharedState->numFinishedTasks) / static_cast<float>(numTasks);
+}
+
+bool AutoModeAnalysis::isFinished() const {
+  ThunderAutoAssert(m_future.valid(), "Auto mode analysis result was already taken");
+
+  return m_future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+AutoModeAnalysis::Result AutoModeAnalysis::takeResult() {
+  ThunderAutoAssert(m_future.valid(), "Auto mode analysis result was already taken");
+
+  return m_future.get();
+}
+
+AutoModeAnalysis::Result AutoModeAnalysis::Run(ThunderAutoProjectState state,
+                                               std::shared_ptr<SharedState> sharedState) {
+  Result result;
+
+  try {
+    std::map<std::string, AutoModeStepIndex> stepIndexes;
+    std::set<std::string> trajectoryNames;
+    for (const auto& [autoModeName, autoMode] : state.autoModes) {
+      AutoModeStepIndex& stepIndex = stepIndexes[autoModeName];
+      stepIndex.rebuild(autoMode);
+
+      for (const AutoModeStepIndex::Entry& entry : stepIndex.entries()) {
+        if (entry.type == ThunderAutoModeStepType::TRAJECTORY) {
+          trajectoryNames.insert(entry.itemName);
+        }
+      }
+    }
+    std::erase_if(trajectoryNames,
+                  [&](const std::string& name) { return !state.trajectories.contains(name); });
+
+    sharedState->numTasks = trajectoryNames.size() + state.autoModes.size();
+
+    // Build each trajectory once.
+
+    std::vector<std::future<TrajectorySummary>> trajectoryFutures;
+    for (const std::string& trajectoryName : trajectoryNames) {
+      const ThunderAutoTrajectorySkeleton& skeleton = state.trajectories.at(trajectoryName);
+
+      trajectoryFutures.push_back(ThreadPool::get().submit([&skeleton, sharedState] {
+        TrajectorySummary summary;
+        if (!sharedState->cancelled) {
+          std::unique_ptr<ThunderAutoOutputTrajectory> trajectory =
+              BuildThunderAutoOutputTrajectory(skeleton, kPreviewOutputTrajectorySettings);
+
+          summary.totalTime = trajectory->totalTime;
+          if (!trajectory->points.empty()) {
+            summary.endPosition = trajectory->points.back().position;
+            summary.endRotation = trajectory->points.back().rotation;
+          }
+        }
+        sharedState->numFinishedTasks++;
+        return summary;
+      }));
+    }
+
+    std::vector<TrajectorySummary> trajectorySummaries = ThreadPool::GetAll(trajectoryFutures);
+
+    TrajectorySummaries trajectories;
+    auto summaryIt = trajectorySummaries.begin();
+    for (const std::string& trajectoryName : trajectoryNames) {
+      trajectories.emplace(trajectoryName, std::move(*summaryIt++));
+    }
+
+    if (sharedState->cancelled) {
+      result.cancelled = true;
+      return result;
+    }
+
+    // Then enumerate the combinations of each auto mode.
+
+    struct AutoModeCombinations {
+      std::string autoModeName;
+      std::vector<Combination> combinations;
+      bool truncated = false;
+    };
+
+    std::vector<std::future<AutoModeCombinations>> autoModeFutures;
+    for (const auto& [autoModeName, stepIndex] : stepIndexes) {
+      autoModeFutures.push_back(
+          ThreadPool::get().submit([&autoModeName, &stepIndex, &trajectories, sharedState] {
+            CombinationEnumerator enumerator(autoModeName, stepIndex, trajectories, sharedState->cancelled);
+            enumerator.enumerate();
+
+            sharedState->numFinishedTasks++;
+            return AutoModeCombinations{autoModeName, std::move(enumerator.combinations()),
+                                        enumerator.truncated()};
+          }));
+    }
+
+    for (AutoModeCombinations& autoModeCombinations : ThreadPool::GetAll(autoModeFutures)) {
+      std::move(autoModeCombinations.combinations.begin(), autoModeCombinations.combinations.end(),
+                std::back_inserter(result.combinations));
+
+      if (autoModeCombinations.truncated) {
+        result.truncatedAutoModes.push_back(std::move(autoModeCombinations.autoModeName));
+      }
+    }
+
+    result.cancelled = sharedState->cancelled;
+
+  } catch (const ThunderError& e) {
+    result.error = e.message();
+  } catch (const std::exception& e) {
+    result.error = e.what();
+  } catch (...) {
+    result.error = "Unknown error ocurred";
+  }
+
+  return result;
+}
@@ -0,0 +1,183 @@
+#include <ThunderAuto/AutoModeStepIndex.hpp>
+
+#include <ThunderAuto/Error.hpp>
+#include <IconsLucide.h>
+#include <fmt/format.h>
+#include <utility>
+
+static std::string StepLabel(const char* icon, const std::string& itemName) {
+  return fmt::format("{}  {}", icon, itemName.empty() ? "<none>" : itemName);
+}
+
+void AutoModeStepIndex::rebuild(const ThunderAutoMode& autoMode) {
+  clear();
+
+  addSteps(ThunderAutoModeStepDirectoryPath{}, autoMode.steps, kNone, kNone, 0);
+  addEditorOrder(0, m_entries.size(), true);
+}
+
+void AutoModeStepIndex::clear() noexcept {
+  m_entries.clear();
+  m_branches.clear();
+  m_editorOrder.clear();
+  m_numTrajectorySlots = 0;
+}
+
+void AutoModeStepIndex::addSteps(const ThunderAutoModeStepDirectoryPath& directoryPath,
+                                 const ThunderAutoMode::StepDirectory& steps,
+                                 size_t parent,
+                                 size_t branch,
+                                 size_t depth) {
+  size_t stepIndex = 0;
+  for (const std::unique_ptr<ThunderAutoModeStep>& step : steps) {
+    ThunderAutoAssert(step != nullptr);
+
+    // Entries may move as nested steps are added, so the entry is only referred to by index after this.
+    const size_t entryIndex = m_entries.size();
+    {
+      Entry& entry = m_entries.emplace_back();
+      entry.path = directoryPath.step(stepIndex++);
+      entry.type = step->type();
+      entry.depth = depth;
+      entry.parent = parent;
+      entry.branch = branch;
+      entry.pathString = ThunderAutoModeStepPathToString(entry.path);
+    }
+    const ThunderAutoModeStepPath path = m_entries[entryIndex].path;
+
+    switch (step->type()) {
+      using enum ThunderAutoModeStepType;
+      case ACTION: {
+        const ThunderAutoModeActionStep& actionStep = static_cast<const ThunderAutoModeActionStep&>(*step);
+
+        m_entries[entryIndex].itemName = actionStep.actionName;
+        m_entries[entryIndex].label = StepLabel(ICON_LC_PAPERCLIP, actionStep.actionName);
+        break;
+      }
+      case TRAJECTORY: {
+        const ThunderAutoModeTrajectoryStep& trajectoryStep =
+            static_cast<const ThunderAutoModeTrajectoryStep&>(*step);
+
+        m_entries[entryIndex].itemName = trajectoryStep.trajectoryName;
+        m_entries[entryIndex].label = StepLabel(ICON_LC_ROUTE, trajectoryStep.trajectoryName);
+        break;
+      }
+      case BRANCH_BOOL: {
+        const ThunderAutoModeBoolBranchStep& branchStep =
+            static_cast<const ThunderAutoModeBoolBranchStep&>(*step);
+
+        m_entries[entryIndex].itemName = branchStep.conditionName;
+        m_entries[entryIndex].label = StepLabel(ICON_LC_TOGGLE_RIGHT, branchStep.conditionName);
+
+        // A step's branches are listed together, before any branches nested inside them.
+        const size_t firstBranch = m_branches.size();
+        addBranch(Branch::Type::BOOL_TRUE, 0, path.boolBranch(true), "TRUE",
+                  branchStep.editorDisplayTrueBranch);
+        addBranch(Branch::Type::BOOL_ELSE, 0, path.boolBranch(false), "FALSE",
+                  !branchStep.editorDisplayTrueBranch);
+        m_entries[entryIndex].firstBranch = firstBranch;
+        m_entries[entryIndex].branchesEnd = m_branches.size();
+
+        addBranchSteps(firstBranch, branchStep.trueBranch, entryIndex, depth + 1);
+        addBranchSteps(firstBranch + 1, branchStep.elseBranch, entryIndex, depth + 1);
+        break;
+      }
+      case BRANCH_SWITCH: {
+        const ThunderAutoModeSwitchBranchStep& branchStep =
+            static_cast<const ThunderAutoModeSwitchBranchStep&>(*step);
+
+        m_entries[entryIndex].itemName = branchStep.conditionName;
+        m_entries[entryIndex].label = StepLabel(ICON_LC_LIST_ORDERED, branchStep.conditionName);
+
+        const size_t firstBranch = m_branches.size();
+        for (const auto& [caseValue, caseSteps] : branchStep.caseBranches) {
+          const bool isDisplayed =
+              !branchStep.editorDisplayDefaultBranch && caseValue == branchStep.editorDisplayCaseBranch;
+          addBranch(Branch::Type::SWITCH_CASE, caseValue, path.switchBranchCase(caseValue),
+                    fmt::format("CASE {}", caseValue), isDisplayed);
+        }
+        addBranch(Branch::Type::SWITCH_DEFAULT, 0, path.switchBranchDefault(), "DEFAULT",
+                  branchStep.editorDisplayDefaultBranch);
+        m_entries[entryIndex].firstBranch = firstBranch;
+        m_entries[entryIndex].branchesEnd = m_branches.size();
+
+        size_t branchIndex = firstBranch;
+        for (const auto& [caseValue, caseSteps] : branchStep.caseBranches) {
+          addBranchSteps(branchIndex++, caseSteps, entryIndex, depth + 1);
+        }
+        addBranchSteps(branchIndex, branchStep.defaultBranch, entryIndex, depth + 1);
+        break;
+      }
+      default:
+        ThunderAutoUnreachable("Invalid auto mode step type");
+    }
+
+    m_entries[entryIndex].subtreeEnd = m_entries.size();
+  }
+}
+
+void AutoModeStepIndex::addBranch(Branch::Type type,
+                                  int caseValue,
+                                  ThunderAutoModeStepDirectoryPath path,
+                                  std::string label,
+                                  bool isDisplayedInEditor) {
+  m_branches.push_back(Branch{
+      .type = type,
+      .caseValue = caseValue,
+      .path = std::move(path),
+      .label = std::move(label),
+      .isDisplayedInEditor = isDisplayedInEditor,
+  });
+}
+
+void AutoModeStepIndex::addBranchSteps(size_t branchIndex,
+                                       const ThunderAutoMode::StepDirectory& steps,
+                                       size_t parent,
+                                       size_t depth) {
+  // Copied since branches may move as nested branches are added.
+  const ThunderAutoModeStepDirectoryPath path = m_branches[branchIndex].path;
+
+  m_branches[branchIndex].begin = m_entries.size();
+  addSteps(path, steps, parent, branchIndex, depth);
+  m_branches[branchIndex].end = m_entries.size();
+}
+
+void AutoModeStepIndex::addEditorOrder(size_t begin, size_t end, bool isActive) {
+  for (size_t i = begin; i < end; i = m_entries[i].subtreeEnd) {
+    Entry& entry = m_entries[i];
+    entry.isActive = isActive;
+    m_editorOrder.push_back(i);
+
+    if (entry.type == ThunderAutoModeStepType::TRAJECTORY) {
+      entry.trajectorySlot = m_numTrajectorySlots++;
+    }
+
+    if (entry.firstBranch == entry.branchesEnd)
+      continue;
+
+    // The editor goes through a switch step's default branch before its cases when the default branch
+    // isn't the one being displayed.
+    const Branch& lastBranch = m_branches[entry.branchesEnd - 1];
+    const bool isDefaultBranchFirst =
+        lastBranch.type == Branch::Type::SWITCH_DEFAULT && !lastBranch.isDisplayedInEditor;
+    if (isDefaultBranchFirst) {
+      addEditorOrder(lastBranch.begin, lastBranch.end, false);
+    }
+
+    size_t displayedBranchIndex = kNone;
+    for (size_t branchIndex = entry.firstBranch; branchIndex < entry.branchesEnd; branchIndex++) {
+      const Branch& branch = m_branches[branchIndex];
+      if (branch.isDisplayedInEditor) {
+        displayedBranchIndex = branchIndex;
+      } else if (branch.type != Branch::Type::SWITCH_DEFAULT) {
+        addEditorOrder(branch.begin, branch.end, false);
+      }
+    }
+
+    // The displayed branch goes last.
+    if (displayedBranchIndex != kNone) {
+      const Branch& displayedBranch = m_branches[displayedBranchIndex];
+      addEditorOrder(displayedBranch.begin, displayedBranch.end, isActive);
+    }
+  }
+}
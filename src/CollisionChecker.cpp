@@ -0,0 +1,453 @@
+#include <ThunderAuto/CollisionChecker.hpp>
+
+#include <ThunderAuto/ThreadPool.hpp>
+#include <ThunderAuto/Logger.hpp>
+#include <ThunderAuto/Error.hpp>
+#include <ThunderLibCore/Auto/ThunderAutoOutputTrajectory.hpp>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <limits>
+
+using Box = KeepOutGeometry::Box;
+
+static constexpr Box kEmptyBox = {
+    std::numeric_limits<float>::max(),
+    std::numeric_limits<float>::max(),
+    std::numeric_limits<float>::lowest(),
+    std::numeric_limits<float>::lowest(),
+};
+
+static void ExpandBox(Box& box, float x, float y) noexcept {
+  box.minX = std::min(box.minX, x);
+  box.minY = std::min(box.minY, y);
+  box.maxX = std::max(box.maxX, x);
+  box.maxY = std::max(box.maxY, y);
+}
+
+static void ExpandBox(Box& box, const Box& other) noexcept {
+  ExpandBox(box, other.minX, other.minY);
+  ExpandBox(box, other.maxX, other.maxY);
+}
+
+// Positive if c is to the left of the line from a to b, negative if to the right, and zero if on it.
+static float Cross(float ax, float ay, float bx, float by, float cx, float cy) noexcept {
+  return (bx - ax) * (cy - ay) - (by - ay) * (cx - ax);
+}
+
+static bool IsPointInsideConvexPolygon(float px,
+                                       float py,
+                                       std::span<const float> x,
+                                       std::span<const float> y) noexcept {
+  bool hasLeft = false, hasRight = false;
+
+  for (size_t i = 0; i < x.size(); i++) {
+    const size_t j = (i + 1) % x.size();
+    const float side = Cross(x[i], y[i], x[j], y[j], px, py);
+
+    hasLeft |= side > 0.f;
+    hasRight |= side < 0.f;
+
+    // Inside a convex polygon, the point is on the same side of every edge.
+    if (hasLeft && hasRight)
+      return false;
+  }
+
+  return true;
+}
+
+static bool SegmentsCross(float ax, float ay, float bx, float by, float cx, float cy, float dx, float dy) {
+  const float d1 = Cross(cx, cy, dx, dy, ax, ay);
+  const float d2 = Cross(cx, cy, dx, dy, bx, by);
+  const float d3 = Cross(ax, ay, bx, by, cx, cy);
+  const float d4 = Cross(ax, ay, bx, by, dx, dy);
+
+  return ((d1 > 0.f && d2 < 0.f) || (d1 < 0.f && d2 > 0.f)) &&
+         ((d3 > 0.f && d4 < 0.f) || (d3 < 0.f && d4 > 0.f));
+}
+
+KeepOutGeometry::KeepOutGeometry(const KeepOutZoneList& zones) {
+  for (size_t zoneIndex = 0; zoneIndex < zones.size(); zoneIndex++) {
+    const std::vector<Point2d>& vertices = zones[zoneIndex].vertices;
+    if (vertices.size() < 3)
+      continue;
+
+    Zone zone{
+        .box = kEmptyBox,
+        .firstEdge = static_cast<uint32_t>(m_edges.size()),
+        .numEdges = static_cast<uint32_t>(vertices.size()),
+    };
+
+    for (size_t i = 0; i < vertices.size(); i++) {
+      const Point2d& start = vertices[i];
+      const Point2d& end = vertices[(i + 1) % vertices.size()];
+
+      const Edge edge{
+          .x0 = static_cast<float>(start.x.value()),
+          .y0 = static_cast<float>(start.y.value()),
+          .x1 = static_cast<float>(end.x.value()),
+          .y1 = static_cast<float>(end.y.value()),
+          .zoneIndex = static_cast<uint32_t>(zoneIndex),
+      };
+      m_edges.push_back(edge);
+
+      ExpandBox(zone.box, edge.x0, edge.y0);
+    }
+
+    m_zones.push_back(zone);
+  }
+
+  if (m_edges.empty())
+    return;
+
+  m_nodeEdges.resize(m_edges.size());
+  for (uint32_t i = 0; i < m_nodeEdges.size(); i++) {
+    m_nodeEdges[i] = i;
+  }
+
+  // A binary tree with up to kMaxEdgesPerLeaf edges per leaf has less than this many nodes.
+  m_nodes.reserve(2 * (m_edges.size() / kMaxEdgesPerLeaf + 1));
+
+  buildNode(0, static_cast<uint32_t>(m_edges.size()));
+}
+
+static Box EdgeBox(float x0, float y0, float x1, float y1) noexcept {
+  return Box{std::min(x0, x1), std::min(y0, y1), std::max(x0, x1), std::max(y0, y1)};
+}
+
+uint32_t KeepOutGeometry::buildNode(uint32_t firstEdge, uint32_t numEdges) {
+  const uint32_t nodeIndex = static_cast<uint32_t>(m_nodes.size());
+  m_nodes.emplace_back();
+
+  Box box = kEmptyBox;
+  for (uint32_t i = firstEdge; i < firstEdge + numEdges; i++) {
+    const Edge& edge = m_edges[m_nodeEdges[i]];
+    ExpandBox(box, EdgeBox(edge.x0, edge.y0, edge.x1, edge.y1));
+  }
+
+  if (numEdges <= kMaxEdgesPerLeaf) {
+    m_nodes[nodeIndex] = Node{.box = box, .firstEdge = firstEdge, .numEdges = numEdges, .rightChild = 0};
+    return nodeIndex;
+  }
+
+  // Split the edges in half along the longer side of the box, by the position of their centers.
+  const bool splitX = (box.maxX - box.minX) >= (box.maxY - box.minY);
+  auto edgeCenter = [&](uint32_t edgeIndex) {
+    const Edge& edge = m_edges[edgeIndex];
+    return splitX ? (edge.x0 + edge.x1) : (edge.y0 + edge.y1);
+  };
+
+  const uint32_t numLeftEdges = numEdges / 2;
+  auto begin = m_nodeEdges.begin() + firstEdge;
+  std::nth_element(begin, begin + numLeftEdges, begin + numEdges,
+                   [&](uint32_t a, uint32_t b) { return edgeCenter(a) < edgeCenter(b); });
+
+  buildNode(firstEdge, numLeftEdges);
+  const uint32_t rightChild = buildNode(firstEdge + numLeftEdges, numEdges - numLeftEdges);
+
+  m_nodes[nodeIndex] = Node{.box = box, .firstEdge = firstEdge, .numEdges = 0, .rightChild = rightChild};
+  return nodeIndex;
+}
+
+std::optional<size_t> KeepOutGeometry::findOverlappingZone(std::span<const float> x,
+                                                           std::span<const float> y) const {
+  ThunderAutoAssert(x.size() == y.size());
+
+  if (x.empty() || m_nodes.empty())
+    return std::nullopt;
+
+  Box polygonBox = kEmptyBox;
+  for (size_t i = 0; i < x.size(); i++) {
+    ExpandBox(polygonBox, x[i], y[i]);
+  }
+
+  // Look for a zone edge that is inside the polygon or crosses one of its edges. That also catches zones
+  // that are entirely inside the polygon.
+
+  std::array<uint32_t, 64> stack;
+  size_t stackSize = 0;
+  stack[stackSize++] = 0;
+
+  while (stackSize) {
+    const uint32_t nodeIndex = stack[--stackSize];
+    const Node& node = m_nodes[nodeIndex];
+
+    if (!node.box.overlaps(polygonBox))
+      continue;
+
+    if (node.numEdges == 0) {
+      ThunderAutoAssert(stackSize + 2 <= stack.size(), "Keep-out geometry tree is too deep");
+      stack[stackSize++] = node.rightChild;
+      stack[stackSize++] = nodeIndex + 1;
+      continue;
+    }
+
+    for (uint32_t i = node.firstEdge; i < node.firstEdge + node.numEdges; i++) {
+      const Edge& edge = m_edges[m_nodeEdges[i]];
+      if (!EdgeBox(edge.x0, edge.y0, edge.x1, edge.y1).overlaps(polygonBox))
+        continue;
+
+      if (IsPointInsideConvexPolygon(edge.x0, edge.y0, x, y) ||
+          IsPointInsideConvexPolygon(edge.x1, edge.y1, x, y)) {
+        return edge.zoneIndex;
+      }
+
+      for (size_t j = 0; j < x.size(); j++) {
+        const size_t k = (j + 1) % x.size();
+        if (SegmentsCross(edge.x0, edge.y0, edge.x1, edge.y1, x[j], y[j], x[k], y[k])) {
+          return edge.zoneIndex;
+        }
+      }
+    }
+  }
+
+  // No edges touch, but the polygon could still be entirely inside a zone.
+
+  for (const Zone& zone : m_zones) {
+    if (zone.box.contains(polygonBox) && isPointInsideZone(zone, x[0], y[0])) {
+      return m_edges[zone.firstEdge].zoneIndex;
+    }
+  }
+
+  return std::nullopt;
+}
+
+bool KeepOutGeometry::isPointInsideZone(const Zone& zone, float x, float y) const noexcept {
+  // Count how many edges a ray going right from the point crosses.
+  bool inside = false;
+
+  for (uint32_t i = zone.firstEdge; i < zone.firstEdge + zone.numEdges; i++) {
+    const Edge& edge = m_edges[i];
+
+    if ((edge.y0 > y) != (edge.y1 > y)) {
+      const float crossingX = edge.x0 + (y - edge.y0) * (edge.x1 - edge.x0) / (edge.y1 - edge.y0);
+      if (x < crossingX) {
+        inside = !inside;
+      }
+    }
+  }
+
+  return inside;
+}
+
+struct HullPoint {
+  float x, y;
+};
+
+// Andrew's monotone chain. The hull is written counter-clockwise to hullX and hullY.
+static void ComputeConvexHull(std::span<const float> x,
+                              std::span<const float> y,
+                              std::vector<HullPoint>& points,
+                              std::vector<float>& hullX,
+                              std::vector<float>& hullY) {
+  points.clear();
+  for (size_t i = 0; i < x.size(); i++) {
+    points.push_back(HullPoint{x[i], y[i]});
+  }
+
+  std::sort(points.begin(), points.end(), [](const HullPoint& a, const HullPoint& b) {
+    return a.x < b.x || (a.x == b.x && a.y < b.y);
+  });
+
+  hullX.clear();
+  hullY.clear();
+
+  auto isNotLeftTurn = [&](const HullPoint& point) {
+    const size_t n = hullX.size();
+    return Cross(hullX[n - 2], hullY[n - 2], hullX[n - 1], hullY[n - 1], point.x, point.y) <= 0.f;
+  };
+
+  // Lower hull.
+  for (const HullPoint& point : points) {
+    while (hullX.size() >= 2 && isNotLeftTurn(point)) {
+      hullX.pop_back();
+      hullY.pop_back();
+    }
+    hullX.push_back(point.x);
+    hullY.push_back(point.y);
+  }
+
+  // Upper hull.
+  const size_t lowerHullSize = hullX.size() + 1;
+  for (auto it = std::next(points.rbegin()); it != points.rend(); ++it) {
+    while (hullX.size() >= lowerHullSize && isNotLeftTurn(*it)) {
+      hullX.pop_back();
+      hullY.pop_back();
+    }
+    hullX.push_back(it->x);
+    hullY.push_back(it->y);
+  }
+
+  // The first point was added again at the end.
+  if (hullX.size() > 1) {
+    hullX.pop_back();
+    hullY.pop_back();
+  }
+}
+
+std::vector<CollisionSegment> CollisionChecker::CheckTrajectory(const ThunderAutoOutputTrajectory& trajectory,
+                                                                const KeepOutGeometry& geometry,
+                                                                const PolygonSoA& footprint) {
+  std::vector<CollisionSegment> collisions;
+
+  if (geometry.empty() || footprint.size() == 0)
+    return collisions;
+
+  std::span<const ThunderAutoOutputTrajectoryPoint> points = trajectory.points;
+  if (points.size() < 2)
+    return collisions;
+
+  const size_t numVertices = footprint.size();
+
+  std::vector<float> outlineX(2 * numVertices), outlineY(2 * numVertices);
+  std::vector<HullPoint> hullPoints;
+  std::vector<float> hullX, hullY;
+
+  hullPoints.reserve(2 * numVertices);
+  hullX.reserve(2 * numVertices + 1);
+  hullY.reserve(2 * numVertices + 1);
+
+  std::optional<size_t> lastCollisionIndex;
+
+  for (size_t i = 0; i + 1 < points.size(); i++) {
+    const ThunderAutoOutputTrajectoryPoint& start = points[i];
+    const ThunderAutoOutputTrajectoryPoint& end = points[i + 1];
+
+    // The area covered while moving from one point to the next is close to the convex hull of the robot's
+    // footprint at both points, since the points are close together.
+    const std::array<PolygonTransform, 2> transforms = {
+        PolygonTransform::FromPose(start.position, start.rotation),
+        PolygonTransform::FromPose(end.position, end.rotation),
+    };
+    TransformPolygonBatch(footprint, transforms, outlineX, outlineY);
+
+    ComputeConvexHull(outlineX, outlineY, hullPoints, hullX, hullY);
+
+    std::optional<size_t> zoneIndex = geometry.findOverlappingZone(hullX, hullY);
+    if (!zoneIndex)
+      continue;
+
+    // Join with the previous segment if the robot is still in the same zone.
+    if (lastCollisionIndex && *lastCollisionIndex + 1 == i && collisions.back().zoneIndex == *zoneIndex) {
+      collisions.back().endPointIndex = i + 1;
+    } else {
+      collisions.push_back(CollisionSegment{i, i + 1, *zoneIndex});
+    }
+    lastCollisionIndex = i;
+  }
+
+  return collisions;
+}
+
+void CollisionChecker::setGeometry(const KeepOutZoneList& zones,
+                                   Measurement2d robotSize,
+                                   units::meter_t robotCornerRadius) {
+  m_geometry = std::make_shared<const KeepOutGeometry>(zones);
+
+  // Far fewer points per corner than what is drawn, since the footprint is tested at every trajectory point.
+  constexpr size_t kNumPointsPerCorner = 4;
+  m_footprint = std::make_shared<const PolygonSoA>(
+      PolylineToSoA(CreateRoundedRectangle(robotSize, robotCornerRadius, kNumPointsPerCorner)));
+
+  // Zone indices may have changed too, so old collisions are no longer meaningful.
+  for (auto& [name, entry] : m_entries) {
+    entry.collisions.clear();
+  }
+  invalidateAll();
+}
+
+void CollisionChecker::invalidateTrajectory(const std::string& trajectoryName) noexcept {
+  auto it = m_entries.find(trajectoryName);
+  if (it != m_entries.end()) {
+    it->second.generation++;
+  }
+}
+
+void CollisionChecker::invalidateAll() noexcept {
+  for (auto& [name, entry] : m_entries) {
+    entry.generation++;
+  }
+}
+
+void CollisionChecker::clear() noexcept {
+  // Pending checks are left to finish on their own, since they hold on to everything they use.
+  m_entries.clear();
+  m_geometry.reset();
+  m_footprint.reset();
+}
+
+void CollisionChecker::update(const ThunderAutoProjectState& state,
+                              PreviewTrajectoryCache& previewTrajectories) {
+  if (!m_geometry || m_geometry->empty()) {
+    m_entries.clear();
+    return;
+  }
+
+  std::erase_if(m_entries, [&](const auto& entry) { return !state.trajectories.contains(entry.first); });
+
+  for (const auto& [trajectoryName, skeleton] : state.trajectories) {
+    Entry& entry = m_entries[trajectoryName];
+
+    if (entry.pendingCollisions.valid()) {
+      if (entry.pendingCollisions.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        continue;
+
+      try {
+        std::vector<CollisionSegment> collisions = entry.pendingCollisions.get();
+
+        // Drop the result if the trajectory changed while it was being checked.
+        if (entry.pendingGeneration == entry.generation) {
+          entry.collisions = std::move(collisions);
+          entry.checkedGeneration = entry.generation;
+        }
+
+      } catch (const ThunderError& e) {
+        ThunderAutoLogger::Warn("Failed to check trajectory '{}' for collisions: {}", trajectoryName,
+                                e.message());
+        entry.collisions.clear();
+        entry.checkedGeneration = entry.generation;
+
+      } catch (const std::exception& e) {
+        ThunderAutoLogger::Warn("Failed to check trajectory '{}' for collisions: {}", trajectoryName,
+                                e.what());
+        entry.collisions.clear();
+        entry.checkedGeneration = entry.generation;
+      }
+    }
+
+    if (entry.checkedGeneration == entry.generation)
+      continue;
+
+    std::optional<std::shared_ptr<const ThunderAutoOutputTrajectory>> trajectory =
+        previewTrajectories.request(trajectoryName, skeleton);
+    if (!trajectory)
+      continue;
+
+    // The cache has already said why it failed.
+    if (!*trajectory) {
+      entry.collisions.clear();
+      entry.checkedGeneration = entry.generation;
+      continue;
+    }
+
+    entry.pendingGeneration = entry.generation;
+    entry.pendingCollisions = ThreadPool::get().submit(
+        [trajectory = std::move(*trajectory), geometry = m_geometry, footprint = m_footprint] {
+          return CheckTrajectory(*trajectory, *geometry, *footprint);
+        });
+  }
+}
+
+std::span<const CollisionSegment> CollisionChecker::collisions(
+    const std::string& trajectoryName) const noexcept {
+  auto it = m_entries.find(trajectoryName);
+  if (it == m_entries.end())
+    return {};
+
+  return it->second.collisions;
+}
+
+bool CollisionChecker::isChecking() const noexcept {
+  return std::any_of(m_entries.begin(), m_entries.end(),
+                     [](const auto& entry) { return entry.second.pendingCollisions.valid(); });
+}
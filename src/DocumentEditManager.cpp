@@ -1,5 +1,31 @@
 #include <ThunderAuto/DocumentEditManager.hpp>
 #include <ThunderAuto/Logger.hpp>
+#include <algorithm>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+// The keys of a map, in order.
+template <typename T>
+static std::vector<std::string> Names(const std::map<std::string, T>& entities) {
+  std::vector<std::string> names;
+  names.reserve(entities.size());
+  for (const auto& [name, entity] : entities) {
+    names.push_back(name);
+  }
+  return names;
+}
+
+// Whether any of the changed entities were added or removed, as opposed to just modified.
+template <typename T>
+static bool NamesChanged(const NameSearchIndex& index,
+                         const std::set<std::string>& changedNames,
+                         const std::map<std::string, T>& entities) {
+  return std::any_of(changedNames.begin(), changedNames.end(), [&](const std::string& name) {
+    return index.contains(name) != entities.contains(name);
+  });
+}
 
 void DocumentEditManager::startLongEdit() noexcept {
   if (m_history.isLocked()) {
@@ -8,6 +34,7 @@ void DocumentEditManager::startLongEdit() noexcept {
   }
   m_history.lock();
   m_currentState = m_history.currentState();
+  m_longEditChanges = {};
   ThunderAutoLogger::Info("Started long edit");
 }
 
@@ -19,6 +46,13 @@ void DocumentEditManager::discardLongEdit() noexcept {
   m_history.unlock();
   m_currentState = std::nullopt;
   ThunderAutoLogger::Info("Discarded long edit");
+
+  // Everything changed during the edit goes back to how it was.
+  StateChangeSet changes = std::move(m_longEditChanges);
+  m_longEditChanges = {};
+  if (!changes.empty()) {
+    notifyStateUpdateSubscribers(changes);
+  }
 }
 
 void DocumentEditManager::finishLongEdit() noexcept {
@@ -27,8 +61,9 @@ void DocumentEditManager::finishLongEdit() noexcept {
     return;
   }
   m_history.unlock();
-  addState(*m_currentState);
+  addState(*m_currentState, m_longEditChanges);
   m_currentState = std::nullopt;
+  m_longEditChanges = {};
   ThunderAutoLogger::Info("Finished long edit");
 }
 
@@ -39,31 +74,133 @@ const ThunderAutoProjectState& DocumentEditManager::currentState() const noexcep
   return m_history.currentState();
 }
 
+ThunderAutoProjectState* DocumentEditManager::longEditState() noexcept {
+  if (!m_history.isLocked()) {
+    return nullptr;
+  }
+  return &*m_currentState;
+}
+
+const TrajectoryLinkIndex& DocumentEditManager::linkIndex() noexcept {
+  ensureIndexesBuilt();
+  return m_linkIndex;
+}
+
+const ActionGraph& DocumentEditManager::actionGraph() noexcept {
+  ensureIndexesBuilt();
+  return m_actionGraph;
+}
+
+const NameSearchIndex& DocumentEditManager::trajectoryNameIndex() noexcept {
+  ensureIndexesBuilt();
+  return m_trajectoryNameIndex;
+}
+
+const NameSearchIndex& DocumentEditManager::autoModeNameIndex() noexcept {
+  ensureIndexesBuilt();
+  return m_autoModeNameIndex;
+}
+
+const NameSearchIndex& DocumentEditManager::actionNameIndex() noexcept {
+  ensureIndexesBuilt();
+  return m_actionNameIndex;
+}
+
+uint64_t DocumentEditManager::trajectoryVersion(const std::string& trajectoryName) noexcept {
+  ensureIndexesBuilt();
+
+  auto versionIt = m_trajectoryVersions.find(trajectoryName);
+  if (versionIt == m_trajectoryVersions.end())
+    return m_allTrajectoriesVersion;
+
+  return versionIt->second;
+}
+
+const AutoModeStepIndex& DocumentEditManager::autoModeStepIndex(const std::string& autoModeName) noexcept {
+  ensureIndexesBuilt();
+
+  if (m_isAutoModeStepIndexValid && m_autoModeStepIndexName == autoModeName)
+    return m_autoModeStepIndex;
+
+  m_autoModeStepIndexName = autoModeName;
+  m_isAutoModeStepIndexValid = true;
+
+  try {
+    const ThunderAutoProjectState& state = currentState();
+
+    auto autoModeIt = state.autoModes.find(autoModeName);
+    if (autoModeIt != state.autoModes.end()) {
+      m_autoModeStepIndex.rebuild(autoModeIt->second);
+    } else {
+      m_autoModeStepIndex.clear();
+    }
+
+  } catch (const std::exception& e) {
+    ThunderAutoLogger::Error("Failed to index auto mode steps: {}", e.what());
+    m_autoModeStepIndex.clear();
+  }
+
+  return m_autoModeStepIndex;
+}
+
 void DocumentEditManager::addState(const ThunderAutoProjectState& state, bool unsaved) noexcept {
+  // Compared to the history rather than the long edit state, since the long edit state may be what was
+  // modified.
+  addState(state, StateChangeSet::Compute(m_history.currentState(), state), unsaved);
+}
+
+void DocumentEditManager::addState(const ThunderAutoProjectState& state,
+                                   const StateChangeSet& changes,
+                                   bool unsaved) noexcept {
   if (m_history.isLocked()) {
-    m_currentState = state;
+    if (&state != &*m_currentState) {
+      m_currentState = state;
+    }
+    m_longEditChanges.merge(changes);
   } else {
-    m_history.addState(state, unsaved);
+    m_history.addState(state, changes, unsaved);
   }
-  notifyStateUpdateSubscribers();
+  notifyStateUpdateSubscribers(changes);
 }
 
 void DocumentEditManager::modifyLastState(const ThunderAutoProjectState& state, bool unsaved) noexcept {
+  modifyLastState(state, StateChangeSet::Compute(m_history.currentState(), state), unsaved);
+}
+
+void DocumentEditManager::modifyLastState(const ThunderAutoProjectState& state,
+                                          const StateChangeSet& changes,
+                                          bool unsaved) noexcept {
   if (m_history.isLocked()) {
-    m_currentState = state;
+    if (&state != &*m_currentState) {
+      m_currentState = state;
+    }
+    m_longEditChanges.merge(changes);
+    updateIndexes(changes);
     return;
   }
-  m_history.modifyLastState(state, unsaved);
+  m_history.modifyLastState(state, changes, unsaved);
+  updateIndexes(changes);
 }
 
 void DocumentEditManager::undo() noexcept {
-  m_history.undo();
-  notifyStateUpdateSubscribers();
+  StateChangeSet changes = m_history.undo();
+  if (!changes.empty()) {
+    notifyStateUpdateSubscribers(changes);
+  }
 }
 
 void DocumentEditManager::redo() noexcept {
-  m_history.redo();
-  notifyStateUpdateSubscribers();
+  StateChangeSet changes = m_history.redo();
+  if (!changes.empty()) {
+    notifyStateUpdateSubscribers(changes);
+  }
+}
+
+void DocumentEditManager::jumpTo(HistoryManager::NodeID node) noexcept {
+  StateChangeSet changes = m_history.jumpTo(node);
+  if (!changes.empty()) {
+    notifyStateUpdateSubscribers(changes);
+  }
 }
 
 DocumentEditManager::StateUpdateSubscriberID DocumentEditManager::registerStateUpdateSubscriber(
@@ -77,8 +214,88 @@ void DocumentEditManager::unregisterStateUpdateSubscriber(StateUpdateSubscriberI
   m_stateUpdateSubscribers.erase(id);
 }
 
-void DocumentEditManager::notifyStateUpdateSubscribers() noexcept {
+void DocumentEditManager::ensureIndexesBuilt() noexcept {
+  if (m_indexesRootNode != m_history.rootNode()) {
+    updateIndexes(StateChangeSet::Everything());
+  }
+}
+
+void DocumentEditManager::updateIndexes(const StateChangeSet& changes) noexcept {
+  if (changes.affectsAutoMode(m_autoModeStepIndexName) || m_indexesRootNode != m_history.rootNode()) {
+    m_isAutoModeStepIndexValid = false;
+  }
+
+  const HistoryManager::NodeID rootNode = m_history.rootNode();
+  if (rootNode == HistoryManager::kInvalidNodeID) {
+    m_linkIndex.clear();
+    m_actionGraph.clear();
+    m_trajectoryNameIndex.clear();
+    m_autoModeNameIndex.clear();
+    m_actionNameIndex.clear();
+    updateTrajectoryVersions(StateChangeSet::Everything());
+    m_indexesRootNode = rootNode;
+    return;
+  }
+
+  try {
+    // A reset history may hold a different project entirely.
+    if (m_indexesRootNode != rootNode) {
+      m_linkIndex.rebuild(currentState());
+      m_actionGraph.rebuild(currentState());
+      updateNameIndexes(StateChangeSet::Everything());
+      updateTrajectoryVersions(StateChangeSet::Everything());
+      m_indexesRootNode = rootNode;
+    } else {
+      m_linkIndex.update(currentState(), changes);
+      m_actionGraph.update(currentState(), changes);
+      updateNameIndexes(changes);
+      updateTrajectoryVersions(changes);
+    }
+
+  } catch (const std::exception& e) {
+    ThunderAutoLogger::Error("Failed to update project indexes: {}", e.what());
+    m_linkIndex.clear();
+    m_actionGraph.clear();
+    m_trajectoryNameIndex.clear();
+    m_autoModeNameIndex.clear();
+    m_actionNameIndex.clear();
+    updateTrajectoryVersions(StateChangeSet::Everything());
+    m_indexesRootNode = HistoryManager::kInvalidNodeID;
+  }
+}
+
+void DocumentEditManager::updateNameIndexes(const StateChangeSet& changes) {
+  const ThunderAutoProjectState& state = currentState();
+
+  // Most changes modify things without adding or removing any, which leaves the names as they were.
+  if (changes.everything || NamesChanged(m_trajectoryNameIndex, changes.trajectories, state.trajectories)) {
+    m_trajectoryNameIndex.rebuild(Names(state.trajectories));
+  }
+  if (changes.everything || NamesChanged(m_autoModeNameIndex, changes.autoModes, state.autoModes)) {
+    m_autoModeNameIndex.rebuild(Names(state.autoModes));
+  }
+  if (changes.everything || changes.actionsOrder ||
+      NamesChanged(m_actionNameIndex, changes.actions, state.actions)) {
+    m_actionNameIndex.rebuild(state.actionsOrder);
+  }
+}
+
+void DocumentEditManager::updateTrajectoryVersions(const StateChangeSet& changes) {
+  if (changes.everything) {
+    m_trajectoryVersions.clear();
+    m_allTrajectoriesVersion = ++m_lastTrajectoryVersion;
+    return;
+  }
+
+  for (const std::string& trajectoryName : changes.trajectories) {
+    m_trajectoryVersions[trajectoryName] = ++m_lastTrajectoryVersion;
+  }
+}
+
+void DocumentEditManager::notifyStateUpdateSubscribers(const StateChangeSet& changes) noexcept {
+  updateIndexes(changes);
+
   for (auto& [id, callback] : m_stateUpdateSubscribers) {
-    callback();
+    callback(changes);
   }
 }
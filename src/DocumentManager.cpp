@@ -1,6 +1,7 @@
 #include <ThunderAuto/DocumentManager.hpp>
 
 #include <ThunderAuto/TrajectoryHelper.hpp>
+#include <ThunderAuto/StartupTimeline.hpp>
 #include <ThunderAuto/Logger.hpp>
 #include <ThunderAuto/Error.hpp>
 
@@ -11,6 +12,8 @@ void DocumentManager::newProject(ThunderAutoProjectSettings settings) noexcept {
   ThunderAutoLogger::Info("New project: {}", settings.name);
 
   m_settings = settings;
+  m_keepOutZones.clear();
+  m_trajectoryExportFormat = TrajectoryExportFormat::CSV;
 
   ThunderAutoProjectState startState;
   startState.trajectories["NewTrajectory"] = kDefaultNewTrajectory;
@@ -22,20 +25,97 @@ void DocumentManager::newProject(ThunderAutoProjectSettings settings) noexcept {
 }
 
 ThunderAutoProjectVersion DocumentManager::openProject(const std::filesystem::path& path) {
-  if (m_open)
-    close();
+  return openProject(LoadProject(path));
+}
+
+// Clears any references in the editor state to items that don't exist in the project.
+static void ValidateEditorState(ThunderAutoProjectState& state) {
+  ThunderAutoTrajectoryEditorState& trajectoryEditorState = state.editorState.trajectoryEditorState;
+  if (!trajectoryEditorState.currentTrajectoryName.empty() &&
+      !state.trajectories.contains(trajectoryEditorState.currentTrajectoryName)) {
+    ThunderAutoLogger::Warn("Current trajectory '{}' does not exist",
+                            trajectoryEditorState.currentTrajectoryName);
+    trajectoryEditorState.currentTrajectoryName.clear();
+    trajectoryEditorState.trajectorySelection = ThunderAutoTrajectoryEditorState::TrajectorySelection::NONE;
+    trajectoryEditorState.selectionIndex = 0;
+  }
+
+  ThunderAutoModeEditorState& autoModeEditorState = state.editorState.autoModeEditorState;
+  if (!autoModeEditorState.currentAutoModeName.empty() &&
+      !state.autoModes.contains(autoModeEditorState.currentAutoModeName)) {
+    ThunderAutoLogger::Warn("Current auto mode '{}' does not exist", autoModeEditorState.currentAutoModeName);
+    autoModeEditorState.currentAutoModeName.clear();
+    autoModeEditorState.selectedStepPath = std::nullopt;
+  }
+}
+
+DocumentManager::LoadedProject DocumentManager::LoadProject(const std::filesystem::path& path) {
+  StartupTimeline::ScopedPhase scopedPhase(StartupTimeline::Phase::PROJECT_LOAD);
 
-  ThunderAutoLogger::Info("Open project: {}", path.string());
+  ThunderAutoLogger::Info("Load project: {}", path.string());
 
-  ThunderAutoProjectVersion version;
-  std::unique_ptr<ThunderAutoProject> project = LoadThunderAutoProject(path, &version);
+  LoadedProject loadedProject;
+
+  std::unique_ptr<ThunderAutoProject> project = LoadThunderAutoProject(path, &loadedProject.version);
   ThunderAutoAssert(project, "LoadThunderAutoProject returned nullptr but did not throw an error");
 
-  m_settings = project->settings();
-  m_history.reset(project->state());
+  loadedProject.settings = project->settings();
+  loadedProject.state = project->state();
+
+  ValidateEditorState(loadedProject.state);
+
+  try {
+    loadedProject.keepOutZones = LoadKeepOutZones(path);
+  } catch (const ThunderError& e) {
+    ThunderAutoLogger::Warn("Failed to load keep-out zones: {}", e.message());
+  } catch (const std::exception& e) {
+    ThunderAutoLogger::Warn("Failed to load keep-out zones: {}", e.what());
+  }
+
+  try {
+    loadedProject.trajectoryExportFormat = LoadTrajectoryExportFormat(path);
+  } catch (const ThunderError& e) {
+    ThunderAutoLogger::Warn("Failed to load export settings: {}", e.message());
+  } catch (const std::exception& e) {
+    ThunderAutoLogger::Warn("Failed to load export settings: {}", e.what());
+  }
+
+  try {
+    loadedProject.recoveredState = EditJournal::Replay(path);
+    if (loadedProject.recoveredState) {
+      ValidateEditorState(*loadedProject.recoveredState);
+    }
+  } catch (const std::exception& e) {
+    ThunderAutoLogger::Warn("Failed to replay edit journal: {}", e.what());
+  }
+
+  return loadedProject;
+}
+
+ThunderAutoProjectVersion DocumentManager::openProject(LoadedProject loadedProject) {
+  if (m_open)
+    close();
+
+  ThunderAutoLogger::Info("Open project: {}", loadedProject.settings.projectPath.string());
+
+  m_settings = std::move(loadedProject.settings);
+  m_keepOutZones = std::move(loadedProject.keepOutZones);
+  m_trajectoryExportFormat = loadedProject.trajectoryExportFormat;
+  m_history.reset(std::move(loadedProject.state));
   m_open = true;
 
-  return version;
+  m_journal.start(m_settings.projectPath, m_history.currentState());
+
+  if (loadedProject.recoveredState) {
+    ThunderAutoLogger::Info("Recovered unsaved edits from edit journal");
+
+    // Added on top of the saved state so that it can be undone.
+    StateChangeSet changes = StateChangeSet::Compute(m_history.currentState(), *loadedProject.recoveredState);
+    m_history.addState(std::move(*loadedProject.recoveredState), changes);
+    m_hasRecoveredEdits = true;
+  }
+
+  return loadedProject.version;
 }
 
 void DocumentManager::save() {
@@ -45,13 +125,37 @@ void DocumentManager::save() {
   ThunderAutoLogger::Info("Save project: {}", m_settings.projectPath.string());
 
   SaveThunderAutoProject(m_settings, m_history.currentState());
+  SaveKeepOutZones(m_settings.projectPath, m_keepOutZones);
+  SaveTrajectoryExportFormat(m_settings.projectPath, m_trajectoryExportFormat);
 
   m_history.markSaved();
+
+  // Everything up to now is on disk, so start journaling over from here.
+  m_journal.start(m_settings.projectPath, m_history.currentState());
+}
+
+void DocumentManager::discardRecoveredEdits() noexcept {
+  if (!m_hasRecoveredEdits)
+    return;
+
+  ThunderAutoLogger::Info("Discard recovered edits");
+
+  m_hasRecoveredEdits = false;
+
+  // The saved state is right before the recovered one. Leave the project marked as unsaved, since the
+  // recovered edits may have been autosaved already.
+  m_history.undo();
+  m_history.reset(m_history.currentState(), true);
 }
 
-void DocumentManager::close() noexcept {
+void DocumentManager::close(bool discardJournal) noexcept {
   ThunderAutoLogger::Info("Close project");
 
+  m_journal.stop(discardJournal);
+
   m_open = false;
+  m_hasRecoveredEdits = false;
   m_settings = {};
+  m_keepOutZones.clear();
+  m_trajectoryExportFormat = TrajectoryExportFormat::CSV;
 }
@@ -0,0 +1,314 @@
+#include <ThunderAuto/EditJournal.hpp>
+
+#include <ThunderAuto/ProjectStateCodec.hpp>
+#include <ThunderAuto/Logger.hpp>
+#include <ThunderAuto/Error.hpp>
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <iterator>
+
+#if THUNDERAUTO_WINDOWS
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+//
+// File layout:
+//
+//   header:  "TAJRNL" magic, u16 format version
+//   records: u8 type, u32 payload size, payload, u32 CRC-32 of (type, size, payload)
+//
+// All integers are little endian. The first record is always a snapshot, and every record after it is a JSON
+// patch from the previous one. A record that is cut off or fails its checksum marks the end of the journal.
+//
+
+static constexpr std::array<uint8_t, 6> kJournalMagic = {'T', 'A', 'J', 'R', 'N', 'L'};
+static constexpr uint16_t kJournalFormatVersion = 1;
+
+static constexpr uint8_t kRecordTypeSnapshot = 1;
+static constexpr uint8_t kRecordTypeDelta = 2;
+
+static constexpr size_t kRecordHeaderSize = 5;
+
+// How often to sync the journal to disk while edits are being made.
+static constexpr auto kSyncInterval = std::chrono::milliseconds(500);
+
+static void AppendLE(std::vector<uint8_t>& buf, uint32_t value, size_t numBytes) {
+  for (size_t i = 0; i < numBytes; i++) {
+    buf.push_back(static_cast<uint8_t>(value >> (i * 8)));
+  }
+}
+
+static uint32_t ReadLE(std::span<const uint8_t> data, size_t numBytes) {
+  uint32_t value = 0;
+  for (size_t i = 0; i < numBytes; i++) {
+    value |= static_cast<uint32_t>(data[i]) << (i * 8);
+  }
+  return value;
+}
+
+EditJournal::EditJournal() : m_thread(&EditJournal::threadMain, this) {}
+
+EditJournal::~EditJournal() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_exit = true;
+  }
+  m_condition.notify_one();
+  m_thread.join();
+}
+
+std::filesystem::path EditJournal::PathForProject(const std::filesystem::path& projectPath) {
+  std::filesystem::path journalPath = projectPath;
+  journalPath += ".journal";
+  return journalPath;
+}
+
+std::optional<ThunderAutoProjectState> EditJournal::Replay(const std::filesystem::path& projectPath) {
+  const std::filesystem::path journalPath = PathForProject(projectPath);
+
+  std::error_code ec;
+  if (!std::filesystem::exists(journalPath, ec))
+    return std::nullopt;
+
+  std::ifstream file(journalPath, std::ios::binary);
+  if (!file) {
+    ThunderAutoLogger::Warn("Failed to open edit journal '{}'", journalPath.string());
+    return std::nullopt;
+  }
+
+  const std::vector<uint8_t> data{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+  std::span<const uint8_t> remaining(data);
+
+  const size_t fileHeaderSize = kJournalMagic.size() + sizeof(uint16_t);
+  if (remaining.size() < fileHeaderSize ||
+      !std::equal(kJournalMagic.begin(), kJournalMagic.end(), remaining.begin()) ||
+      ReadLE(remaining.subspan(kJournalMagic.size()), sizeof(uint16_t)) != kJournalFormatVersion) {
+    ThunderAutoLogger::Warn("Edit journal '{}' is not valid, ignoring it", journalPath.string());
+    return std::nullopt;
+  }
+  remaining = remaining.subspan(fileHeaderSize);
+
+  std::optional<wpi::json> baseState, state;
+  size_t numDeltas = 0;
+
+  while (remaining.size() >= kRecordHeaderSize + sizeof(uint32_t)) {
+    const uint8_t type = remaining[0];
+    const size_t payloadSize = ReadLE(remaining.subspan(1), sizeof(uint32_t));
+    const size_t recordSize = kRecordHeaderSize + payloadSize;
+
+    if (remaining.size() < recordSize + sizeof(uint32_t))
+      break;  // Cut off.
+
+    const uint32_t crc = ReadLE(remaining.subspan(recordSize), sizeof(uint32_t));
+    if (crc != ComputeCRC32(remaining.first(recordSize)))
+      break;  // Torn write.
+
+    std::span<const uint8_t> payload = remaining.subspan(kRecordHeaderSize, payloadSize);
+    remaining = remaining.subspan(recordSize + sizeof(uint32_t));
+
+    try {
+      if (type == kRecordTypeSnapshot) {
+        state = DecodeProjectJson(payload);
+        if (!baseState)
+          baseState = state;
+
+      } else if (type == kRecordTypeDelta && state) {
+        state = PatchProjectJson(*state, DecodeProjectJson(payload));
+        numDeltas++;
+
+      } else {
+        break;
+      }
+    } catch (const ThunderError& e) {
+      ThunderAutoLogger::Warn("Stopped replaying edit journal early: {}", e.message());
+      break;
+    }
+  }
+
+  if (!state || numDeltas == 0 || *state == *baseState)
+    return std::nullopt;
+
+  ThunderAutoLogger::Info("Replayed {} edits from journal '{}'", numDeltas, journalPath.string());
+
+  try {
+    return ProjectStateFromJson(*state);
+  } catch (const std::exception& e) {
+    ThunderAutoLogger::Warn("Failed to recover project state from edit journal: {}", e.what());
+    return std::nullopt;
+  }
+}
+
+void EditJournal::start(const std::filesystem::path& projectPath, const ThunderAutoProjectState& baseState) {
+  m_active = true;
+  pushCommand(Command{.type = Command::Type::START, .path = projectPath, .state = baseState});
+}
+
+void EditJournal::record(const ThunderAutoProjectState& state) {
+  if (!m_active)
+    return;
+
+  pushCommand(Command{.type = Command::Type::RECORD, .state = state});
+}
+
+void EditJournal::stop(bool discard) {
+  if (!m_active)
+    return;
+
+  m_active = false;
+  pushCommand(Command{.type = Command::Type::STOP, .discard = discard});
+}
+
+void EditJournal::pushCommand(Command command) {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // Only the latest state matters, so a record that hasn't been written yet can just be replaced.
+    if (command.type == Command::Type::RECORD && !m_commands.empty() &&
+        m_commands.back().type == Command::Type::RECORD) {
+      m_commands.back() = std::move(command);
+    } else {
+      m_commands.push_back(std::move(command));
+    }
+  }
+  m_condition.notify_one();
+}
+
+void EditJournal::threadMain() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+
+  while (true) {
+    m_condition.wait_for(lock, kSyncInterval, [this] { return m_exit || !m_commands.empty(); });
+
+    std::deque<Command> commands;
+    commands.swap(m_commands);
+    const bool exit = m_exit;
+
+    lock.unlock();
+
+    for (Command& command : commands) {
+      processCommand(command);
+    }
+
+    if (m_unsynced && (exit || std::chrono::steady_clock::now() - m_lastSyncTime >= kSyncInterval)) {
+      sync();
+    }
+
+    lock.lock();
+
+    if (exit && m_commands.empty())
+      break;
+  }
+
+  lock.unlock();
+
+  // Leave the journal behind so that whatever wasn't saved can be recovered next time.
+  if (m_file) {
+    sync();
+    std::fclose(m_file);
+    m_file = nullptr;
+  }
+}
+
+void EditJournal::processCommand(Command& command) {
+  try {
+    switch (command.type) {
+      using enum Command::Type;
+      case START:
+        closeFile(true);
+        openFile(command.path, *command.state);
+        break;
+      case RECORD:
+        appendState(*command.state);
+        break;
+      case STOP:
+        closeFile(command.discard);
+        break;
+      default:
+        ThunderAutoUnreachable("Unknown edit journal command");
+    }
+  } catch (const ThunderError& e) {
+    ThunderAutoLogger::Error("Edit journal error: {}", e.message());
+  } catch (const std::exception& e) {
+    ThunderAutoLogger::Error("Edit journal error: {}", e.what());
+  }
+}
+
+void EditJournal::openFile(const std::filesystem::path& projectPath, const ThunderAutoProjectState& baseState) {
+  m_filePath = PathForProject(projectPath);
+
+  m_file = std::fopen(m_filePath.string().c_str(), "wb");
+  if (!m_file) {
+    throw RuntimeError::Construct("Failed to create edit journal '{}'", m_filePath.string());
+  }
+
+  std::vector<uint8_t> header(kJournalMagic.begin(), kJournalMagic.end());
+  AppendLE(header, kJournalFormatVersion, sizeof(uint16_t));
+  std::fwrite(header.data(), 1, header.size(), m_file);
+
+  m_lastJournaledState = ProjectStateToJson(baseState);
+  writeRecord(kRecordTypeSnapshot, EncodeProjectJson(m_lastJournaledState));
+  sync();
+}
+
+void EditJournal::appendState(const ThunderAutoProjectState& state) {
+  if (!m_file)
+    return;
+
+  wpi::json stateJson = ProjectStateToJson(state);
+
+  wpi::json delta = DiffProjectJson(m_lastJournaledState, stateJson);
+  if (delta.empty())
+    return;
+
+  writeRecord(kRecordTypeDelta, EncodeProjectJson(delta));
+  m_lastJournaledState = std::move(stateJson);
+}
+
+void EditJournal::closeFile(bool discard) {
+  if (!m_file)
+    return;
+
+  std::fclose(m_file);
+  m_file = nullptr;
+  m_unsynced = false;
+  m_lastJournaledState = {};
+
+  if (discard) {
+    std::error_code ec;
+    std::filesystem::remove(m_filePath, ec);
+  }
+}
+
+void EditJournal::writeRecord(uint8_t type, std::span<const uint8_t> payload) {
+  std::vector<uint8_t> record;
+  record.reserve(kRecordHeaderSize + payload.size() + sizeof(uint32_t));
+
+  record.push_back(type);
+  AppendLE(record, static_cast<uint32_t>(payload.size()), sizeof(uint32_t));
+  record.insert(record.end(), payload.begin(), payload.end());
+  AppendLE(record, ComputeCRC32(record), sizeof(uint32_t));
+
+  if (std::fwrite(record.data(), 1, record.size(), m_file) != record.size()) {
+    throw RuntimeError::Construct("Failed to write to edit journal '{}'", m_filePath.string());
+  }
+
+  m_unsynced = true;
+}
+
+void EditJournal::sync() {
+  if (!m_file)
+    return;
+
+  std::fflush(m_file);
+#if THUNDERAUTO_WINDOWS
+  _commit(_fileno(m_file));
+#else
+  fsync(fileno(m_file));
+#endif
+
+  m_unsynced = false;
+  m_lastSyncTime = std::chrono::steady_clock::now();
+}
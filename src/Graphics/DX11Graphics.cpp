@@ -1,5 +1,7 @@
 #include "DX11Graphics.hpp"
 
+#include <ThunderAuto/StartupTimeline.hpp>
+
 #include <wrl/client.h>
 #include <windowsx.h>
 
@@ -39,15 +41,19 @@ void GraphicsDirectX11::init(App& app) {
 
   const DWORD ws = WS_THICKFRAME | WS_SYSMENU | WS_MAXIMIZEBOX | WS_MINIMIZEBOX | WS_VISIBLE;
 
+  StartupTimeline::get().beginPhase(StartupTimeline::Phase::WINDOW_CREATION);
   m_hwnd =
       CreateWindowExW(WS_EX_APPWINDOW, m_wc.lpszClassName, L"" DEFAULT_WINDOW_TITLE, ws, 100, 100,
                       DEFAULT_WINDOW_WIDTH, DEFAULT_WINDOW_HEIGHT, nullptr, nullptr, m_wc.hInstance, nullptr);
+  StartupTimeline::get().endPhase(StartupTimeline::Phase::WINDOW_CREATION);
 
   // Initialize DirectX
+  StartupTimeline::get().beginPhase(StartupTimeline::Phase::GRAPHICS_LOAD);
   if (!initDirectX()) {
     UnregisterClassW(m_wc.lpszClassName, m_wc.hInstance);
     exit(1);
   }
+  StartupTimeline::get().endPhase(StartupTimeline::Phase::GRAPHICS_LOAD);
 
   ShowWindow(m_hwnd, SW_SHOWDEFAULT);
   UpdateWindow(m_hwnd);
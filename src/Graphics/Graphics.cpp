@@ -3,6 +3,7 @@
 #include <ThunderAuto/Logger.hpp>
 #include <ThunderAuto/Error.hpp>
 
+#include <ThunderAuto/StartupTimeline.hpp>
 #include <ThunderAuto/UISizes.hpp>
 #include <ThunderAuto/ColorPalette.hpp>
 #include <ThunderLibCore/Error.hpp>
@@ -135,6 +136,22 @@ void Graphics::updateUIScale(double scale) {
   style.UserSizes[UISIZE_PROJECT_SETTINGS_PAGE_START_HEIGHT] = 350.f;
   style.UserSizes[UISIZE_REMOTE_UPDATE_PAGE_START_WIDTH] = 350.f;
   style.UserSizes[UISIZE_REMOTE_UPDATE_PAGE_START_HEIGHT] = 150.f;
+  style.UserSizes[UISIZE_HISTORY_PAGE_START_WIDTH] = 300.f;
+  style.UserSizes[UISIZE_HISTORY_PAGE_START_HEIGHT] = 400.f;
+  style.UserSizes[UISIZE_AUTO_MODE_ANALYSIS_PAGE_START_WIDTH] = 600.f;
+  style.UserSizes[UISIZE_AUTO_MODE_ANALYSIS_PAGE_START_HEIGHT] = 400.f;
+  style.UserSizes[UISIZE_TELEMETRY_PAGE_START_WIDTH] = 700.f;
+  style.UserSizes[UISIZE_TELEMETRY_PAGE_START_HEIGHT] = 450.f;
+  style.UserSizes[UISIZE_TELEMETRY_PAGE_AXIS_COMBO_WIDTH] = 130.f;
+  style.UserSizes[UISIZE_TELEMETRY_PAGE_PLOT_PADDING] = 4.f;
+  style.UserSizes[UISIZE_ROBOT_LOG_REPLAY_PAGE_START_WIDTH] = 350.f;
+  style.UserSizes[UISIZE_ROBOT_LOG_REPLAY_PAGE_START_HEIGHT] = 200.f;
+  style.UserSizes[UISIZE_SPEED_CONSTRAINT_TUNER_PAGE_START_WIDTH] = 650.f;
+  style.UserSizes[UISIZE_SPEED_CONSTRAINT_TUNER_PAGE_START_HEIGHT] = 450.f;
+  style.UserSizes[UISIZE_WAYPOINT_OPTIMIZER_PAGE_START_WIDTH] = 400.f;
+  style.UserSizes[UISIZE_WAYPOINT_OPTIMIZER_PAGE_START_HEIGHT] = 450.f;
+  style.UserSizes[UISIZE_IMAGE_EXPORT_PAGE_START_WIDTH] = 400.f;
+  style.UserSizes[UISIZE_IMAGE_EXPORT_PAGE_START_HEIGHT] = 300.f;
   // Popup sizes
   style.UserSizes[UISIZE_WELCOME_POPUP_WIDTH] = 630.f;
   style.UserSizes[UISIZE_WELCOME_POPUP_HEIGHT] = 235.f;
@@ -148,8 +165,10 @@ void Graphics::updateUIScale(double scale) {
   style.UserSizes[UISIZE_UNSAVED_POPUP_START_HEIGHT] = 115.f;
   style.UserSizes[UISIZE_PROJECT_VERSION_POPUP_START_WIDTH] = 550.f;
   style.UserSizes[UISIZE_PROJECT_VERSION_POPUP_START_HEIGHT] = 300.f;
+  style.UserSizes[UISIZE_RECOVERED_EDITS_POPUP_START_WIDTH] = 450.f;
   style.UserSizes[UISIZE_PROJECT_OPEN_ERROR_POPUP_START_WIDTH] = 800.f;
   style.UserSizes[UISIZE_PROJECT_OPEN_ERROR_POPUP_START_HEIGHT] = 96.f;
+  style.UserSizes[UISIZE_PROJECT_LOADING_POPUP_START_WIDTH] = 400.f;
   style.UserSizes[UISIZE_PROJECT_SAVE_ERROR_POPUP_START_WIDTH] = 800.f;
   style.UserSizes[UISIZE_PROJECT_SAVE_ERROR_POPUP_START_HEIGHT] = 96.f;
   style.UserSizes[UISIZE_CSV_EXPORT_POPUP_START_WIDTH] = 550.f;
@@ -232,6 +251,8 @@ static void mergeLucideIconsWithFont(double size, double scale) {
 }
 
 void Graphics::loadFonts(double scale) {
+  StartupTimeline::ScopedPhase scopedPhase(StartupTimeline::Phase::FONT_ATLAS);
+
   FontLibrary& fontLib = FontLibrary::get();
 
   ImGuiIO* io = &ImGui::GetIO();
@@ -1,5 +1,7 @@
 #include "OpenGLGraphics.hpp"
 
+#include <ThunderAuto/StartupTimeline.hpp>
+
 #include <imgui_impl_glfw.h>
 #include <imgui_impl_opengl3.h>
 
@@ -51,10 +53,12 @@ void GraphicsOpenGL::init(App& app) {
 #endif
 
   // Initialize window.
+  StartupTimeline::get().beginPhase(StartupTimeline::Phase::WINDOW_CREATION);
   m_window =
       glfwCreateWindow(DEFAULT_WINDOW_WIDTH, DEFAULT_WINDOW_HEIGHT, DEFAULT_WINDOW_TITLE, nullptr, nullptr);
   if (!m_window)
     exit(1);
+  StartupTimeline::get().endPhase(StartupTimeline::Phase::WINDOW_CREATION);
 
   glfwSetWindowSizeLimits(m_window, 700, 500, GLFW_DONT_CARE, GLFW_DONT_CARE);
 
@@ -64,7 +68,9 @@ void GraphicsOpenGL::init(App& app) {
   glfwSwapInterval(true);
 
   // Load OpenGL functions.
+  StartupTimeline::get().beginPhase(StartupTimeline::Phase::GRAPHICS_LOAD);
   gladLoadGLLoader((GLADloadproc)glfwGetProcAddress);
+  StartupTimeline::get().endPhase(StartupTimeline::Phase::GRAPHICS_LOAD);
 
   //
   // More ImGui setup.
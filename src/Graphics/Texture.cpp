@@ -11,37 +11,50 @@
 #endif
 
 #include <stb_image.h>
+#include <utility>
 
-void Texture::loadFromMemory(unsigned char* data, size_t size) {
-  if (!data || size == 0) {
-    throw InvalidArgumentError::Construct("Texture data is null or size is zero");
-  }
+TextureImage::~TextureImage() {
+  if (m_data)
+    stbi_image_free(m_data);
+}
 
-  if (!textureID()) {
-    if (!setup()) {
-      throw RuntimeError::Construct("Failed to setup texture");
-    }
+TextureImage::TextureImage(TextureImage&& other) noexcept
+    : m_data(std::exchange(other.m_data, nullptr)),
+      m_width(other.m_width),
+      m_height(other.m_height),
+      m_numChannels(other.m_numChannels) {}
+
+TextureImage& TextureImage::operator=(TextureImage&& other) noexcept {
+  if (this != &other) {
+    if (m_data)
+      stbi_image_free(m_data);
+
+    m_data = std::exchange(other.m_data, nullptr);
+    m_width = other.m_width;
+    m_height = other.m_height;
+    m_numChannels = other.m_numChannels;
   }
+  return *this;
+}
 
-  ThunderAutoLogger::Info("Loading texture from memory, size: {} bytes", size);
+TextureImage TextureImage::DecodeFromMemory(const unsigned char* data, size_t size) {
+  if (!data || size == 0) {
+    throw InvalidArgumentError::Construct("Texture data is null or size is zero");
+  }
 
-  int width = 0, height = 0, numChannels = 0;
+  ThunderAutoLogger::Info("Decoding image from memory, size: {} bytes", size);
 
-  unsigned char* imgData = stbi_load_from_memory(data, int(size), &width, &height, &numChannels, 0);
-  if (!imgData) {
+  TextureImage image;
+  image.m_data =
+      stbi_load_from_memory(data, int(size), &image.m_width, &image.m_height, &image.m_numChannels, 0);
+  if (!image.m_data) {
     throw RuntimeError::Construct("Failed to load image from memory: {}", stbi_failure_reason());
   }
 
-  bool result = setData(imgData, width, height, numChannels);
-
-  stbi_image_free(imgData);
-
-  if (!result) {
-    throw RuntimeError::Construct("Failed to set texture data from memory");
-  }
+  return image;
 }
 
-void Texture::loadFromFile(const std::filesystem::path& path) {
+TextureImage TextureImage::DecodeFromFile(const std::filesystem::path& path) {
   if (path.empty()) {
     throw InvalidArgumentError::Construct("Texture file path is empty");
   }
@@ -49,28 +62,49 @@ void Texture::loadFromFile(const std::filesystem::path& path) {
     throw RuntimeError::Construct("Texture file '{}' does not exist", path.string().c_str());
   }
 
-  if (!textureID()) {
-    if (!setup()) {
-      throw RuntimeError::Construct("Failed to setup texture");
-    }
+  ThunderAutoLogger::Info("Decoding image from file '{}'", path.string().c_str());
+
+  TextureImage image;
+  image.m_data =
+      stbi_load(path.string().c_str(), &image.m_width, &image.m_height, &image.m_numChannels, 0);
+  if (!image.m_data) {
+    throw RuntimeError::Construct("Failed to load image from file '{}': {}", path.string().c_str(),
+                                  stbi_failure_reason());
   }
 
-  ThunderAutoLogger::Info("Loading texture from file '{}'", path.string().c_str());
+  return image;
+}
 
-  int width = 0, height = 0, numChannels = 0;
+void Texture::loadFromMemory(unsigned char* data, size_t size) {
+  loadFromImage(TextureImage::DecodeFromMemory(data, size));
+}
 
-  unsigned char* imgData = stbi_load(path.string().c_str(), &width, &height, &numChannels, 0);
-  if (!imgData) {
-    throw RuntimeError::Construct("Failed to load image from file '{}': {}", path.string().c_str(),
-                                  stbi_failure_reason());
+void Texture::loadFromFile(const std::filesystem::path& path) {
+  loadFromImage(TextureImage::DecodeFromFile(path));
+}
+
+void Texture::loadFromImage(const TextureImage& image) {
+  if (!image.data()) {
+    throw InvalidArgumentError::Construct("Texture image has no data");
   }
 
-  bool result = setData(imgData, width, height, numChannels);
+  loadFromPixels(image.data(), image.width(), image.height(), image.numChannels());
+}
+
+void Texture::loadFromPixels(unsigned char* data, int width, int height, int numChannels) {
+  if (!data || width <= 0 || height <= 0) {
+    throw InvalidArgumentError::Construct("Texture pixels are null or empty");
+  }
 
-  stbi_image_free(imgData);
+  if (!textureID()) {
+    if (!setup()) {
+      throw RuntimeError::Construct("Failed to setup texture");
+    }
+  }
 
+  bool result = setData(data, width, height, numChannels);
   if (!result) {
-    throw RuntimeError::Construct("Failed to set texture data from file '{}'", path.string().c_str());
+    throw RuntimeError::Construct("Failed to set texture data");
   }
 }
 
@@ -102,3 +136,9 @@ std::unique_ptr<Texture> PlatformTexture::make(const std::filesystem::path& path
   texture->loadFromFile(path);  // will throw if error
   return texture;
 }
+
+std::unique_ptr<Texture> PlatformTexture::make(const TextureImage& image) {
+  std::unique_ptr<Texture> texture = PlatformTexture::make();
+  texture->loadFromImage(image);  // will throw if error
+  return texture;
+}
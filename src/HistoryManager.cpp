@@ -1,70 +1,437 @@
 #include <ThunderAuto/HistoryManager.hpp>
 
+#include <ThunderAuto/EditJournal.hpp>
+#include <ThunderAuto/ProjectStateCodec.hpp>
 #include <ThunderAuto/Logger.hpp>
 #include <ThunderAuto/Error.hpp>
+#include <algorithm>
+#include <utility>
 
-static constexpr size_t kMaxHistorySize = 100;
+// The oldest history is dropped for good once there are more nodes than this, or once this much history has
+// been spilled to disk.
+static constexpr size_t kMaxNodes = 10000;
+static constexpr size_t kMaxSpilledSize = 256 * 1024 * 1024;
+
+// Roughly how much bigger a project state is in memory than its encoded form.
+static constexpr size_t kEncodedToMemorySizeFactor = 3;
 
 void HistoryManager::reset(ThunderAutoProjectState state, bool unsaved) noexcept {
-  m_history.clear();
-  m_history.push_back(state);
-  m_currentState = m_history.cbegin();
+  m_nodes.clear();
+  m_spillStore.clear();
+  m_residentMemoryUsage = 0;
+  m_spilledSize = 0;
+  m_currentJson.reset();
+
+  size_t stateMemoryUsage = sizeof(ThunderAutoProjectState);
+  try {
+    m_currentJson = ProjectStateToJson(state);
+    stateMemoryUsage = EstimateMemoryUsage(*m_currentJson);
+  } catch (const std::exception& e) {
+    ThunderAutoLogger::Warn("Failed to measure project state size: {}", e.what());
+  }
+
+  m_rootNode = m_currentNode = createNode(kInvalidNodeID, std::move(state), stateMemoryUsage);
+
   m_unsaved = unsaved;
   m_locked = false;
 }
 
-void HistoryManager::addState(ThunderAutoProjectState state, bool unsaved) noexcept {
+void HistoryManager::addState(ThunderAutoProjectState state,
+                              const StateChangeSet& changes,
+                              bool unsaved) noexcept {
   ThunderAutoAssert(!m_locked, "HistoryManager is locked, cannot add state");
 
-  // Erase all states after the current state (the ones left over from undos).
-  m_history.erase(m_currentState + 1, m_history.cend());
+  // Adding a state never erases anything. If the current node already has children (the ones left over from
+  // undos), the new state just starts another branch.
+
+  try {
+    const wpi::json& parentJson = currentJson();
+    wpi::json stateJson = ProjectStateToJson(state);
+
+    std::vector<uint8_t> toParent = EncodeProjectJson(DiffProjectJson(stateJson, parentJson));
+    std::vector<uint8_t> fromParent = EncodeProjectJson(DiffProjectJson(parentJson, stateJson));
+
+    NodeID node = createNode(m_currentNode, std::move(state), EstimateMemoryUsage(stateJson));
+    Node& newNode = m_nodes.at(node);
+    setDeltas(newNode, std::move(toParent), std::move(fromParent));
+    newNode.changes = changes;
 
-  // Add the new state.
-  m_history.push_back(state);
+    m_currentNode = node;
+    m_currentJson = std::move(stateJson);
 
-  // Keep the history size under the limit.
-  if (m_history.size() > kMaxHistorySize) {
-    m_history.pop_front();
+  } catch (const std::exception& e) {
+    ThunderAutoLogger::Error("Failed to add state to undo history, clearing history: {}", e.what());
+    reset(std::move(state), true);
   }
 
-  m_currentState = m_history.cend() - 1;
+  enforceMemoryBudget();
 
   if (unsaved) {
     m_unsaved = true;
   }
+
+  journalCurrentState();
 }
 
-void HistoryManager::modifyLastState(ThunderAutoProjectState state, bool unsaved) noexcept {
+void HistoryManager::modifyLastState(ThunderAutoProjectState state,
+                                     const StateChangeSet& changes,
+                                     bool unsaved) noexcept {
   ThunderAutoAssert(!m_locked, "HistoryManager is locked, cannot add state");
-  if (m_history.empty()) {
+  if (m_nodes.empty()) {
     return;
   }
 
-  m_history.back() = state;
+  Node& node = m_nodes.at(m_currentNode);
+
+  try {
+    const wpi::json& oldJson = currentJson();
+    wpi::json stateJson = ProjectStateToJson(state);
+
+    // The deltas to the parent and children were relative to the old state, so recompute them. The same goes
+    // for what changed between them.
+
+    if (node.parent != kInvalidNodeID) {
+      const wpi::json parentJson = PatchProjectJson(oldJson, DecodeProjectJson(loadDelta(node.toParent)));
+      setDeltas(node, EncodeProjectJson(DiffProjectJson(stateJson, parentJson)),
+                EncodeProjectJson(DiffProjectJson(parentJson, stateJson)));
+      node.changes.merge(changes);
+    }
+
+    for (NodeID childID : node.children) {
+      Node& child = m_nodes.at(childID);
+      const wpi::json childJson = PatchProjectJson(oldJson, DecodeProjectJson(loadDelta(child.fromParent)));
+      setDeltas(child, EncodeProjectJson(DiffProjectJson(childJson, stateJson)),
+                EncodeProjectJson(DiffProjectJson(stateJson, childJson)));
+      child.changes.merge(changes);
+    }
+
+    m_residentMemoryUsage -= node.stateMemoryUsage;
+    node.stateMemoryUsage = EstimateMemoryUsage(stateJson);
+    m_residentMemoryUsage += node.stateMemoryUsage;
+
+    node.cachedState = std::move(state);
+    m_currentJson = std::move(stateJson);
+
+  } catch (const std::exception& e) {
+    ThunderAutoLogger::Error("Failed to modify undo history, clearing history: {}", e.what());
+    reset(std::move(state), true);
+  }
+
+  enforceMemoryBudget();
 
   if (unsaved) {
     m_unsaved = true;
   }
+
+  journalCurrentState();
 }
 
-void HistoryManager::undo() noexcept {
-  if (m_locked || m_currentState == m_history.cbegin())
-    return;
+StateChangeSet HistoryManager::undo() noexcept {
+  if (!canUndo())
+    return {};
 
   ThunderAutoLogger::Info("Undo");
 
-  // Roll back one state.
-  m_currentState--;
-  m_unsaved = true;
+  return jumpTo(m_nodes.at(m_currentNode).parent);
 }
 
-void HistoryManager::redo() noexcept {
-  if (m_locked || m_currentState == m_history.cend() - 1)
-    return;
+StateChangeSet HistoryManager::redo() noexcept {
+  if (!canRedo())
+    return {};
 
   ThunderAutoLogger::Info("Redo");
 
-  // Roll forward one state.
-  m_currentState++;
+  const Node& node = m_nodes.at(m_currentNode);
+  NodeID child = node.lastVisitedChild != kInvalidNodeID ? node.lastVisitedChild : node.children.back();
+
+  return jumpTo(child);
+}
+
+StateChangeSet HistoryManager::jumpTo(NodeID target) noexcept {
+  if (m_locked || target == m_currentNode || !m_nodes.contains(target))
+    return {};
+
+  StateChangeSet changes;
+  try {
+    changes = moveTo(target);
+  } catch (const std::exception& e) {
+    ThunderAutoLogger::Error("Failed to load undo history, clearing history: {}", e.what());
+    ThunderAutoProjectState state = currentState();
+    reset(std::move(state), true);
+    changes = StateChangeSet::Everything();
+  }
+
   m_unsaved = true;
+
+  enforceMemoryBudget();
+
+  journalCurrentState();
+
+  return changes;
+}
+
+void HistoryManager::setMemoryBudget(size_t bytes) noexcept {
+  m_memoryBudget = std::max(bytes, kMinMemoryBudget);
+
+  if (!m_nodes.empty()) {
+    enforceMemoryBudget();
+  }
+}
+
+void HistoryManager::journalCurrentState() noexcept {
+  if (m_journal) {
+    m_journal->record(currentState());
+  }
+}
+
+const wpi::json& HistoryManager::currentJson() const {
+  if (!m_currentJson) {
+    m_currentJson = ProjectStateToJson(currentState());
+  }
+  return *m_currentJson;
+}
+
+HistoryManager::NodeID HistoryManager::createNode(NodeID parent,
+                                                  ThunderAutoProjectState state,
+                                                  size_t stateMemoryUsage) {
+  const NodeID id = m_nextNodeID++;
+
+  Node node;
+  node.parent = parent;
+  node.cachedState = std::move(state);
+  node.stateMemoryUsage = stateMemoryUsage;
+  node.timestamp = Clock::now();
+  touch(node);
+
+  if (parent != kInvalidNodeID) {
+    Node& parentNode = m_nodes.at(parent);
+    parentNode.children.push_back(id);
+    parentNode.lastVisitedChild = id;
+    node.depth = parentNode.depth + 1;
+  }
+
+  m_nodes.emplace(id, std::move(node));
+
+  m_residentMemoryUsage += stateMemoryUsage;
+  m_treeVersion++;
+
+  return id;
+}
+
+void HistoryManager::setDeltas(Node& node, std::vector<uint8_t> toParent, std::vector<uint8_t> fromParent) {
+  releaseDelta(node.toParent);
+  releaseDelta(node.fromParent);
+
+  m_residentMemoryUsage += toParent.size() + fromParent.size();
+
+  node.toParent.data = std::move(toParent);
+  node.fromParent.data = std::move(fromParent);
+}
+
+void HistoryManager::removeSubtree(NodeID root) noexcept {
+  std::vector<NodeID> stack = {root};
+
+  while (!stack.empty()) {
+    NodeID id = stack.back();
+    stack.pop_back();
+
+    Node& node = m_nodes.at(id);
+    stack.insert(stack.end(), node.children.begin(), node.children.end());
+
+    if (node.cachedState) {
+      m_residentMemoryUsage -= node.stateMemoryUsage;
+    }
+    releaseDelta(node.toParent);
+    releaseDelta(node.fromParent);
+
+    m_nodes.erase(id);
+  }
+
+  m_treeVersion++;
+}
+
+void HistoryManager::releaseDelta(Delta& delta) noexcept {
+  m_residentMemoryUsage -= delta.data.size();
+  if (delta.spilledRecord) {
+    m_spilledSize -= delta.spilledRecord->size;
+  }
+
+  delta.data = {};
+  delta.spilledRecord.reset();
+}
+
+StateChangeSet HistoryManager::moveTo(NodeID target) {
+  // Find the path from the current node up to the common ancestor, and from there down to the target.
+
+  std::vector<NodeID> upPath, downPath;
+
+  NodeID up = m_currentNode, down = target;
+  while (m_nodes.at(up).depth > m_nodes.at(down).depth) {
+    upPath.push_back(up);
+    up = m_nodes.at(up).parent;
+  }
+  while (m_nodes.at(down).depth > m_nodes.at(up).depth) {
+    downPath.push_back(down);
+    down = m_nodes.at(down).parent;
+  }
+  while (up != down) {
+    upPath.push_back(up);
+    up = m_nodes.at(up).parent;
+    downPath.push_back(down);
+    down = m_nodes.at(down).parent;
+  }
+
+  // Whatever changed along the way, in either direction.
+  StateChangeSet changes;
+  for (NodeID id : upPath) {
+    changes.merge(m_nodes.at(id).changes);
+  }
+  for (NodeID id : downPath) {
+    changes.merge(m_nodes.at(id).changes);
+  }
+
+  Node& targetNode = m_nodes.at(target);
+
+  if (targetNode.cachedState) {
+    m_currentJson.reset();
+
+  } else {
+    // Patch the current JSON in place instead of copying the whole project at each step. If a patch fails
+    // partway, the current JSON is recomputed from the current state the next time it's needed.
+    currentJson();
+    wpi::json json = std::move(*m_currentJson);
+    m_currentJson.reset();
+
+    for (NodeID id : upPath) {
+      PatchProjectJsonInPlace(json, DecodeProjectJson(loadDelta(m_nodes.at(id).toParent)));
+    }
+    for (auto it = downPath.rbegin(); it != downPath.rend(); ++it) {
+      PatchProjectJsonInPlace(json, DecodeProjectJson(loadDelta(m_nodes.at(*it).fromParent)));
+    }
+
+    targetNode.cachedState = ProjectStateFromJson(json);
+    m_residentMemoryUsage += targetNode.stateMemoryUsage;
+
+    m_currentJson = std::move(json);
+  }
+
+  // Redo should follow the branch that was just taken.
+  for (NodeID id : downPath) {
+    m_nodes.at(m_nodes.at(id).parent).lastVisitedChild = id;
+  }
+
+  m_currentNode = target;
+  touch(targetNode);
+
+  return changes;
+}
+
+std::vector<uint8_t>& HistoryManager::loadDelta(Delta& delta) {
+  if (delta.data.empty()) {
+    ThunderAutoAssert(delta.spilledRecord.has_value(), "History delta is missing");
+
+    delta.data = m_spillStore.read(*delta.spilledRecord);
+    m_residentMemoryUsage += delta.data.size();
+  }
+  return delta.data;
+}
+
+void HistoryManager::enforceMemoryBudget() noexcept {
+  while (m_residentMemoryUsage > m_memoryBudget) {
+    if (evictLeastRecentlyUsedState())
+      continue;
+
+    if (spillOldestDelta())
+      continue;
+
+    break;
+  }
+
+  while ((m_nodes.size() > kMaxNodes || m_spilledSize > kMaxSpilledSize) && pruneOldest()) {
+  }
+}
+
+bool HistoryManager::evictLeastRecentlyUsedState() noexcept {
+  Node* leastRecentlyUsed = nullptr;
+
+  for (auto& [id, node] : m_nodes) {
+    if (id == m_currentNode || !node.cachedState)
+      continue;
+
+    if (!leastRecentlyUsed || node.lastUsed < leastRecentlyUsed->lastUsed) {
+      leastRecentlyUsed = &node;
+    }
+  }
+
+  if (!leastRecentlyUsed)
+    return false;
+
+  leastRecentlyUsed->cachedState.reset();
+  m_residentMemoryUsage -= leastRecentlyUsed->stateMemoryUsage;
+
+  return true;
+}
+
+bool HistoryManager::spillOldestDelta() noexcept {
+  for (auto& [id, node] : m_nodes) {
+    for (Delta* delta : {&node.toParent, &node.fromParent}) {
+      if (delta->data.empty())
+        continue;
+
+      try {
+        if (!delta->spilledRecord) {
+          delta->spilledRecord = m_spillStore.write(delta->data);
+          m_spilledSize += delta->spilledRecord->size;
+        }
+      } catch (const std::exception& e) {
+        ThunderAutoLogger::Error("Failed to spill undo history to disk: {}", e.what());
+        return false;
+      }
+
+      m_residentMemoryUsage -= delta->data.size();
+      delta->data = {};
+
+      return true;
+    }
+  }
+
+  return false;
+}
+
+bool HistoryManager::pruneOldest() noexcept {
+  if (m_rootNode == m_currentNode)
+    return false;
+
+  // Find the root's child that leads to the current node.
+  NodeID newRoot = m_currentNode;
+  while (m_nodes.at(newRoot).parent != m_rootNode) {
+    newRoot = m_nodes.at(newRoot).parent;
+  }
+
+  // Drop the root along with every branch that doesn't lead to the current node.
+  Node& root = m_nodes.at(m_rootNode);
+  for (NodeID child : root.children) {
+    if (child != newRoot) {
+      removeSubtree(child);
+    }
+  }
+  root.children.clear();
+  removeSubtree(m_rootNode);
+
+  Node& newRootNode = m_nodes.at(newRoot);
+  newRootNode.parent = kInvalidNodeID;
+  releaseDelta(newRootNode.toParent);
+  releaseDelta(newRootNode.fromParent);
+
+  m_rootNode = newRoot;
+
+  if (m_spilledSize == 0) {
+    m_spillStore.clear();
+  }
+
+  return true;
+}
+
+size_t HistoryManager::EstimateMemoryUsage(const wpi::json& stateJson) {
+  return sizeof(ThunderAutoProjectState) + EncodeProjectJson(stateJson).size() * kEncodedToMemorySizeFactor;
 }
@@ -0,0 +1,87 @@
+#include <ThunderAuto/HistorySpillStore.hpp>
+
+#include <ThunderAuto/ProjectStateCodec.hpp>
+#include <ThunderAuto/Logger.hpp>
+#include <ThunderAuto/Error.hpp>
+#include <fmt/format.h>
+#include <chrono>
+
+HistorySpillStore::~HistorySpillStore() {
+  clear();
+}
+
+HistorySpillStore::Record HistorySpillStore::write(std::span<const uint8_t> data) {
+  if (!m_file.is_open()) {
+    open();
+  }
+
+  Record record;
+  record.offset = m_fileSize;
+  record.size = static_cast<uint32_t>(data.size());
+  record.crc = ComputeCRC32(data);
+
+  m_file.seekp(static_cast<std::streamoff>(record.offset));
+  m_file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+  if (!m_file) {
+    m_file.clear();
+    throw RuntimeError::Construct("Failed to write to undo history file '{}'", m_path.string());
+  }
+
+  m_fileSize += data.size();
+
+  return record;
+}
+
+std::vector<uint8_t> HistorySpillStore::read(const Record& record) {
+  ThunderAutoAssert(m_file.is_open());
+  ThunderAutoAssert(record.offset + record.size <= m_fileSize);
+
+  std::vector<uint8_t> data(record.size);
+
+  m_file.flush();
+  m_file.seekg(static_cast<std::streamoff>(record.offset));
+  m_file.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size()));
+  if (!m_file) {
+    m_file.clear();
+    throw RuntimeError::Construct("Failed to read from undo history file '{}'", m_path.string());
+  }
+
+  if (ComputeCRC32(data) != record.crc) {
+    throw RuntimeError::Construct("Undo history file '{}' is corrupt", m_path.string());
+  }
+
+  return data;
+}
+
+void HistorySpillStore::clear() noexcept {
+  if (!m_file.is_open())
+    return;
+
+  m_file.close();
+  m_fileSize = 0;
+
+  std::error_code ec;
+  std::filesystem::remove(m_path, ec);
+}
+
+void HistorySpillStore::open() {
+  const auto uniqueID = std::chrono::steady_clock::now().time_since_epoch().count();
+
+  std::error_code ec;
+  std::filesystem::path tempDir = std::filesystem::temp_directory_path(ec);
+  if (ec) {
+    throw RuntimeError::Construct("Failed to find temp directory: {}", ec.message());
+  }
+
+  m_path = tempDir / fmt::format("ThunderAuto-history-{:x}-{:x}.bin", uniqueID,
+                                 reinterpret_cast<uintptr_t>(this));
+
+  m_file.open(m_path, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!m_file.is_open()) {
+    throw RuntimeError::Construct("Failed to create undo history file '{}'", m_path.string());
+  }
+
+  m_fileSize = 0;
+
+  ThunderAutoLogger::Info("Spilling undo history to '{}'", m_path.string());
+}
@@ -0,0 +1,317 @@
+#include <ThunderAuto/ImageExport.hpp>
+
+#include <ThunderAuto/AutoModeStepIndex.hpp>
+#include <ThunderAuto/PlaybackTimeline.hpp>
+#include <ThunderAuto/PngEncoder.hpp>
+#include <ThunderAuto/ThreadPool.hpp>
+#include <ThunderAuto/Logger.hpp>
+#include <ThunderAuto/Error.hpp>
+#include <ThunderLibCore/Auto/ThunderAutoOutputTrajectory.hpp>
+#include <ThunderLibCore/Math.hpp>
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <optional>
+#include <set>
+#include <span>
+#include <vector>
+
+namespace {
+
+using TrajectoryLayer = OffscreenRenderer::TrajectoryLayer;
+using RobotPose = OffscreenRenderer::RobotPose;
+
+// One image to draw and write.
+struct ImageJob {
+  // Shared by every frame of a trajectory or auto mode.
+  std::shared_ptr<const std::vector<TrajectoryLayer>> layers;
+
+  std::optional<RobotPose> robot;
+
+  std::filesystem::path path;
+};
+
+// What happened to one image.
+struct ImageJobResult {
+  bool isWritten = false;
+  std::string error;  // Empty if successful.
+};
+
+/**
+ * Turns a trajectory or auto mode name into a file name that stays in its directory on every platform. Names
+ * can turn into the same file name (e.g. "a/b" and "a_b", or "A" and "a" on case-insensitive file systems),
+ * so repeats get a number added.
+ */
+std::string SafeFileName(const std::string& name, std::set<std::string>& usedFileNames) {
+  std::string fileName = name;
+  for (char& c : fileName) {
+    if (static_cast<unsigned char>(c) < 0x20 || std::strchr("<>:\"/\\|?*", c)) {
+      c = '_';
+    }
+  }
+
+  // Windows drops trailing dots and spaces.
+  while (!fileName.empty() && (fileName.back() == '.' || fileName.back() == ' ')) {
+    fileName.pop_back();
+  }
+  if (fileName.empty()) {
+    fileName = "_";
+  }
+
+  auto toLower = [](std::string str) {
+    std::transform(str.begin(), str.end(), str.begin(), [](unsigned char c) { return std::tolower(c); });
+    return str;
+  };
+
+  std::string uniqueFileName = fileName;
+  for (size_t i = 2; !usedFileNames.insert(toLower(uniqueFileName)).second; i++) {
+    uniqueFileName = fmt::format("{} ({})", fileName, i);
+  }
+
+  return uniqueFileName;
+}
+
+RobotPose SampleRobotPose(const PlaybackTimeline& timeline, units::second_t time) {
+  const PlaybackTimeline::Sample sample = timeline.sample(time);
+
+  const ThunderAutoOutputTrajectoryPoint& lowerPoint = *sample.lowerPoint;
+  const ThunderAutoOutputTrajectoryPoint& upperPoint = *sample.upperPoint;
+  const double t = sample.t;
+
+  return RobotPose{
+      .position = Point2d(Lerp(lowerPoint.position.x, upperPoint.position.x, t),
+                          Lerp(lowerPoint.position.y, upperPoint.position.y, t)),
+      .rotation = Lerp(lowerPoint.rotation, upperPoint.rotation, t),
+  };
+}
+
+/**
+ * Adds the images of one trajectory or auto mode. The robot's poses are found here instead of in the jobs,
+ * since sampling a timeline isn't thread safe.
+ */
+void AddImageJobs(std::vector<ImageJob>& jobs,
+                  std::vector<std::string>& failures,
+                  std::shared_ptr<const std::vector<TrajectoryLayer>> layers,
+                  const PlaybackTimeline& timeline,
+                  const std::filesystem::path& basePath,
+                  const ImageExport::Options& options) {
+  if (!options.exportFrames) {
+    std::filesystem::path path = basePath;
+    path += ".png";
+    jobs.push_back(ImageJob{std::move(layers), std::nullopt, std::move(path)});
+    return;
+  }
+
+  std::error_code ec;
+  std::filesystem::create_directories(basePath, ec);
+  if (ec) {
+    failures.push_back(fmt::format("Failed to create directory '{}': {}", basePath.string(), ec.message()));
+    return;
+  }
+
+  // Nothing to play back, but still write a frame so that every trajectory and auto mode has one.
+  if (timeline.empty()) {
+    jobs.push_back(ImageJob{std::move(layers), std::nullopt, basePath / "frame_0000.png"});
+    return;
+  }
+
+  const size_t numFrames =
+      static_cast<size_t>(std::floor(timeline.totalTime().value() * options.framesPerSecond)) + 1;
+
+  for (size_t i = 0; i < numFrames; i++) {
+    const units::second_t time = units::second_t(static_cast<double>(i) / options.framesPerSecond);
+
+    jobs.push_back(ImageJob{
+        .layers = layers,
+        .robot = SampleRobotPose(timeline, time),
+        .path = basePath / fmt::format("frame_{:04}.png", i),
+    });
+  }
+}
+
+}  // namespace
+
+ImageExport::ImageExport(ThunderAutoProjectState state,
+                         ThunderAutoProjectSettings settings,
+                         std::filesystem::path outputDirectory,
+                         Options options)
+  : m_sharedState(std::make_shared<SharedState>()),
+    m_future(std::async(std::launch::async,
+                        &ImageExport::Run,
+                        std::move(state),
+                        std::move(settings),
+                        std::move(outputDirectory),
+                        std::move(options),
+                        m_sharedState)) {}
+
+float ImageExport::progress() const noexcept {
+  const size_t numTasks = m_sharedState->numTasks;
+  if (numTasks == 0)
+    return 0.f;
+
+  return static_cast<float>(m_sharedState->numFinishedTasks) / static_cast<float>(numTasks);
+}
+
+bool ImageExport::isFinished() const {
+  ThunderAutoAssert(m_future.valid(), "Image export result was already taken");
+
+  return m_future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+ImageExport::Result ImageExport::takeResult() {
+  ThunderAutoAssert(m_future.valid(), "Image export result was already taken");
+
+  return m_future.get();
+}
+
+ImageExport::Result ImageExport::Run(ThunderAutoProjectState state,
+                                     ThunderAutoProjectSettings settings,
+                                     std::filesystem::path outputDirectory,
+                                     Options options,
+                                     std::shared_ptr<SharedState> sharedState) {
+  Result result;
+
+  try {
+    if (options.exportFrames && !(options.framesPerSecond > 0.0)) {
+      throw InvalidArgumentError::Construct("Invalid frame rate {}", options.framesPerSecond);
+    }
+
+    const TextureImage fieldImage = EditorPage::DecodeFieldImage(settings.fieldImage);
+    const OffscreenRenderer renderer(settings, fieldImage, options.render);
+
+    sharedState->numTasks = state.trajectories.size();
+
+    // Build each trajectory once.
+
+    std::vector<std::future<std::unique_ptr<ThunderAutoOutputTrajectory>>> trajectoryFutures;
+    for (const auto& [trajectoryName, skeleton] : state.trajectories) {
+      trajectoryFutures.push_back(ThreadPool::get().submit([&skeleton, sharedState] {
+        std::unique_ptr<ThunderAutoOutputTrajectory> trajectory;
+        if (!sharedState->cancelled) {
+          trajectory = BuildThunderAutoOutputTrajectory(skeleton, kPreviewOutputTrajectorySettings);
+        }
+        sharedState->numFinishedTasks++;
+        return trajectory;
+      }));
+    }
+
+    std::vector<std::unique_ptr<ThunderAutoOutputTrajectory>> builtTrajectories =
+        ThreadPool::GetAll(trajectoryFutures);
+
+    if (sharedState->cancelled) {
+      result.cancelled = true;
+      return result;
+    }
+
+    std::map<std::string, const ThunderAutoOutputTrajectory*> trajectories;
+    auto builtTrajectoryIt = builtTrajectories.begin();
+    for (const auto& [trajectoryName, skeleton] : state.trajectories) {
+      trajectories.emplace(trajectoryName, (builtTrajectoryIt++)->get());
+    }
+
+    // Then work out every image to write.
+
+    std::vector<ImageJob> jobs;
+    PlaybackTimeline timeline;
+
+    const std::filesystem::path trajectoriesDirectory = outputDirectory / "trajectories";
+    std::filesystem::create_directories(trajectoriesDirectory);
+    std::set<std::string> trajectoryFileNames;
+
+    for (const auto& [trajectoryName, skeleton] : state.trajectories) {
+      const ThunderAutoOutputTrajectory* trajectory = trajectories.at(trajectoryName);
+
+      auto layers = std::make_shared<std::vector<TrajectoryLayer>>();
+      layers->push_back(TrajectoryLayer{&skeleton, trajectory, true});
+
+      timeline.clear();
+      timeline.addTrajectory(*trajectory);
+
+      AddImageJobs(jobs, result.failures, std::move(layers), timeline,
+                   trajectoriesDirectory / SafeFileName(trajectoryName, trajectoryFileNames), options);
+    }
+
+    const std::filesystem::path autoModesDirectory = outputDirectory / "auto_modes";
+    std::filesystem::create_directories(autoModesDirectory);
+    std::set<std::string> autoModeFileNames;
+
+    AutoModeStepIndex stepIndex;
+    for (const auto& [autoModeName, autoMode] : state.autoModes) {
+      stepIndex.rebuild(autoMode);
+
+      auto layers = std::make_shared<std::vector<TrajectoryLayer>>();
+      timeline.clear();
+
+      // Same order as the editor, so the displayed branches are drawn on top and played back in order.
+      std::span<const AutoModeStepIndex::Entry> entries = stepIndex.entries();
+      for (size_t entryIndex : stepIndex.editorOrder()) {
+        const AutoModeStepIndex::Entry& entry = entries[entryIndex];
+        if (entry.type != ThunderAutoModeStepType::TRAJECTORY)
+          continue;
+
+        auto trajectoryIt = trajectories.find(entry.itemName);
+        if (trajectoryIt == trajectories.end())
+          continue;
+
+        const ThunderAutoTrajectorySkeleton& skeleton = state.trajectories.at(entry.itemName);
+        layers->push_back(TrajectoryLayer{&skeleton, trajectoryIt->second, entry.isActive});
+
+        if (entry.isActive) {
+          timeline.addTrajectory(*trajectoryIt->second);
+        }
+      }
+
+      AddImageJobs(jobs, result.failures, std::move(layers), timeline,
+                   autoModesDirectory / SafeFileName(autoModeName, autoModeFileNames), options);
+    }
+
+    // Finally draw and write the images.
+
+    sharedState->numTasks += jobs.size();
+
+    // One image failing doesn't stop the rest.
+    std::vector<std::future<ImageJobResult>> imageFutures;
+    imageFutures.reserve(jobs.size());
+    for (const ImageJob& job : jobs) {
+      imageFutures.push_back(ThreadPool::get().submit([&job, &renderer, sharedState] {
+        ImageJobResult jobResult;
+        if (!sharedState->cancelled) {
+          try {
+            WritePNG(job.path, renderer.render(*job.layers, job.robot));
+            jobResult.isWritten = true;
+          } catch (const ThunderError& e) {
+            jobResult.error = e.message();
+          } catch (const std::exception& e) {
+            jobResult.error = e.what();
+          }
+        }
+        sharedState->numFinishedTasks++;
+        return jobResult;
+      }));
+    }
+
+    std::vector<ImageJobResult> jobResults = ThreadPool::GetAll(imageFutures);
+    for (size_t i = 0; i < jobs.size(); i++) {
+      result.numImages += jobResults[i].isWritten;
+
+      if (!jobResults[i].error.empty()) {
+        result.failures.push_back(
+            fmt::format("Failed to write '{}': {}", jobs[i].path.string(), jobResults[i].error));
+      }
+    }
+
+    result.cancelled = sharedState->cancelled;
+
+  } catch (const ThunderError& e) {
+    result.error = e.message();
+  } catch (const std::exception& e) {
+    result.error = e.what();
+  } catch (...) {
+    result.error = "Unknown error ocurred";
+  }
+
+  return result;
+}
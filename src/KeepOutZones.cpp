@@ -0,0 +1,112 @@
+#include <ThunderAuto/KeepOutZones.hpp>
+
+#include <ThunderAuto/Logger.hpp>
+#include <ThunderAuto/Error.hpp>
+#include <wpi/json.h>
+#include <fstream>
+#include <iterator>
+
+std::filesystem::path KeepOutZonesPathForProject(const std::filesystem::path& projectPath) {
+  std::filesystem::path zonesPath = projectPath;
+  zonesPath += ".keepout.json";
+  return zonesPath;
+}
+
+static wpi::json KeepOutZonesToJson(const KeepOutZoneList& zones) {
+  wpi::json zonesJson = wpi::json::array();
+
+  for (const KeepOutZone& zone : zones) {
+    wpi::json verticesJson = wpi::json::array();
+    for (const Point2d& vertex : zone.vertices) {
+      verticesJson.push_back(wpi::json::array({vertex.x.value(), vertex.y.value()}));
+    }
+
+    zonesJson.push_back({
+        {"name", zone.name},
+        {"vertices", std::move(verticesJson)},
+    });
+  }
+
+  return {
+      {"zones", std::move(zonesJson)},
+  };
+}
+
+static KeepOutZoneList KeepOutZonesFromJson(const wpi::json& json) {
+  KeepOutZoneList zones;
+
+  for (const wpi::json& zoneJson : json.at("zones")) {
+    KeepOutZone zone;
+    zone.name = zoneJson.at("name").get<std::string>();
+
+    for (const wpi::json& vertexJson : zoneJson.at("vertices")) {
+      zone.vertices.push_back(Point2d(units::meter_t(vertexJson.at(0).get<double>()),
+                                      units::meter_t(vertexJson.at(1).get<double>())));
+    }
+
+    if (zone.vertices.size() < 3) {
+      ThunderAutoLogger::Warn("Keep-out zone '{}' has less than 3 vertices, ignoring it", zone.name);
+      continue;
+    }
+
+    zones.push_back(std::move(zone));
+  }
+
+  return zones;
+}
+
+KeepOutZoneList LoadKeepOutZones(const std::filesystem::path& projectPath) {
+  const std::filesystem::path zonesPath = KeepOutZonesPathForProject(projectPath);
+
+  std::error_code ec;
+  if (!std::filesystem::exists(zonesPath, ec))
+    return {};
+
+  std::ifstream file(zonesPath);
+  if (!file) {
+    throw RuntimeError::Construct("Failed to open keep-out zones file '{}'", zonesPath.string());
+  }
+
+  const std::string data{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+
+  try {
+    return KeepOutZonesFromJson(wpi::json::parse(data));
+  } catch (const wpi::json::exception& e) {
+    throw RuntimeError::Construct("Keep-out zones file '{}' is not valid: {}", zonesPath.string(), e.what());
+  }
+}
+
+void SaveKeepOutZones(const std::filesystem::path& projectPath, const KeepOutZoneList& zones) {
+  const std::filesystem::path zonesPath = KeepOutZonesPathForProject(projectPath);
+
+  if (zones.empty()) {
+    std::error_code ec;
+    std::filesystem::remove(zonesPath, ec);
+    return;
+  }
+
+  std::ofstream file(zonesPath);
+  if (!file) {
+    throw RuntimeError::Construct("Failed to open keep-out zones file '{}' for writing", zonesPath.string());
+  }
+
+  file << KeepOutZonesToJson(zones).dump(2) << '\n';
+
+  if (!file) {
+    throw RuntimeError::Construct("Failed to write keep-out zones file '{}'", zonesPath.string());
+  }
+}
+
+KeepOutZone MakeDefaultKeepOutZone(std::string name, const Point2d& center) {
+  const units::meter_t halfSize = 0.5_m;
+
+  KeepOutZone zone;
+  zone.name = std::move(name);
+  zone.vertices = {
+      Point2d(center.x - halfSize, center.y - halfSize),
+      Point2d(center.x + halfSize, center.y - halfSize),
+      Point2d(center.x + halfSize, center.y + halfSize),
+      Point2d(center.x - halfSize, center.y + halfSize),
+  };
+  return zone;
+}
@@ -0,0 +1,114 @@
+#include <ThunderAuto/LivePoseSubscriber.hpp>
+
+#include <ThunderAuto/Logger.hpp>
+#include <bit>
+#include <numbers>
+#include <span>
+
+static double ReadDoubleLE(std::span<const uint8_t> data) {
+  uint64_t bits = 0;
+  for (size_t i = 0; i < sizeof(double); i++) {
+    bits |= static_cast<uint64_t>(data[i]) << (i * 8);
+  }
+  return std::bit_cast<double>(bits);
+}
+
+// Runs on the NetworkTables listener thread.
+static std::optional<LivePoseSubscriber::Sample> DecodePose(const nt::Value& value) {
+  LivePoseSubscriber::Sample sample;
+  sample.time = value.time();
+
+  if (value.IsRaw()) {
+    std::span<const uint8_t> raw = value.GetRaw();
+    if (raw.size() < sizeof(double) * 3)
+      return std::nullopt;
+
+    sample.x = ReadDoubleLE(raw);
+    sample.y = ReadDoubleLE(raw.subspan(sizeof(double)));
+    sample.rotation = ReadDoubleLE(raw.subspan(sizeof(double) * 2));
+    return sample;
+  }
+
+  if (value.IsDoubleArray()) {
+    std::span<const double> array = value.GetDoubleArray();
+    if (array.size() < 3)
+      return std::nullopt;
+
+    sample.x = array[0];
+    sample.y = array[1];
+    sample.rotation = array[2] * std::numbers::pi / 180.0;
+    return sample;
+  }
+
+  return std::nullopt;
+}
+
+void LivePoseSubscriber::subscribe(nt::NetworkTableInstance instance, std::string_view topicName) {
+  unsubscribe();
+
+  m_topicName = topicName;
+  m_shared = std::make_shared<Shared>();
+  m_shared->topic = instance.GetTopic(topicName).GetHandle();
+
+  // Listening to the topic's name as a prefix subscribes to it for as long as the listener exists. Other
+  // topics that happen to start with the same name are filtered out by handle.
+  std::string_view prefixes[] = {topicName};
+
+  auto onEvent = [shared = m_shared](const nt::Event& event) {
+    const nt::ValueEventData* valueData = event.GetValueEventData();
+    if (!valueData || valueData->topic != shared->topic)
+      return;
+
+    if (std::optional<Sample> sample = DecodePose(valueData->value)) {
+      // If the main thread falls behind, newer poses are dropped until it catches up.
+      (void)shared->samples.push(*sample);
+    }
+  };
+
+  const int eventMask = nt::EventFlags::kValueAll | nt::EventFlags::kImmediate;
+  m_listener = instance.AddListener(prefixes, eventMask, std::move(onEvent));
+
+  ThunderAutoLogger::Info("Subscribed to live robot pose topic '{}'", m_topicName);
+}
+
+void LivePoseSubscriber::unsubscribe() noexcept {
+  if (m_listener) {
+    nt::NetworkTableInstance::RemoveListener(m_listener);
+    m_listener = 0;
+  }
+
+  m_shared.reset();
+  m_topicName.clear();
+  m_trail.clear();
+}
+
+void LivePoseSubscriber::update() {
+  if (!m_shared)
+    return;
+
+  bool receivedSample = false;
+  while (std::optional<Sample> sample = m_shared->samples.pop()) {
+    // Start the trail over if time goes backwards (e.g. the robot program restarted).
+    if (!m_trail.empty() && sample->time < m_trail.back().time) {
+      m_trail.clear();
+    }
+
+    m_trail.push_back(*sample);
+    receivedSample = true;
+  }
+
+  if (receivedSample) {
+    m_lastSampleReceivedTime = std::chrono::steady_clock::now();
+  }
+
+  if (!m_trail.empty()) {
+    const int64_t trailStartTime = m_trail.back().time - kTrailDuration;
+    while (m_trail.front().time < trailStartTime) {
+      m_trail.pop_front();
+    }
+  }
+}
+
+bool LivePoseSubscriber::isStale() const noexcept {
+  return m_trail.empty() || std::chrono::steady_clock::now() - m_lastSampleReceivedTime > kStaleTimeout;
+}
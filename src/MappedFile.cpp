@@ -0,0 +1,104 @@
+#include <ThunderAuto/MappedFile.hpp>
+
+#include <ThunderAuto/Error.hpp>
+
+#if THUNDERAUTO_WINDOWS
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile(const std::filesystem::path& path) {
+#if THUNDERAUTO_WINDOWS
+  HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+                            OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    throw RuntimeError::Construct("Failed to open file '{}'", path.string());
+  }
+  m_fileHandle = file;
+
+  LARGE_INTEGER fileSize;
+  if (!GetFileSizeEx(file, &fileSize)) {
+    unmap();
+    throw RuntimeError::Construct("Failed to get the size of file '{}'", path.string());
+  }
+  m_size = static_cast<size_t>(fileSize.QuadPart);
+
+  // Empty files can't be mapped.
+  if (m_size == 0)
+    return;
+
+  HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (!mapping) {
+    unmap();
+    throw RuntimeError::Construct("Failed to map file '{}'", path.string());
+  }
+  m_mappingHandle = mapping;
+
+  m_data = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+  if (!m_data) {
+    unmap();
+    throw RuntimeError::Construct("Failed to map file '{}'", path.string());
+  }
+#else
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw RuntimeError::Construct("Failed to open file '{}'", path.string());
+  }
+
+  struct stat fileStat;
+  if (fstat(fd, &fileStat) != 0) {
+    close(fd);
+    throw RuntimeError::Construct("Failed to get the size of file '{}'", path.string());
+  }
+  m_size = static_cast<size_t>(fileStat.st_size);
+
+  // Empty files can't be mapped.
+  if (m_size == 0) {
+    close(fd);
+    return;
+  }
+
+  void* data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);  // The mapping keeps the file open.
+
+  if (data == MAP_FAILED) {
+    m_size = 0;
+    throw RuntimeError::Construct("Failed to map file '{}'", path.string());
+  }
+  m_data = static_cast<const uint8_t*>(data);
+
+  // Logs are read front to back.
+  madvise(data, m_size, MADV_SEQUENTIAL);
+#endif
+}
+
+MappedFile::~MappedFile() {
+  unmap();
+}
+
+void MappedFile::unmap() noexcept {
+#if THUNDERAUTO_WINDOWS
+  if (m_data) {
+    UnmapViewOfFile(m_data);
+  }
+  if (m_mappingHandle) {
+    CloseHandle(static_cast<HANDLE>(m_mappingHandle));
+  }
+  if (m_fileHandle) {
+    CloseHandle(static_cast<HANDLE>(m_fileHandle));
+  }
+  m_mappingHandle = nullptr;
+  m_fileHandle = nullptr;
+#else
+  if (m_data) {
+    munmap(const_cast<uint8_t*>(m_data), m_size);
+  }
+#endif
+
+  m_data = nullptr;
+  m_size = 0;
+}
@@ -0,0 +1,127 @@
+#include <ThunderAuto/NameSearchIndex.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <numeric>
+#include <utility>
+
+// How many of the query's trigrams a name needs to have to match, as a fraction.
+static constexpr size_t kMinTrigramMatchNumerator = 2;
+static constexpr size_t kMinTrigramMatchDenominator = 3;
+
+static std::string ToLowercase(std::string_view str) {
+  std::string lowercase(str);
+  std::transform(lowercase.begin(), lowercase.end(), lowercase.begin(),
+                 [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+  return lowercase;
+}
+
+static uint32_t Trigram(std::string_view str, size_t i) noexcept {
+  return (uint32_t(uint8_t(str[i])) << 16) | (uint32_t(uint8_t(str[i + 1])) << 8) |
+         uint32_t(uint8_t(str[i + 2]));
+}
+
+// Unique trigrams in a string, sorted.
+static std::vector<uint32_t> Trigrams(std::string_view str) {
+  std::vector<uint32_t> trigrams;
+  if (str.size() < 3)
+    return trigrams;
+
+  trigrams.reserve(str.size() - 2);
+  for (size_t i = 0; i + 2 < str.size(); i++) {
+    trigrams.push_back(Trigram(str, i));
+  }
+
+  std::sort(trigrams.begin(), trigrams.end());
+  trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+  return trigrams;
+}
+
+void NameSearchIndex::rebuild(std::vector<std::string> names) {
+  clear();
+
+  m_names = std::move(names);
+  m_lowercaseNames.reserve(m_names.size());
+  m_nameIndices.reserve(m_names.size());
+
+  for (size_t i = 0; i < m_names.size(); i++) {
+    m_lowercaseNames.push_back(ToLowercase(m_names[i]));
+    m_nameIndices.emplace(m_names[i], i);
+
+    for (uint32_t trigram : Trigrams(m_lowercaseNames[i])) {
+      m_trigramNames[trigram].push_back(static_cast<uint32_t>(i));
+    }
+  }
+}
+
+void NameSearchIndex::clear() noexcept {
+  m_names.clear();
+  m_lowercaseNames.clear();
+  m_nameIndices.clear();
+  m_trigramNames.clear();
+  m_version++;
+}
+
+void NameSearchIndex::search(std::string_view query, std::vector<size_t>& matches) const {
+  matches.clear();
+
+  const std::string lowercaseQuery = ToLowercase(query);
+
+  if (lowercaseQuery.empty()) {
+    matches.resize(m_names.size());
+    std::iota(matches.begin(), matches.end(), size_t(0));
+    return;
+  }
+
+  if (lowercaseQuery.size() < 3) {
+    for (size_t i = 0; i < m_lowercaseNames.size(); i++) {
+      if (m_lowercaseNames[i].find(lowercaseQuery) != std::string::npos) {
+        matches.push_back(i);
+      }
+    }
+    return;
+  }
+
+  const std::vector<uint32_t> queryTrigrams = Trigrams(lowercaseQuery);
+
+  std::vector<uint32_t> numSharedTrigrams(m_names.size(), 0);
+  for (uint32_t trigram : queryTrigrams) {
+    auto namesIt = m_trigramNames.find(trigram);
+    if (namesIt == m_trigramNames.end())
+      continue;
+
+    for (uint32_t nameIndex : namesIt->second) {
+      numSharedTrigrams[nameIndex]++;
+    }
+  }
+
+  const size_t minSharedTrigrams = std::max<size_t>(
+      1, (queryTrigrams.size() * kMinTrigramMatchNumerator + kMinTrigramMatchDenominator - 1) /
+             kMinTrigramMatchDenominator);
+
+  struct Match {
+    size_t nameIndex;
+    bool containsQuery;
+    uint32_t numSharedTrigrams;
+  };
+
+  std::vector<Match> rankedMatches;
+  for (size_t i = 0; i < m_names.size(); i++) {
+    if (numSharedTrigrams[i] < minSharedTrigrams)
+      continue;
+
+    const bool containsQuery = m_lowercaseNames[i].find(lowercaseQuery) != std::string::npos;
+    rankedMatches.push_back({i, containsQuery, numSharedTrigrams[i]});
+  }
+
+  std::stable_sort(rankedMatches.begin(), rankedMatches.end(), [](const Match& a, const Match& b) {
+    if (a.containsQuery != b.containsQuery)
+      return a.containsQuery;
+    return a.numSharedTrigrams > b.numSharedTrigrams;
+  });
+
+  matches.reserve(rankedMatches.size());
+  for (const Match& match : rankedMatches) {
+    matches.push_back(match.nameIndex);
+  }
+}
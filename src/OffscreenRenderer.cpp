@@ -0,0 +1,217 @@
+#include <ThunderAuto/OffscreenRenderer.hpp>
+
+#include <ThunderAuto/ColorPalette.hpp>
+#include <ThunderAuto/Error.hpp>
+#include <ThunderAuto/Types.hpp>
+#include <ThunderLibCore/Math.hpp>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+static const ImU32 kActionColor = ThunderAutoColorPalette::kOrangeMid;
+static const ImU32 kStartPointColor = ThunderAutoColorPalette::kGreenHigh;
+static const ImU32 kEndPointColor = ThunderAutoColorPalette::kRedHigh;
+static const ImU32 kInactiveTrajectoryColor = IM_COL32(64, 64, 64, 255);
+static const ImU32 kRobotColor = IM_COL32(128, 128, 128, 255);
+static const ImU32 kRobotFootprintColor = IM_COL32(128, 128, 128, 96);
+
+// Lines and points are the size the editor draws them when the field is this wide, and scale with the image.
+static constexpr float kReferenceImageWidth = 960.f;
+static constexpr float kReferenceLineThickness = 2.f;
+static constexpr float kReferencePointRadius = 5.f / 1.5f;
+
+// Keep the number of footprints reasonable.
+static constexpr units::second_t kMinRobotFootprintInterval = units::second_t(0.05);
+
+OffscreenRenderer::OffscreenRenderer(const ThunderAutoProjectSettings& settings,
+                                     const TextureImage& fieldImage,
+                                     const Options& options)
+  : m_options(options), m_robotSize(settings.robotSize) {
+  if (!fieldImage.data() || fieldImage.width() <= 0 || fieldImage.height() <= 0) {
+    throw InvalidArgumentError::Construct("Field image is empty");
+  }
+  if (options.imageWidth <= 0) {
+    throw InvalidArgumentError::Construct("Invalid image width {}", options.imageWidth);
+  }
+
+  const int width = options.imageWidth;
+  const int height = std::max(1, static_cast<int>(std::lround(static_cast<double>(width) *
+                                                               fieldImage.height() / fieldImage.width())));
+
+  // Scale the field image once, every image starts as a copy of it.
+  m_background.resize(width, height);
+  m_background.clear(ThunderAutoColorPalette::kBackground);
+  m_background.drawImage(fieldImage.data(), fieldImage.width(), fieldImage.height(), fieldImage.numChannels(),
+                         ImVec2(0.f, 0.f), ImVec2(static_cast<float>(width), static_cast<float>(height)));
+
+  // The image is the whole field image, like the editor's field when it isn't zoomed in.
+  const ImRect bb(ImVec2(0.f, 0.f), ImVec2(static_cast<float>(width), static_cast<float>(height)));
+  m_origin = EditorPage::ToScreenCoordinate(Point2d(0_m, 0_m), settings.fieldImage, bb);
+  m_scale = EditorPage::ToScreenCoordinate(Point2d(1_m, 1_m), settings.fieldImage, bb) - m_origin;
+
+  m_robotPolygon = PolylineToSoA(CreateRoundedRectangle(settings.robotSize, settings.robotCornerRadius));
+
+  const float sizeScale = static_cast<float>(width) / kReferenceImageWidth;
+  m_lineThickness = std::max(kReferenceLineThickness * sizeScale, 1.f);
+  m_pointRadius = std::max(kReferencePointRadius * sizeScale, 1.5f);
+}
+
+SoftwareCanvas OffscreenRenderer::render(std::span<const TrajectoryLayer> layers,
+                                         const std::optional<RobotPose>& robot) const {
+  SoftwareCanvas canvas = m_background;
+
+  if (m_options.showRobotFootprints) {
+    for (const TrajectoryLayer& layer : layers) {
+      if (layer.isActive) {
+        drawRobotFootprints(canvas, layer);
+      }
+    }
+  }
+
+  for (const TrajectoryLayer& layer : layers) {
+    drawTrajectory(canvas, layer);
+  }
+
+  if (m_options.showActions) {
+    for (const TrajectoryLayer& layer : layers) {
+      if (layer.isActive) {
+        drawActions(canvas, layer);
+      }
+    }
+  }
+
+  if (robot) {
+    drawRobot(canvas, *robot);
+  }
+
+  return canvas;
+}
+
+ImVec2 OffscreenRenderer::toImageCoordinate(const Point2d& fieldCoordinate) const noexcept {
+  const ImVec2 pt = ToImVec2(fieldCoordinate);
+  return ImVec2(m_origin.x + pt.x * m_scale.x, m_origin.y + pt.y * m_scale.y);
+}
+
+void OffscreenRenderer::drawTrajectory(SoftwareCanvas& canvas, const TrajectoryLayer& layer) const {
+  ThunderAutoAssert(layer.skeleton != nullptr);
+  ThunderAutoAssert(layer.trajectory != nullptr);
+
+  std::span<const ThunderAutoOutputTrajectoryPoint> points = layer.trajectory->points;
+  if (points.empty())
+    return;
+
+  for (size_t i = 1; i < points.size(); i++) {
+    ImU32 color = kInactiveTrajectoryColor;
+    if (layer.isActive) {
+      const float hue = EditorPage::TrajectoryOverlayHue(m_options.trajectoryOverlay, points[i - 1],
+                                                         points[i], *layer.skeleton);
+      color = ImColor::HSV(hue, 1.f, 1.f);
+    }
+
+    canvas.drawLine(toImageCoordinate(points[i - 1].position), toImageCoordinate(points[i].position), color,
+                    m_lineThickness);
+  }
+
+  if (layer.isActive) {
+    canvas.fillCircle(toImageCoordinate(points.front().position), m_pointRadius, kStartPointColor);
+    canvas.fillCircle(toImageCoordinate(points.back().position), m_pointRadius, kEndPointColor);
+  }
+}
+
+void OffscreenRenderer::drawActions(SoftwareCanvas& canvas, const TrajectoryLayer& layer) const {
+  const ThunderAutoOutputTrajectory& trajectory = *layer.trajectory;
+  if (trajectory.points.empty())
+    return;
+
+  const float lineLength = m_pointRadius * 1.5f * 3.f;
+
+  for (const auto& [positionInTrajectory, action] : layer.skeleton->actions()) {
+    size_t pointIndex = trajectory.trajectoryPositionToPointIndex(positionInTrajectory);
+    const ThunderAutoOutputTrajectoryPoint& point = trajectory.points.at(pointIndex);
+
+    const ImVec2 pt = toImageCoordinate(point.position);
+
+    // Same as the editor's action drag widget, a point with a line across the path.
+    const double headingRadians = point.heading.radians().value();
+    const float dy = static_cast<float>(std::cos(headingRadians)) * (lineLength / 2.f);
+    const float dx = static_cast<float>(std::sin(headingRadians)) * (lineLength / 2.f);
+
+    canvas.drawLine(ImVec2(pt.x + dx, pt.y + dy), ImVec2(pt.x - dx, pt.y - dy), kActionColor,
+                    m_lineThickness);
+    canvas.fillCircle(pt, m_pointRadius, kActionColor);
+  }
+}
+
+void OffscreenRenderer::drawRobotFootprints(SoftwareCanvas& canvas, const TrajectoryLayer& layer) const {
+  std::span<const ThunderAutoOutputTrajectoryPoint> points = layer.trajectory->points;
+  if (points.empty())
+    return;
+
+  const units::second_t interval = std::max(m_options.robotFootprintInterval, kMinRobotFootprintInterval);
+
+  const units::second_t startTime = points.front().time;
+  const units::second_t totalTime = points.back().time - startTime;
+  const size_t numIntervals = static_cast<size_t>(totalTime / interval);
+
+  std::vector<PolygonTransform> transforms;
+  transforms.reserve(numIntervals + 2);
+
+  // Sample times only increase, so walk the points forward instead of searching for each one.
+  auto upperIt = points.begin();
+
+  for (size_t i = 0; i <= numIntervals + 1; i++) {
+    // The last footprint is always at the end of the trajectory.
+    const units::second_t time =
+        (i <= numIntervals) ? startTime + interval * static_cast<double>(i) : points.back().time;
+
+    while (std::next(upperIt) != points.end() && upperIt->time < time) {
+      ++upperIt;
+    }
+    auto lowerIt = (upperIt == points.begin()) ? upperIt : std::prev(upperIt);
+
+    const units::second_t dt = upperIt->time - lowerIt->time;
+    const double t = dt > 0_s ? std::clamp((time - lowerIt->time).value() / dt.value(), 0.0, 1.0) : 0.0;
+
+    const Point2d position = Point2d(Lerp(lowerIt->position.x, upperIt->position.x, t),
+                                     Lerp(lowerIt->position.y, upperIt->position.y, t));
+
+    const CanonicalAngle rotation = Lerp(lowerIt->rotation, upperIt->rotation, t);
+
+    transforms.push_back(PolygonTransform::FromPose(position, rotation));
+  }
+
+  drawRobotOutlines(canvas, transforms, kRobotFootprintColor);
+}
+
+void OffscreenRenderer::drawRobot(SoftwareCanvas& canvas, const RobotPose& robot) const {
+  const PolygonTransform transform = PolygonTransform::FromPose(robot.position, robot.rotation);
+  drawRobotOutlines(canvas, std::span(&transform, 1), kRobotColor);
+
+  const Point2d rotationPoint = robot.position.extendAtAngle(robot.rotation, m_robotSize.length / 2.f);
+  canvas.fillCircle(toImageCoordinate(rotationPoint), m_pointRadius, kRobotColor);
+}
+
+void OffscreenRenderer::drawRobotOutlines(SoftwareCanvas& canvas,
+                                          std::span<const PolygonTransform> transforms,
+                                          ImU32 color) const {
+  const size_t numVertices = m_robotPolygon.size();
+  if (!numVertices || transforms.empty())
+    return;
+
+  std::vector<float> x(transforms.size() * numVertices);
+  std::vector<float> y(transforms.size() * numVertices);
+  TransformPolygonBatch(m_robotPolygon, transforms, x, y);
+
+  std::vector<ImVec2> outline(numVertices);
+
+  for (size_t i = 0; i < transforms.size(); i++) {
+    const float* outlineX = x.data() + i * numVertices;
+    const float* outlineY = y.data() + i * numVertices;
+
+    for (size_t j = 0; j < numVertices; j++) {
+      outline[j] = ImVec2(m_origin.x + outlineX[j] * m_scale.x, m_origin.y + outlineY[j] * m_scale.y);
+    }
+
+    canvas.drawPolyline(outline, color, m_lineThickness, true);
+  }
+}
@@ -5,6 +5,10 @@
 #include <ThunderAuto/Error.hpp>
 #include <IconsLucide.h>
 #include <imgui_raii.h>
+#include <fmt/ranges.h>
+#include <algorithm>
+#include <span>
+#include <vector>
 
 void ActionsPage::present(bool* running) {
   m_event = Event::NONE;
@@ -18,13 +22,55 @@ void ActionsPage::present(bool* running) {
 
   ThunderAutoProjectState state = m_history.currentState();
 
-  std::vector<std::string> actionsOrder = state.actionsOrder;
-  for (size_t actionIndex = 0; actionIndex < actionsOrder.size(); actionIndex++) {
-    const std::string& actionName = actionsOrder[actionIndex];
+  std::string actionToDeleteName;
+
+  m_searchBox.present("Search actions");
+
+  const NameSearchIndex& nameIndex = m_history.actionNameIndex();
+  const std::vector<size_t>& matches = m_searchBox.matches(nameIndex);
+  const uint64_t nameIndexVersion = nameIndex.version();
+
+  if (m_rowHeightsNameIndexVersion != nameIndexVersion) {
+    m_rowHeightsNameIndexVersion = nameIndexVersion;
+    std::erase_if(m_rowHeights, [&](const auto& rowHeight) { return !nameIndex.contains(rowHeight.first); });
+  }
+
+  if (matches.empty() && m_searchBox.isSearching()) {
+    ImGui::TextDisabled("No matching actions");
+  }
+
+  // Only the rows in view are drawn. Open rows are taller than closed ones, so the rows out of view are
+  // skipped over using the height they had the last time they were drawn.
+  const float visibleTop = ImGui::GetScrollY();
+  const float visibleBottom = visibleTop + ImGui::GetWindowHeight();
+  const float closedRowHeight = ImGui::GetFrameHeight() + GET_UISIZE(SELECTABLE_LIST_ITEM_SPACING_Y) / 3.f;
+
+  float rowY = ImGui::GetCursorPosY();
+
+  for (size_t matchIndex = 0; matchIndex < matches.size(); matchIndex++) {
+    // Moving an action reorders the names, which makes the rest of the matches out of date.
+    if (nameIndex.version() != nameIndexVersion)
+      break;
+
+    {
+      const std::string& indexedActionName = nameIndex.names()[matches[matchIndex]];
+
+      auto rowHeightIt = m_rowHeights.find(indexedActionName);
+      const float rowHeight = rowHeightIt != m_rowHeights.end() ? rowHeightIt->second : closedRowHeight;
+      if (rowY + rowHeight < visibleTop || rowY > visibleBottom) {
+        rowY += rowHeight;
+        continue;
+      }
+    }
+
+    const std::string actionName = nameIndex.names()[matches[matchIndex]];
     ThunderAutoAction& actionInfo = state.getAction(actionName);
 
+    ImGui::SetCursorPosY(rowY);
+
     {
-      auto scopedID = ImGui::Scoped::ID(actionIndex);
+      // Keyed by name so that a row stays open when the search changes which rows come before it.
+      auto scopedID = ImGui::Scoped::ID(actionName.c_str());
       auto scopedPadding = ImGui::Scoped::StyleVarY(ImGuiStyleVar_ItemSpacing, 0.f);
 
       const float spacingX = std::max(ImGui::GetContentRegionAvail().x, 1.f);
@@ -56,8 +102,7 @@ void ActionsPage::present(bool* running) {
           m_eventActionName = actionName;
         }
         if (ImGui::MenuItem(ICON_LC_TRASH "  Delete")) {
-          state.removeAction(actionName);
-          m_history.addState(state);
+          actionToDeleteName = actionName;
         }
       }
 
@@ -172,11 +217,19 @@ void ActionsPage::present(bool* running) {
             bool newAction = false;
 
             if (auto scopedCombo = ImGui::Scoped::Combo("##Group Add Action Combo", nullptr)) {
-              for (const std::string& addActionName : actionsOrder) {
-                auto scopedDisabled = ImGui::Scoped::Disabled(actionName == addActionName ||
-                                                              actionInfo.hasGroupAction(addActionName));
-                if (ImGui::Selectable(addActionName.c_str())) {
-                  selectedAction = addActionName;
+              const std::vector<std::string>& actionsOrder = state.actionsOrder;
+
+              ImGuiListClipper clipper;
+              clipper.Begin(static_cast<int>(actionsOrder.size()));
+              while (clipper.Step()) {
+                for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++) {
+                  const std::string& addActionName = actionsOrder[i];
+
+                  auto scopedDisabled = ImGui::Scoped::Disabled(actionName == addActionName ||
+                                                                actionInfo.hasGroupAction(addActionName));
+                  if (ImGui::Selectable(addActionName.c_str())) {
+                    selectedAction = addActionName;
+                  }
                 }
               }
 
@@ -202,24 +255,45 @@ void ActionsPage::present(bool* running) {
             }
           }
         }
+
+        if (actionInfo.type() == SEQUENTIAL_ACTION_GROUP || actionInfo.type() == CONCURRENT_ACTION_GROUP) {
+          auto scopedField =
+              ImGui::ScopedField::Builder("Runs").leftColumnWidth(fieldLeftColumnWidth).build();
+
+          // Every command the group ends up running, with nested groups expanded.
+          std::span<const std::string> leafActions = m_history.actionGraph().leafActions(actionName);
+          if (leafActions.empty()) {
+            ImGui::TextDisabled("Nothing");
+          } else {
+            ImGui::TextWrapped("%s", fmt::format("{}", fmt::join(leafActions, ", ")).c_str());
+          }
+        }
       }
     }
 
-    if (actionIndex == actionsOrder.size() - 1) {
-      auto scopedID = ImGui::Scoped::ID("Bottom Drag Target");
+    const float drawnRowHeight = ImGui::GetCursorPosY() - rowY;
+    m_rowHeights[actionName] = drawnRowHeight;
+    rowY += drawnRowHeight;
+  }
 
-      const float spacingX = std::max(ImGui::GetContentRegionAvail().x, 1.f);
-      const float spacingY = GET_UISIZE(SELECTABLE_LIST_ITEM_SPACING_Y) / 3.f;
-      (void)ImGui::InvisibleButton("Drag Separator", ImVec2(spacingX, spacingY));
+  ImGui::SetCursorPosY(rowY);
 
-      if (auto scopedDragTarget = ImGui::Scoped::DragDropTarget()) {
-        if (const ImGuiPayload* payload = ImGui::AcceptDragDropPayload("Action")) {
-          std::string payloadActionName = reinterpret_cast<const char*>(payload->Data);
-          if (actionName != payloadActionName) {
-            ThunderAutoLogger::Info("Move action '{}' after action '{}'", payloadActionName, actionName);
-            state.moveActionAfterOther(payloadActionName, actionName);
-            m_history.addState(state);
-          }
+  if (!matches.empty() && nameIndex.version() == nameIndexVersion) {
+    const std::string& lastActionName = nameIndex.names()[matches.back()];
+
+    auto scopedID = ImGui::Scoped::ID("Bottom Drag Target");
+
+    const float spacingX = std::max(ImGui::GetContentRegionAvail().x, 1.f);
+    const float spacingY = GET_UISIZE(SELECTABLE_LIST_ITEM_SPACING_Y) / 3.f;
+    (void)ImGui::InvisibleButton("Drag Separator", ImVec2(spacingX, spacingY));
+
+    if (auto scopedDragTarget = ImGui::Scoped::DragDropTarget()) {
+      if (const ImGuiPayload* payload = ImGui::AcceptDragDropPayload("Action")) {
+        std::string payloadActionName = reinterpret_cast<const char*>(payload->Data);
+        if (lastActionName != payloadActionName) {
+          ThunderAutoLogger::Info("Move action '{}' after action '{}'", payloadActionName, lastActionName);
+          state.moveActionAfterOther(payloadActionName, lastActionName);
+          m_history.addState(state);
         }
       }
     }
@@ -231,12 +305,18 @@ void ActionsPage::present(bool* running) {
     m_event = Event::NEW_ACTION;
     m_eventActionName.clear();
   }
+
+  if (!actionToDeleteName.empty()) {
+    state.removeAction(actionToDeleteName);
+    m_history.addState(state);
+  }
 }
 
 bool ActionsPage::verifyAddedGroupAction(const ThunderAutoProjectState& state,
                                          const std::string& groupActionName,
                                          const std::string& addedActionName) {
-  m_eventActionRecursionPath = state.findActionRecursionPath(addedActionName);
+  m_eventActionRecursionPath =
+      m_history.actionGraph().findRecursionPathIfAdded(state, groupActionName, addedActionName);
   if (!m_eventActionRecursionPath.empty()) {
     m_event = Event::INVALID_OPERATION_RECURSIVE_ACTION;
     m_eventActionName = groupActionName;
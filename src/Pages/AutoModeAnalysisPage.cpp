@@ -0,0 +1,165 @@
+#include <ThunderAuto/Pages/AutoModeAnalysisPage.hpp>
+
+#include <ThunderAuto/Logger.hpp>
+#include <IconsLucide.h>
+#include <imgui_raii.h>
+#include <algorithm>
+#include <span>
+
+enum AutoModeAnalysisColumn : ImGuiID {
+  AUTO_MODE_ANALYSIS_COLUMN_AUTO_MODE = 0,
+  AUTO_MODE_ANALYSIS_COLUMN_BRANCHES,
+  AUTO_MODE_ANALYSIS_COLUMN_TIME,
+  AUTO_MODE_ANALYSIS_COLUMN_FINAL_POSE,
+};
+
+void AutoModeAnalysisPage::present(bool* running) {
+  ImGui::SetNextWindowSize(ImVec2(GET_UISIZE(AUTO_MODE_ANALYSIS_PAGE_START_WIDTH),
+                                  GET_UISIZE(AUTO_MODE_ANALYSIS_PAGE_START_HEIGHT)),
+                           ImGuiCond_FirstUseEver);
+  ImGui::Scoped scopedWindow = ImGui::Scoped::Window(name(), running);
+  if (!scopedWindow || (running && !*running))
+    return;
+
+  if (m_analysis && m_analysis->isFinished()) {
+    m_result = m_analysis->takeResult();
+    m_hasResult = !m_result.cancelled;
+    m_analysis.reset();
+
+    if (!m_result.error.empty()) {
+      ThunderAutoLogger::Error("Auto mode analysis failed: {}", m_result.error);
+    }
+  }
+
+  if (m_analysis) {
+    ImGui::ProgressBar(m_analysis->progress(), ImVec2(-FLT_MIN, 0.f), "Analyzing...");
+    if (ImGui::Button(ICON_LC_X "  Cancel")) {
+      m_analysis->cancel();
+    }
+  } else if (ImGui::Button(ICON_LC_PLAY "  Analyze")) {
+    ThunderAutoLogger::Info("Analyze auto modes");
+    m_analysis = std::make_unique<AutoModeAnalysis>(m_history.currentState());
+  }
+
+  if (!m_hasResult)
+    return;
+
+  ImGui::Spacing();
+
+  if (!m_result.error.empty()) {
+    ImGui::TextWrapped(ICON_LC_TRIANGLE_ALERT "  Analysis failed: %s", m_result.error.c_str());
+    return;
+  }
+
+  const size_t numOverBudget =
+      std::ranges::count_if(m_result.combinations, [](const AutoModeAnalysis::Combination& combination) {
+        return combination.exceedsAutonomousPeriod();
+      });
+
+  ImGui::Text("%zu combinations, %zu over %.0f s", m_result.combinations.size(), numOverBudget,
+              AutoModeAnalysis::kAutonomousPeriod.value());
+
+  for (const std::string& autoModeName : m_result.truncatedAutoModes) {
+    ImGui::TextDisabled(ICON_LC_TRIANGLE_ALERT "  Only the first %zu combinations of '%s' are shown",
+                        AutoModeAnalysis::kMaxCombinationsPerAutoMode, autoModeName.c_str());
+  }
+
+  ImGui::Spacing();
+
+  presentResultsTable();
+}
+
+void AutoModeAnalysisPage::reset() noexcept {
+  m_analysis.reset();
+  m_result = {};
+  m_hasResult = false;
+}
+
+void AutoModeAnalysisPage::presentResultsTable() {
+  const ImGuiTableFlags tableFlags = ImGuiTableFlags_Sortable | ImGuiTableFlags_SortMulti |
+                                     ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV |
+                                     ImGuiTableFlags_Resizable | ImGuiTableFlags_ScrollY;
+
+  if (!ImGui::BeginTable("Combinations", 4, tableFlags))
+    return;
+
+  ImGui::TableSetupScrollFreeze(0, 1);
+  ImGui::TableSetupColumn("Auto Mode", ImGuiTableColumnFlags_DefaultSort, 0.f,
+                          AUTO_MODE_ANALYSIS_COLUMN_AUTO_MODE);
+  ImGui::TableSetupColumn("Branches", ImGuiTableColumnFlags_WidthStretch, 0.f,
+                          AUTO_MODE_ANALYSIS_COLUMN_BRANCHES);
+  ImGui::TableSetupColumn("Time", ImGuiTableColumnFlags_PreferSortDescending, 0.f,
+                          AUTO_MODE_ANALYSIS_COLUMN_TIME);
+  ImGui::TableSetupColumn("Final Pose", ImGuiTableColumnFlags_NoSort, 0.f,
+                          AUTO_MODE_ANALYSIS_COLUMN_FINAL_POSE);
+  ImGui::TableHeadersRow();
+
+  if (ImGuiTableSortSpecs* sortSpecs = ImGui::TableGetSortSpecs(); sortSpecs && sortSpecs->SpecsDirty) {
+    sortCombinations(*sortSpecs);
+    sortSpecs->SpecsDirty = false;
+  }
+
+  const ImU32 overBudgetColor = ImGui::GetColorU32(ImVec4(0.8f, 0.2f, 0.2f, 0.35f));
+
+  ImGuiListClipper clipper;
+  clipper.Begin(static_cast<int>(m_result.combinations.size()));
+  while (clipper.Step()) {
+    for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++) {
+      const AutoModeAnalysis::Combination& combination = m_result.combinations[i];
+
+      ImGui::TableNextRow();
+      if (combination.exceedsAutonomousPeriod()) {
+        ImGui::TableSetBgColor(ImGuiTableBgTarget_RowBg1, overBudgetColor);
+      }
+
+      ImGui::TableNextColumn();
+      ImGui::TextUnformatted(combination.autoModeName.c_str());
+
+      ImGui::TableNextColumn();
+      ImGui::TextUnformatted(combination.branches.empty() ? "-" : combination.branches.c_str());
+
+      ImGui::TableNextColumn();
+      ImGui::Text("%.2f s", combination.totalTime.value());
+
+      ImGui::TableNextColumn();
+      if (combination.finalPosition && combination.finalRotation) {
+        ImGui::Text("(%.2f m, %.2f m) %.1f deg", combination.finalPosition->x(),
+                    combination.finalPosition->y(), combination.finalRotation->degrees()());
+      } else {
+        ImGui::TextDisabled("-");
+      }
+    }
+  }
+
+  ImGui::EndTable();
+}
+
+void AutoModeAnalysisPage::sortCombinations(const ImGuiTableSortSpecs& sortSpecs) {
+  std::span<const ImGuiTableColumnSortSpecs> specs(sortSpecs.Specs, sortSpecs.SpecsCount);
+
+  auto compare = [&](const AutoModeAnalysis::Combination& a, const AutoModeAnalysis::Combination& b) {
+    for (const ImGuiTableColumnSortSpecs& spec : specs) {
+      int delta = 0;
+      switch (spec.ColumnUserID) {
+        case AUTO_MODE_ANALYSIS_COLUMN_AUTO_MODE:
+          delta = a.autoModeName.compare(b.autoModeName);
+          break;
+        case AUTO_MODE_ANALYSIS_COLUMN_BRANCHES:
+          delta = a.branches.compare(b.branches);
+          break;
+        case AUTO_MODE_ANALYSIS_COLUMN_TIME:
+          delta = (a.totalTime < b.totalTime) ? -1 : (a.totalTime > b.totalTime ? 1 : 0);
+          break;
+        default:
+          break;
+      }
+
+      if (delta != 0) {
+        return spec.SortDirection == ImGuiSortDirection_Ascending ? delta < 0 : delta > 0;
+      }
+    }
+    return false;
+  };
+
+  std::stable_sort(m_result.combinations.begin(), m_result.combinations.end(), compare);
+}
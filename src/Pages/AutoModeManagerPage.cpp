@@ -2,6 +2,8 @@
 #include <ThunderAuto/ColorPalette.hpp>
 #include <IconsLucide.h>
 #include <imgui_raii.h>
+#include <optional>
+#include <vector>
 
 void AutoModeManagerPage::present(bool* running) {
   m_event = Event::NONE;
@@ -22,66 +24,96 @@ void AutoModeManagerPage::present(bool* running) {
 
   std::string autoModeToDeleteName;
 
-  for (auto& [autoModeName, autoMode] : autoModes) {
-    const bool isAutoModeSelected =
-        isInAutoModeState && (autoModeName == autoModeEditorState.currentAutoModeName);
+  m_searchBox.present("Search auto modes");
 
-    // TODO: Only compute once for both properties page and auto mode manager page.
-    ThunderAutoModeStepTrajectoryBehavior trajectoryBehavior =
-        autoMode.getTrajectoryBehavior(state.trajectories);
-    if (trajectoryBehavior.errorInfo) {
-      ImGui::PushStyleColor(ImGuiCol_Text, (ImU32)ThunderAutoColorPalette::kYellow);
-    }
+  const NameSearchIndex& nameIndex = m_history.autoModeNameIndex();
+  const std::vector<size_t>& matches = m_searchBox.matches(nameIndex);
 
-    auto scopedPadding =
-        ImGui::Scoped::StyleVarY(ImGuiStyleVar_ItemSpacing, GET_UISIZE(SELECTABLE_LIST_ITEM_SPACING_Y));
+  if (matches.empty() && m_searchBox.isSearching()) {
+    ImGui::TextDisabled("No matching auto modes");
+  }
 
-    if (ImGui::Selectable(autoModeName.c_str(), isAutoModeSelected, ImGuiSelectableFlags_AllowOverlap) &&
-        !isAutoModeSelected) {
-      ThunderAutoLogger::Info("Auto Mode '{}' selected", autoModeName);
+  const TrajectoryThumbnails& thumbnails = m_editorPage.trajectoryThumbnails(state);
+  ImDrawList* drawList = ImGui::GetWindowDrawList();
+
+  // Only the rows in view are drawn.
+  ImGuiListClipper clipper;
+  clipper.Begin(static_cast<int>(matches.size()));
+  while (clipper.Step()) {
+    for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++) {
+      auto autoModeIt = autoModes.find(nameIndex.names()[matches[row]]);
+      if (autoModeIt == autoModes.end())
+        continue;
+
+      const std::string& autoModeName = autoModeIt->first;
+      ThunderAutoMode& autoMode = autoModeIt->second;
+
+      const bool isAutoModeSelected =
+          isInAutoModeState && (autoModeName == autoModeEditorState.currentAutoModeName);
+
+      // TODO: Only compute once for both properties page and auto mode manager page.
+      ThunderAutoModeStepTrajectoryBehavior trajectoryBehavior =
+          autoMode.getTrajectoryBehavior(state.trajectories);
+      if (trajectoryBehavior.errorInfo) {
+        ImGui::PushStyleColor(ImGuiCol_Text, (ImU32)ThunderAutoColorPalette::kYellow);
+      }
 
-      state.editorState.view = ThunderAutoEditorState::View::AUTO_MODE;
-      autoModeEditorState.currentAutoModeName = autoModeName;
-      autoModeEditorState.selectedStepPath = std::nullopt;
+      auto scopedPadding =
+          ImGui::Scoped::StyleVarY(ImGuiStyleVar_ItemSpacing, GET_UISIZE(SELECTABLE_LIST_ITEM_SPACING_Y));
 
-      m_history.addState(state);
-    }
+      if (ImGui::Selectable(autoModeName.c_str(), isAutoModeSelected,
+                            ImGuiSelectableFlags_AllowOverlap) &&
+          !isAutoModeSelected) {
+        ThunderAutoLogger::Info("Auto Mode '{}' selected", autoModeName);
 
-    if (trajectoryBehavior.errorInfo) {
-      ImGui::PopStyleColor();
+        state.editorState.view = ThunderAutoEditorState::View::AUTO_MODE;
+        autoModeEditorState.currentAutoModeName = autoModeName;
+        autoModeEditorState.selectedStepPath = std::nullopt;
 
-      if (ImGui::IsItemHovered(ImGuiHoveredFlags_DelayNormal)) {
-        auto scopedTooltip = ImGui::Scoped::Tooltip();
-        if (trajectoryBehavior.errorInfo.isTrajectoryMissing) {
-          ImGui::Text(ICON_LC_TRIANGLE_ALERT
-                      " Contains one or more references to\nnon-existent trajectories");
-        }
-        if (trajectoryBehavior.errorInfo.containsNonContinuousSequence) {
-          ImGui::Text(ICON_LC_TRIANGLE_ALERT
-                      " Contains one or more sequences of\nnon-continuous trajectory steps");
-        }
+        m_history.addState(state);
       }
-    }
 
-    if (auto popup = ImGui::Scoped::PopupContextItem()) {
-      if (ImGui::MenuItem(ICON_LC_PENCIL "  Rename")) {
-        m_eventAutoMode = autoModeName;
-        m_event = Event::RENAME_AUTO_MODE;
+      if (std::optional<TrajectoryThumbnails::Tile> tile = thumbnails.autoModeTile(autoModeName)) {
+        TrajectoryThumbnails::DrawTileInRow(drawList, *tile, ImGui::GetItemRectMin(),
+                                            ImGui::GetItemRectMax());
       }
 
-      if (ImGui::MenuItem(ICON_LC_COPY "  Duplicate")) {
-        m_eventAutoMode = autoModeName;
-        m_event = Event::DUPLICATE_AUTO_MODE;
+      if (trajectoryBehavior.errorInfo) {
+        ImGui::PopStyleColor();
+
+        if (ImGui::IsItemHovered(ImGuiHoveredFlags_DelayNormal)) {
+          auto scopedTooltip = ImGui::Scoped::Tooltip();
+          if (trajectoryBehavior.errorInfo.isTrajectoryMissing) {
+            ImGui::Text(ICON_LC_TRIANGLE_ALERT
+                        " Contains one or more references to\nnon-existent trajectories");
+          }
+          if (trajectoryBehavior.errorInfo.containsNonContinuousSequence) {
+            ImGui::Text(ICON_LC_TRIANGLE_ALERT
+                        " Contains one or more sequences of\nnon-continuous trajectory steps");
+          }
+        }
       }
 
-      if (ImGui::MenuItem(ICON_LC_TRASH "  Delete")) {
-        autoModeToDeleteName = autoModeName;
+      if (auto popup = ImGui::Scoped::PopupContextItem()) {
+        if (ImGui::MenuItem(ICON_LC_PENCIL "  Rename")) {
+          m_eventAutoMode = autoModeName;
+          m_event = Event::RENAME_AUTO_MODE;
+        }
+
+        if (ImGui::MenuItem(ICON_LC_COPY "  Duplicate")) {
+          m_eventAutoMode = autoModeName;
+          m_event = Event::DUPLICATE_AUTO_MODE;
+        }
+
+        if (ImGui::MenuItem(ICON_LC_TRASH "  Delete")) {
+          autoModeToDeleteName = autoModeName;
+        }
       }
-    }
 
-    if (auto scopedDragSource = ImGui::Scoped::DragDropSource()) {
-      ImGui::SetDragDropPayload("Auto Mode", autoModeName.c_str(), autoModeName.size() + 1);
-      ImGui::Text("%s", autoModeName.c_str());
+      if (auto scopedDragSource = ImGui::Scoped::DragDropSource()) {
+        ImGui::SetDragDropPayload("Auto Mode", autoModeName.c_str(), autoModeName.size() + 1);
+        ImGui::Text("%s", autoModeName.c_str());
+      }
     }
   }
 
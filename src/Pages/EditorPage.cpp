@@ -3,12 +3,16 @@
 #include <ThunderAuto/Input.hpp>
 #include <ThunderAuto/Types.hpp>
 #include <ThunderAuto/ColorPalette.hpp>
+#include <ThunderAuto/StartupTimeline.hpp>
+#include <ThunderAuto/ThreadPool.hpp>
 #include <ThunderLibCore/Math.hpp>
 #include <IconsLucide.h>
 #include <stb_image.h>
 #include <imgui_raii.h>
 #include <algorithm>
+#include <cmath>
 #include <limits>
+#include <optional>
 
 static const units::meter_t kMinRotationTargetSeparation = 0.1_m;
 
@@ -36,6 +40,26 @@ static const ImU32 kAutoModeTrajectoryStepColor = ThunderAutoColorPalette::kBlue
 static const ImU32 kAutoModeTrajectoryStepColorSelected = ThunderAutoColorPalette::kBlueHigh;
 static const ImU32 kAutoModeTrajectoryStepColorNotActive = IM_COL32(64, 64, 64, 255);
 
+static const ImU32 kReplayPathColor = ThunderAutoColorPalette::kGreenMid;
+static const ImU32 kReplayRobotColor = ThunderAutoColorPalette::kGreenHigh;
+static const ImU32 kReplayErrorColor = ThunderAutoColorPalette::kRedHigh;
+
+static const ImU32 kRobotFootprintColor = IM_COL32(128, 128, 128, 96);
+
+static const ImU32 kKeepOutZoneColor = IM_COL32(255, 64, 64, 48);
+static const ImU32 kKeepOutZoneOutlineColor = ThunderAutoColorPalette::kRedMid;
+static const ImU32 kCollisionColor = ThunderAutoColorPalette::kRedHigh;
+
+static const ImU32 kLivePoseColor = ThunderAutoColorPalette::kYellowHigh;
+static const ImU32 kLivePoseStaleColor = ThunderAutoColorPalette::kYellowLow;
+
+static const ImU32 kGhostPathColor = IM_COL32(255, 255, 255, 128);
+
+static const ImU32 kLinkedWaypointColor = ThunderAutoColorPalette::kPurpleHigh;
+
+static const ImU32 kPlaybackActionMarkerColor = kActionColor;
+static const ImU32 kPlaybackBranchMarkerColor = ThunderAutoColorPalette::kPurpleHigh;
+
 ImVec2 EditorPage::ToScreenCoordinate(const Point2d& fieldCoordinate,
                                       const ThunderAutoFieldImage& fieldImage,
                                       ImRect bb) {
@@ -70,6 +94,31 @@ Point2d EditorPage::ToFieldCoordinate(const ImVec2& screenCoordinate,
   return ToPoint2d(pt);
 }
 
+float EditorPage::TrajectoryOverlayHue(EditorPageTrajectoryOverlay overlay,
+                                      const ThunderAutoOutputTrajectoryPoint& startPoint,
+                                      const ThunderAutoOutputTrajectoryPoint& endPoint,
+                                      const ThunderAutoTrajectorySkeleton& skeleton) {
+  double hue = 0.0;
+  switch (overlay) {
+    using enum EditorPageTrajectoryOverlay;
+    case VELOCITY: {
+      // Make the line color the average of the two points' linear velocities.
+      auto averageLinearVelocity = (startPoint.linearVelocity + endPoint.linearVelocity) / 2.0;
+      hue = 0.7 - averageLinearVelocity / skeleton.settings().maxLinearVelocity;
+      break;
+    }
+    case CURVATURE: {
+      auto averageCurvature = (startPoint.curvature + endPoint.curvature) / 2.0;
+      hue = 0.6 - std::clamp(averageCurvature.value(), 0.0, 10.0) / 10.0;
+      break;
+    }
+    default:
+      ThunderAutoUnreachable("Unknown trajectory overlay");
+  }
+
+  return static_cast<float>(hue);
+}
+
 void EditorPage::SetMouseCursorMoveDirection(CanonicalAngle angle) {
   units::degree_t angleDeg = angle.degrees();
 
@@ -104,54 +153,88 @@ bool EditorPage::IsMouseHoveringPoint(Point2d point, ImRect bb) {
 #include <field_2025_png.h>
 #include <field_2026_png.h>
 
-void EditorPage::setupField(const ThunderAutoProjectSettings& settings) {
-  m_settings = &settings;
+TextureImage EditorPage::DecodeFieldImage(const ThunderAutoFieldImage& fieldImage) {
+  StartupTimeline::ScopedPhase scopedPhase(StartupTimeline::Phase::FIELD_TEXTURE_DECODE);
 
-  const ThunderAutoFieldImage& fieldImage = settings.fieldImage;
   ThunderAutoFieldImageType imageType = fieldImage.type();
 
   if (imageType == ThunderAutoFieldImageType::CUSTOM) {
     std::filesystem::path imagePath = fieldImage.customImagePath();
-    m_fieldTexture = PlatformTexture::make(imagePath);  // will throw if error loading
-  } else {
-    unsigned char* imageDataBuf = nullptr;
-    size_t imageDataSize = 0;
-    switch (fieldImage.builtinImage()) {
-      using enum ThunderAutoBuiltinFieldImage;
-      case FIELD_2022:
-        imageDataBuf = field_2022_png;
-        imageDataSize = field_2022_png_size;
-        break;
-      case FIELD_2023:
-        imageDataBuf = field_2023_png;
-        imageDataSize = field_2023_png_size;
-        break;
-      case FIELD_2024:
-        imageDataBuf = field_2024_png;
-        imageDataSize = field_2024_png_size;
-        break;
-      case FIELD_2025:
-        imageDataBuf = field_2025_png;
-        imageDataSize = field_2025_png_size;
-        break;
-      case FIELD_2026:
-        imageDataBuf = field_2026_png;
-        imageDataSize = field_2026_png_size;
-        break;
-      default:
-        ThunderAutoUnreachable("Unknown builtin field image");
-    }
+    return TextureImage::DecodeFromFile(imagePath);  // will throw if error loading
+  }
 
-    m_fieldTexture = PlatformTexture::make(imageDataBuf, imageDataSize);  // will throw if error loading
+  unsigned char* imageDataBuf = nullptr;
+  size_t imageDataSize = 0;
+  switch (fieldImage.builtinImage()) {
+    using enum ThunderAutoBuiltinFieldImage;
+    case FIELD_2022:
+      imageDataBuf = field_2022_png;
+      imageDataSize = field_2022_png_size;
+      break;
+    case FIELD_2023:
+      imageDataBuf = field_2023_png;
+      imageDataSize = field_2023_png_size;
+      break;
+    case FIELD_2024:
+      imageDataBuf = field_2024_png;
+      imageDataSize = field_2024_png_size;
+      break;
+    case FIELD_2025:
+      imageDataBuf = field_2025_png;
+      imageDataSize = field_2025_png_size;
+      break;
+    case FIELD_2026:
+      imageDataBuf = field_2026_png;
+      imageDataSize = field_2026_png_size;
+      break;
+    default:
+      ThunderAutoUnreachable("Unknown builtin field image");
   }
 
+  return TextureImage::DecodeFromMemory(imageDataBuf, imageDataSize);  // will throw if error loading
+}
+
+void EditorPage::setupField(const ThunderAutoProjectSettings& settings) {
+  setupField(settings, DecodeFieldImage(settings.fieldImage));
+}
+
+void EditorPage::setupField(const ThunderAutoProjectSettings& settings, const TextureImage& fieldImage) {
+  m_settings = &settings;
+
+  m_fieldTexture = PlatformTexture::make(fieldImage);  // will throw if error loading
+
   m_fieldAspectRatio =
       static_cast<float>(m_fieldTexture->width()) / static_cast<float>(m_fieldTexture->height());
 
   m_fieldOffset = ImVec2(0.f, 0.f);
   m_fieldScale = 1.0f;
 
+  clearProjectCaches();
+}
+
+void EditorPage::clearProjectCaches() noexcept {
   invalidateCachedTrajectories();
+
+  m_previewTrajectories.clear();
+
+  m_collisionChecker.clear();
+  // The checker forgot its geometry, so set it again next frame.
+  m_keepOutZonesChanged = true;
+
+  m_trajectoryThumbnails.clear();
+  m_trajectoryThumbnailsUpdateFrame = -1;
+}
+
+std::unique_ptr<ThunderAutoOutputTrajectory> EditorPage::BuildPreviewTrajectory(
+    const ThunderAutoTrajectorySkeleton& skeleton) {
+  StartupTimeline::ScopedPhase scopedPhase(StartupTimeline::Phase::FIRST_TRAJECTORY_BUILD);
+
+  return BuildThunderAutoOutputTrajectory(skeleton, kPreviewOutputTrajectorySettings);
+}
+
+void EditorPage::setCachedTrajectory(std::unique_ptr<ThunderAutoOutputTrajectory> trajectory) noexcept {
+  m_cachedTrajectory = std::move(trajectory);
+  m_robotFootprints.isValid = false;
 }
 
 void EditorPage::resetView() {
@@ -217,22 +300,47 @@ void EditorPage::presentEditor() {
 
   // Draw Editor UI
 
-  ThunderAutoProjectState state = m_history.currentState();
+  // While dragging, edit the long edit's state in place instead of copying the whole project every frame.
+  // Nothing below may touch the state after the long edit finishes.
+  std::optional<ThunderAutoProjectState> stateCopy;
+  ThunderAutoProjectState* statePtr = m_history.longEditState();
+  if (!statePtr) {
+    stateCopy = m_history.currentState();
+    statePtr = &stateCopy.value();
+  }
+  ThunderAutoProjectState& state = *statePtr;
+
+  m_plannedRobotPosition = std::nullopt;
+
+  updateCollisionChecker(state);
+
+  if (trajectoryEditorOptions.showKeepOutZones) {
+    presentKeepOutZones(bb);
+  }
 
   ThunderAutoEditorState& editorState = state.editorState;
   switch (editorState.view) {
     using enum ThunderAutoEditorState::View;
     case TRAJECTORY:
       presentTrajectoryEditor(state, bb);
+      presentGhostPath(state, bb);
+      presentRobotLogReplay(bb);
+      presentLivePose(bb);
       presentPlaybackSlider(state);
       processPlaybackInput();
-      processTrajectoryEditorInput(state, bb);
+      if (!m_isReadOnly) {
+        processTrajectoryEditorInput(state, bb);
+      }
       break;
     case AUTO_MODE:
       presentAutoModeEditor(state, bb);
+      presentRobotLogReplay(bb);
+      presentLivePose(bb);
       presentPlaybackSlider(state);
       processPlaybackInput();
-      processAutoModeEditorInput(state, bb);
+      if (!m_isReadOnly) {
+        processAutoModeEditorInput(state, bb);
+      }
       break;
     case NONE:
       break;
@@ -241,8 +349,42 @@ void EditorPage::presentEditor() {
   }
 }
 
-void EditorPage::onStateUpdated() {
-  invalidateCachedTrajectories();
+void EditorPage::onStateUpdated(const StateChangeSet& changes) {
+  if (changes.everything) {
+    m_previewTrajectories.invalidateAll();
+    m_collisionChecker.invalidateAll();
+    m_trajectoryThumbnails.invalidateAll();
+  } else {
+    for (const std::string& trajectoryName : changes.trajectories) {
+      m_previewTrajectories.invalidateTrajectory(trajectoryName);
+      m_collisionChecker.invalidateTrajectory(trajectoryName);
+      m_trajectoryThumbnails.invalidateTrajectory(trajectoryName);
+    }
+    for (const std::string& autoModeName : changes.autoModes) {
+      m_trajectoryThumbnails.invalidateAutoMode(autoModeName);
+    }
+  }
+
+  if (changes.everything || changes.editorView) {
+    invalidateCachedTrajectories();
+    return;
+  }
+
+  const ThunderAutoEditorState& editorState = m_history.currentState().editorState;
+
+  // Only the current trajectory is cached in the trajectory editor.
+  const std::string& currentTrajectoryName = editorState.trajectoryEditorState.currentTrajectoryName;
+  if (changes.currentTrajectory || changes.affectsTrajectory(currentTrajectoryName)) {
+    m_cachedTrajectory.reset();
+    m_robotFootprints.isValid = false;
+  }
+
+  // The auto mode editor caches every trajectory used by the current auto mode.
+  const std::string& currentAutoModeName = editorState.autoModeEditorState.currentAutoModeName;
+  if (changes.currentAutoMode || changes.affectsAutoMode(currentAutoModeName) ||
+      !changes.trajectories.empty()) {
+    invalidateCachedAutoModeTrajectories();
+  }
 }
 
 void EditorPage::processPanAndZoomInput(const ImVec2& fieldScreenSize) {
@@ -312,6 +454,11 @@ void EditorPage::presentTrajectoryEditor(ThunderAutoProjectState& state, ImRect
     return;
 
   presentTrajectory(state, bb);
+  presentTrajectoryCollisions(state, bb);
+  presentLinkedWaypoints(state, bb);
+  if (trajectoryEditorOptions.showRobotFootprints) {
+    presentTrajectoryRobotFootprints(bb);
+  }
   presentTrajectoryRobotPreview(bb);
   presentTrajectoryDragWidgets(state, bb);
 }
@@ -320,7 +467,8 @@ void EditorPage::presentTrajectory(const ThunderAutoProjectState& state, ImRect
   const ThunderAutoTrajectorySkeleton& skeleton = state.currentTrajectory();
 
   if (!m_cachedTrajectory) {
-    m_cachedTrajectory = BuildThunderAutoOutputTrajectory(skeleton, kPreviewOutputTrajectorySettings);
+    m_cachedTrajectory = BuildPreviewTrajectory(skeleton);
+    m_robotFootprints.isValid = false;
   }
   ThunderAutoAssert(m_cachedTrajectory != nullptr);
 
@@ -336,26 +484,11 @@ void EditorPage::presentTrajectory(const ThunderAutoProjectState& state, ImRect
         ToScreenCoordinate(startPointIt->position, m_settings->fieldImage, bb);
     const ImVec2 endPointCoordinate = ToScreenCoordinate(endPointIt->position, m_settings->fieldImage, bb);
 
-    double hue = 0.0;
-    switch (trajectoryEditorOptions.trajectoryOverlay) {
-      using enum EditorPageTrajectoryOverlay;
-      case VELOCITY: {
-        // Make the line color the average of the two points' linear velocities.
-        auto averageLinearVelocity = (startPointIt->linearVelocity + endPointIt->linearVelocity) / 2.0;
-        hue = 0.7 - averageLinearVelocity / skeleton.settings().maxLinearVelocity;
-        break;
-      }
-      case CURVATURE: {
-        auto averageCurvature = (startPointIt->curvature + endPointIt->curvature) / 2.0;
-        hue = 0.6 - std::clamp(averageCurvature.value(), 0.0, 10.0) / 10.0;
-        break;
-      }
-      default:
-        ThunderAutoUnreachable("Unknown trajectory overlay");
-    }
+    const float hue =
+        TrajectoryOverlayHue(trajectoryEditorOptions.trajectoryOverlay, *startPointIt, *endPointIt, skeleton);
 
-    drawList->AddLine(startPointCoordinate, endPointCoordinate,
-                      ImColor::HSV(static_cast<float>(hue), 1.f, 1.f), GET_UISIZE(LINE_THICKNESS));
+    drawList->AddLine(startPointCoordinate, endPointCoordinate, ImColor::HSV(hue, 1.f, 1.f),
+                      GET_UISIZE(LINE_THICKNESS));
   }
 }
 
@@ -409,6 +542,133 @@ void EditorPage::presentTrajectoryRobotPreview(ImRect bb) {
   CanonicalAngle rotation = Lerp(lowerPoint.rotation, upperPoint.rotation, t);
 
   drawRobot(position, rotation, 0.f, GET_UISIZE(DRAG_POINT_RADIUS) / 1.5f, kPointPreviewColor, bb);
+  m_plannedRobotPosition = position;
+}
+
+void EditorPage::presentTrajectoryCollisions(const ThunderAutoProjectState& state, ImRect bb) {
+  ThunderAutoAssert(m_cachedTrajectory != nullptr);
+
+  const std::string& trajectoryName = state.editorState.trajectoryEditorState.currentTrajectoryName;
+  std::span<const CollisionSegment> collisions = m_collisionChecker.collisions(trajectoryName);
+  if (collisions.empty())
+    return;
+
+  ImDrawList* drawList = ImGui::GetWindowDrawList();
+
+  std::span<const ThunderAutoOutputTrajectoryPoint> points = m_cachedTrajectory->points;
+
+  for (const CollisionSegment& collision : collisions) {
+    // The trajectory may have been rebuilt since it was checked.
+    if (collision.endPointIndex >= points.size())
+      continue;
+
+    ImVec2 lastPoint =
+        ToScreenCoordinate(points[collision.startPointIndex].position, m_settings->fieldImage, bb);
+    for (size_t i = collision.startPointIndex + 1; i <= collision.endPointIndex; i++) {
+      const ImVec2 point = ToScreenCoordinate(points[i].position, m_settings->fieldImage, bb);
+      drawList->AddLine(lastPoint, point, kCollisionColor, GET_UISIZE(LINE_THICKNESS) * 3.f);
+      lastPoint = point;
+    }
+  }
+}
+
+void EditorPage::presentTrajectoryRobotFootprints(ImRect bb) {
+  ThunderAutoAssert(m_cachedTrajectory != nullptr);
+
+  updateBaseRobotPolygon();
+
+  // Keep the number of footprints reasonable.
+  const units::second_t interval =
+      units::second_t(std::max(trajectoryEditorOptions.robotFootprintInterval, 0.05f));
+
+  if (!m_robotFootprints.isValid || m_robotFootprints.interval != interval) {
+    buildTrajectoryRobotFootprints(interval);
+  }
+
+  drawRobotOutlines(m_robotFootprints.x, m_robotFootprints.y, m_robotFootprints.transforms.size(),
+                    kRobotFootprintColor, bb);
+}
+
+void EditorPage::buildTrajectoryRobotFootprints(units::second_t interval) {
+  ThunderAutoAssert(m_cachedTrajectory != nullptr);
+
+  RobotFootprints& footprints = m_robotFootprints;
+  footprints.isValid = true;
+  footprints.interval = interval;
+  footprints.transforms.clear();
+
+  std::span<const ThunderAutoOutputTrajectoryPoint> points = m_cachedTrajectory->points;
+
+  if (!points.empty()) {
+    const units::second_t startTime = points.front().time;
+    const units::second_t totalTime = points.back().time - startTime;
+    const size_t numIntervals = static_cast<size_t>(totalTime / interval);
+
+    // Sample times only increase, so walk the points forward instead of searching for each one.
+    auto upperIt = points.begin();
+
+    for (size_t i = 0; i <= numIntervals + 1; i++) {
+      // The last footprint is always at the end of the trajectory.
+      const units::second_t time =
+          (i <= numIntervals) ? startTime + interval * static_cast<double>(i) : points.back().time;
+
+      while (std::next(upperIt) != points.end() && upperIt->time < time) {
+        ++upperIt;
+      }
+      auto lowerIt = (upperIt == points.begin()) ? upperIt : std::prev(upperIt);
+
+      const units::second_t dt = upperIt->time - lowerIt->time;
+      const double t = dt > 0_s ? std::clamp((time - lowerIt->time).value() / dt.value(), 0.0, 1.0) : 0.0;
+
+      const Point2d position = Point2d(Lerp(lowerIt->position.x, upperIt->position.x, t),
+                                       Lerp(lowerIt->position.y, upperIt->position.y, t));
+
+      const CanonicalAngle rotation = Lerp(lowerIt->rotation, upperIt->rotation, t);
+
+      footprints.transforms.push_back(PolygonTransform::FromPose(position, rotation));
+    }
+  }
+
+  const size_t bufferSize = footprints.transforms.size() * m_baseRobotPolygon.size();
+  footprints.x.resize(bufferSize);
+  footprints.y.resize(bufferSize);
+
+  TransformPolygonBatch(m_baseRobotPolygon, footprints.transforms, footprints.x, footprints.y);
+}
+
+void EditorPage::presentLinkedWaypoints(const ThunderAutoProjectState& state, ImRect bb) {
+  const ThunderAutoTrajectoryEditorState& editorState = state.editorState.trajectoryEditorState;
+  if (editorState.trajectorySelection != ThunderAutoTrajectoryEditorState::TrajectorySelection::WAYPOINT)
+    return;
+
+  const ThunderAutoTrajectorySkeleton& skeleton = state.currentTrajectory();
+  const size_t selectionIndex = static_cast<size_t>(editorState.selectionIndex);
+  if (selectionIndex >= skeleton.numPoints())
+    return;
+
+  auto selectedWaypointIt = std::next(skeleton.begin(), static_cast<std::ptrdiff_t>(selectionIndex));
+  if (!selectedWaypointIt->isLinked())
+    return;
+
+  ImDrawList* drawList = ImGui::GetWindowDrawList();
+
+  // Ring the waypoints of other trajectories that move along with the selected one.
+  const std::string linkName(selectedWaypointIt->linkName());
+  for (const TrajectoryLinkIndex::LinkedWaypoint& linked : m_history.linkIndex().linkedWaypoints(linkName)) {
+    if (linked.trajectoryName == editorState.currentTrajectoryName)
+      continue;
+
+    auto trajectoryIt = state.trajectories.find(linked.trajectoryName);
+    if (trajectoryIt == state.trajectories.end() || linked.waypointIndex >= trajectoryIt->second.numPoints())
+      continue;
+
+    auto waypointIt =
+        std::next(trajectoryIt->second.begin(), static_cast<std::ptrdiff_t>(linked.waypointIndex));
+
+    const ImVec2 pt = ToScreenCoordinate(waypointIt->position(), m_settings->fieldImage, bb);
+    drawList->AddCircle(pt, GET_UISIZE(DRAG_POINT_RADIUS) * 1.5f, kLinkedWaypointColor, 0,
+                        GET_UISIZE(LINE_THICKNESS));
+  }
 }
 
 void EditorPage::presentTrajectoryDragWidgets(const ThunderAutoProjectState& state, ImRect bb) {
@@ -956,7 +1216,7 @@ void EditorPage::processTrajectoryInput(ThunderAutoProjectState& state, ImRect b
       }
 
       if (m_dragPoint == PointType::WAYPOINT_POSITION) {
-        state.trajectoryUpdateAllLinkedWaypointPositionsFromSelectedWaypoint();
+        m_history.linkIndex().updateLinkedWaypointPositionsFromSelectedWaypoint(state);
       }
       m_history.addState(state);
       m_history.finishLongEdit();
@@ -1116,7 +1376,13 @@ void EditorPage::processTrajectoryInput(ThunderAutoProjectState& state, ImRect b
           ThunderAutoUnreachable("Invalid drag point type");
       }
 
-      m_history.addState(state);
+      // Only the dragged trajectory changed, so there's no need to compare the whole project.
+      StateChangeSet dragChanges;
+      dragChanges.trajectories.insert(editorState.currentTrajectoryName);
+      dragChanges.trajectorySelection =
+          (m_dragPoint == PointType::ROTATION_POSITION || m_dragPoint == PointType::ACTION_POSITION);
+
+      m_history.addState(state, dragChanges);
 
       m_clickedPoint = PointType::NONE;
     }
@@ -1135,10 +1401,10 @@ void EditorPage::processTrajectoryInput(ThunderAutoProjectState& state, ImRect b
         }
 
         if (m_dragPoint == PointType::WAYPOINT_POSITION) {
-          state.trajectoryUpdateAllLinkedWaypointPositionsFromSelectedWaypoint();
+          m_history.linkIndex().updateLinkedWaypointPositionsFromSelectedWaypoint(state);
         } else if (m_dragPoint == PointType::WAYPOINT_ANGLE) {
-          state.trajectoryUpdateAllLinkedTrajectoryEndBehaviorsFromCurrentTrajectoryEndBehavior(
-              editorState.selectionIndex == 0, editorState.selectionIndex == skeleton.numPoints() - 1);
+          m_history.linkIndex().updateLinkedTrajectoryEndBehaviorsFromCurrentTrajectory(
+              state, editorState.selectionIndex == 0, editorState.selectionIndex == skeleton.numPoints() - 1);
         }
 
         m_history.addState(state);
@@ -1170,12 +1436,24 @@ void EditorPage::presentAutoModeEditor(ThunderAutoProjectState& state, ImRect bb
   if (state.editorState.autoModeEditorState.currentAutoModeName.empty())
     return;
 
-  const ThunderAutoMode& autoMode = state.currentAutoMode();
+  const AutoModeStepIndex& stepIndex =
+      m_history.autoModeStepIndex(state.editorState.autoModeEditorState.currentAutoModeName);
+
+  if (m_cachedAutoModeTrajectories.empty()) {
+    // Auto modes without any trajectory steps get here every frame.
+    m_autoModeTimelineEntries.clear();
+    m_autoModeTimelineDirty = true;
+
+    queueAutoModeTrajectoryBuilds(stepIndex, state);
+  }
+  collectFinishedAutoModeTrajectories();
+
+  if (m_autoModeTimelineDirty) {
+    rebuildAutoModeTimeline();
+  }
 
-  size_t trajectoryIndex = 0;
   bool clickWasCaptured = false;
-  bool stateWasChanged = presentAutoModeStepList(ThunderAutoModeStepDirectoryPath{}, autoMode.steps,
-                                                 trajectoryIndex, clickWasCaptured, true, state, bb);
+  bool stateWasChanged = presentAutoModeSteps(stepIndex, clickWasCaptured, state, bb);
 
   if (stateWasChanged) {
     m_history.addState(state);
@@ -1191,138 +1469,60 @@ void EditorPage::presentAutoModeEditor(ThunderAutoProjectState& state, ImRect bb
   presentAutoModeRobotPreview(bb);
 }
 
-bool EditorPage::presentAutoModeStepList(const ThunderAutoModeStepDirectoryPath& parentPath,
-                                         const ThunderAutoMode::StepDirectory& steps,
-                                         size_t& trajectoryIndex,
-                                         bool& clickWasCaptured,
-                                         bool isActive,
-                                         ThunderAutoProjectState& state,
-                                         ImRect bb) {
-  bool stateWasChanged = false;
-  size_t stepIndex = 0;
-  for (const std::unique_ptr<ThunderAutoModeStep>& step : steps) {
-    ThunderAutoAssert(step != nullptr);
-    ThunderAutoModeStepPath stepPath = parentPath.step(stepIndex);
-    stateWasChanged |=
-        presentAutoModeStep(stepPath, *step, trajectoryIndex, clickWasCaptured, isActive, state, bb);
-    stepIndex++;
-  }
-
-  return stateWasChanged;
-}
-
-bool EditorPage::presentAutoModeStep(const ThunderAutoModeStepPath& path,
-                                     const ThunderAutoModeStep& step,
-                                     size_t& trajectoryIndex,
-                                     bool& clickWasCaptured,
-                                     bool isActive,
-                                     ThunderAutoProjectState& state,
-                                     ImRect bb) {
-  switch (step.type()) {
-    using enum ThunderAutoModeStepType;
-    case ACTION: {
-      // TODO: Draw something? Difficult since we don't know pose, and there may be other actions there too.
-      break;
-    }
-    case TRAJECTORY: {
-      const ThunderAutoModeTrajectoryStep& trajectoryStep =
-          static_cast<const ThunderAutoModeTrajectoryStep&>(step);
-      return presentAutoModeTrajectoryStep(path, trajectoryStep, trajectoryIndex, clickWasCaptured, isActive,
-                                           state, bb);
-    }
-    case BRANCH_BOOL: {
-      const ThunderAutoModeBoolBranchStep& branchBoolStep =
-          static_cast<const ThunderAutoModeBoolBranchStep&>(step);
-
-      ThunderAutoModeStepDirectoryPath activeBranchPath = path.boolBranch(true),
-                                       inactiveBranchPath = path.boolBranch(false);
-      const ThunderAutoMode::StepDirectory *activeBranchSteps = &branchBoolStep.trueBranch,
-                                           *inactiveBranchSteps = &branchBoolStep.elseBranch;
-
-      if (!branchBoolStep.editorDisplayTrueBranch) {
-        std::swap(activeBranchPath, inactiveBranchPath);
-        std::swap(activeBranchSteps, inactiveBranchSteps);
-      }
-
-      // Present inactive branch first.
-      (void)presentAutoModeStepList(inactiveBranchPath, *inactiveBranchSteps, trajectoryIndex,
-                                    clickWasCaptured, false, state, bb);
-
-      // Then present active branch.
-      return presentAutoModeStepList(activeBranchPath, *activeBranchSteps, trajectoryIndex, clickWasCaptured,
-                                     isActive, state, bb);
-    }
-    case BRANCH_SWITCH: {
-      const ThunderAutoModeSwitchBranchStep& branchSwitchStep =
-          static_cast<const ThunderAutoModeSwitchBranchStep&>(step);
-
-      ThunderAutoModeStepDirectoryPath activeBranchPath;
-      const ThunderAutoMode::StepDirectory* activeBranchSteps = nullptr;
-
-      if (branchSwitchStep.editorDisplayDefaultBranch) {
-        activeBranchPath = path.switchBranchDefault();
-        activeBranchSteps = &branchSwitchStep.defaultBranch;
-      } else {
-        (void)presentAutoModeStepList(path.switchBranchDefault(), branchSwitchStep.defaultBranch,
-                                      trajectoryIndex, clickWasCaptured, false, state, bb);
-      }
+bool EditorPage::presentAutoModeSteps(const AutoModeStepIndex& stepIndex,
+                                      bool& clickWasCaptured,
+                                      ThunderAutoProjectState& state,
+                                      ImRect bb) {
+  std::span<const AutoModeStepIndex::Entry> entries = stepIndex.entries();
 
-      for (const auto& [caseValue, caseSteps] : branchSwitchStep.caseBranches) {
-        if (!branchSwitchStep.editorDisplayDefaultBranch &&
-            caseValue == branchSwitchStep.editorDisplayCaseBranch) {
-          activeBranchPath = path.switchBranchCase(caseValue);
-          activeBranchSteps = &caseSteps;
-        } else {
-          (void)presentAutoModeStepList(path.switchBranchCase(caseValue), caseSteps, trajectoryIndex,
-                                        clickWasCaptured, false, state, bb);
-        }
-      }
+  bool stateWasChanged = false;
+  for (size_t entryIndex : stepIndex.editorOrder()) {
+    const AutoModeStepIndex::Entry& entry = entries[entryIndex];
 
-      ThunderAutoAssert(activeBranchSteps != nullptr);
-      if (activeBranchSteps == nullptr)
-        return false;
+    // TODO: Draw action steps? Difficult since we don't know pose, and there may be other actions there too.
+    if (entry.type != ThunderAutoModeStepType::TRAJECTORY)
+      continue;
 
-      // Present active branch last.
-      return presentAutoModeStepList(activeBranchPath, *activeBranchSteps, trajectoryIndex, clickWasCaptured,
-                                     isActive, state, bb);
-    }
-    default:
-      ThunderAutoUnreachable("Invalid auto mode step type");
+    stateWasChanged |= presentAutoModeTrajectoryStep(entry, clickWasCaptured, state, bb);
   }
-  return false;
+
+  return stateWasChanged;
 }
 
-bool EditorPage::presentAutoModeTrajectoryStep(const ThunderAutoModeStepPath& path,
-                                               const ThunderAutoModeTrajectoryStep& step,
-                                               size_t& trajectoryIndex,
+bool EditorPage::presentAutoModeTrajectoryStep(const AutoModeStepIndex::Entry& entry,
                                                bool& clickWasCaptured,
-                                               bool isActive,
                                                ThunderAutoProjectState& state,
                                                ImRect bb) {
+  const ThunderAutoModeStepPath& path = entry.path;
+  const std::string& trajectoryName = entry.itemName;
+  const bool isActive = entry.isActive;
+
   bool isExactStepSelected = false, isParentStepSelected = false;
   const std::optional<ThunderAutoModeStepPath>& selectedStepPath =
       state.editorState.autoModeEditorState.selectedStepPath;
   if (selectedStepPath.has_value()) {
-    ThunderAutoModeStepPath selectedStepPathValue = selectedStepPath.value();
+    const ThunderAutoModeStepPath& selectedStepPathValue = selectedStepPath.value();
     isExactStepSelected = (path == selectedStepPathValue);
     isParentStepSelected = path.hasParentPath(selectedStepPathValue);
   }
   const bool isStepSelected = isExactStepSelected || isParentStepSelected;
 
-  auto trajectoryIt = state.trajectories.find(step.trajectoryName);
+  auto trajectoryIt = state.trajectories.find(trajectoryName);
   if (trajectoryIt == state.trajectories.end())
     return false;
 
   ThunderAutoTrajectorySkeleton& skeleton = trajectoryIt->second;
 
-  ThunderAutoAssert(trajectoryIndex <= m_cachedAutoModeTrajectories.size());
-  if (trajectoryIndex >= m_cachedAutoModeTrajectories.size()) {
-    trajectoryIndex = m_cachedAutoModeTrajectories.size();
-    m_cachedAutoModeTrajectories.emplace_back(
-        BuildThunderAutoOutputTrajectory(skeleton, kPreviewOutputTrajectorySettings), isActive);
-  }
+  if (entry.trajectorySlot >= m_cachedAutoModeTrajectories.size())
+    return false;
+
+  // Still being built, show it once it's done.
+  const ThunderAutoOutputTrajectory* cachedTrajectory =
+      m_cachedAutoModeTrajectories.at(entry.trajectorySlot).trajectory.get();
+  if (!cachedTrajectory)
+    return false;
 
-  const ThunderAutoOutputTrajectory& trajectory = *m_cachedAutoModeTrajectories.at(trajectoryIndex++).first;
+  const ThunderAutoOutputTrajectory& trajectory = *cachedTrajectory;
 
   std::span<const ThunderAutoOutputTrajectoryPoint> points = trajectory.points;
 
@@ -1368,8 +1568,8 @@ bool EditorPage::presentAutoModeTrajectoryStep(const ThunderAutoModeStepPath& pa
 
     if (trajectoryEditorOptions.showTooltip && ImGui::IsWindowFocused()) {
       auto scopedTooltip = ImGui::Scoped::Tooltip();
-      ImGui::Text("%s", step.trajectoryName.empty() ? "<none>" : step.trajectoryName.c_str());
-      ImGui::Text("Step: %s", ThunderAutoModeStepPathToString(path).c_str());
+      ImGui::Text("%s", trajectoryName.empty() ? "<none>" : trajectoryName.c_str());
+      ImGui::Text("Step: %s", entry.pathString.c_str());
     }
 
     if (!clickWasCaptured) {
@@ -1380,13 +1580,13 @@ bool EditorPage::presentAutoModeTrajectoryStep(const ThunderAutoModeStepPath& pa
       }
       if (isLeftDoubleClicked) {
         state.editorState.trajectoryEditorState = {};
-        state.editorState.trajectoryEditorState.currentTrajectoryName = step.trajectoryName;
+        state.editorState.trajectoryEditorState.currentTrajectoryName = trajectoryName;
         state.editorState.view = ThunderAutoEditorState::View::TRAJECTORY;
         clickWasCaptured = true;
         return true;  // State was changed.
       }
       if (isRightClicked) {
-        m_autoModeContextMenuOpenData.trajectoryName = step.trajectoryName;
+        m_autoModeContextMenuOpenData.trajectoryName = trajectoryName;
         ImGui::OpenPopup("AutoModeEditorContextMenu_TrajectoryStep");
         clickWasCaptured = true;
         return false;
@@ -1397,70 +1597,143 @@ bool EditorPage::presentAutoModeTrajectoryStep(const ThunderAutoModeStepPath& pa
   return false;
 }
 
-void EditorPage::presentAutoModeRobotPreview(ImRect bb) {
-  ImDrawList* drawList = ImGui::GetWindowDrawList();
+void EditorPage::queueAutoModeTrajectoryBuilds(const AutoModeStepIndex& stepIndex,
+                                               const ThunderAutoProjectState& state) {
+  std::span<const AutoModeStepIndex::Entry> entries = stepIndex.entries();
 
-  ThunderAutoOutputTrajectory* trajectory = nullptr;
-  ThunderAutoOutputTrajectory* lastTrajectory = nullptr;
-  units::second_t accumulatedTime = 0.0_s;
-  for (const auto& [cachedTrajectory, isActive] : m_cachedAutoModeTrajectories) {
-    if (!isActive || !cachedTrajectory) {
-      continue;
-    }
+  // Slots of trajectory steps whose trajectory doesn't exist are left empty.
+  m_cachedAutoModeTrajectories.resize(stepIndex.numTrajectorySlots());
 
-    lastTrajectory = cachedTrajectory.get();
+  for (size_t entryIndex : stepIndex.editorOrder()) {
+    const AutoModeStepIndex::Entry& entry = entries[entryIndex];
 
-    if (m_playbackTime < accumulatedTime + cachedTrajectory->totalTime) {
-      trajectory = cachedTrajectory.get();
-      break;
+    switch (entry.type) {
+      using enum ThunderAutoModeStepType;
+      case ACTION: {
+        if (entry.isActive && !entry.itemName.empty()) {
+          m_autoModeTimelineEntries.push_back(AutoModeTimelineEntry{
+              .type = AutoModeTimelineEntry::Type::ACTION,
+              .label = entry.itemName,
+          });
+        }
+        break;
+      }
+      case TRAJECTORY: {
+        auto trajectoryIt = state.trajectories.find(entry.itemName);
+        if (trajectoryIt == state.trajectories.end())
+          break;
+
+        const ThunderAutoTrajectorySkeleton& skeleton = trajectoryIt->second;
+
+        if (entry.isActive) {
+          m_autoModeTimelineEntries.push_back(AutoModeTimelineEntry{
+              .type = AutoModeTimelineEntry::Type::TRAJECTORY,
+              .trajectoryIndex = entry.trajectorySlot,
+          });
+        }
+
+        CachedAutoModeTrajectory& cachedTrajectory = m_cachedAutoModeTrajectories.at(entry.trajectorySlot);
+        cachedTrajectory.isActive = entry.isActive;
+        cachedTrajectory.pendingTrajectory = ThreadPool::get().submit([skeleton] {
+          return BuildThunderAutoOutputTrajectory(skeleton, kPreviewOutputTrajectorySettings);
+        });
+
+        if (entry.isActive) {
+          if (skeleton.hasStartAction()) {
+            cachedTrajectory.actions.emplace_back(ThunderAutoTrajectoryPosition(0.0), skeleton.startAction());
+          }
+          for (const auto& [positionInTrajectory, action] : skeleton.actions()) {
+            cachedTrajectory.actions.emplace_back(positionInTrajectory, action.action);
+          }
+          if (skeleton.hasEndAction()) {
+            cachedTrajectory.actions.emplace_back(
+                ThunderAutoTrajectoryPosition(static_cast<double>(skeleton.numPoints() - 1)),
+                skeleton.endAction());
+          }
+        }
+        break;
+      }
+      case BRANCH_BOOL:
+      case BRANCH_SWITCH: {
+        if (entry.isActive) {
+          m_autoModeTimelineEntries.push_back(AutoModeTimelineEntry{
+              .type = AutoModeTimelineEntry::Type::BRANCH,
+              .label = entry.pathString,
+          });
+        }
+        break;
+      }
+      default:
+        ThunderAutoUnreachable("Invalid auto mode step type");
     }
-    accumulatedTime += cachedTrajectory->totalTime;
   }
+}
 
-  if (!trajectory) {
-    if (!lastTrajectory) {
-      return;
-    }
+void EditorPage::collectFinishedAutoModeTrajectories() {
+  for (CachedAutoModeTrajectory& cachedTrajectory : m_cachedAutoModeTrajectories) {
+    std::future<std::unique_ptr<ThunderAutoOutputTrajectory>>& pendingTrajectory =
+        cachedTrajectory.pendingTrajectory;
+
+    if (pendingTrajectory.valid() &&
+        pendingTrajectory.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+      cachedTrajectory.trajectory = pendingTrajectory.get();
 
-    trajectory = lastTrajectory;
+      if (cachedTrajectory.isActive) {
+        m_autoModeTimelineDirty = true;
+      }
+    }
   }
+}
 
-  // Find closest time.
+void EditorPage::rebuildAutoModeTimeline() {
+  m_autoModeTimeline.clear();
+  m_autoModeTimelineDirty = false;
 
-  std::span<const ThunderAutoOutputTrajectoryPoint> points = trajectory->points;
+  for (const AutoModeTimelineEntry& entry : m_autoModeTimelineEntries) {
+    const units::second_t time = m_autoModeTimeline.totalTime();
 
-  auto lowerIt = std::lower_bound(
-      points.begin(), points.end(), m_playbackTime - accumulatedTime,
-      [](const ThunderAutoOutputTrajectoryPoint& point, units::second_t time) { return point.time < time; });
+    switch (entry.type) {
+      using enum AutoModeTimelineEntry::Type;
+      case TRAJECTORY: {
+        const CachedAutoModeTrajectory& cachedTrajectory =
+            m_cachedAutoModeTrajectories.at(entry.trajectoryIndex);
 
-  auto upperIt = lowerIt;
+        // Still building, leave it out until it's done.
+        if (!cachedTrajectory.trajectory)
+          break;
 
-  units::second_t playbackTime = m_playbackTime - accumulatedTime;
+        const ThunderAutoOutputTrajectory& trajectory = *cachedTrajectory.trajectory;
 
-  if (lowerIt == points.end()) {
-    upperIt = std::prev(lowerIt);
-    lowerIt = std::prev(upperIt);
+        for (const auto& [positionInTrajectory, actionName] : cachedTrajectory.actions) {
+          size_t pointIndex = trajectory.trajectoryPositionToPointIndex(positionInTrajectory);
+          units::second_t actionTime = time + trajectory.points.at(pointIndex).time;
+          m_autoModeTimeline.addMarker(PlaybackTimeline::Marker::Type::ACTION, actionTime, actionName);
+        }
 
-  } else if (lowerIt == points.begin()) {
-    upperIt = std::next(lowerIt);
-    if (upperIt == points.end()) {
-      upperIt = lowerIt;
+        m_autoModeTimeline.addTrajectory(trajectory);
+        break;
+      }
+      case ACTION:
+        m_autoModeTimeline.addMarker(PlaybackTimeline::Marker::Type::ACTION, time, entry.label);
+        break;
+      case BRANCH:
+        m_autoModeTimeline.addMarker(PlaybackTimeline::Marker::Type::BRANCH, time, entry.label);
+        break;
+      default:
+        ThunderAutoUnreachable("Invalid auto mode timeline entry type");
     }
-    playbackTime = lowerIt->time;
-
-  } else {
-    upperIt = lowerIt;
-    lowerIt = std::prev(lowerIt);
   }
+}
 
-  ThunderAutoAssert(lowerIt != points.end());
-  ThunderAutoAssert(upperIt != points.end());
+void EditorPage::presentAutoModeRobotPreview(ImRect bb) {
+  if (m_autoModeTimeline.empty())
+    return;
 
-  const ThunderAutoOutputTrajectoryPoint& lowerPoint = *lowerIt;
-  const ThunderAutoOutputTrajectoryPoint& upperPoint = *upperIt;
+  const PlaybackTimeline::Sample sample = m_autoModeTimeline.sample(m_playbackTime);
 
-  const units::second_t dt = upperPoint.time - lowerPoint.time;
-  const double t = dt > 0.01_s ? (playbackTime - lowerPoint.time).value() / dt.value() : 0.0;
+  const ThunderAutoOutputTrajectoryPoint& lowerPoint = *sample.lowerPoint;
+  const ThunderAutoOutputTrajectoryPoint& upperPoint = *sample.upperPoint;
+  const double t = sample.t;
 
   // Interpolate between points.
 
@@ -1470,6 +1743,133 @@ void EditorPage::presentAutoModeRobotPreview(ImRect bb) {
   CanonicalAngle rotation = Lerp(lowerPoint.rotation, upperPoint.rotation, t);
 
   drawRobot(position, rotation, 0.f, GET_UISIZE(DRAG_POINT_RADIUS) / 1.5f, kPointPreviewColor, bb);
+  m_plannedRobotPosition = position;
+}
+
+void EditorPage::presentGhostPath(const ThunderAutoProjectState& state, ImRect bb) {
+  if (m_ghostPath.size() < 2 ||
+      m_ghostPathTrajectoryName != state.editorState.trajectoryEditorState.currentTrajectoryName)
+    return;
+
+  m_ghostPathScreenPoints.clear();
+  for (const Point2d& position : m_ghostPath) {
+    ImVec2 pt = ToScreenCoordinate(position, m_settings->fieldImage, bb);
+
+    // Trajectory points can be much denser than pixels when zoomed out.
+    if (!m_ghostPathScreenPoints.empty()) {
+      ImVec2 delta = pt - m_ghostPathScreenPoints.back();
+      if (delta.x * delta.x + delta.y * delta.y < 2.f * 2.f)
+        continue;
+    }
+    m_ghostPathScreenPoints.push_back(pt);
+  }
+
+  ImDrawList* drawList = ImGui::GetWindowDrawList();
+  drawList->AddPolyline(m_ghostPathScreenPoints.data(), static_cast<int>(m_ghostPathScreenPoints.size()),
+                        kGhostPathColor, ImDrawFlags_None, GET_UISIZE(LINE_THICKNESS));
+}
+
+void EditorPage::presentRobotLogReplay(ImRect bb) {
+  m_replayTrackingError = std::nullopt;
+
+  if (!m_robotLogReplay.isOpen() || !m_robotLogReplay.visible)
+    return;
+
+  ImDrawList* drawList = ImGui::GetWindowDrawList();
+
+  // Actual path.
+
+  const std::vector<Point2d>& path = m_robotLogReplay.decimatedPath();
+
+  m_replayPathScreenPoints.clear();
+  for (const Point2d& position : path) {
+    ImVec2 pt = ToScreenCoordinate(position, m_settings->fieldImage, bb);
+
+    // The path is decimated in field space already, but zoomed out it can still be much denser than pixels.
+    if (!m_replayPathScreenPoints.empty()) {
+      ImVec2 delta = pt - m_replayPathScreenPoints.back();
+      if (delta.x * delta.x + delta.y * delta.y < 2.f * 2.f)
+        continue;
+    }
+    m_replayPathScreenPoints.push_back(pt);
+  }
+
+  if (m_replayPathScreenPoints.size() > 1) {
+    drawList->AddPolyline(m_replayPathScreenPoints.data(), static_cast<int>(m_replayPathScreenPoints.size()),
+                          kReplayPathColor, ImDrawFlags_None, GET_UISIZE(LINE_THICKNESS));
+  }
+
+  // Actual robot.
+
+  std::optional<RobotLog::PoseSample> sample = m_robotLogReplay.sample(m_playbackTime);
+  if (!sample)
+    return;
+
+  drawRobot(sample->position, sample->rotation, 0.f, GET_UISIZE(DRAG_POINT_RADIUS) / 1.5f, kReplayRobotColor,
+            bb);
+
+  // Tracking error.
+
+  if (!m_plannedRobotPosition)
+    return;
+
+  const Point2d& planned = *m_plannedRobotPosition;
+  const units::meter_t error = units::meter_t(std::hypot((sample->position.x - planned.x).value(),
+                                                         (sample->position.y - planned.y).value()));
+  m_replayTrackingError = error;
+
+  const ImVec2 plannedPt = ToScreenCoordinate(planned, m_settings->fieldImage, bb);
+  const ImVec2 actualPt = ToScreenCoordinate(sample->position, m_settings->fieldImage, bb);
+  drawList->AddLine(plannedPt, actualPt, kReplayErrorColor, GET_UISIZE(LINE_THICKNESS));
+
+  char buffer[32];
+  snprintf(buffer, sizeof(buffer), "%.2f m", error.value());
+  drawList->AddText((plannedPt + actualPt) * 0.5f, kReplayErrorColor, buffer);
+}
+
+void EditorPage::presentLivePose(ImRect bb) {
+  m_livePose.update();
+
+  std::optional<LivePoseSubscriber::Sample> latest = m_livePose.latest();
+  if (!latest)
+    return;
+
+  ImDrawList* drawList = ImGui::GetWindowDrawList();
+
+  const bool isStale = m_livePose.isStale();
+  const ImColor color = isStale ? kLivePoseStaleColor : kLivePoseColor;
+
+  // Trail, fading out towards the oldest sample.
+
+  const std::deque<LivePoseSubscriber::Sample>& trail = m_livePose.trail();
+
+  ImVec2 previousPt;
+  bool hasPreviousPt = false;
+  for (const LivePoseSubscriber::Sample& sample : trail) {
+    const Point2d position(units::meter_t(sample.x), units::meter_t(sample.y));
+    const ImVec2 pt = ToScreenCoordinate(position, m_settings->fieldImage, bb);
+
+    if (hasPreviousPt) {
+      ImVec2 delta = pt - previousPt;
+      if (delta.x * delta.x + delta.y * delta.y < 2.f * 2.f)
+        continue;
+
+      const float age = static_cast<float>(latest->time - sample.time) / LivePoseSubscriber::kTrailDuration;
+
+      ImColor segmentColor = color;
+      segmentColor.Value.w = std::clamp(1.f - age, 0.f, 1.f);
+      drawList->AddLine(previousPt, pt, segmentColor, GET_UISIZE(LINE_THICKNESS));
+    }
+
+    previousPt = pt;
+    hasPreviousPt = true;
+  }
+
+  // Robot.
+
+  const Point2d position(units::meter_t(latest->x), units::meter_t(latest->y));
+  const CanonicalAngle rotation(units::radian_t(latest->rotation));
+  drawRobot(position, rotation, 0.f, GET_UISIZE(DRAG_POINT_RADIUS) / 1.5f, color, bb);
 }
 
 void EditorPage::presentPlaybackSlider(const ThunderAutoProjectState& state) {
@@ -1484,11 +1884,7 @@ void EditorPage::presentPlaybackSlider(const ThunderAutoProjectState& state) {
       }
       break;
     case AUTO_MODE:
-      for (const auto& [cachedTrajectory, isActive] : m_cachedAutoModeTrajectories) {
-        if (cachedTrajectory && isActive) {
-          totalTime += cachedTrajectory->totalTime;
-        }
-      }
+      totalTime = m_autoModeTimeline.totalTime();
       break;
     case NONE:
       break;
@@ -1538,6 +1934,43 @@ void EditorPage::presentPlaybackSlider(const ThunderAutoProjectState& state) {
 
     m_playbackTime = units::second_t(playbackTime);
   }
+
+  if (editorState.view == ThunderAutoEditorState::View::AUTO_MODE) {
+    presentPlaybackSliderMarkers(ImRect(ImGui::GetItemRectMin(), ImGui::GetItemRectMax()));
+  }
+}
+
+void EditorPage::presentPlaybackSliderMarkers(ImRect sliderBB) {
+  const units::second_t totalTime = m_autoModeTimeline.totalTime();
+  if (totalTime <= 0.0_s)
+    return;
+
+  ImDrawList* drawList = ImGui::GetWindowDrawList();
+
+  // The slider grab doesn't reach the very ends of the frame.
+  const ImGuiStyle& style = ImGui::GetStyle();
+  const float grabHalfWidth = style.GrabMinSize / 2.f + style.FramePadding.x;
+  const float left = sliderBB.Min.x + grabHalfWidth;
+  const float width = sliderBB.GetWidth() - grabHalfWidth * 2.f;
+  const float tickHeight = sliderBB.GetHeight() / 4.f;
+
+  const bool isSliderHovered = ImGui::IsItemHovered();
+  const ImVec2 mousePosition = ImGui::GetMousePos();
+
+  for (const PlaybackTimeline::Marker& marker : m_autoModeTimeline.markers()) {
+    const float x = left + width * static_cast<float>(marker.time.value() / totalTime.value());
+
+    const ImU32 color = marker.type == PlaybackTimeline::Marker::Type::ACTION ? kPlaybackActionMarkerColor
+                                                                              : kPlaybackBranchMarkerColor;
+
+    drawList->AddLine(ImVec2(x, sliderBB.Min.y), ImVec2(x, sliderBB.Min.y + tickHeight), color, 2.f);
+    drawList->AddLine(ImVec2(x, sliderBB.Max.y - tickHeight), ImVec2(x, sliderBB.Max.y), color, 2.f);
+
+    if (isSliderHovered && std::abs(mousePosition.x - x) <= 3.f) {
+      const char* typeName = marker.type == PlaybackTimeline::Marker::Type::ACTION ? "Action" : "Branch";
+      ImGui::SetTooltip("%s: %s (%.2f s)", typeName, marker.label.c_str(), marker.time.value());
+    }
+  }
 }
 
 void EditorPage::processPlaybackInput() {
@@ -1574,28 +2007,16 @@ void EditorPage::drawRobot(const Point2d& position,
 
   // Draw the robot outline.
 
-  // Calculate the points for the robot preview rectangle just once, unless size gets changed.
-  if (m_robotRectangleSize != m_settings->robotSize ||
-      m_robotRectangleCornerRadius != m_settings->robotCornerRadius) {
-    m_robotRectangleSize = m_settings->robotSize;
-    m_robotRectangleCornerRadius = m_settings->robotCornerRadius;
-
-    m_baseRobotRectangle = CreateRoundedRectangle(m_robotRectangleSize, m_robotRectangleCornerRadius);
-  }
+  updateBaseRobotPolygon();
 
-  TPolyline robotPreviewRectangle = m_baseRobotRectangle;
+  const PolygonTransform transform = PolygonTransform::FromPose(position, rotation);
 
-  RotatePolygon(robotPreviewRectangle, rotation);
-  TranslatePolygon(robotPreviewRectangle, Displacement2d(position.x, position.y));
+  m_robotOutlineX.resize(m_baseRobotPolygon.size());
+  m_robotOutlineY.resize(m_baseRobotPolygon.size());
 
-  std::vector<ImVec2> screenCoordinates(robotPreviewRectangle.size());
-  std::transform(robotPreviewRectangle.begin(), robotPreviewRectangle.end(), screenCoordinates.begin(),
-                 [&](const Point2d& fieldCoordinate) {
-                   return ToScreenCoordinate(fieldCoordinate, m_settings->fieldImage, bb);
-                 });
+  TransformPolygonBatch(m_baseRobotPolygon, std::span(&transform, 1), m_robotOutlineX, m_robotOutlineY);
 
-  drawList->AddPolyline(screenCoordinates.data(), static_cast<int>(screenCoordinates.size()), color,
-                        ImDrawFlags_Closed, GET_UISIZE(LINE_THICKNESS));
+  drawRobotOutlines(m_robotOutlineX, m_robotOutlineY, 1, color, bb);
 }
 
 void EditorPage::drawRobot(const frc::Pose2d& pose,
@@ -1607,4 +2028,107 @@ void EditorPage::drawRobot(const frc::Pose2d& pose,
             bb);
 }
 
+void EditorPage::updateCollisionChecker(const ThunderAutoProjectState& state) {
+  if (!m_keepOutZones)
+    return;
+
+  if (m_keepOutZonesChanged || m_collisionRobotSize != m_settings->robotSize ||
+      m_collisionRobotCornerRadius != m_settings->robotCornerRadius) {
+    m_keepOutZonesChanged = false;
+    m_collisionRobotSize = m_settings->robotSize;
+    m_collisionRobotCornerRadius = m_settings->robotCornerRadius;
+
+    m_collisionChecker.setGeometry(*m_keepOutZones, m_collisionRobotSize, m_collisionRobotCornerRadius);
+  }
+
+  m_previewTrajectories.update(state);
+  m_collisionChecker.update(state, m_previewTrajectories);
+}
+
+const TrajectoryThumbnails& EditorPage::trajectoryThumbnails(const ThunderAutoProjectState& state) {
+  const int frame = ImGui::GetFrameCount();
+  if (m_trajectoryThumbnailsUpdateFrame != frame && m_settings) {
+    m_trajectoryThumbnailsUpdateFrame = frame;
+    m_previewTrajectories.update(state);
+    m_trajectoryThumbnails.update(state, m_previewTrajectories, m_settings->fieldImage.fieldSize());
+  }
+
+  return m_trajectoryThumbnails;
+}
+
+void EditorPage::presentKeepOutZones(ImRect bb) {
+  if (!m_keepOutZones)
+    return;
+
+  ImDrawList* drawList = ImGui::GetWindowDrawList();
+
+  for (const KeepOutZone& zone : *m_keepOutZones) {
+    if (zone.vertices.size() < 3)
+      continue;
+
+    m_keepOutZoneScreenPoints.resize(zone.vertices.size());
+    std::transform(zone.vertices.begin(), zone.vertices.end(), m_keepOutZoneScreenPoints.begin(),
+                   [&](const Point2d& vertex) {
+                     return ToScreenCoordinate(vertex, m_settings->fieldImage, bb);
+                   });
+
+    const int numPoints = static_cast<int>(m_keepOutZoneScreenPoints.size());
+    drawList->AddConcavePolyFilled(m_keepOutZoneScreenPoints.data(), numPoints, kKeepOutZoneColor);
+    drawList->AddPolyline(m_keepOutZoneScreenPoints.data(), numPoints, kKeepOutZoneOutlineColor,
+                          ImDrawFlags_Closed, GET_UISIZE(LINE_THICKNESS));
+  }
+}
+
+void EditorPage::updateBaseRobotPolygon() {
+  // Calculate the points for the robot outline just once, unless size gets changed.
+  if (m_baseRobotPolygon.size() > 0 && m_robotRectangleSize == m_settings->robotSize &&
+      m_robotRectangleCornerRadius == m_settings->robotCornerRadius) {
+    return;
+  }
+
+  m_robotRectangleSize = m_settings->robotSize;
+  m_robotRectangleCornerRadius = m_settings->robotCornerRadius;
+
+  m_baseRobotPolygon =
+      PolylineToSoA(CreateRoundedRectangle(m_robotRectangleSize, m_robotRectangleCornerRadius));
+
+  // The footprints were built from the old outline.
+  m_robotFootprints.isValid = false;
+}
+
+void EditorPage::drawRobotOutlines(std::span<const float> x,
+                                   std::span<const float> y,
+                                   size_t numOutlines,
+                                   ImU32 color,
+                                   ImRect bb) {
+  ImDrawList* drawList = ImGui::GetWindowDrawList();
+
+  const size_t numVertices = m_baseRobotPolygon.size();
+  if (!numVertices)
+    return;
+
+  ThunderAutoAssert(x.size() >= numOutlines * numVertices);
+  ThunderAutoAssert(y.size() >= numOutlines * numVertices);
+
+  // Field to screen coordinates is just a scale and an offset on each axis, so find them once instead of
+  // calling ToScreenCoordinate() for every vertex.
+  const ImVec2 origin = ToScreenCoordinate(Point2d(0_m, 0_m), m_settings->fieldImage, bb);
+  const ImVec2 scale = ToScreenCoordinate(Point2d(1_m, 1_m), m_settings->fieldImage, bb) - origin;
+
+  m_robotOutlineScreenPoints.resize(numVertices);
+
+  for (size_t i = 0; i < numOutlines; i++) {
+    const float* outlineX = x.data() + i * numVertices;
+    const float* outlineY = y.data() + i * numVertices;
+
+    for (size_t j = 0; j < numVertices; j++) {
+      m_robotOutlineScreenPoints[j] =
+          ImVec2(origin.x + outlineX[j] * scale.x, origin.y + outlineY[j] * scale.y);
+    }
+
+    drawList->AddPolyline(m_robotOutlineScreenPoints.data(), static_cast<int>(numVertices), color,
+                          ImDrawFlags_Closed, GET_UISIZE(LINE_THICKNESS));
+  }
+}
+
 // hi ishan!!!
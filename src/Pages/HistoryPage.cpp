@@ -0,0 +1,116 @@
+#include <ThunderAuto/Pages/HistoryPage.hpp>
+
+#include <ThunderAuto/Logger.hpp>
+#include <IconsLucide.h>
+#include <imgui_raii.h>
+#include <ctime>
+#include <utility>
+
+void HistoryPage::present(bool* running) {
+  ImGui::SetNextWindowSize(
+      ImVec2(GET_UISIZE(HISTORY_PAGE_START_WIDTH), GET_UISIZE(HISTORY_PAGE_START_HEIGHT)),
+      ImGuiCond_FirstUseEver);
+  ImGui::Scoped scopedWindow = ImGui::Scoped::Window(name(), running);
+  if (!scopedWindow || (running && !*running))
+    return;
+
+  const HistoryManager& history = m_documentManager.history();
+
+  if (history.treeVersion() != m_rowsTreeVersion || history.rootNode() != m_rowsRootNode) {
+    rebuildRows(history);
+  }
+
+  const HistoryManager::NodeID currentNode = history.currentNode();
+  const bool currentNodeChanged = currentNode != m_lastCurrentNode;
+  m_lastCurrentNode = currentNode;
+
+  ImGui::BeginDisabled(history.isLocked());
+
+  HistoryManager::NodeID clickedNode = HistoryManager::kInvalidNodeID;
+
+  ImGuiListClipper clipper;
+  clipper.Begin(static_cast<int>(m_rows.size()));
+
+  // Keep the current row laid out so that it can be scrolled to.
+  if (currentNodeChanged) {
+    for (size_t i = 0; i < m_rows.size(); i++) {
+      if (m_rows[i].node == currentNode) {
+        clipper.IncludeItemByIndex(static_cast<int>(i));
+        break;
+      }
+    }
+  }
+
+  while (clipper.Step()) {
+    for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++) {
+      const Row& row = m_rows[i];
+      const bool isCurrent = row.node == currentNode;
+
+      auto scopedID = ImGui::Scoped::ID(static_cast<int>(i));
+
+      if (row.indent > 0) {
+        ImGui::Indent(GET_UISIZE(INDENT_SMALL) * row.indent);
+      }
+
+      if (ImGui::Selectable(row.label.c_str(), isCurrent) && !isCurrent) {
+        clickedNode = row.node;
+      }
+
+      if (isCurrent && currentNodeChanged) {
+        ImGui::SetScrollHereY();
+      }
+
+      if (row.indent > 0) {
+        ImGui::Unindent(GET_UISIZE(INDENT_SMALL) * row.indent);
+      }
+    }
+  }
+
+  ImGui::EndDisabled();
+
+  if (clickedNode != HistoryManager::kInvalidNodeID) {
+    m_history.jumpTo(clickedNode);
+  }
+}
+
+void HistoryPage::rebuildRows(const HistoryManager& history) {
+  m_rows.clear();
+  m_rows.reserve(history.numEntries());
+
+  m_rowsTreeVersion = history.treeVersion();
+  m_rowsRootNode = history.rootNode();
+
+  // Each node's last child continues on the same line, while older branches are shown indented above it.
+  // Walked with an explicit stack since a long history is a very deep tree.
+
+  std::vector<std::pair<HistoryManager::NodeID, size_t>> stack = {{history.rootNode(), 0}};
+  std::vector<size_t> depths = {0};
+
+  while (!stack.empty()) {
+    auto [node, indent] = stack.back();
+    stack.pop_back();
+    size_t depth = depths.back();
+    depths.pop_back();
+
+    std::time_t timestamp = HistoryManager::Clock::to_time_t(history.timestampOf(node));
+    std::tm* localTime = std::localtime(&timestamp);
+
+    std::string label;
+    if (depth == 0) {
+      label = fmt::format(ICON_LC_FOLDER_OPEN "  Start  {:02}:{:02}:{:02}", localTime->tm_hour,
+                          localTime->tm_min, localTime->tm_sec);
+    } else {
+      label = fmt::format(ICON_LC_HISTORY "  Change {}  {:02}:{:02}:{:02}", depth, localTime->tm_hour,
+                          localTime->tm_min, localTime->tm_sec);
+    }
+
+    m_rows.push_back(Row{.node = node, .indent = indent, .label = std::move(label)});
+
+    const std::vector<HistoryManager::NodeID>& children = history.childrenOf(node);
+    for (auto it = children.rbegin(); it != children.rend(); ++it) {
+      const bool isLastChild = it == children.rbegin();
+      stack.emplace_back(*it, isLastChild ? indent : indent + 1);
+      depths.push_back(depth + 1);
+    }
+  }
+}
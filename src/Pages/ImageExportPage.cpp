@@ -0,0 +1,154 @@
+#include <ThunderAuto/Pages/ImageExportPage.hpp>
+
+#include <ThunderAuto/ImGuiScopedField.hpp>
+#include <ThunderAuto/Logger.hpp>
+#include <IconsLucide.h>
+#include <imgui_raii.h>
+
+static const char* TrajectoryOverlayToString(EditorPageTrajectoryOverlay overlay) noexcept {
+  switch (overlay) {
+    using enum EditorPageTrajectoryOverlay;
+    case VELOCITY:
+      return "Velocity";
+    case CURVATURE:
+      return "Curvature";
+    default:
+      return "Unknown";
+  }
+}
+
+void ImageExportPage::present(bool* running) {
+  ImGui::SetNextWindowSize(
+      ImVec2(GET_UISIZE(IMAGE_EXPORT_PAGE_START_WIDTH), GET_UISIZE(IMAGE_EXPORT_PAGE_START_HEIGHT)),
+      ImGuiCond_FirstUseEver);
+  ImGui::Scoped scopedWindow = ImGui::Scoped::Window(name(), running);
+  if (!scopedWindow || (running && !*running))
+    return;
+
+  if (m_export && m_export->isFinished()) {
+    m_result = m_export->takeResult();
+    m_hasResult = true;
+    m_export.reset();
+
+    if (!m_result.error.empty()) {
+      ThunderAutoLogger::Error("Image export failed: {}", m_result.error);
+    } else if (!m_result.cancelled) {
+      for (const std::string& failure : m_result.failures) {
+        ThunderAutoLogger::Error("{}", failure);
+      }
+      ThunderAutoLogger::Info("Exported {} images to '{}'", m_result.numImages, m_exportDirectory.string());
+    }
+  }
+
+  {
+    auto scopedDisabled = ImGui::Scoped::Disabled(m_export != nullptr);
+    presentOptions();
+  }
+
+  ImGui::Spacing();
+
+  if (m_export) {
+    ImGui::ProgressBar(m_export->progress(), ImVec2(-FLT_MIN, 0.f), "Exporting...");
+    if (ImGui::Button(ICON_LC_X "  Cancel")) {
+      m_export->cancel();
+    }
+  } else if (ImGui::Button(ICON_LC_IMAGE "  Export")) {
+    m_exportDirectory = m_documentManager.settings().directory / "images";
+    ThunderAutoLogger::Info("Export images to '{}'", m_exportDirectory.string());
+
+    m_export = std::make_unique<ImageExport>(m_history.currentState(), m_documentManager.settings(),
+                                             m_exportDirectory, m_options);
+    m_hasResult = false;
+  }
+
+  if (m_hasResult) {
+    ImGui::Spacing();
+    presentResult();
+  }
+}
+
+void ImageExportPage::reset() noexcept {
+  m_export.reset();
+  m_exportDirectory.clear();
+  m_result = {};
+  m_hasResult = false;
+}
+
+void ImageExportPage::presentOptions() {
+  OffscreenRenderer::Options& renderOptions = m_options.render;
+
+  {
+    auto scopedField = ImGui::ScopedField::Builder("Image Width")
+                           .tooltip("The height follows the aspect ratio of the field image")
+                           .build();
+    ImGui::DragInt("##Image Width", &renderOptions.imageWidth, 8.f, 256, 8192, "%d px",
+                   ImGuiSliderFlags_AlwaysClamp);
+  }
+  {
+    auto scopedField = ImGui::ScopedField::Builder("Overlay").build();
+
+    const char* overlayStr = TrajectoryOverlayToString(renderOptions.trajectoryOverlay);
+    if (auto scopedCombo = ImGui::Scoped::Combo("##Overlay", overlayStr)) {
+      using enum EditorPageTrajectoryOverlay;
+      for (EditorPageTrajectoryOverlay overlay : {VELOCITY, CURVATURE}) {
+        const bool isSelected = renderOptions.trajectoryOverlay == overlay;
+        if (ImGui::Selectable(TrajectoryOverlayToString(overlay), isSelected)) {
+          renderOptions.trajectoryOverlay = overlay;
+        }
+      }
+    }
+  }
+  {
+    auto scopedField = ImGui::ScopedField::Builder("Show Actions").build();
+    ImGui::Checkbox("##Show Actions", &renderOptions.showActions);
+  }
+  {
+    auto scopedField = ImGui::ScopedField::Builder("Show Robot Footprints").build();
+    ImGui::Checkbox("##Show Robot Footprints", &renderOptions.showRobotFootprints);
+  }
+  if (renderOptions.showRobotFootprints) {
+    auto scopedField = ImGui::ScopedField::Builder("Footprint Interval").build();
+
+    float interval = static_cast<float>(renderOptions.robotFootprintInterval.value());
+    if (ImGui::DragFloat("##Footprint Interval", &interval, 0.01f, 0.05f, 5.f, "%.2f s",
+                         ImGuiSliderFlags_AlwaysClamp)) {
+      renderOptions.robotFootprintInterval = units::second_t(static_cast<double>(interval));
+    }
+  }
+  {
+    auto scopedField = ImGui::ScopedField::Builder("Export Frames")
+                           .tooltip("Export every frame of playback instead of one image each")
+                           .build();
+    ImGui::Checkbox("##Export Frames", &m_options.exportFrames);
+  }
+  if (m_options.exportFrames) {
+    auto scopedField = ImGui::ScopedField::Builder("Frame Rate").build();
+
+    float framesPerSecond = static_cast<float>(m_options.framesPerSecond);
+    if (ImGui::DragFloat("##Frame Rate", &framesPerSecond, 0.5f, 1.f, 120.f, "%.0f fps",
+                         ImGuiSliderFlags_AlwaysClamp)) {
+      m_options.framesPerSecond = static_cast<double>(framesPerSecond);
+    }
+  }
+}
+
+void ImageExportPage::presentResult() {
+  if (!m_result.error.empty()) {
+    ImGui::TextWrapped(ICON_LC_TRIANGLE_ALERT "  Export failed: %s", m_result.error.c_str());
+    return;
+  }
+
+  if (m_result.cancelled) {
+    ImGui::TextDisabled("Export cancelled after %zu images", m_result.numImages);
+    return;
+  }
+
+  ImGui::TextWrapped("Exported %zu images to %s", m_result.numImages, m_exportDirectory.string().c_str());
+
+  if (!m_result.failures.empty()) {
+    ImGui::TextWrapped(ICON_LC_TRIANGLE_ALERT "  %zu failed:", m_result.failures.size());
+    for (const std::string& failure : m_result.failures) {
+      ImGui::BulletText("%s", failure.c_str());
+    }
+  }
+}
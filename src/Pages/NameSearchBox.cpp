@@ -0,0 +1,46 @@
+#include <ThunderAuto/Pages/NameSearchBox.hpp>
+
+#include <IconsLucide.h>
+#include <imgui.h>
+#include <imgui_raii.h>
+
+void NameSearchBox::present(const char* hint) {
+  auto scopedID = ImGui::Scoped::ID(this);
+
+  const ImGuiStyle& style = ImGui::GetStyle();
+  const float clearButtonWidth = ImGui::CalcTextSize(ICON_LC_X).x + style.FramePadding.x * 2.f;
+
+  float inputWidth = ImGui::GetContentRegionAvail().x;
+  if (isSearching()) {
+    inputWidth -= clearButtonWidth + style.ItemSpacing.x;
+  }
+
+  ImGui::SetNextItemWidth(inputWidth);
+  ImGui::InputTextWithHint("##Search", hint, m_query, sizeof(m_query));
+
+  if (isSearching()) {
+    ImGui::SameLine();
+    if (ImGui::Button(ICON_LC_X)) {
+      clear();
+    }
+    if (ImGui::IsItemHovered(ImGuiHoveredFlags_DelayNormal)) {
+      ImGui::SetTooltip("Clear search");
+    }
+  }
+}
+
+const std::vector<size_t>& NameSearchBox::matches(const NameSearchIndex& index) {
+  if (m_lastQuery != m_query || m_lastIndex != &index || m_lastIndexVersion != index.version()) {
+    m_lastQuery = m_query;
+    m_lastIndex = &index;
+    m_lastIndexVersion = index.version();
+
+    index.search(m_lastQuery, m_matches);
+  }
+
+  return m_matches;
+}
+
+void NameSearchBox::clear() noexcept {
+  m_query[0] = '\0';
+}
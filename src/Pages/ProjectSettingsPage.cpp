@@ -5,6 +5,9 @@
 #include <ThunderAuto/Error.hpp>
 #include <IconsLucide.h>
 #include <imgui_raii.h>
+#include <imgui_internal.h>
+#include <fmt/format.h>
+#include <cstring>
 
 void ProjectSettingsPage::present(bool* running) {
   ImGui::SetNextWindowSize(
@@ -29,13 +32,19 @@ void ProjectSettingsPage::present(bool* running) {
       m_subPage = SettingsSubPage::ROBOT_SETTINGS;
     }
 
-    if (ImGui::Selectable("CSV Export Settings", m_subPage == SettingsSubPage::CSV_EXPORT_SETTINGS)) {
+    if (ImGui::Selectable("Export Settings", m_subPage == SettingsSubPage::CSV_EXPORT_SETTINGS)) {
       m_subPage = SettingsSubPage::CSV_EXPORT_SETTINGS;
     }
     if (ImGui::Selectable("Trajectory Editor Settings",
                           m_subPage == SettingsSubPage::TRAJECTORY_EDITOR_SETTINGS)) {
       m_subPage = SettingsSubPage::TRAJECTORY_EDITOR_SETTINGS;
     }
+    if (ImGui::Selectable("Keep-Out Zone Settings", m_subPage == SettingsSubPage::KEEP_OUT_ZONE_SETTINGS)) {
+      m_subPage = SettingsSubPage::KEEP_OUT_ZONE_SETTINGS;
+    }
+    if (ImGui::Selectable("Undo History Settings", m_subPage == SettingsSubPage::UNDO_HISTORY_SETTINGS)) {
+      m_subPage = SettingsSubPage::UNDO_HISTORY_SETTINGS;
+    }
   }
 
   ImGui::SameLine();
@@ -53,6 +62,12 @@ void ProjectSettingsPage::present(bool* running) {
       case SettingsSubPage::TRAJECTORY_EDITOR_SETTINGS:
         presentTrajectoryEditorSettings();
         break;
+      case SettingsSubPage::KEEP_OUT_ZONE_SETTINGS:
+        presentKeepOutZoneSettings();
+        break;
+      case SettingsSubPage::UNDO_HISTORY_SETTINGS:
+        presentUndoHistorySettings();
+        break;
       default:
         ThunderAutoUnreachable("Invalid project settings sub page");
     }
@@ -105,7 +120,7 @@ void ProjectSettingsPage::presentCSVExportSettings() {
   // Title
   {
     auto scopedFont = ImGui::Scoped::Font(FontLibrary::get().boldFont, 0.f);
-    ImGui::Text("CSV Export Settings");
+    ImGui::Text("Export Settings");
 
     ImGui::Spacing();
   }
@@ -127,9 +142,29 @@ void ProjectSettingsPage::presentCSVExportSettings() {
 
   const float fieldLeftColumnWidth = GET_UISIZE(FIELD_NORMAL_LEFT_COLUMN_WIDTH) * 1.25f;
 
-  ImGui::SeparatorText("CSV Format");
+  ImGui::SeparatorText("Format");
 
+  TrajectoryExportFormat& exportFormat = m_documentManager.trajectoryExportFormat();
   {
+    auto scopedField = ImGui::ScopedField::Builder("Format")
+                           .leftColumnWidth(fieldLeftColumnWidth)
+                           .tooltip("Binary files can be memory mapped and read in place on the robot "
+                                    "(see BinaryTrajectoryReader.hpp)")
+                           .build();
+
+    if (auto scopedCombo = ImGui::Scoped::Combo("##Format", TrajectoryExportFormatToString(exportFormat))) {
+      using enum TrajectoryExportFormat;
+      for (TrajectoryExportFormat format : {CSV, BINARY}) {
+        const bool isSelected = exportFormat == format;
+        if (ImGui::Selectable(TrajectoryExportFormatToString(format), isSelected) && !isSelected) {
+          exportFormat = format;
+          changed = true;
+        }
+      }
+    }
+  }
+
+  if (exportFormat == TrajectoryExportFormat::CSV) {
     auto scopedField = ImGui::ScopedField::Builder("Include Header")
                            .leftColumnWidth(fieldLeftColumnWidth)
                            .tooltip("Write a header to the first line of the CSV with column names")
@@ -137,7 +172,7 @@ void ProjectSettingsPage::presentCSVExportSettings() {
     changed |= ImGui::Checkbox("##Include Header", &exportProperties.includeHeader);
   }
 
-  ImGui::SeparatorText("CSV Values");
+  ImGui::SeparatorText("Values");
 
   {
     auto scopedField = ImGui::ScopedField::Builder("Time").leftColumnWidth(fieldLeftColumnWidth).build();
@@ -220,4 +255,176 @@ void ProjectSettingsPage::presentTrajectoryEditorSettings() {
     auto scopedField = ImGui::ScopedField::Builder("Show Tooltip").build();
     ImGui::Checkbox("##Show Tooltip", &options.showTooltip);
   }
+  {
+    auto scopedField = ImGui::ScopedField::Builder("Show Robot Footprints")
+                           .tooltip("Draw the robot's outline along the trajectory to check clearances")
+                           .build();
+    ImGui::Checkbox("##Show Robot Footprints", &options.showRobotFootprints);
+  }
+  if (options.showRobotFootprints) {
+    auto scopedField = ImGui::ScopedField::Builder("Footprint Interval")
+                           .tooltip("Time between each robot footprint drawn along the trajectory")
+                           .build();
+    ImGui::DragFloat("##Footprint Interval", &options.robotFootprintInterval, 0.01f, 0.05f, 2.f, "%.2f s",
+                     ImGuiSliderFlags_AlwaysClamp);
+  }
+}
+
+void ProjectSettingsPage::presentKeepOutZoneSettings() {
+  // Title
+  {
+    auto scopedFont = ImGui::Scoped::Font(FontLibrary::get().boldFont, 0.f);
+    ImGui::Text("Keep-Out Zone Settings");
+
+    ImGui::Spacing();
+  }
+
+  KeepOutZoneList& zones = m_documentManager.keepOutZones();
+  bool changed = false;
+
+  {
+    auto scopedField = ImGui::ScopedField::Builder("Show Keep-Out Zones").build();
+    ImGui::Checkbox("##Show Keep-Out Zones", &m_editorPage.trajectoryEditorOptions.showKeepOutZones);
+  }
+
+  if (ImGui::Button(ICON_LC_PLUS "  Add Zone")) {
+    const Measurement2d fieldSize = m_documentManager.settings().fieldImage.fieldSize();
+    const Point2d fieldCenter(units::meter_t(fieldSize.x() / 2.0), units::meter_t(fieldSize.y() / 2.0));
+
+    zones.push_back(MakeDefaultKeepOutZone(fmt::format("Zone {}", zones.size() + 1), fieldCenter));
+    changed = true;
+  }
+
+  std::optional<size_t> zoneToRemove;
+
+  for (size_t zoneIndex = 0; zoneIndex < zones.size(); zoneIndex++) {
+    auto scopedID = ImGui::Scoped::ID(static_cast<int>(zoneIndex));
+
+    ImGui::Separator();
+
+    bool remove = false;
+    changed |= presentKeepOutZone(zones[zoneIndex], &remove);
+    if (remove) {
+      zoneToRemove = zoneIndex;
+    }
+  }
+
+  if (zoneToRemove) {
+    zones.erase(zones.begin() + *zoneToRemove);
+    changed = true;
+  }
+
+  if (changed) {
+    m_documentManager.history().markUnsaved();
+    m_editorPage.invalidateKeepOutZones();
+  }
+}
+
+bool ProjectSettingsPage::presentKeepOutZone(KeepOutZone& zone, bool* remove) {
+  bool changed = false;
+
+  {
+    auto scopedField = ImGui::ScopedField::Builder("Name").build();
+
+    char nameBuffer[64] = {};
+    std::strncpy(nameBuffer, zone.name.c_str(), sizeof(nameBuffer) - 1);
+
+    if (ImGui::InputText("##Name", nameBuffer, sizeof(nameBuffer))) {
+      zone.name = nameBuffer;
+      changed = true;
+    }
+  }
+
+  std::optional<size_t> vertexToRemove;
+
+  for (size_t vertexIndex = 0; vertexIndex < zone.vertices.size(); vertexIndex++) {
+    auto scopedID = ImGui::Scoped::ID(static_cast<int>(vertexIndex));
+
+    Point2d& vertex = zone.vertices[vertexIndex];
+
+    const std::string label = fmt::format("Vertex {}", vertexIndex + 1);
+    auto scopedField = ImGui::ScopedField::Builder(label.c_str()).build();
+
+    float position[2] = {static_cast<float>(vertex.x.value()), static_cast<float>(vertex.y.value())};
+
+    const float removeButtonWidth = ImGui::GetFrameHeight();
+    {
+      auto scopedItemWidth = ImGui::Scoped::ItemWidth(ImGui::GetContentRegionAvail().x - removeButtonWidth -
+                                                      ImGui::GetStyle().ItemSpacing.x);
+
+      if (ImGui::DragFloat2("##Position", position, 0.01f, 0.f, 0.f, "%.2f m")) {
+        vertex = Point2d(units::meter_t(static_cast<double>(position[0])),
+                         units::meter_t(static_cast<double>(position[1])));
+        changed = true;
+      }
+    }
+
+    ImGui::SameLine();
+
+    // A zone needs at least 3 vertices.
+    auto scopedDisabled = ImGui::Scoped::Disabled(zone.vertices.size() <= 3);
+    if (ImGui::Button(ICON_LC_TRASH, ImVec2(removeButtonWidth, 0.f))) {
+      vertexToRemove = vertexIndex;
+    }
+  }
+
+  if (vertexToRemove) {
+    zone.vertices.erase(zone.vertices.begin() + *vertexToRemove);
+    changed = true;
+  }
+
+  if (ImGui::Button(ICON_LC_PLUS "  Add Vertex")) {
+    // Split the edge between the last and first vertices.
+    const Point2d& first = zone.vertices.front();
+    const Point2d& last = zone.vertices.back();
+    zone.vertices.push_back(Point2d((first.x + last.x) / 2.0, (first.y + last.y) / 2.0));
+    changed = true;
+  }
+
+  ImGui::SameLine();
+
+  if (ImGui::Button(ICON_LC_TRASH "  Remove Zone")) {
+    *remove = true;
+  }
+
+  return changed;
+}
+
+void ProjectSettingsPage::presentUndoHistorySettings() {
+  // Title
+  {
+    auto scopedFont = ImGui::Scoped::Font(FontLibrary::get().boldFont, 0.f);
+    ImGui::Text("Undo History Settings");
+
+    ImGui::Spacing();
+  }
+
+  HistoryManager& history = m_documentManager.history();
+
+  constexpr size_t kBytesPerMiB = 1024 * 1024;
+
+  {
+    auto scopedField =
+        ImGui::ScopedField::Builder("Memory Budget")
+            .tooltip("How much memory undo history can use before older changes are moved to disk")
+            .build();
+
+    const int minBudgetMiB = static_cast<int>(HistoryManager::kMinMemoryBudget / kBytesPerMiB);
+
+    int budgetMiB = static_cast<int>(history.memoryBudget() / kBytesPerMiB);
+    if (ImGui::DragInt("##Memory Budget", &budgetMiB, 1.f, minBudgetMiB, 4096, "%d MiB",
+                       ImGuiSliderFlags_AlwaysClamp)) {
+      history.setMemoryBudget(static_cast<size_t>(budgetMiB) * kBytesPerMiB);
+      ImGui::MarkIniSettingsDirty();  // Saved with the app settings.
+    }
+  }
+
+  ImGui::Spacing();
+
+  ImGui::TextDisabled("%zu changes, %.1f MiB in memory", history.numEntries(),
+                      static_cast<double>(history.residentMemoryUsage()) / kBytesPerMiB);
+  if (history.spilledSize() > 0) {
+    ImGui::TextDisabled("%.1f MiB of older changes on disk",
+                        static_cast<double>(history.spilledSize()) / kBytesPerMiB);
+  }
 }
@@ -10,6 +10,8 @@
 #include <imgui_raii.h>
 #include <imgui_internal.h>
 #include <fmt/format.h>
+#include <algorithm>
+#include <iterator>
 #include <limits>
 
 static const ImU32 kWarningTextColor = IM_COL32(255, 242, 0, 255);
@@ -19,6 +21,16 @@ static const float kAngleSliderSpeed = 1.f;
 static const float kVelocitySliderSpeed = 0.025f;
 static const float kTrajectoryPositionSliderSpeed = 0.025f;
 
+// Trajectory properties only change the current trajectory (plus the trajectories linked to it, which the
+// link index adds), so they say so instead of having the whole project compared every frame of a drag.
+static StateChangeSet CurrentTrajectoryChanges(const ThunderAutoProjectState& state,
+                                               bool selectionChanged = false) {
+  StateChangeSet changes;
+  changes.trajectories.insert(state.editorState.trajectoryEditorState.currentTrajectoryName);
+  changes.trajectorySelection = selectionChanged;
+  return changes;
+}
+
 void PropertiesPage::present(bool* running) {
   m_event = Event::NONE;
 
@@ -69,6 +81,9 @@ void PropertiesPage::presentTrajectoryItemList(ThunderAutoProjectState& state) {
     ThunderAutoTrajectoryEditorState& editorState = state.editorState.trajectoryEditorState;
     ThunderAutoTrajectorySkeleton& skeleton = state.currentTrajectory();
 
+    const TrajectoryItemLists& itemLists =
+        trajectoryItemLists(editorState.currentTrajectoryName, skeleton);
+
     // Don't push id on tabs so that child window is the same for all tabs (user can change the size of one,
     // changes it for all).
 
@@ -80,105 +95,115 @@ void PropertiesPage::presentTrajectoryItemList(ThunderAutoProjectState& state) {
       auto scopedPadding =
           ImGui::Scoped::StyleVarY(ImGuiStyleVar_ItemSpacing, GET_UISIZE(SELECTABLE_LIST_ITEM_SPACING_Y));
 
-      size_t pointIndex = 0;
-      for (auto pointIt = skeleton.begin(); pointIt != skeleton.end(); pointIt++, pointIndex++) {
-        auto scopedID = ImGui::Scoped::ID(pointIndex);
-
-        std::string selectableTitle = fmt::format("{}:    ({:.2f} m, {:.2f} m)", pointIndex,
-                                                  pointIt->position().x(), pointIt->position().y());
+      // Only the rows in view are drawn.
+      bool pointsChanged = false;
+      ImGuiListClipper clipper;
+      clipper.Begin(static_cast<int>(skeleton.numPoints()));
+      while (!pointsChanged && clipper.Step()) {
+        size_t pointIndex = static_cast<size_t>(clipper.DisplayStart);
+        auto pointIt = std::next(skeleton.begin(), clipper.DisplayStart);
+        for (; pointIndex < static_cast<size_t>(clipper.DisplayEnd); pointIt++, pointIndex++) {
+          auto scopedID = ImGui::Scoped::ID(pointIndex);
 
-        const bool isPointLinked = pointIt->isLinked();
+          std::string selectableTitle = fmt::format("{}:    ({:.2f} m, {:.2f} m)", pointIndex,
+                                                    pointIt->position().x(), pointIt->position().y());
 
-        if (isPointLinked) {
-          selectableTitle += fmt::format("  {}  {}", ICON_LC_ARROW_RIGHT, pointIt->linkName());
-        }
-        if (pointIndex == 0 && skeleton.hasStartBehaviorLink()) {
-          selectableTitle +=
-              fmt::format("  {}  {}", ICON_LC_ARROW_RIGHT_TO_LINE, skeleton.startBehaviorLinkName());
-        } else if (pointIndex == skeleton.numPoints() - 1 && skeleton.hasEndBehaviorLink()) {
-          selectableTitle +=
-              fmt::format("  {}  {}", ICON_LC_ARROW_RIGHT_TO_LINE, skeleton.endBehaviorLinkName());
-        }
+          const bool isPointLinked = pointIt->isLinked();
 
-        const bool isPointSelected = (editorState.trajectorySelection ==
-                                      ThunderAutoTrajectoryEditorState::TrajectorySelection::WAYPOINT) &&
-                                     (editorState.selectionIndex == pointIndex);
-
-        if (ImGui::Selectable(selectableTitle.c_str(), isPointSelected, ImGuiSelectableFlags_AllowOverlap)) {
-          editorState.trajectorySelection = ThunderAutoTrajectoryEditorState::TrajectorySelection::WAYPOINT;
-          editorState.selectionIndex = pointIndex;
-          m_history.addState(state, false);
-        }
+          if (isPointLinked) {
+            selectableTitle += fmt::format("  {}  {}", ICON_LC_ARROW_RIGHT, pointIt->linkName());
+          }
+          if (pointIndex == 0 && skeleton.hasStartBehaviorLink()) {
+            selectableTitle +=
+                fmt::format("  {}  {}", ICON_LC_ARROW_RIGHT_TO_LINE, skeleton.startBehaviorLinkName());
+          } else if (pointIndex == skeleton.numPoints() - 1 && skeleton.hasEndBehaviorLink()) {
+            selectableTitle +=
+                fmt::format("  {}  {}", ICON_LC_ARROW_RIGHT_TO_LINE, skeleton.endBehaviorLinkName());
+          }
 
-        const bool isPointLocked = pointIt->isEditorLocked();
+          const bool isPointSelected = (editorState.trajectorySelection ==
+                                        ThunderAutoTrajectoryEditorState::TrajectorySelection::WAYPOINT) &&
+                                       (editorState.selectionIndex == pointIndex);
 
-        // Right-click the point.
-        if (auto scopedContextMenu = ImGui::Scoped::PopupContextItem()) {
-          if (!isPointSelected) {
+          if (ImGui::Selectable(selectableTitle.c_str(), isPointSelected,
+                                ImGuiSelectableFlags_AllowOverlap)) {
             editorState.trajectorySelection = ThunderAutoTrajectoryEditorState::TrajectorySelection::WAYPOINT;
             editorState.selectionIndex = pointIndex;
             m_history.addState(state, false);
           }
 
-          {
-            auto scopedDisabled = ImGui::Scoped::Disabled(skeleton.numPoints() <= 2);
+          const bool isPointLocked = pointIt->isEditorLocked();
 
-            if (ImGui::MenuItem(ICON_LC_TRASH "  Delete Point")) {
-              state.currentTrajectoryDeleteSelectedItem();
-              m_history.addState(state);
-              break;
+          // Right-click the point.
+          if (auto scopedContextMenu = ImGui::Scoped::PopupContextItem()) {
+            if (!isPointSelected) {
+              editorState.trajectorySelection =
+                  ThunderAutoTrajectoryEditorState::TrajectorySelection::WAYPOINT;
+              editorState.selectionIndex = pointIndex;
+              m_history.addState(state, false);
             }
-          }
 
-          if (isPointLinked) {
-            if (ImGui::MenuItem(ICON_LC_LINK "  Edit Link")) {
-              m_event = Event::TRAJECTORY_POINT_LINK;
+            {
+              auto scopedDisabled = ImGui::Scoped::Disabled(skeleton.numPoints() <= 2);
+
+              if (ImGui::MenuItem(ICON_LC_TRASH "  Delete Point")) {
+                state.currentTrajectoryDeleteSelectedItem();
+                m_history.addState(state);
+                pointsChanged = true;
+                break;
+              }
             }
-            if (ImGui::MenuItem(ICON_LC_UNLINK "  Remove Link")) {
-              pointIt->removeLink();
-              m_history.addState(state);
+
+            if (isPointLinked) {
+              if (ImGui::MenuItem(ICON_LC_LINK "  Edit Link")) {
+                m_event = Event::TRAJECTORY_POINT_LINK;
+              }
+              if (ImGui::MenuItem(ICON_LC_UNLINK "  Remove Link")) {
+                pointIt->removeLink();
+                m_history.addState(state);
+              }
+            } else {
+              if (ImGui::MenuItem(ICON_LC_LINK "  Link")) {
+                m_event = Event::TRAJECTORY_POINT_LINK;
+              }
             }
-          } else {
-            if (ImGui::MenuItem(ICON_LC_LINK "  Link")) {
-              m_event = Event::TRAJECTORY_POINT_LINK;
+
+            const char* lockedMenuItemText =
+                isPointLocked ? ICON_LC_LOCK_OPEN "  Unlock in Editor" : ICON_LC_LOCK "  Lock in Editor";
+            if (ImGui::MenuItem(lockedMenuItemText)) {
+              state.currentTrajectoryToggleEditorLockedForSelectedItem();
+              m_history.addState(state);
             }
           }
 
-          const char* lockedMenuItemText =
-              isPointLocked ? ICON_LC_LOCK_OPEN "  Unlock in Editor" : ICON_LC_LOCK "  Lock in Editor";
-          if (ImGui::MenuItem(lockedMenuItemText)) {
-            state.currentTrajectoryToggleEditorLockedForSelectedItem();
-            m_history.addState(state);
-          }
-        }
+          if (isPointLocked) {
+            ImGui::SameLine();
 
-        if (isPointLocked) {
-          ImGui::SameLine();
+            const ImGuiStyle& style = ImGui::GetStyle();
+            const float lockedButtonWidthNeeded = ImGui::CalcTextSize(ICON_LC_LOCK).x + style.ItemSpacing.x;
+            const float lockedButtonCursorOffset = ImGui::GetContentRegionAvail().x - lockedButtonWidthNeeded;
+            if (lockedButtonCursorOffset > 0) {
+              ImGui::SetCursorPosX(ImGui::GetCursorPosX() + lockedButtonCursorOffset);
+            }
 
-          const ImGuiStyle& style = ImGui::GetStyle();
-          const float lockedButtonWidthNeeded = ImGui::CalcTextSize(ICON_LC_LOCK).x + style.ItemSpacing.x;
-          const float lockedButtonCursorOffset = ImGui::GetContentRegionAvail().x - lockedButtonWidthNeeded;
-          if (lockedButtonCursorOffset > 0) {
-            ImGui::SetCursorPosX(ImGui::GetCursorPosX() + lockedButtonCursorOffset);
-          }
+            auto scopedButtonColor = ImGui::Scoped::StyleColor(ImGuiCol_Button, 0);
+            auto scopedButtonHoveredColor = ImGui::Scoped::StyleColor(ImGuiCol_ButtonHovered, 0);
+            auto scopedButtonActiveColor = ImGui::Scoped::StyleColor(ImGuiCol_ButtonActive, 0);
 
-          auto scopedButtonColor = ImGui::Scoped::StyleColor(ImGuiCol_Button, 0);
-          auto scopedButtonHoveredColor = ImGui::Scoped::StyleColor(ImGuiCol_ButtonHovered, 0);
-          auto scopedButtonActiveColor = ImGui::Scoped::StyleColor(ImGuiCol_ButtonActive, 0);
+            if (ImGui::SmallButton(ICON_LC_LOCK)) {
+              if (!isPointSelected) {
+                editorState.trajectorySelection =
+                    ThunderAutoTrajectoryEditorState::TrajectorySelection::WAYPOINT;
+                editorState.selectionIndex = pointIndex;
+                m_history.addState(state, false);
+              }
 
-          if (ImGui::SmallButton(ICON_LC_LOCK)) {
-            if (!isPointSelected) {
-              editorState.trajectorySelection =
-                  ThunderAutoTrajectoryEditorState::TrajectorySelection::WAYPOINT;
-              editorState.selectionIndex = pointIndex;
-              m_history.addState(state, false);
+              state.currentTrajectoryToggleEditorLockedForSelectedItem();
+              m_history.addState(state);
+            }
+            if (ImGui::IsItemHovered(ImGuiHoveredFlags_DelayNormal)) {
+              ImGui::SetTooltip("Unlock in Editor");
             }
-
-            state.currentTrajectoryToggleEditorLockedForSelectedItem();
-            m_history.addState(state);
-          }
-          if (ImGui::IsItemHovered(ImGuiHoveredFlags_DelayNormal)) {
-            ImGui::SetTooltip("Unlock in Editor");
           }
         }
       }
@@ -191,128 +216,44 @@ void PropertiesPage::presentTrajectoryItemList(ThunderAutoProjectState& state) {
       auto scopedPadding =
           ImGui::Scoped::StyleVarY(ImGuiStyleVar_ItemSpacing, GET_UISIZE(SELECTABLE_LIST_ITEM_SPACING_Y));
 
-      std::map<ThunderAutoTrajectoryPosition, TrajectoryItemSelection<CanonicalAngle>> rotations =
-          GetAllRotationSelections(skeleton);
+      const std::vector<TrajectoryItemSelection<CanonicalAngle>>& rotations = itemLists.rotations;
 
-      size_t i = 0;
-      for (const auto& [position, selection] : rotations) {
-        auto scopedID = ImGui::Scoped::ID(i);
+      // Only the rows in view are drawn.
+      bool rotationsChanged = false;
+      ImGuiListClipper clipper;
+      clipper.Begin(static_cast<int>(rotations.size()));
+      while (!rotationsChanged && clipper.Step()) {
+        for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++) {
+          const TrajectoryItemSelection<CanonicalAngle>& selection = rotations[i];
 
-        const CanonicalAngle& angle = selection.item;
-        std::string selectableTitle =
-            fmt::format("{:.2f}:    {:.0f} deg", (double)position, angle.degrees().value());
+          auto scopedID = ImGui::Scoped::ID(i);
 
-        if (i == 0 && skeleton.hasStartBehaviorLink()) {
-          selectableTitle +=
-              fmt::format("  {}  {}", ICON_LC_ARROW_RIGHT_TO_LINE, skeleton.startBehaviorLinkName());
-        } else if (i == rotations.size() - 1 && skeleton.hasEndBehaviorLink()) {
-          selectableTitle +=
-              fmt::format("  {}  {}", ICON_LC_ARROW_RIGHT_TO_LINE, skeleton.endBehaviorLinkName());
-        }
+          const CanonicalAngle& angle = selection.item;
+          std::string selectableTitle =
+              fmt::format("{:.2f}:    {:.0f} deg", (double)selection.position, angle.degrees().value());
 
-        i++;
+          if (i == 0 && skeleton.hasStartBehaviorLink()) {
+            selectableTitle +=
+                fmt::format("  {}  {}", ICON_LC_ARROW_RIGHT_TO_LINE, skeleton.startBehaviorLinkName());
+          } else if (static_cast<size_t>(i) == rotations.size() - 1 && skeleton.hasEndBehaviorLink()) {
+            selectableTitle +=
+                fmt::format("  {}  {}", ICON_LC_ARROW_RIGHT_TO_LINE, skeleton.endBehaviorLinkName());
+          }
 
-        const bool isRotationSelected = (editorState.trajectorySelection == selection.trajectorySelection) &&
-                                        (editorState.selectionIndex == selection.selectionIndex);
+          const bool isRotationSelected =
+              (editorState.trajectorySelection == selection.trajectorySelection) &&
+              (editorState.selectionIndex == selection.selectionIndex);
 
-        if (ImGui::Selectable(selectableTitle.c_str(), isRotationSelected,
-                              ImGuiSelectableFlags_AllowOverlap)) {
-          editorState.trajectorySelection = selection.trajectorySelection;
-          editorState.selectionIndex = selection.selectionIndex;
-          m_history.addState(state, false);
-        }
-
-        // Right-click the rotation.
-        if (auto scopedContextMenu = ImGui::Scoped::PopupContextItem()) {
-          if (!isRotationSelected) {
+          if (ImGui::Selectable(selectableTitle.c_str(), isRotationSelected,
+                                ImGuiSelectableFlags_AllowOverlap)) {
             editorState.trajectorySelection = selection.trajectorySelection;
             editorState.selectionIndex = selection.selectionIndex;
             m_history.addState(state, false);
           }
 
-          const std::string deleteMenuItemText = fmt::format(
-              "{}  Delete {}", ICON_LC_TRASH, TrajectorySelectionToString(selection.trajectorySelection));
-
-          if (ImGui::MenuItem(deleteMenuItemText.c_str())) {
-            state.currentTrajectoryDeleteSelectedItem();
-            m_history.addState(state);
-            break;
-          }
-
-          const bool locked = selection.editorLocked;
-          const char* lockedMenuItemText =
-              locked ? ICON_LC_LOCK_OPEN "  Unlock in Editor" : ICON_LC_LOCK "  Lock in Editor";
-          if (ImGui::MenuItem(lockedMenuItemText)) {
-            state.currentTrajectoryToggleEditorLockedForSelectedItem();
-            m_history.addState(state);
-          }
-        }
-
-        if (selection.editorLocked) {
-          ImGui::SameLine();
-
-          const ImGuiStyle& style = ImGui::GetStyle();
-          const float lockedButtonWidthNeeded = ImGui::CalcTextSize(ICON_LC_LOCK).x + style.ItemSpacing.x;
-          const float lockedButtonCursorOffset = ImGui::GetContentRegionAvail().x - lockedButtonWidthNeeded;
-          if (lockedButtonCursorOffset > 0) {
-            ImGui::SetCursorPosX(ImGui::GetCursorPosX() + lockedButtonCursorOffset);
-          }
-
-          auto scopedButtonColor = ImGui::Scoped::StyleColor(ImGuiCol_Button, 0);
-          auto scopedButtonHoveredColor = ImGui::Scoped::StyleColor(ImGuiCol_ButtonHovered, 0);
-          auto scopedButtonActiveColor = ImGui::Scoped::StyleColor(ImGuiCol_ButtonActive, 0);
-
-          if (ImGui::SmallButton(ICON_LC_LOCK)) {
-            if (!isRotationSelected) {
-              editorState.trajectorySelection = selection.trajectorySelection;
-              editorState.selectionIndex = selection.selectionIndex;
-              m_history.addState(state, false);
-            }
-
-            state.currentTrajectoryToggleEditorLockedForSelectedItem();
-            m_history.addState(state);
-          }
-          if (ImGui::IsItemHovered(ImGuiHoveredFlags_DelayNormal)) {
-            ImGui::SetTooltip("Unlock in Editor");
-          }
-        }
-      }
-    }
-    if (auto scopedTabItem = ImGui::Scoped::TabItem("Actions", nullptr, ImGuiTabItemFlags_NoPushId)) {
-      auto scopedChildWindow = ImGui::Scoped::ChildWindow(
-          childWindowName,
-          ImVec2(0.f, GET_UISIZE(PROPERTIES_PAGE_TRAJECTORY_ITEM_LIST_CHILD_WINDOW_START_SIZE_Y)),
-          ImGuiChildFlags_ResizeY | ImGuiChildFlags_Borders);
-      auto scopedPadding =
-          ImGui::Scoped::StyleVarY(ImGuiStyleVar_ItemSpacing, GET_UISIZE(SELECTABLE_LIST_ITEM_SPACING_Y));
-
-      std::multimap<ThunderAutoTrajectoryPosition, TrajectoryItemSelection<std::string>> actions =
-          GetAllActionSelections(skeleton);
-
-      for (const auto& [position, selection] : actions) {
-        const std::string& action = selection.item;
-        std::string selectableTitle = fmt::format("{:.2f}:    {}", (double)position, action);
-
-        const bool isActionSelected = (editorState.trajectorySelection == selection.trajectorySelection) &&
-                                      (editorState.selectionIndex == selection.selectionIndex);
-
-        if (ImGui::Selectable(selectableTitle.c_str(), isActionSelected, ImGuiSelectableFlags_AllowOverlap)) {
-          editorState.trajectorySelection = selection.trajectorySelection;
-          editorState.selectionIndex = selection.selectionIndex;
-          m_history.addState(state, false);
-        }
-
-        const bool isFirstPoint = (selection.trajectorySelection ==
-                                   ThunderAutoTrajectoryEditorState::TrajectorySelection::WAYPOINT) &&
-                                  (selection.selectionIndex == 0);
-        const bool isLastPoint = (selection.trajectorySelection ==
-                                  ThunderAutoTrajectoryEditorState::TrajectorySelection::WAYPOINT) &&
-                                 (selection.selectionIndex == skeleton.numPoints() - 1);
-
-        if (!isFirstPoint && !isLastPoint) {
-          // Right-click the action.
+          // Right-click the rotation.
           if (auto scopedContextMenu = ImGui::Scoped::PopupContextItem()) {
-            if (!isActionSelected) {
+            if (!isRotationSelected) {
               editorState.trajectorySelection = selection.trajectorySelection;
               editorState.selectionIndex = selection.selectionIndex;
               m_history.addState(state, false);
@@ -324,6 +265,7 @@ void PropertiesPage::presentTrajectoryItemList(ThunderAutoProjectState& state) {
             if (ImGui::MenuItem(deleteMenuItemText.c_str())) {
               state.currentTrajectoryDeleteSelectedItem();
               m_history.addState(state);
+              rotationsChanged = true;
               break;
             }
 
@@ -351,7 +293,7 @@ void PropertiesPage::presentTrajectoryItemList(ThunderAutoProjectState& state) {
             auto scopedButtonActiveColor = ImGui::Scoped::StyleColor(ImGuiCol_ButtonActive, 0);
 
             if (ImGui::SmallButton(ICON_LC_LOCK)) {
-              if (!isActionSelected) {
+              if (!isRotationSelected) {
                 editorState.trajectorySelection = selection.trajectorySelection;
                 editorState.selectionIndex = selection.selectionIndex;
                 m_history.addState(state, false);
@@ -367,6 +309,106 @@ void PropertiesPage::presentTrajectoryItemList(ThunderAutoProjectState& state) {
         }
       }
     }
+    if (auto scopedTabItem = ImGui::Scoped::TabItem("Actions", nullptr, ImGuiTabItemFlags_NoPushId)) {
+      auto scopedChildWindow = ImGui::Scoped::ChildWindow(
+          childWindowName,
+          ImVec2(0.f, GET_UISIZE(PROPERTIES_PAGE_TRAJECTORY_ITEM_LIST_CHILD_WINDOW_START_SIZE_Y)),
+          ImGuiChildFlags_ResizeY | ImGuiChildFlags_Borders);
+      auto scopedPadding =
+          ImGui::Scoped::StyleVarY(ImGuiStyleVar_ItemSpacing, GET_UISIZE(SELECTABLE_LIST_ITEM_SPACING_Y));
+
+      const std::vector<TrajectoryItemSelection<TrajectoryActionItem>>& actions = itemLists.actions;
+
+      // Only the rows in view are drawn.
+      bool actionsChanged = false;
+      ImGuiListClipper clipper;
+      clipper.Begin(static_cast<int>(actions.size()));
+      while (!actionsChanged && clipper.Step()) {
+        for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++) {
+          const TrajectoryItemSelection<TrajectoryActionItem>& selection = actions[row];
+
+          const TrajectoryActionItem& action = selection.item;
+          std::string selectableTitle =
+              fmt::format("{:.2f}:    {}{}", (double)selection.position, action.prefix, action.action);
+
+          const bool isActionSelected = (editorState.trajectorySelection == selection.trajectorySelection) &&
+                                        (editorState.selectionIndex == selection.selectionIndex);
+
+          if (ImGui::Selectable(selectableTitle.c_str(), isActionSelected,
+                                ImGuiSelectableFlags_AllowOverlap)) {
+            editorState.trajectorySelection = selection.trajectorySelection;
+            editorState.selectionIndex = selection.selectionIndex;
+            m_history.addState(state, false);
+          }
+
+          const bool isFirstPoint = (selection.trajectorySelection ==
+                                     ThunderAutoTrajectoryEditorState::TrajectorySelection::WAYPOINT) &&
+                                    (selection.selectionIndex == 0);
+          const bool isLastPoint = (selection.trajectorySelection ==
+                                    ThunderAutoTrajectoryEditorState::TrajectorySelection::WAYPOINT) &&
+                                   (selection.selectionIndex == skeleton.numPoints() - 1);
+
+          if (!isFirstPoint && !isLastPoint) {
+            // Right-click the action.
+            if (auto scopedContextMenu = ImGui::Scoped::PopupContextItem()) {
+              if (!isActionSelected) {
+                editorState.trajectorySelection = selection.trajectorySelection;
+                editorState.selectionIndex = selection.selectionIndex;
+                m_history.addState(state, false);
+              }
+
+              const std::string deleteMenuItemText = fmt::format(
+                  "{}  Delete {}", ICON_LC_TRASH, TrajectorySelectionToString(selection.trajectorySelection));
+
+              if (ImGui::MenuItem(deleteMenuItemText.c_str())) {
+                state.currentTrajectoryDeleteSelectedItem();
+                m_history.addState(state);
+                actionsChanged = true;
+                break;
+              }
+
+              const bool locked = selection.editorLocked;
+              const char* lockedMenuItemText =
+                  locked ? ICON_LC_LOCK_OPEN "  Unlock in Editor" : ICON_LC_LOCK "  Lock in Editor";
+              if (ImGui::MenuItem(lockedMenuItemText)) {
+                state.currentTrajectoryToggleEditorLockedForSelectedItem();
+                m_history.addState(state);
+              }
+            }
+
+            if (selection.editorLocked) {
+              ImGui::SameLine();
+
+              const ImGuiStyle& style = ImGui::GetStyle();
+              const float lockedButtonWidthNeeded = ImGui::CalcTextSize(ICON_LC_LOCK).x + style.ItemSpacing.x;
+              const float lockedButtonCursorOffset =
+                  ImGui::GetContentRegionAvail().x - lockedButtonWidthNeeded;
+              if (lockedButtonCursorOffset > 0) {
+                ImGui::SetCursorPosX(ImGui::GetCursorPosX() + lockedButtonCursorOffset);
+              }
+
+              auto scopedButtonColor = ImGui::Scoped::StyleColor(ImGuiCol_Button, 0);
+              auto scopedButtonHoveredColor = ImGui::Scoped::StyleColor(ImGuiCol_ButtonHovered, 0);
+              auto scopedButtonActiveColor = ImGui::Scoped::StyleColor(ImGuiCol_ButtonActive, 0);
+
+              if (ImGui::SmallButton(ICON_LC_LOCK)) {
+                if (!isActionSelected) {
+                  editorState.trajectorySelection = selection.trajectorySelection;
+                  editorState.selectionIndex = selection.selectionIndex;
+                  m_history.addState(state, false);
+                }
+
+                state.currentTrajectoryToggleEditorLockedForSelectedItem();
+                m_history.addState(state);
+              }
+              if (ImGui::IsItemHovered(ImGuiHoveredFlags_DelayNormal)) {
+                ImGui::SetTooltip("Unlock in Editor");
+              }
+            }
+          }
+        }
+      }
+    }
   }
 
   ImGui::Spacing();
@@ -409,12 +451,13 @@ void PropertiesPage::presentTrajectorySelectedPointProperties(ThunderAutoProject
   ThunderAutoTrajectorySkeletonWaypoint& point = skeleton.getPoint(editorState.selectionIndex);
 
   bool changed = false;
+  StateChangeSet changes = CurrentTrajectoryChanges(state);
 
   // Position
   bool positionChanged = presentPointPositionProperties(point);
   if (positionChanged) {
     changed = true;
-    state.trajectoryUpdateAllLinkedWaypointPositionsFromSelectedWaypoint();
+    m_history.linkIndex().updateLinkedWaypointPositionsFromSelectedWaypoint(state, &changes);
   }
 
   ImGui::Separator();
@@ -445,7 +488,7 @@ void PropertiesPage::presentTrajectorySelectedPointProperties(ThunderAutoProject
   changed |= presentPointLinkProperty(point);
 
   if (changed) {
-    m_history.addState(state);
+    m_history.addState(state, changes);
   }
 }
 
@@ -839,12 +882,12 @@ void PropertiesPage::presentTrajectorySelectedRotationProperties(ThunderAutoProj
 
       skeleton.separateRotations(0.1_m, trajectoryPositionData.get());
 
-      m_history.modifyLastState(state);
+      m_history.modifyLastState(state, CurrentTrajectoryChanges(state, true));
     }
   }
 
   if (changed) {
-    m_history.addState(state);
+    m_history.addState(state, CurrentTrajectoryChanges(state, true));
   }
 }
 
@@ -895,7 +938,7 @@ void PropertiesPage::presentTrajectorySelectedActionProperties(ThunderAutoProjec
   }
 
   if (changed) {
-    m_history.addState(state);
+    m_history.addState(state, CurrentTrajectoryChanges(state, true));
   }
 }
 
@@ -907,14 +950,17 @@ void PropertiesPage::presentTrajectoryOtherProperties(ThunderAutoProjectState& s
   ThunderAutoTrajectorySkeleton& skeleton = state.currentTrajectory();
 
   bool changed = false;
+  StateChangeSet changes = CurrentTrajectoryChanges(state);
 
   if (presentTrajectoryStartRotationProperty(skeleton)) {
     changed = true;
-    state.trajectoryUpdateAllLinkedTrajectoryEndBehaviorsFromCurrentTrajectoryEndBehavior(true, false);
+    m_history.linkIndex().updateLinkedTrajectoryEndBehaviorsFromCurrentTrajectory(state, true, false,
+                                                                              &changes);
   }
   if (presentTrajectoryEndRotationProperty(skeleton)) {
     changed = true;
-    state.trajectoryUpdateAllLinkedTrajectoryEndBehaviorsFromCurrentTrajectoryEndBehavior(false, true);
+    m_history.linkIndex().updateLinkedTrajectoryEndBehaviorsFromCurrentTrajectory(state, false, true,
+                                                                              &changes);
   }
 
   ImGui::Separator();
@@ -928,7 +974,7 @@ void PropertiesPage::presentTrajectoryOtherProperties(ThunderAutoProjectState& s
   changed |= presentTrajectoryEndActionProperty(skeleton, state);
 
   if (changed) {
-    m_history.addState(state);
+    m_history.addState(state, changes);
   }
 }
 
@@ -1008,10 +1054,17 @@ void PropertiesPage::presentTrajectorySpeedConstraintProperties(ThunderAutoProje
   }
 
   if (changed) {
-    m_history.addState(state);
+    m_history.addState(state, CurrentTrajectoryChanges(state));
   }
 
   ImGui::Spacing();
+
+  if (ImGui::Button(ICON_LC_GAUGE "  Auto-Tune...", ImVec2(-FLT_MIN, 0.f))) {
+    m_event = Event::TRAJECTORY_SPEED_CONSTRAINT_TUNER;
+  }
+  ImGui::SetItemTooltip("Search for the fastest speed constraints within the robot's limits");
+
+  ImGui::Spacing();
 }
 
 void PropertiesPage::presentAutoModeProperties(ThunderAutoProjectState& state) {
@@ -1042,11 +1095,15 @@ void PropertiesPage::presentAutoModeStepList(ThunderAutoProjectState& state) {
     ThunderAutoModeStepTrajectoryBehaviorTreeNode behaviorTree =
         autoMode.getTrajectoryBehaviorTree(state.trajectories);
 
-    (void)drawAutoModeStepsTree(rootPath, autoMode.steps, behaviorTree, std::nullopt, true, true, state);
+    const AutoModeStepIndex& index =
+        m_history.autoModeStepIndex(state.editorState.autoModeEditorState.currentAutoModeName);
+
+    (void)drawAutoModeStepsTree(index, 0, index.entries().size(), rootPath, autoMode.steps, behaviorTree,
+                                std::nullopt, true, true, state);
   }
 
   // Dropping trajectories and actions into the child window adds them as steps to the end of the auto mode.
-  (void)autoModeStepDragDropTarget(rootPath, AutoModeStepDragDropInsertMethod::INTO, false, state);
+  (void)autoModeStepDragDropTarget(&rootPath, AutoModeStepDragDropInsertMethod::INTO, false, state);
 
   if (ImGui::Button("+ Add Step", ImVec2(ImGui::GetContentRegionAvail().x, 0.f))) {
     m_event = Event::AUTO_MODE_ADD_STEP;
@@ -1054,13 +1111,21 @@ void PropertiesPage::presentAutoModeStepList(ThunderAutoProjectState& state) {
 }
 
 bool PropertiesPage::drawAutoModeStepTreeNode(
-    const ThunderAutoModeStepPath& stepPath,
+    const AutoModeStepIndex& index,
+    size_t entryIndex,
     std::unique_ptr<ThunderAutoModeStep>& step,
     const ThunderAutoModeStepTrajectoryBehaviorTreeNode& stepBehaviorTree,
     std::optional<frc::Pose2d> previousStepEndPose,
     bool isFirstTrajectoryStep,
     bool isLastTrajectoryStep,
     ThunderAutoProjectState& state) {
+  const AutoModeStepIndex::Entry& entry = index.entries()[entryIndex];
+  const ThunderAutoModeStepPath& stepPath = entry.path;
+
+  // The steps changed earlier this frame, the step index will catch up next frame.
+  if (entry.type != step->type())
+    return true;
+
   // Space in between steps to allow for drag-and-drop.
   {
     auto scopedPadding = ImGui::Scoped::StyleVarY(ImGuiStyleVar_ItemSpacing, 0.f);
@@ -1070,7 +1135,7 @@ bool PropertiesPage::drawAutoModeStepTreeNode(
     (void)ImGui::InvisibleButton("Drag Separator", ImVec2(spacingX, spacingY));
 
     bool shouldStop =
-        autoModeStepDragDropTarget(stepPath, AutoModeStepDragDropInsertMethod::BEFORE, true, state);
+        autoModeStepDragDropTarget(&stepPath, AutoModeStepDragDropInsertMethod::BEFORE, true, state);
     if (shouldStop) {
       return true;
     }
@@ -1082,52 +1147,13 @@ bool PropertiesPage::drawAutoModeStepTreeNode(
 
   ImGuiTreeNodeFlags treeNodeFlags = ImGuiTreeNodeFlags_DrawLinesFull | ImGuiTreeNodeFlags_FramePadding |
                                      ImGuiTreeNodeFlags_SpanFullWidth | ImGuiTreeNodeFlags_DefaultOpen;
-  std::string treeNodeLabel;
-  bool warnNoItemSelected = false;
-
-  switch (step->type()) {
-    using enum ThunderAutoModeStepType;
-    case ACTION: {
-      const ThunderAutoModeActionStep& actionStep = reinterpret_cast<const ThunderAutoModeActionStep&>(*step);
-
-      bool noActionSelected = warnNoItemSelected = actionStep.actionName.empty();
-      treeNodeLabel =
-          fmt::format(ICON_LC_PAPERCLIP "  {}", noActionSelected ? "<none>" : actionStep.actionName);
-      treeNodeFlags |= ImGuiTreeNodeFlags_Leaf | ImGuiTreeNodeFlags_Bullet;
-      break;
-    }
-    case TRAJECTORY: {
-      const ThunderAutoModeTrajectoryStep& trajectoryStep =
-          reinterpret_cast<const ThunderAutoModeTrajectoryStep&>(*step);
-
-      bool noTrajectorySelected = warnNoItemSelected = trajectoryStep.trajectoryName.empty();
-      treeNodeLabel =
-          fmt::format(ICON_LC_ROUTE "  {}", noTrajectorySelected ? "<none>" : trajectoryStep.trajectoryName);
-      treeNodeFlags |= ImGuiTreeNodeFlags_Leaf | ImGuiTreeNodeFlags_Bullet;
-      break;
-    }
-    case BRANCH_BOOL: {
-      const ThunderAutoModeBoolBranchStep& branchStep =
-          reinterpret_cast<const ThunderAutoModeBoolBranchStep&>(*step);
-
-      bool noConditionSelected = warnNoItemSelected = branchStep.conditionName.empty();
-      treeNodeLabel =
-          fmt::format(ICON_LC_TOGGLE_RIGHT "  {}", noConditionSelected ? "<none>" : branchStep.conditionName);
-      break;
-    }
-    case BRANCH_SWITCH: {
-      const ThunderAutoModeSwitchBranchStep& branchStep =
-          reinterpret_cast<const ThunderAutoModeSwitchBranchStep&>(*step);
-
-      bool noConditionSelected = warnNoItemSelected = branchStep.conditionName.empty();
-      treeNodeLabel =
-          fmt::format(ICON_LC_LIST_ORDERED "  {}", noConditionSelected ? "<none>" : branchStep.conditionName);
-      break;
-    }
-    default:
-      ThunderAutoUnreachable("Invalid auto mode step type");
+  if (entry.type == ThunderAutoModeStepType::ACTION || entry.type == ThunderAutoModeStepType::TRAJECTORY) {
+    treeNodeFlags |= ImGuiTreeNodeFlags_Leaf | ImGuiTreeNodeFlags_Bullet;
   }
 
+  const std::string& treeNodeLabel = entry.label;
+  const bool warnNoItemSelected = entry.itemName.empty();
+
   ThunderAutoModeEditorState& editorState = state.editorState.autoModeEditorState;
   bool isStepSelected = (editorState.selectedStepPath == stepPath);
 
@@ -1190,7 +1216,7 @@ bool PropertiesPage::drawAutoModeStepTreeNode(
   // Right-click the step.
   if (auto popup = ImGui::Scoped::PopupContextItem()) {
     if (ImGui::MenuItem(ICON_LC_TRASH "  Delete")) {
-      ThunderAutoLogger::Info("Deleting auto mode step at \"{}\"", ThunderAutoModeStepPathToString(stepPath));
+      ThunderAutoLogger::Info("Deleting auto mode step at \"{}\"", entry.pathString);
       state.currentAutoModeDeleteStep(stepPath);
       m_history.addState(state);
       return true;
@@ -1208,12 +1234,15 @@ bool PropertiesPage::drawAutoModeStepTreeNode(
         auto scopedDisabled = ImGui::Scoped::Disabled(isNewCaseValueUsed);
         if (ImGui::Button("Add")) {
           ThunderAutoLogger::Info("Adding case {} to switch branch at \"{}\"", newCaseValue,
-                                  ThunderAutoModeStepPathToString(stepPath));
+                                  entry.pathString);
           branchStep.caseBranches[newCaseValue] = std::list<std::unique_ptr<ThunderAutoModeStep>>{};
           m_history.addState(state);
 
           newCaseValue = 0;
           ImGui::CloseCurrentPopup();
+
+          // The step index doesn't have the new case yet.
+          return true;
         }
         if (isNewCaseValueUsed &&
             ImGui::IsItemHovered(ImGuiHoveredFlags_DelayNormal | ImGuiHoveredFlags_AllowWhenDisabled)) {
@@ -1240,15 +1269,18 @@ bool PropertiesPage::drawAutoModeStepTreeNode(
     case BRANCH_BOOL: {
       ThunderAutoModeBoolBranchStep& branchStep = reinterpret_cast<ThunderAutoModeBoolBranchStep&>(*step);
 
+      const AutoModeStepIndex::Branch& trueBranch = index.branches()[entry.firstBranch];
+      const AutoModeStepIndex::Branch& falseBranch = index.branches()[entry.firstBranch + 1];
+
       if (scopedTreeNode) {
         // True Branch
         {
           auto scopedTrueBranchTreeNode =
               ImGui::Scoped::TreeNodeEx("TRUE", treeNodeFlags | ImGuiTreeNodeFlags_AllowOverlap);
 
-          const ThunderAutoModeStepDirectoryPath trueChildStepPath = stepPath.boolBranch(true);
+          const ThunderAutoModeStepDirectoryPath& trueChildStepPath = trueBranch.path;
 
-          if (autoModeStepDragDropTarget(trueChildStepPath, AutoModeStepDragDropInsertMethod::INTO, true,
+          if (autoModeStepDragDropTarget(&trueChildStepPath, AutoModeStepDragDropInsertMethod::INTO, true,
                                          state))
             return true;
 
@@ -1262,8 +1294,9 @@ bool PropertiesPage::drawAutoModeStepTreeNode(
           // Branch Steps
           if (scopedTrueBranchTreeNode) {
             bool shouldStop = drawAutoModeStepsTree(
-                trueChildStepPath, branchStep.trueBranch, stepBehaviorTree.childrenMap.at(true),
-                previousStepEndPose, isFirstTrajectoryStep, isLastTrajectoryStep, state);
+                index, trueBranch.begin, trueBranch.end, trueChildStepPath, branchStep.trueBranch,
+                stepBehaviorTree.childrenMap.at(true), previousStepEndPose, isFirstTrajectoryStep,
+                isLastTrajectoryStep, state);
             if (shouldStop) {
               return true;
             }
@@ -1275,9 +1308,9 @@ bool PropertiesPage::drawAutoModeStepTreeNode(
           auto scopedFalseBranchTreeNode =
               ImGui::Scoped::TreeNodeEx("FALSE", treeNodeFlags | ImGuiTreeNodeFlags_AllowOverlap);
 
-          const ThunderAutoModeStepDirectoryPath falseChildStepPath = stepPath.boolBranch(false);
+          const ThunderAutoModeStepDirectoryPath& falseChildStepPath = falseBranch.path;
 
-          if (autoModeStepDragDropTarget(falseChildStepPath, AutoModeStepDragDropInsertMethod::INTO, true,
+          if (autoModeStepDragDropTarget(&falseChildStepPath, AutoModeStepDragDropInsertMethod::INTO, true,
                                          state))
             return true;
 
@@ -1291,8 +1324,9 @@ bool PropertiesPage::drawAutoModeStepTreeNode(
           // Branch Steps
           if (scopedFalseBranchTreeNode) {
             bool shouldStop = drawAutoModeStepsTree(
-                falseChildStepPath, branchStep.elseBranch, stepBehaviorTree.childrenMap.at(false),
-                previousStepEndPose, isFirstTrajectoryStep, isLastTrajectoryStep, state);
+                index, falseBranch.begin, falseBranch.end, falseChildStepPath, branchStep.elseBranch,
+                stepBehaviorTree.childrenMap.at(false), previousStepEndPose, isFirstTrajectoryStep,
+                isLastTrajectoryStep, state);
             if (shouldStop) {
               return true;
             }
@@ -1304,18 +1338,23 @@ bool PropertiesPage::drawAutoModeStepTreeNode(
     case BRANCH_SWITCH: {
       ThunderAutoModeSwitchBranchStep& branchStep = reinterpret_cast<ThunderAutoModeSwitchBranchStep&>(*step);
 
+      // The cases, then the default branch.
+      if (branchStep.caseBranches.size() + 1 != entry.branchesEnd - entry.firstBranch)
+        return true;  // A case was just added or removed, the step index will catch up next frame.
+
       if (scopedTreeNode) {
+        size_t branchIndex = entry.firstBranch;
         for (auto& [caseValue, caseBranch] : branchStep.caseBranches) {
+          const AutoModeStepIndex::Branch& caseIndexBranch = index.branches()[branchIndex++];
+
           // Case Branch
           {
-            std::string label = fmt::format("CASE {}", caseValue);
+            auto scopedCaseBranchTreeNode = ImGui::Scoped::TreeNodeEx(
+                caseIndexBranch.label.c_str(), treeNodeFlags | ImGuiTreeNodeFlags_AllowOverlap);
 
-            auto scopedCaseBranchTreeNode =
-                ImGui::Scoped::TreeNodeEx(label.c_str(), treeNodeFlags | ImGuiTreeNodeFlags_AllowOverlap);
+            const ThunderAutoModeStepDirectoryPath& caseChildStepPath = caseIndexBranch.path;
 
-            const ThunderAutoModeStepDirectoryPath caseChildStepPath = stepPath.switchBranchCase(caseValue);
-
-            if (autoModeStepDragDropTarget(caseChildStepPath, AutoModeStepDragDropInsertMethod::INTO, true,
+            if (autoModeStepDragDropTarget(&caseChildStepPath, AutoModeStepDragDropInsertMethod::INTO, true,
                                            state))
               return true;
 
@@ -1323,7 +1362,7 @@ bool PropertiesPage::drawAutoModeStepTreeNode(
             if (auto popup = ImGui::Scoped::PopupContextItem()) {
               if (ImGui::MenuItem(ICON_LC_TRASH "  Delete Case")) {
                 ThunderAutoLogger::Info("Deleting case {} from switch branch at \"{}\"", caseValue,
-                                        ThunderAutoModeStepPathToString(stepPath));
+                                        entry.pathString);
                 branchStep.caseBranches.erase(caseValue);
                 if (!branchStep.editorDisplayDefaultBranch &&
                     branchStep.editorDisplayCaseBranch == caseValue) {
@@ -1349,8 +1388,9 @@ bool PropertiesPage::drawAutoModeStepTreeNode(
             // Branch Steps
             if (scopedCaseBranchTreeNode) {
               bool shouldStop = drawAutoModeStepsTree(
-                  caseChildStepPath, caseBranch, stepBehaviorTree.childrenMap.at(caseValue),
-                  previousStepEndPose, isFirstTrajectoryStep, isLastTrajectoryStep, state);
+                  index, caseIndexBranch.begin, caseIndexBranch.end, caseChildStepPath, caseBranch,
+                  stepBehaviorTree.childrenMap.at(caseValue), previousStepEndPose, isFirstTrajectoryStep,
+                  isLastTrajectoryStep, state);
               if (shouldStop) {
                 return true;
               }
@@ -1363,9 +1403,10 @@ bool PropertiesPage::drawAutoModeStepTreeNode(
           auto scopedDefaultBranchTreeNode =
               ImGui::Scoped::TreeNodeEx("DEFAULT", treeNodeFlags | ImGuiTreeNodeFlags_AllowOverlap);
 
-          const ThunderAutoModeStepDirectoryPath defaultChildStepPath = stepPath.switchBranchDefault();
+          const AutoModeStepIndex::Branch& defaultBranch = index.branches()[entry.branchesEnd - 1];
+          const ThunderAutoModeStepDirectoryPath& defaultChildStepPath = defaultBranch.path;
 
-          if (autoModeStepDragDropTarget(defaultChildStepPath, AutoModeStepDragDropInsertMethod::INTO, true,
+          if (autoModeStepDragDropTarget(&defaultChildStepPath, AutoModeStepDragDropInsertMethod::INTO, true,
                                          state)) {
             return true;
           }
@@ -1384,9 +1425,10 @@ bool PropertiesPage::drawAutoModeStepTreeNode(
 
           // Branch Steps
           if (scopedDefaultBranchTreeNode) {
-            bool shouldStop = drawAutoModeStepsTree(defaultChildStepPath, branchStep.defaultBranch,
-                                                    stepBehaviorTree.childrenVec.at(0), previousStepEndPose,
-                                                    isFirstTrajectoryStep, isLastTrajectoryStep, state);
+            bool shouldStop = drawAutoModeStepsTree(
+                index, defaultBranch.begin, defaultBranch.end, defaultChildStepPath, branchStep.defaultBranch,
+                stepBehaviorTree.childrenVec.at(0), previousStepEndPose, isFirstTrajectoryStep,
+                isLastTrajectoryStep, state);
             if (shouldStop) {
               return true;
             }
@@ -1402,7 +1444,10 @@ bool PropertiesPage::drawAutoModeStepTreeNode(
   return false;
 }
 
-bool PropertiesPage::drawAutoModeStepsTree(const ThunderAutoModeStepDirectoryPath& parentPath,
+bool PropertiesPage::drawAutoModeStepsTree(const AutoModeStepIndex& index,
+                                           size_t begin,
+                                           size_t end,
+                                           const ThunderAutoModeStepDirectoryPath& parentPath,
                                            std::list<std::unique_ptr<ThunderAutoModeStep>>& steps,
                                            const ThunderAutoModeStepTrajectoryBehaviorTreeNode& behaviorTree,
                                            std::optional<frc::Pose2d> originalPreviousStepEndPose,
@@ -1413,11 +1458,15 @@ bool PropertiesPage::drawAutoModeStepsTree(const ThunderAutoModeStepDirectoryPat
 
   const ThunderAutoModeStepTrajectoryBehavior& behavior = behaviorTree.behavior;
 
+  std::span<const AutoModeStepIndex::Entry> entries = index.entries();
+
   std::optional<frc::Pose2d> previousStepEndPose = originalPreviousStepEndPose;
-  ThunderAutoModeStepPath stepPath(parentPath, 0);
+  size_t entryIndex = begin, lastEntryIndex = begin;
   size_t stepIndex = 0;
   for (auto& step : steps) {
-    stepPath.setStepIndex(stepIndex);
+    // The steps changed earlier this frame, the step index will catch up next frame.
+    if (entryIndex >= end)
+      return true;
 
     auto scopedID = ImGui::Scoped::ID(step->getID());
 
@@ -1430,13 +1479,15 @@ bool PropertiesPage::drawAutoModeStepsTree(const ThunderAutoModeStepDirectoryPat
     const ThunderAutoModeStepTrajectoryBehaviorTreeNode& stepBehaviorTree =
         behaviorTree.childrenVec.at(stepIndex);
 
-    bool shouldStop =
-        drawAutoModeStepTreeNode(stepPath, step, stepBehaviorTree, previousStepEndPose, first, last, state);
+    bool shouldStop = drawAutoModeStepTreeNode(index, entryIndex, step, stepBehaviorTree, previousStepEndPose,
+                                               first, last, state);
     if (shouldStop) {
       return true;
     }
 
     previousStepEndPose = stepBehaviorTree.behavior.endPose;
+    lastEntryIndex = entryIndex;
+    entryIndex = entries[entryIndex].subtreeEnd;
     stepIndex++;
   }
 
@@ -1452,9 +1503,11 @@ bool PropertiesPage::drawAutoModeStepsTree(const ThunderAutoModeStepDirectoryPat
     bool shouldStop;
     if (steps.empty()) {
       shouldStop =
-          autoModeStepDragDropTarget(parentPath, AutoModeStepDragDropInsertMethod::INTO, true, state);
+          autoModeStepDragDropTarget(&parentPath, AutoModeStepDragDropInsertMethod::INTO, true, state);
     } else {
-      shouldStop = autoModeStepDragDropTarget(stepPath, AutoModeStepDragDropInsertMethod::AFTER, true, state);
+      const ThunderAutoModeStepPath& lastStepPath = entries[lastEntryIndex].path;
+      shouldStop =
+          autoModeStepDragDropTarget(&lastStepPath, AutoModeStepDragDropInsertMethod::AFTER, true, state);
     }
 
     if (shouldStop) {
@@ -1466,7 +1519,8 @@ bool PropertiesPage::drawAutoModeStepsTree(const ThunderAutoModeStepDirectoryPat
 }
 
 bool PropertiesPage::autoModeStepDragDropTarget(
-    std::variant<ThunderAutoModeStepPath, ThunderAutoModeStepDirectoryPath> closestStepOrDirectoryPath,
+    std::variant<const ThunderAutoModeStepPath*, const ThunderAutoModeStepDirectoryPath*>
+        closestStepOrDirectoryPath,
     AutoModeStepDragDropInsertMethod insertMethod,
     bool acceptAutoModeSteps,
     ThunderAutoProjectState& state) {
@@ -1483,14 +1537,16 @@ bool PropertiesPage::autoModeStepDragDropTarget(
       bool moveWasSuccessful = false;
 
       if (insertMethod == INTO) {
-        auto directoryPath = std::get<ThunderAutoModeStepDirectoryPath>(closestStepOrDirectoryPath);
+        const ThunderAutoModeStepDirectoryPath& directoryPath =
+            *std::get<const ThunderAutoModeStepDirectoryPath*>(closestStepOrDirectoryPath);
         ThunderAutoLogger::Info("Drag and drop auto mode step from \"{}\" into \"{}\"",
                                 ThunderAutoModeStepPathToString(payloadPath),
                                 ThunderAutoModeStepDirectoryPathToString(directoryPath));
 
         moveWasSuccessful = state.currentAutoModeMoveStepIntoDirectory(payloadPath, directoryPath);
       } else {
-        auto stepPath = std::get<ThunderAutoModeStepPath>(closestStepOrDirectoryPath);
+        const ThunderAutoModeStepPath& stepPath =
+            *std::get<const ThunderAutoModeStepPath*>(closestStepOrDirectoryPath);
         ThunderAutoLogger::Info("Drag and drop auto mode step from \"{}\" to {} \"{}\"",
                                 ThunderAutoModeStepPathToString(payloadPath),
                                 (insertMethod == BEFORE ? "before" : "after"),
@@ -1528,10 +1584,12 @@ bool PropertiesPage::autoModeStepDragDropTarget(
       // Add the new step.
       if (newStep) {
         if (insertMethod == INTO) {
-          auto directoryPath = std::get<ThunderAutoModeStepDirectoryPath>(closestStepOrDirectoryPath);
+          const ThunderAutoModeStepDirectoryPath& directoryPath =
+              *std::get<const ThunderAutoModeStepDirectoryPath*>(closestStepOrDirectoryPath);
           state.currentAutoModeInsertStepInDirectory(directoryPath, std::move(newStep));
         } else {
-          auto stepPath = std::get<ThunderAutoModeStepPath>(closestStepOrDirectoryPath);
+          const ThunderAutoModeStepPath& stepPath =
+              *std::get<const ThunderAutoModeStepPath*>(closestStepOrDirectoryPath);
           if (insertMethod == BEFORE) {
             state.currentAutoModeInsertStepBeforeOther(stepPath, std::move(newStep));
           } else if (insertMethod == AFTER) {
@@ -1712,33 +1770,78 @@ void PropertiesPage::presentAutoModeSpeedConstraintProperties(ThunderAutoProject
   // TODO: Implement
 }
 
-std::map<ThunderAutoTrajectoryPosition, PropertiesPage::TrajectoryItemSelection<CanonicalAngle>>
-PropertiesPage::GetAllRotationSelections(const ThunderAutoTrajectorySkeleton& skeleton) {
-  std::map<ThunderAutoTrajectoryPosition, PropertiesPage::TrajectoryItemSelection<CanonicalAngle>>
-      rotationSelections;
+const PropertiesPage::TrajectoryItemLists& PropertiesPage::trajectoryItemLists(
+    const std::string& trajectoryName,
+    const ThunderAutoTrajectorySkeleton& skeleton) {
+  pruneTrajectoryItemLists();
+
+  const uint64_t trajectoryVersion = m_history.trajectoryVersion(trajectoryName);
+
+  auto [itemListsIt, inserted] = m_trajectoryItemLists.try_emplace(trajectoryName);
+  TrajectoryItemLists& itemLists = itemListsIt->second;
+
+  if (inserted || itemLists.trajectoryVersion != trajectoryVersion) {
+    itemLists.trajectoryVersion = trajectoryVersion;
+
+    GetAllRotationSelections(skeleton, itemLists.rotations);
+    GetAllActionSelections(skeleton, m_internedActionNames, itemLists.actions);
+  }
+
+  return itemLists;
+}
+
+void PropertiesPage::pruneTrajectoryItemLists() {
+  const NameSearchIndex& trajectoryNameIndex = m_history.trajectoryNameIndex();
+  const NameSearchIndex& actionNameIndex = m_history.actionNameIndex();
+
+  if (trajectoryNameIndex.version() == m_itemListsTrajectoryNameIndexVersion &&
+      actionNameIndex.version() == m_itemListsActionNameIndexVersion)
+    return;
+
+  m_itemListsTrajectoryNameIndexVersion = trajectoryNameIndex.version();
+  m_itemListsActionNameIndexVersion = actionNameIndex.version();
+
+  std::erase_if(m_trajectoryItemLists,
+                [&](const auto& itemLists) { return !trajectoryNameIndex.contains(itemLists.first); });
 
-  PropertiesPage::TrajectoryItemSelection<CanonicalAngle> startRotationSelection{
+  // Item lists that haven't been rebuilt since an action was renamed still point at the old name, so a name
+  // is only dropped once nothing points at it.
+  std::unordered_set<std::string_view> usedActionNames;
+  for (const auto& [trajectoryName, itemLists] : m_trajectoryItemLists) {
+    for (const TrajectoryItemSelection<TrajectoryActionItem>& action : itemLists.actions) {
+      usedActionNames.insert(action.item.action);
+    }
+  }
+
+  std::erase_if(m_internedActionNames,
+                [&](const std::string& actionName) { return !usedActionNames.contains(actionName); });
+}
+
+void PropertiesPage::GetAllRotationSelections(
+    const ThunderAutoTrajectorySkeleton& skeleton,
+    std::vector<TrajectoryItemSelection<CanonicalAngle>>& rotations) {
+  rotations.clear();
+
+  rotations.push_back({
+      .position = ThunderAutoTrajectoryPosition(0.0),
       .item = skeleton.startRotation(),
       .editorLocked = skeleton.front().isEditorLocked(),
       .trajectorySelection = ThunderAutoTrajectoryEditorState::TrajectorySelection::WAYPOINT,
       .selectionIndex = 0,
-  };
-
-  rotationSelections.emplace(ThunderAutoTrajectoryPosition(0.0), startRotationSelection);
+  });
 
   const ThunderAutoPositionedTrajectoryItemList<ThunderAutoTrajectoryRotation>& rotationTargets =
       skeleton.rotations();
 
   size_t rotationIndex = 0;
   for (const auto& [position, rotation] : rotationTargets) {
-    PropertiesPage::TrajectoryItemSelection<CanonicalAngle> rotationSelection{
+    rotations.push_back({
+        .position = position,
         .item = rotation.angle,
         .editorLocked = rotation.editorLocked,
         .trajectorySelection = ThunderAutoTrajectoryEditorState::TrajectorySelection::ROTATION,
         .selectionIndex = rotationIndex,
-    };
-
-    rotationSelections.emplace(position, rotationSelection);
+    });
 
     rotationIndex++;
   }
@@ -1748,46 +1851,51 @@ PropertiesPage::GetAllRotationSelections(const ThunderAutoTrajectorySkeleton& sk
     for (auto waypointIt = std::next(skeleton.begin()); waypointIt != std::prev(skeleton.end());
          ++waypointIt, ++waypointIndex) {
       if (waypointIt->isStopped()) {
-        PropertiesPage::TrajectoryItemSelection<CanonicalAngle> rotationSelection{
+        rotations.push_back({
+            .position = ThunderAutoTrajectoryPosition(static_cast<double>(waypointIndex)),
             .item = waypointIt->stopRotation(),
             .editorLocked = waypointIt->isEditorLocked(),
             .trajectorySelection = ThunderAutoTrajectoryEditorState::TrajectorySelection::WAYPOINT,
             .selectionIndex = waypointIndex,
-        };
-
-        rotationSelections.emplace(ThunderAutoTrajectoryPosition(static_cast<double>(waypointIndex)),
-                                   rotationSelection);
+        });
       }
     }
   }
 
-  PropertiesPage::TrajectoryItemSelection<CanonicalAngle> endRotationSelection{
+  rotations.push_back({
+      .position = ThunderAutoTrajectoryPosition(static_cast<double>(skeleton.numPoints() - 1)),
       .item = skeleton.startRotation(),
       .editorLocked = skeleton.back().isEditorLocked(),
       .trajectorySelection = ThunderAutoTrajectoryEditorState::TrajectorySelection::WAYPOINT,
       .selectionIndex = skeleton.numPoints() - 1,
-  };
-
-  rotationSelections.emplace(ThunderAutoTrajectoryPosition(static_cast<double>(skeleton.numPoints() - 1)),
-                             endRotationSelection);
-
-  return rotationSelections;
+  });
+
+  // Sort by position, keeping the first rotation added at each position.
+  std::stable_sort(rotations.begin(), rotations.end(),
+                   [](const auto& a, const auto& b) { return a.position < b.position; });
+  rotations.erase(std::unique(rotations.begin(), rotations.end(),
+                              [](const auto& a, const auto& b) { return !(a.position < b.position); }),
+                  rotations.end());
 }
 
-std::multimap<ThunderAutoTrajectoryPosition, PropertiesPage::TrajectoryItemSelection<std::string>>
-PropertiesPage::GetAllActionSelections(const ThunderAutoTrajectorySkeleton& skeleton) {
-  std::multimap<ThunderAutoTrajectoryPosition, PropertiesPage::TrajectoryItemSelection<std::string>>
-      actionSelections;
+void PropertiesPage::GetAllActionSelections(
+    const ThunderAutoTrajectorySkeleton& skeleton,
+    std::unordered_set<std::string>& internedActionNames,
+    std::vector<TrajectoryItemSelection<TrajectoryActionItem>>& actions) {
+  actions.clear();
+
+  auto intern = [&](const std::string& actionName) -> std::string_view {
+    return *internedActionNames.insert(actionName).first;
+  };
 
   if (skeleton.hasStartAction()) {
-    PropertiesPage::TrajectoryItemSelection<std::string> startActionSelection{
-        .item = "<start> " + skeleton.startAction(),
+    actions.push_back({
+        .position = ThunderAutoTrajectoryPosition(0.0),
+        .item = {"<start> ", intern(skeleton.startAction())},
         .editorLocked = skeleton.front().isEditorLocked(),
         .trajectorySelection = ThunderAutoTrajectoryEditorState::TrajectorySelection::WAYPOINT,
         .selectionIndex = 0,
-    };
-
-    actionSelections.emplace(ThunderAutoTrajectoryPosition(0.0), startActionSelection);
+    });
   }
 
   const ThunderAutoPositionedTrajectoryItemList<ThunderAutoTrajectoryAction>& actionTargets =
@@ -1795,14 +1903,13 @@ PropertiesPage::GetAllActionSelections(const ThunderAutoTrajectorySkeleton& skel
 
   size_t actionIndex = 0;
   for (const auto& [position, action] : actionTargets) {
-    PropertiesPage::TrajectoryItemSelection<std::string> actionSelection{
-        .item = action.action,
+    actions.push_back({
+        .position = position,
+        .item = {"", intern(action.action)},
         .editorLocked = action.editorLocked,
         .trajectorySelection = ThunderAutoTrajectoryEditorState::TrajectorySelection::ACTION,
         .selectionIndex = actionIndex,
-    };
-
-    actionSelections.emplace(position, actionSelection);
+    });
 
     actionIndex++;
   }
@@ -1812,32 +1919,30 @@ PropertiesPage::GetAllActionSelections(const ThunderAutoTrajectorySkeleton& skel
     for (auto waypointIt = std::next(skeleton.begin()); waypointIt != std::prev(skeleton.end());
          ++waypointIt, ++waypointIndex) {
       if (waypointIt->isStopped() && waypointIt->hasStopAction()) {
-        PropertiesPage::TrajectoryItemSelection<std::string> acitionSelection{
-            .item = "<stop> " + waypointIt->stopAction(),
+        actions.push_back({
+            .position = ThunderAutoTrajectoryPosition(static_cast<double>(waypointIndex)),
+            .item = {"<stop> ", intern(waypointIt->stopAction())},
             .editorLocked = waypointIt->isEditorLocked(),
             .trajectorySelection = ThunderAutoTrajectoryEditorState::TrajectorySelection::WAYPOINT,
             .selectionIndex = waypointIndex,
-        };
-
-        actionSelections.emplace(ThunderAutoTrajectoryPosition(static_cast<double>(waypointIndex)),
-                                 acitionSelection);
+        });
       }
     }
   }
 
   if (skeleton.hasEndAction()) {
-    PropertiesPage::TrajectoryItemSelection<std::string> endActionSelection{
-        .item = "<end> " + skeleton.endAction(),
+    actions.push_back({
+        .position = ThunderAutoTrajectoryPosition(static_cast<double>(skeleton.numPoints() - 1)),
+        .item = {"<end> ", intern(skeleton.endAction())},
         .editorLocked = skeleton.back().isEditorLocked(),
         .trajectorySelection = ThunderAutoTrajectoryEditorState::TrajectorySelection::WAYPOINT,
         .selectionIndex = skeleton.numPoints() - 1,
-    };
-
-    actionSelections.emplace(ThunderAutoTrajectoryPosition(static_cast<double>(skeleton.numPoints() - 1)),
-                             endActionSelection);
+    });
   }
 
-  return actionSelections;
+  // Actions at the same position stay in the order they were added.
+  std::stable_sort(actions.begin(), actions.end(),
+                   [](const auto& a, const auto& b) { return a.position < b.position; });
 }
 
 bool PropertiesPage::presentRightAlignedEyeButton(int id, bool isEyeOpen) {
@@ -8,8 +8,10 @@
 #include <imgui_raii.h>
 #include <ctime>
 
-RemoteUpdatePage::RemoteUpdatePage(const DocumentManager& documentManager, const DocumentEditManager& history)
-    : m_documentManager(documentManager), m_history(history) {
+RemoteUpdatePage::RemoteUpdatePage(const DocumentManager& documentManager,
+                                   const DocumentEditManager& history,
+                                   EditorPage& editorPage)
+    : m_documentManager(documentManager), m_history(history), m_editorPage(editorPage) {
   m_networkTableInstance = nt::NetworkTableInstance::GetDefault();
   m_thunderAutoNetworkTable = m_networkTableInstance.GetTable("ThunderAuto");
 }
@@ -37,6 +39,10 @@ void RemoteUpdatePage::present(bool* running) {
   if (auto scopedTabItem = ImGui::Scoped::TabItem("Update")) {
     presentUpdateTab();
   }
+
+  if (auto scopedTabItem = ImGui::Scoped::TabItem("Live Pose")) {
+    presentLivePoseTab();
+  }
 }
 
 void RemoteUpdatePage::presentConnectionTab() {
@@ -69,30 +75,10 @@ void RemoteUpdatePage::presentConnectionTab() {
 }
 
 void RemoteUpdatePage::presentUpdateTab() {
-  if (m_wasOnConnectionTab) {
-    m_wasOnConnectionTab = false;
-
-    if (!m_startedClient) {
-      m_startedClient = true;
-      m_networkTableInstance.StartClient4("ThunderAuto");
-    }
-
-    if (m_useCustomServerIP) {
-      m_networkTableInstance.SetServer(m_customServerIP);
-    } else {
-      m_networkTableInstance.SetServerTeam(m_teamNumber);
-      if (m_driverStationRunning) {
-        m_networkTableInstance.StartDSClient();
-      }
-    }
-  }
+  connectIfNeeded();
+  presentConnectionStatus();
 
   bool isConnected = m_networkTableInstance.IsConnected();
-  if (isConnected) {
-    ImGui::TextColored(ImVec4(0.0f, 1.0f, 0.0f, 1.0f), "Connected");
-  } else {
-    ImGui::TextColored(ImVec4(1.0f, 0.0f, 0.0f, 1.0f), "Not connected");
-  }
 
   ImGui::Separator();
 
@@ -119,6 +105,76 @@ void RemoteUpdatePage::presentUpdateTab() {
   }
 }
 
+void RemoteUpdatePage::presentLivePoseTab() {
+  connectIfNeeded();
+  presentConnectionStatus();
+
+  ImGui::Separator();
+
+  LivePoseSubscriber& livePose = m_editorPage.livePose();
+
+  {
+    auto scopedField = ImGui::ScopedField::Builder("Pose Topic")
+                           .tooltip("A struct:Pose2d topic, or a double[] topic of [x, y, degrees] such as a "
+                                    "Field2d's robot pose")
+                           .build();
+
+    auto scopedDisabled = ImGui::Scoped::Disabled(livePose.isSubscribed());
+    ImGui::InputText("##Pose Topic", &m_livePoseTopic[0], sizeof(m_livePoseTopic));
+  }
+
+  ImVec2 buttonSize = ImVec2(ImGui::GetContentRegionAvail().x, 0.f);
+  if (livePose.isSubscribed()) {
+    if (ImGui::Button(ICON_LC_EYE_OFF "  Stop Showing Live Pose", buttonSize)) {
+      ThunderAutoLogger::Info("Stop showing live robot pose");
+      livePose.unsubscribe();
+    }
+
+    if (livePose.isStale()) {
+      ImGui::TextDisabled("Waiting for poses...");
+    } else if (std::optional<LivePoseSubscriber::Sample> latest = livePose.latest()) {
+      ImGui::Text("(%.2f m, %.2f m), %.1f deg", latest->x, latest->y,
+                  units::degree_t(units::radian_t(latest->rotation)).value());
+    }
+
+  } else {
+    auto scopedDisabled = ImGui::Scoped::Disabled(m_livePoseTopic[0] == '\0');
+
+    if (ImGui::Button(ICON_LC_EYE "  Show Live Pose", buttonSize)) {
+      livePose.subscribe(m_networkTableInstance, m_livePoseTopic);
+    }
+  }
+}
+
+void RemoteUpdatePage::connectIfNeeded() {
+  if (!m_wasOnConnectionTab)
+    return;
+
+  m_wasOnConnectionTab = false;
+
+  if (!m_startedClient) {
+    m_startedClient = true;
+    m_networkTableInstance.StartClient4("ThunderAuto");
+  }
+
+  if (m_useCustomServerIP) {
+    m_networkTableInstance.SetServer(m_customServerIP);
+  } else {
+    m_networkTableInstance.SetServerTeam(m_teamNumber);
+    if (m_driverStationRunning) {
+      m_networkTableInstance.StartDSClient();
+    }
+  }
+}
+
+void RemoteUpdatePage::presentConnectionStatus() {
+  if (m_networkTableInstance.IsConnected()) {
+    ImGui::TextColored(ImVec4(0.0f, 1.0f, 0.0f, 1.0f), "Connected");
+  } else {
+    ImGui::TextColored(ImVec4(1.0f, 0.0f, 0.0f, 1.0f), "Not connected");
+  }
+}
+
 void RemoteUpdatePage::sendUpdate() {
   m_wasUpdateSent = true;
 
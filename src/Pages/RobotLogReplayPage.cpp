@@ -0,0 +1,119 @@
+#include <ThunderAuto/Pages/RobotLogReplayPage.hpp>
+
+#include <ThunderAuto/Logger.hpp>
+#include <ThunderAuto/Platform/Platform.hpp>
+#include <IconsLucide.h>
+#include <imgui_raii.h>
+#include <fmt/format.h>
+
+static const FileExtensionList kRobotLogFileFilters = {
+    {"WPILib Data Logs (*.wpilog)", "wpilog"},
+    {"CSV Pose Logs (*.csv)", "csv"},
+};
+
+void RobotLogReplayPage::present(bool* running) {
+  ImGui::SetNextWindowSize(ImVec2(GET_UISIZE(ROBOT_LOG_REPLAY_PAGE_START_WIDTH),
+                                  GET_UISIZE(ROBOT_LOG_REPLAY_PAGE_START_HEIGHT)),
+                           ImGuiCond_FirstUseEver);
+  ImGui::Scoped scopedWindow = ImGui::Scoped::Window(name(), running);
+  if (!scopedWindow || (running && !*running))
+    return;
+
+  RobotLogReplay& replay = m_editorPage.robotLogReplay();
+
+  if (ImGui::Button(ICON_LC_FOLDER_OPEN "  Open Log...")) {
+    openLog();
+  }
+
+  if (replay.isOpen()) {
+    ImGui::SameLine();
+    if (ImGui::Button(ICON_LC_X "  Close")) {
+      ThunderAutoLogger::Info("Close robot log '{}'", replay.path().string());
+      replay.close();
+    }
+  }
+
+  if (!m_openError.empty()) {
+    ImGui::TextWrapped(ICON_LC_TRIANGLE_ALERT "  %s", m_openError.c_str());
+  }
+
+  if (!replay.isOpen()) {
+    ImGui::TextDisabled("Open a .wpilog or CSV log to compare the robot's actual path to the plan");
+    return;
+  }
+
+  ImGui::Spacing();
+  ImGui::TextUnformatted(replay.path().filename().string().c_str());
+
+  const std::vector<RobotLog::Entry>& entries = replay.entries();
+  if (entries.empty()) {
+    ImGui::TextDisabled("No pose entries found in the log");
+    return;
+  }
+
+  // Entry.
+
+  auto entryLabel = [](const RobotLog::Entry& entry) {
+    return fmt::format("{} ({})", entry.name, entry.type);
+  };
+
+  const std::string currentEntryLabel = entryLabel(entries.at(replay.entryIndex()));
+
+  ImGui::SetNextItemWidth(-FLT_MIN);
+  if (auto scopedCombo = ImGui::Scoped::Combo("##Entry", currentEntryLabel.c_str())) {
+    for (size_t i = 0; i < entries.size(); i++) {
+      auto scopedID = ImGui::Scoped::ID(static_cast<int>(i));
+
+      const bool isSelected = i == replay.entryIndex();
+      if (ImGui::Selectable(entryLabel(entries[i]).c_str(), isSelected) && !isSelected) {
+        replay.selectEntry(i);
+      }
+    }
+  }
+
+  ImGui::Checkbox("Show on field", &replay.visible);
+
+  // Start time, relative to the start of the log.
+
+  const units::second_t logStartTime = replay.logStartTime();
+  const units::second_t logDuration = replay.logEndTime() - logStartTime;
+
+  float startTime = static_cast<float>((replay.startTime() - logStartTime).value());
+  if (ImGui::DragFloat("Start Time", &startTime, 0.01f, 0.f, static_cast<float>(logDuration.value()),
+                       "%.2f s")) {
+    replay.setStartTime(logStartTime + units::second_t(startTime));
+  }
+  ImGui::SetItemTooltip("The time in the log that lines up with the start of playback");
+
+  ImGui::Text("%zu poses over %.2f s", replay.numSamples(), logDuration.value());
+
+  // Tracking error.
+
+  if (std::optional<units::meter_t> error = m_editorPage.replayTrackingError()) {
+    ImGui::Text("Tracking error: %.3f m", error->value());
+  } else {
+    ImGui::TextDisabled("Tracking error: -");
+  }
+}
+
+void RobotLogReplayPage::openLog() {
+  std::filesystem::path path = getPlatform().openFileDialog(FileType::FILE, kRobotLogFileFilters);
+  if (path.empty())
+    return;
+
+  ThunderAutoLogger::Info("Open robot log '{}'", path.string());
+
+  m_openError.clear();
+
+  try {
+    m_editorPage.robotLogReplay().open(path);
+  } catch (const ThunderError& e) {
+    m_openError = fmt::format("Failed to open robot log '{}': {}", path.string(), e.message());
+  } catch (const std::exception& e) {
+    m_openError = fmt::format("Failed to open robot log '{}': {}", path.string(), e.what());
+  }
+
+  if (!m_openError.empty()) {
+    ThunderAutoLogger::Error("{}", m_openError);
+  }
+}
@@ -0,0 +1,256 @@
+#include <ThunderAuto/Pages/SpeedConstraintTunerPage.hpp>
+
+#include <ThunderAuto/ImGuiScopedField.hpp>
+#include <ThunderAuto/Logger.hpp>
+#include <IconsLucide.h>
+#include <imgui_raii.h>
+
+void SpeedConstraintTunerPage::present(bool* running) {
+  ImGui::SetNextWindowSize(ImVec2(GET_UISIZE(SPEED_CONSTRAINT_TUNER_PAGE_START_WIDTH),
+                                  GET_UISIZE(SPEED_CONSTRAINT_TUNER_PAGE_START_HEIGHT)),
+                           ImGuiCond_FirstUseEver);
+  ImGui::Scoped scopedWindow = ImGui::Scoped::Window(name(), running);
+  if (!scopedWindow || (running && !*running))
+    return;
+
+  if (m_tuner && m_tuner->isFinished()) {
+    m_result = m_tuner->takeResult();
+    m_resultTrajectoryName = std::move(m_tunerTrajectoryName);
+    m_resultTrajectoryVersion = m_tunerTrajectoryVersion;
+    m_hasResult = !m_result.cancelled || !m_result.candidates.empty();
+    m_tuner.reset();
+
+    if (!m_result.error.empty()) {
+      ThunderAutoLogger::Error("Speed constraint tuning failed: {}", m_result.error);
+    }
+  }
+
+  const ThunderAutoProjectState& state = m_history.currentState();
+  const std::string& trajectoryName = state.editorState.trajectoryEditorState.currentTrajectoryName;
+
+  const bool isTrajectorySelected = state.editorState.view == ThunderAutoEditorState::View::TRAJECTORY &&
+                                    !trajectoryName.empty();
+  if (!isTrajectorySelected) {
+    ImGui::TextDisabled("Select a trajectory to tune its speed constraints");
+  } else {
+    ImGui::Text("Trajectory: %s", trajectoryName.c_str());
+  }
+
+  ImGui::Spacing();
+
+  {
+    auto scopedDisabled = ImGui::Scoped::Disabled(m_tuner != nullptr);
+    presentLimits();
+  }
+
+  ImGui::Spacing();
+
+  if (m_tuner) {
+    ImGui::ProgressBar(m_tuner->progress(), ImVec2(-FLT_MIN, 0.f), "Tuning...");
+    if (ImGui::Button(ICON_LC_X "  Cancel")) {
+      m_tuner->cancel();
+    }
+  } else {
+    auto scopedDisabled = ImGui::Scoped::Disabled(!isTrajectorySelected);
+
+    if (ImGui::Button(ICON_LC_PLAY "  Tune")) {
+      ThunderAutoLogger::Info("Tune speed constraints of trajectory '{}'", trajectoryName);
+
+      m_tunerTrajectoryName = trajectoryName;
+      m_tunerTrajectoryVersion = m_history.trajectoryVersion(trajectoryName);
+      m_tuner = std::make_unique<SpeedConstraintTuner>(state.currentTrajectory(), m_limits);
+    }
+  }
+
+  if (!m_hasResult)
+    return;
+
+  ImGui::Spacing();
+
+  if (!m_result.error.empty()) {
+    ImGui::TextWrapped(ICON_LC_TRIANGLE_ALERT "  Tuning failed: %s", m_result.error.c_str());
+    return;
+  }
+
+  ImGui::Text("'%s' currently takes %.2f s", m_resultTrajectoryName.c_str(), m_result.originalTime.value());
+  ImGui::TextDisabled("%zu candidates built, %zu skipped early", m_result.numEvaluated, m_result.numSkipped);
+
+  if (m_result.candidates.empty()) {
+    ImGui::TextWrapped(ICON_LC_TRIANGLE_ALERT "  No candidates were within the robot's limits");
+    return;
+  }
+
+  ImGui::Spacing();
+
+  if (isResultOutOfDate()) {
+    ImGui::TextWrapped(ICON_LC_TRIANGLE_ALERT "  '%s' changed since it was tuned. Tune it again to apply a "
+                       "candidate.",
+                       m_resultTrajectoryName.c_str());
+  }
+
+  presentCandidatesTable();
+}
+
+void SpeedConstraintTunerPage::reset() noexcept {
+  m_tuner.reset();
+  m_tunerTrajectoryName.clear();
+  m_tunerTrajectoryVersion = 0;
+  m_result = {};
+  m_resultTrajectoryName.clear();
+  m_resultTrajectoryVersion = 0;
+  m_hasResult = false;
+}
+
+// Edits a limit stored as a units type through a float drag.
+template <typename Unit>
+static void DragLimit(const char* id, Unit& limit, float speed, float min, float max, const char* format) {
+  float value = static_cast<float>(limit.value());
+  if (ImGui::DragFloat(id, &value, speed, min, max, format, ImGuiSliderFlags_AlwaysClamp)) {
+    limit = Unit(static_cast<double>(value));
+  }
+}
+
+void SpeedConstraintTunerPage::presentLimits() {
+  {
+    auto scopedField =
+        ImGui::ScopedField::Builder("Max Velocity").tooltip("The robot's top speed").build();
+    DragLimit("##Max Velocity", m_limits.maxLinearVelocity, 0.05f, 0.1f, 25.f, "%.2f m/s");
+  }
+  {
+    auto scopedField = ImGui::ScopedField::Builder("Max Linear Accel").build();
+    DragLimit("##Max Linear Acceleration", m_limits.maxLinearAcceleration, 0.05f, 0.1f, 25.f, "%.2f m/s²");
+  }
+  {
+    auto scopedField = ImGui::ScopedField::Builder("Max Total Accel")
+                           .tooltip("The most the robot can accelerate in any direction before its wheels "
+                                    "slip, counting both linear and centripetal acceleration")
+                           .build();
+    DragLimit("##Max Total Acceleration", m_limits.maxTotalAcceleration, 0.05f, 0.1f, 25.f, "%.2f m/s²");
+  }
+  {
+    auto scopedField = ImGui::ScopedField::Builder("Max Angular Velocity").build();
+    DragLimit("##Max Angular Velocity", m_limits.maxAngularVelocity, 1.f, 1.f, 720.f, "%.1f °/s");
+  }
+  {
+    auto scopedField = ImGui::ScopedField::Builder("Max Angular Accel").build();
+    DragLimit("##Max Angular Acceleration", m_limits.maxAngularAcceleration, 1.f, 1.f, 1440.f, "%.1f °/s²");
+  }
+  {
+    auto scopedField = ImGui::ScopedField::Builder("Tune Overrides")
+                           .tooltip("Also tune the velocity overrides of waypoints that aren't stopped")
+                           .build();
+    ImGui::Checkbox("##Tune Overrides", &m_limits.tuneVelocityOverrides);
+  }
+}
+
+void SpeedConstraintTunerPage::presentCandidatesTable() {
+  const ImGuiTableFlags tableFlags = ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV |
+                                     ImGuiTableFlags_Resizable | ImGuiTableFlags_ScrollX |
+                                     ImGuiTableFlags_ScrollY;
+
+  if (!ImGui::BeginTable("Candidates", 9, tableFlags))
+    return;
+
+  ImGui::TableSetupScrollFreeze(1, 1);
+  ImGui::TableSetupColumn("");
+  ImGui::TableSetupColumn("Time");
+  ImGui::TableSetupColumn("Velocity");
+  ImGui::TableSetupColumn("Linear Accel");
+  ImGui::TableSetupColumn("Centripetal Accel");
+  ImGui::TableSetupColumn("Angular Velocity");
+  ImGui::TableSetupColumn("Angular Accel");
+  ImGui::TableSetupColumn("Overrides");
+  ImGui::TableSetupColumn("Peak Total Accel");
+  ImGui::TableHeadersRow();
+
+  const SpeedConstraintTuner::Candidate* candidateToApply = nullptr;
+
+  const bool isOutOfDate = isResultOutOfDate();
+
+  for (size_t i = 0; i < m_result.candidates.size(); i++) {
+    const SpeedConstraintTuner::Candidate& candidate = m_result.candidates[i];
+    const ThunderAutoTrajectorySkeletonSettings& settings = candidate.settings;
+
+    auto scopedID = ImGui::Scoped::ID(static_cast<int>(i));
+
+    ImGui::TableNextRow();
+
+    ImGui::TableNextColumn();
+    {
+      auto scopedDisabled = ImGui::Scoped::Disabled(isOutOfDate);
+      if (ImGui::SmallButton("Apply")) {
+        candidateToApply = &candidate;
+      }
+    }
+
+    ImGui::TableNextColumn();
+    ImGui::Text("%.2f s (%+.2f s)", candidate.totalTime.value(),
+                (candidate.totalTime - m_result.originalTime).value());
+
+    ImGui::TableNextColumn();
+    ImGui::Text("%.2f m/s", settings.maxLinearVelocity.value());
+
+    ImGui::TableNextColumn();
+    ImGui::Text("%.2f m/s²", settings.maxLinearAcceleration.value());
+
+    ImGui::TableNextColumn();
+    ImGui::Text("%.2f m/s²", settings.maxCentripetalAcceleration.value());
+
+    ImGui::TableNextColumn();
+    ImGui::Text("%.1f °/s", units::degrees_per_second_t(settings.maxAngularVelocity).value());
+
+    ImGui::TableNextColumn();
+    ImGui::Text("%.1f °/s²", units::degrees_per_second_squared_t(settings.maxAngularAcceleration).value());
+
+    ImGui::TableNextColumn();
+    if (candidate.velocityOverrides.empty()) {
+      ImGui::TextDisabled("-");
+    } else {
+      ImGui::Text("%zu", candidate.velocityOverrides.size());
+
+      if (ImGui::IsItemHovered()) {
+        auto scopedTooltip = ImGui::Scoped::Tooltip();
+        for (const auto& [waypointIndex, velocity] : candidate.velocityOverrides) {
+          ImGui::Text("Point %zu: %.2f m/s", waypointIndex, velocity.value());
+        }
+      }
+    }
+
+    ImGui::TableNextColumn();
+    ImGui::Text("%.2f m/s²", candidate.peakTotalAcceleration.value());
+  }
+
+  ImGui::EndTable();
+
+  if (candidateToApply) {
+    applyCandidate(*candidateToApply);
+  }
+}
+
+bool SpeedConstraintTunerPage::isResultOutOfDate() {
+  return m_history.trajectoryVersion(m_resultTrajectoryName) != m_resultTrajectoryVersion;
+}
+
+void SpeedConstraintTunerPage::applyCandidate(const SpeedConstraintTuner::Candidate& candidate) {
+  ThunderAutoProjectState state = m_history.currentState();
+
+  auto trajectoryIt = state.trajectories.find(m_resultTrajectoryName);
+  if (trajectoryIt == state.trajectories.end()) {
+    ThunderAutoLogger::Warn("Trajectory '{}' no longer exists", m_resultTrajectoryName);
+    return;
+  }
+
+  ThunderAutoTrajectorySkeleton& skeleton = trajectoryIt->second;
+
+  // The velocity overrides are by waypoint index, so they'd land on the wrong waypoints if any were added or
+  // removed since the trajectory was tuned.
+  if (isResultOutOfDate()) {
+    ThunderAutoLogger::Warn("Trajectory '{}' changed since it was tuned", m_resultTrajectoryName);
+    return;
+  }
+
+  ThunderAutoLogger::Info("Apply tuned speed constraints to trajectory '{}'", m_resultTrajectoryName);
+
+  SpeedConstraintTuner::ApplyCandidate(skeleton, candidate);
+  m_history.addState(state);
+}
@@ -0,0 +1,380 @@
+#include <ThunderAuto/Pages/TelemetryPage.hpp>
+
+#include <ThunderAuto/ColorPalette.hpp>
+#include <ThunderAuto/Logger.hpp>
+#include <ThunderAuto/ThreadPool.hpp>
+#include <IconsLucide.h>
+#include <imgui_raii.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+static const std::array<ImU32, TelemetrySeries::kNumChannels> kChannelColors = {
+    ThunderAutoColorPalette::kBlueHigh,    // LINEAR_VELOCITY
+    ThunderAutoColorPalette::kGreenHigh,   // LINEAR_ACCELERATION
+    ThunderAutoColorPalette::kOrangeHigh,  // CENTRIPETAL_ACCELERATION
+    ThunderAutoColorPalette::kPurpleHigh,  // ANGULAR_VELOCITY
+    ThunderAutoColorPalette::kYellowMid,   // CURVATURE
+};
+
+static const ImU32 kPlotBackgroundColor = ThunderAutoColorPalette::kGrayLow;
+static const ImU32 kPlotZeroLineColor = ThunderAutoColorPalette::kGrayHigh;
+static const ImU32 kPlaybackCursorColor = ThunderAutoColorPalette::kRedHigh;
+static const ImU32 kHoverCursorColor = IM_COL32(255, 255, 255, 96);
+
+// How much one notch of the mouse wheel zooms in.
+static constexpr float kZoomFactor = 0.8f;
+
+static const char* AxisToString(TelemetrySeries::Axis axis) {
+  switch (axis) {
+    using enum TelemetrySeries::Axis;
+    case TIME:
+      return "Time (s)";
+    case DISTANCE:
+      return "Distance (m)";
+    default:
+      ThunderAutoUnreachable("Unknown telemetry axis");
+  }
+}
+
+void TelemetryPage::present(bool* running) {
+  ImGui::SetNextWindowSize(
+      ImVec2(GET_UISIZE(TELEMETRY_PAGE_START_WIDTH), GET_UISIZE(TELEMETRY_PAGE_START_HEIGHT)),
+      ImGuiCond_FirstUseEver);
+  ImGui::Scoped scopedWindow = ImGui::Scoped::Window(name(), running);
+  if (!scopedWindow || (running && !*running))
+    return;
+
+  updateSeries();
+
+  // Controls.
+
+  ImGui::SetNextItemWidth(GET_UISIZE(TELEMETRY_PAGE_AXIS_COMBO_WIDTH));
+  if (auto scopedCombo = ImGui::Scoped::Combo("##Axis", AxisToString(m_axis))) {
+    for (TelemetrySeries::Axis axis : {TelemetrySeries::Axis::TIME, TelemetrySeries::Axis::DISTANCE}) {
+      if (ImGui::Selectable(AxisToString(axis), m_axis == axis) && m_axis != axis) {
+        m_axis = axis;
+        resetView();
+      }
+    }
+  }
+
+  for (size_t i = 0; i < TelemetrySeries::kNumChannels; i++) {
+    const TelemetrySeries::Channel channel = static_cast<TelemetrySeries::Channel>(i);
+
+    ImGui::SameLine();
+
+    auto scopedColor = ImGui::Scoped::StyleColor(ImGuiCol_CheckMark, kChannelColors[i]);
+    ImGui::Checkbox(TelemetrySeries::ChannelToString(channel), &m_showChannels[i]);
+  }
+
+  if (!m_series || m_series->empty()) {
+    ImGui::TextDisabled(m_pendingSeries.valid() ? "Building..." : "Select a trajectory or auto mode");
+    return;
+  }
+
+  // Plots.
+
+  const size_t numPlots = std::ranges::count(m_showChannels, true);
+  if (numPlots == 0)
+    return;
+
+  const ImVec2 plotsPosition = ImGui::GetCursorScreenPos();
+  const ImVec2 plotsSize = ImGui::GetContentRegionAvail();
+  if (plotsSize.x <= 0.f || plotsSize.y <= 0.f)
+    return;
+
+  const ImRect plotsBB(plotsPosition, plotsPosition + plotsSize);
+
+  ImGui::InvisibleButton("##Plots", plotsSize);
+  processPlotInput(plotsBB);
+
+  const float spacing = ImGui::GetStyle().ItemSpacing.y;
+  const float plotHeight = (plotsSize.y - spacing * static_cast<float>(numPlots - 1)) / numPlots;
+
+  float plotY = plotsBB.Min.y;
+  for (size_t i = 0; i < TelemetrySeries::kNumChannels; i++) {
+    if (!m_showChannels[i])
+      continue;
+
+    const ImRect plotBB(ImVec2(plotsBB.Min.x, plotY), ImVec2(plotsBB.Max.x, plotY + plotHeight));
+    presentPlot(static_cast<TelemetrySeries::Channel>(i), plotBB);
+
+    plotY += plotHeight + spacing;
+  }
+}
+
+void TelemetryPage::onStateUpdated(const StateChangeSet& changes) {
+  if (changes.everything || changes.editorView || changes.currentTrajectory || changes.currentAutoMode ||
+      !changes.trajectories.empty() || !changes.autoModes.empty()) {
+    m_seriesIsStale = true;
+  }
+}
+
+void TelemetryPage::updateSeries() {
+  if (m_pendingSeries.valid() &&
+      m_pendingSeries.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+    try {
+      const bool hadSeries = m_series && !m_series->empty();
+      m_series = m_pendingSeries.get();
+
+      // Keep the view while editing, but show everything when switching to something new.
+      if (!hadSeries) {
+        resetView();
+      }
+
+    } catch (const ThunderError& e) {
+      ThunderAutoLogger::Error("Failed to build telemetry: {}", e.message());
+      m_series.reset();
+    } catch (const std::exception& e) {
+      ThunderAutoLogger::Error("Failed to build telemetry: {}", e.what());
+      m_series.reset();
+    }
+  }
+
+  // Wait for the current build to finish before starting another one, so that builds don't pile up while
+  // dragging.
+  if (!m_seriesIsStale || m_pendingSeries.valid())
+    return;
+
+  m_seriesIsStale = false;
+
+  const ThunderAutoProjectState& state = m_history.currentState();
+  const ThunderAutoEditorState& editorState = state.editorState;
+
+  std::vector<ThunderAutoTrajectorySkeleton> skeletons;
+  std::string sourceName;
+
+  switch (editorState.view) {
+    using enum ThunderAutoEditorState::View;
+    case TRAJECTORY: {
+      sourceName = editorState.trajectoryEditorState.currentTrajectoryName;
+
+      auto trajectoryIt = state.trajectories.find(sourceName);
+      if (trajectoryIt != state.trajectories.end()) {
+        skeletons.push_back(trajectoryIt->second);
+      }
+      break;
+    }
+    case AUTO_MODE: {
+      sourceName = editorState.autoModeEditorState.currentAutoModeName;
+
+      // The steps are in the order they run, and the active ones are in the branches the editor displays.
+      const AutoModeStepIndex& stepIndex = m_history.autoModeStepIndex(sourceName);
+      for (const AutoModeStepIndex::Entry& entry : stepIndex.entries()) {
+        if (entry.type != ThunderAutoModeStepType::TRAJECTORY || !entry.isActive)
+          continue;
+
+        auto trajectoryIt = state.trajectories.find(entry.itemName);
+        if (trajectoryIt != state.trajectories.end()) {
+          skeletons.push_back(trajectoryIt->second);
+        }
+      }
+      break;
+    }
+    case NONE:
+      break;
+    default:
+      ThunderAutoUnreachable("Unknown editor view");
+  }
+
+  // Switching to a different trajectory or auto mode should show all of it once it's built.
+  if (editorState.view != m_seriesView || sourceName != m_seriesSourceName) {
+    m_seriesView = editorState.view;
+    m_seriesSourceName = std::move(sourceName);
+    m_series.reset();
+  }
+
+  if (skeletons.empty()) {
+    m_series.reset();
+    return;
+  }
+
+  m_pendingSeries = ThreadPool::get().submit([skeletons = std::move(skeletons)] {
+    auto series = std::make_unique<TelemetrySeries>();
+    for (const ThunderAutoTrajectorySkeleton& skeleton : skeletons) {
+      std::unique_ptr<ThunderAutoOutputTrajectory> trajectory =
+          BuildThunderAutoOutputTrajectory(skeleton, kHighResOutputTrajectorySettings);
+      series->addTrajectory(*trajectory);
+    }
+    series->build();
+    return series;
+  });
+}
+
+void TelemetryPage::resetView() {
+  m_viewMin = 0.f;
+  m_viewMax = 0.f;
+
+  if (m_series && !m_series->empty()) {
+    m_viewMax = m_series->axisValues(m_axis).back();
+  }
+}
+
+void TelemetryPage::processPlotInput(ImRect bb) {
+  const float viewSpan = m_viewMax - m_viewMin;
+  if (viewSpan <= 0.f)
+    return;
+
+  const ImGuiIO& io = ImGui::GetIO();
+
+  const float mouseT = std::clamp((io.MousePos.x - bb.Min.x) / bb.GetWidth(), 0.f, 1.f);
+  const float mouseValue = m_viewMin + viewSpan * mouseT;
+
+  const float fullMax = m_series->axisValues(m_axis).back();
+
+  if (ImGui::IsItemHovered() && io.MouseWheel != 0.f) {
+    // Zoom around the mouse.
+    const float newSpan = std::min(std::max(viewSpan * std::pow(kZoomFactor, io.MouseWheel), 0.01f), fullMax);
+    m_viewMin = mouseValue - newSpan * mouseT;
+    m_viewMax = m_viewMin + newSpan;
+  }
+
+  if (ImGui::IsItemActive() && ImGui::IsMouseDragging(ImGuiMouseButton_Left)) {
+    // Pan.
+    const float delta = -io.MouseDelta.x / bb.GetWidth() * (m_viewMax - m_viewMin);
+    m_viewMin += delta;
+    m_viewMax += delta;
+
+  } else if (ImGui::IsItemDeactivated() && !ImGui::IsMouseDragPastThreshold(ImGuiMouseButton_Left)) {
+    // Seek the editor's playback to where was clicked.
+    float time = mouseValue;
+    if (m_axis != TelemetrySeries::Axis::TIME) {
+      time = m_series->convertAxisValue(m_axis, TelemetrySeries::Axis::TIME, mouseValue);
+    }
+    m_editorPage.setPlaybackTime(units::second_t(std::max(time, 0.f)));
+  }
+
+  if (ImGui::IsItemHovered() && ImGui::IsMouseDoubleClicked(ImGuiMouseButton_Left)) {
+    resetView();
+  }
+
+  // Keep the view within the series.
+  const float span = m_viewMax - m_viewMin;
+  if (m_viewMin < 0.f) {
+    m_viewMin = 0.f;
+    m_viewMax = span;
+  } else if (m_viewMax > fullMax) {
+    m_viewMax = fullMax;
+    m_viewMin = std::max(fullMax - span, 0.f);
+  }
+}
+
+void TelemetryPage::presentPlot(TelemetrySeries::Channel channel, ImRect bb) {
+  ImDrawList* drawList = ImGui::GetWindowDrawList();
+
+  drawList->AddRectFilled(bb.Min, bb.Max, kPlotBackgroundColor, ImGui::GetStyle().FrameRounding);
+
+  const float viewSpan = m_viewMax - m_viewMin;
+  const int width = static_cast<int>(bb.GetWidth());
+  if (viewSpan <= 0.f || width <= 0)
+    return;
+
+  const std::vector<float>& axisValues = m_series->axisValues(m_axis);
+  const std::vector<float>& values = m_series->channelValues(channel);
+
+  // Include one sample past each edge so that lines reach the edges of the plot.
+  auto [begin, end] = m_series->findSamples(m_axis, m_viewMin, m_viewMax);
+  begin = begin > 0 ? begin - 1 : 0;
+  end = std::min(end + 1, m_series->size());
+  if (begin >= end)
+    return;
+
+  // Scale the plot to fit what's visible, always including zero.
+  TelemetrySeries::Range range = m_series->channelRange(channel, begin, end);
+  range.min = std::min(range.min, 0.f);
+  range.max = std::max(range.max, 0.f);
+  if (range.max - range.min < 1e-6f) {
+    range.max = range.min + 1.f;
+  }
+
+  const float padding = GET_UISIZE(TELEMETRY_PAGE_PLOT_PADDING);
+  const float plotTop = bb.Min.y + padding;
+  const float plotHeight = bb.GetHeight() - padding * 2.f;
+
+  auto toScreenX = [&](float axisValue) { return bb.Min.x + (axisValue - m_viewMin) / viewSpan * width; };
+  auto toScreenY = [&](float value) {
+    return plotTop + (range.max - value) / (range.max - range.min) * plotHeight;
+  };
+
+  drawList->PushClipRect(bb.Min, bb.Max, true);
+
+  drawList->AddLine(ImVec2(bb.Min.x, toScreenY(0.f)), ImVec2(bb.Max.x, toScreenY(0.f)), kPlotZeroLineColor);
+
+  const ImU32 color = kChannelColors.at(static_cast<size_t>(channel));
+
+  if (end - begin <= static_cast<size_t>(width) * 2) {
+    // Few enough samples to draw every one of them.
+    ImVec2 previous(toScreenX(axisValues[begin]), toScreenY(values[begin]));
+    for (size_t i = begin + 1; i < end; i++) {
+      ImVec2 current(toScreenX(axisValues[i]), toScreenY(values[i]));
+      drawList->AddLine(previous, current, color, 1.5f);
+      previous = current;
+    }
+
+  } else {
+    // Otherwise draw the range of the samples under each column of pixels.
+    size_t columnBegin = begin;
+    for (int x = 0; x < width; x++) {
+      const float columnMax = m_viewMin + viewSpan * static_cast<float>(x + 1) / width;
+
+      auto columnEndIt =
+          std::lower_bound(axisValues.begin() + columnBegin, axisValues.begin() + end, columnMax);
+      size_t columnEnd = static_cast<size_t>(std::distance(axisValues.begin(), columnEndIt));
+      if (columnEnd == columnBegin)
+        continue;
+
+      // Overlap the previous column by a sample so that neighboring columns connect.
+      const size_t rangeBegin = columnBegin > begin ? columnBegin - 1 : columnBegin;
+      const TelemetrySeries::Range columnRange = m_series->channelRange(channel, rangeBegin, columnEnd);
+
+      const float screenX = bb.Min.x + static_cast<float>(x) + 0.5f;
+      drawList->AddLine(ImVec2(screenX, toScreenY(columnRange.max)),
+                        ImVec2(screenX, toScreenY(columnRange.min) + 1.f), color, 1.f);
+
+      columnBegin = columnEnd;
+    }
+  }
+
+  // Label.
+  {
+    const TelemetrySeries::Range visibleRange = m_series->channelRange(channel, begin, end);
+
+    char buffer[128];
+    snprintf(buffer, sizeof(buffer), "%s (%s)  [%.2f, %.2f]", TelemetrySeries::ChannelToString(channel),
+             TelemetrySeries::ChannelUnits(channel), visibleRange.min, visibleRange.max);
+
+    drawList->AddText(bb.Min + ImVec2(padding, padding), ImGui::GetColorU32(ImGuiCol_Text), buffer);
+  }
+
+  // Playback cursor.
+  {
+    float playbackValue = static_cast<float>(m_editorPage.playbackTime().value());
+    if (m_axis != TelemetrySeries::Axis::TIME) {
+      playbackValue = m_series->convertAxisValue(TelemetrySeries::Axis::TIME, m_axis, playbackValue);
+    }
+
+    const float x = toScreenX(playbackValue);
+    drawList->AddLine(ImVec2(x, bb.Min.y), ImVec2(x, bb.Max.y), kPlaybackCursorColor, 1.5f);
+  }
+
+  // Hover cursor and value.
+  if (ImGui::IsMouseHoveringRect(bb.Min, bb.Max) && ImGui::IsWindowHovered()) {
+    const float mouseX = ImGui::GetIO().MousePos.x;
+    const float mouseValue = m_viewMin + (mouseX - bb.Min.x) / width * viewSpan;
+
+    auto sampleIt = std::lower_bound(axisValues.begin(), axisValues.end(), mouseValue);
+    if (sampleIt == axisValues.end()) {
+      sampleIt = std::prev(sampleIt);
+    }
+    const size_t sample = static_cast<size_t>(std::distance(axisValues.begin(), sampleIt));
+
+    drawList->AddLine(ImVec2(mouseX, bb.Min.y), ImVec2(mouseX, bb.Max.y), kHoverCursorColor);
+
+    ImGui::SetTooltip("%s: %.2f\n%s: %.3f %s", AxisToString(m_axis), axisValues[sample],
+                      TelemetrySeries::ChannelToString(channel), values[sample],
+                      TelemetrySeries::ChannelUnits(channel));
+  }
+
+  drawList->PopClipRect();
+}
@@ -2,6 +2,8 @@
 
 #include <IconsLucide.h>
 #include <imgui_raii.h>
+#include <optional>
+#include <vector>
 
 void TrajectoryManagerPage::present(bool* running) {
   m_event = Event::NONE;
@@ -22,73 +24,102 @@ void TrajectoryManagerPage::present(bool* running) {
 
   std::string trajectoryToDeleteName;
 
-  for (auto& [trajectoryName, trajectorySkeleton] : trajectories) {
-    const bool isTrajectorySelected =
-        isInTrajectoryMode && (trajectoryName == trajectoryEditorState.currentTrajectoryName);
+  m_searchBox.present("Search trajectories");
 
-    auto scopedPadding =
-        ImGui::Scoped::StyleVarY(ImGuiStyleVar_ItemSpacing, GET_UISIZE(SELECTABLE_LIST_ITEM_SPACING_Y));
+  const NameSearchIndex& nameIndex = m_history.trajectoryNameIndex();
+  const std::vector<size_t>& matches = m_searchBox.matches(nameIndex);
 
-    if (ImGui::Selectable(trajectoryName.c_str(), isTrajectorySelected) && !isTrajectorySelected) {
-      ThunderAutoLogger::Info("Trajectory '{}' selected", trajectoryName);
+  if (matches.empty() && m_searchBox.isSearching()) {
+    ImGui::TextDisabled("No matching trajectories");
+  }
 
-      state.editorState.view = ThunderAutoEditorState::View::TRAJECTORY;
-      trajectoryEditorState.currentTrajectoryName = trajectoryName;
-      trajectoryEditorState.trajectorySelection = ThunderAutoTrajectoryEditorState::TrajectorySelection::NONE;
-      trajectoryEditorState.selectionIndex = 0;
+  const TrajectoryThumbnails& thumbnails = m_editorPage.trajectoryThumbnails(state);
+  ImDrawList* drawList = ImGui::GetWindowDrawList();
 
-      m_history.addState(state);
-    }
+  // Only the rows in view are drawn.
+  ImGuiListClipper clipper;
+  clipper.Begin(static_cast<int>(matches.size()));
+  while (clipper.Step()) {
+    for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++) {
+      auto trajectoryIt = trajectories.find(nameIndex.names()[matches[row]]);
+      if (trajectoryIt == trajectories.end())
+        continue;
+
+      const std::string& trajectoryName = trajectoryIt->first;
+      ThunderAutoTrajectorySkeleton& trajectorySkeleton = trajectoryIt->second;
+
+      const bool isTrajectorySelected =
+          isInTrajectoryMode && (trajectoryName == trajectoryEditorState.currentTrajectoryName);
+
+      auto scopedPadding =
+          ImGui::Scoped::StyleVarY(ImGuiStyleVar_ItemSpacing, GET_UISIZE(SELECTABLE_LIST_ITEM_SPACING_Y));
+
+      if (ImGui::Selectable(trajectoryName.c_str(), isTrajectorySelected) && !isTrajectorySelected) {
+        ThunderAutoLogger::Info("Trajectory '{}' selected", trajectoryName);
 
-    if (auto popup = ImGui::Scoped::PopupContextItem()) {
-      if (ImGui::MenuItem(ICON_LC_PENCIL "  Rename")) {
-        m_eventTrajectory = trajectoryName;
-        m_event = Event::RENAME_TRAJECTORY;
+        state.editorState.view = ThunderAutoEditorState::View::TRAJECTORY;
+        trajectoryEditorState.currentTrajectoryName = trajectoryName;
+        trajectoryEditorState.trajectorySelection =
+            ThunderAutoTrajectoryEditorState::TrajectorySelection::NONE;
+        trajectoryEditorState.selectionIndex = 0;
+
+        m_history.addState(state);
       }
 
-      if (ImGui::MenuItem(ICON_LC_LINK "  Link Start/End Behavior")) {
-        m_eventTrajectory = trajectoryName;
-        m_event = Event::LINK_END_BEHAVIOR;
+      if (std::optional<TrajectoryThumbnails::Tile> tile = thumbnails.trajectoryTile(trajectoryName)) {
+        TrajectoryThumbnails::DrawTileInRow(drawList, *tile, ImGui::GetItemRectMin(),
+                                            ImGui::GetItemRectMax());
       }
 
-      {
-        auto scopedIndent = ImGui::Scoped::Indent();
+      if (auto popup = ImGui::Scoped::PopupContextItem()) {
+        if (ImGui::MenuItem(ICON_LC_PENCIL "  Rename")) {
+          m_eventTrajectory = trajectoryName;
+          m_event = Event::RENAME_TRAJECTORY;
+        }
 
-      if (trajectorySkeleton.hasStartBehaviorLink()) {
-        if (ImGui::MenuItem(ICON_LC_UNLINK "  Unlink Start Behavior")) {
-          trajectorySkeleton.clearStartBehaviorLink();
-          m_history.addState(state);
+        if (ImGui::MenuItem(ICON_LC_LINK "  Link Start/End Behavior")) {
+          m_eventTrajectory = trajectoryName;
+          m_event = Event::LINK_END_BEHAVIOR;
         }
-      }
 
-      if (trajectorySkeleton.hasEndBehaviorLink()) {
-        if (ImGui::MenuItem(ICON_LC_UNLINK "  Unlink End Behavior")) {
-          trajectorySkeleton.clearEndBehaviorLink();
-          m_history.addState(state);
+        {
+          auto scopedIndent = ImGui::Scoped::Indent();
+
+          if (trajectorySkeleton.hasStartBehaviorLink()) {
+            if (ImGui::MenuItem(ICON_LC_UNLINK "  Unlink Start Behavior")) {
+              trajectorySkeleton.clearStartBehaviorLink();
+              m_history.addState(state);
+            }
+          }
+
+          if (trajectorySkeleton.hasEndBehaviorLink()) {
+            if (ImGui::MenuItem(ICON_LC_UNLINK "  Unlink End Behavior")) {
+              trajectorySkeleton.clearEndBehaviorLink();
+              m_history.addState(state);
+            }
+          }
         }
-      }
 
-      }
+        if (ImGui::MenuItem(ICON_LC_ARROW_RIGHT_LEFT "  Reverse Direction")) {
+          trajectorySkeleton.reverseDirection();
+          m_history.addState(state);
+        }
 
-      if (ImGui::MenuItem(ICON_LC_ARROW_RIGHT_LEFT "  Reverse Direction")) {
-        trajectorySkeleton.reverseDirection();
-        m_history.addState(state);
-      }
+        if (ImGui::MenuItem(ICON_LC_COPY "  Duplicate")) {
+          m_eventTrajectory = trajectoryName;
+          m_event = Event::DUPLICATE_TRAJECTORY;
+        }
 
-      if (ImGui::MenuItem(ICON_LC_COPY "  Duplicate")) {
-        m_eventTrajectory = trajectoryName;
-        m_event = Event::DUPLICATE_TRAJECTORY;
+        if (ImGui::MenuItem(ICON_LC_TRASH "  Delete")) {
+          trajectoryToDeleteName = trajectoryName;
+        }
       }
 
-      if (ImGui::MenuItem(ICON_LC_TRASH "  Delete")) {
-        trajectoryToDeleteName = trajectoryName;
+      if (auto scopedDragSource = ImGui::Scoped::DragDropSource()) {
+        ImGui::SetDragDropPayload("Trajectory", trajectoryName.c_str(), trajectoryName.size() + 1);
+        ImGui::Text("%s", trajectoryName.c_str());
       }
     }
-
-    if (auto scopedDragSource = ImGui::Scoped::DragDropSource()) {
-      ImGui::SetDragDropPayload("Trajectory", trajectoryName.c_str(), trajectoryName.size() + 1);
-      ImGui::Text("%s", trajectoryName.c_str());
-    }
   }
 
   ImGui::Separator();
@@ -0,0 +1,285 @@
+#include <ThunderAuto/Pages/WaypointOptimizerPage.hpp>
+
+#include <ThunderAuto/ImGuiScopedField.hpp>
+#include <ThunderAuto/Logger.hpp>
+#include <IconsLucide.h>
+#include <imgui_raii.h>
+#include <fmt/format.h>
+
+void WaypointOptimizerPage::present(bool* running) {
+  ImGui::SetNextWindowSize(ImVec2(GET_UISIZE(WAYPOINT_OPTIMIZER_PAGE_START_WIDTH),
+                                  GET_UISIZE(WAYPOINT_OPTIMIZER_PAGE_START_HEIGHT)),
+                           ImGuiCond_FirstUseEver);
+  ImGui::Scoped scopedWindow = ImGui::Scoped::Window(name(), running);
+
+  // Closing the window stops optimizing and previewing.
+  if (running && !*running) {
+    reset();
+    return;
+  }
+
+  // Keep collecting results while the window is collapsed, so that the preview stays up to date.
+  updateOptimizer();
+
+  if (!scopedWindow)
+    return;
+
+  const ThunderAutoProjectState& state = m_history.currentState();
+  const std::string& trajectoryName = state.editorState.trajectoryEditorState.currentTrajectoryName;
+
+  const bool isTrajectorySelected = state.editorState.view == ThunderAutoEditorState::View::TRAJECTORY &&
+                                    !trajectoryName.empty();
+  if (!isTrajectorySelected) {
+    ImGui::TextDisabled("Select a trajectory to optimize its waypoints");
+  } else {
+    ImGui::Text("Trajectory: %s", trajectoryName.c_str());
+  }
+
+  ImGui::Spacing();
+
+  {
+    auto scopedDisabled = ImGui::Scoped::Disabled(m_optimizer != nullptr);
+    presentSettings();
+  }
+
+  ImGui::Spacing();
+
+  if (m_optimizer) {
+    const std::string overlay = fmt::format("{} candidates", m_optimizer->numEvaluated());
+    ImGui::ProgressBar(m_optimizer->progress(), ImVec2(-FLT_MIN, 0.f), overlay.c_str());
+    if (ImGui::Button(ICON_LC_X "  Stop")) {
+      m_optimizer->cancel();
+    }
+  } else {
+    auto scopedDisabled = ImGui::Scoped::Disabled(!isTrajectorySelected);
+
+    if (ImGui::Button(ICON_LC_PLAY "  Optimize")) {
+      startOptimizing(state);
+    }
+  }
+
+  if (m_hasResult) {
+    ImGui::Spacing();
+    presentResult();
+  }
+}
+
+void WaypointOptimizerPage::reset() noexcept {
+  m_optimizer.reset();
+  m_optimizerTrajectoryName.clear();
+  m_optimizerTrajectoryVersion = 0;
+  m_previewGeneration = 0;
+  m_previewPath.clear();
+  m_result = {};
+  m_resultTrajectoryName.clear();
+  m_resultTrajectoryVersion = 0;
+  m_hasResult = false;
+  m_editorPage.clearGhostPath();
+}
+
+void WaypointOptimizerPage::updateOptimizer() {
+  // The changes are by waypoint index, and would overwrite edits made since the trajectory was optimized (or
+  // move the wrong waypoints if any were added or removed).
+  if (m_hasResult && m_history.trajectoryVersion(m_resultTrajectoryName) != m_resultTrajectoryVersion) {
+    ThunderAutoLogger::Info("Trajectory '{}' changed since it was optimized, discarding the result",
+                            m_resultTrajectoryName);
+    discardResult();
+  }
+
+  if (!m_optimizer)
+    return;
+
+  if (!m_optimizer->isFinished()) {
+    if (m_optimizer->bestPathSoFar(m_previewGeneration, m_previewPath)) {
+      m_editorPage.setGhostPath(m_optimizerTrajectoryName, m_previewPath);
+    }
+    return;
+  }
+
+  m_result = m_optimizer->takeResult();
+  m_resultTrajectoryName = std::move(m_optimizerTrajectoryName);
+  m_resultTrajectoryVersion = m_optimizerTrajectoryVersion;
+  m_hasResult = true;
+  m_optimizer.reset();
+
+  if (!m_result.error.empty()) {
+    ThunderAutoLogger::Error("Waypoint optimization failed: {}", m_result.error);
+  }
+
+  if (m_history.trajectoryVersion(m_resultTrajectoryName) != m_resultTrajectoryVersion) {
+    ThunderAutoLogger::Info("Trajectory '{}' changed while it was being optimized, discarding the result",
+                            m_resultTrajectoryName);
+    discardResult();
+    return;
+  }
+
+  if (m_result.changes.empty()) {
+    m_editorPage.clearGhostPath();
+  } else {
+    m_editorPage.setGhostPath(m_resultTrajectoryName, m_result.bestPath);
+  }
+}
+
+void WaypointOptimizerPage::presentSettings() {
+  {
+    auto scopedField = ImGui::ScopedField::Builder("Minimize").build();
+
+    const char* objectiveStr = WaypointOptimizerObjectiveToString(m_settings.objective);
+    if (auto scopedCombo = ImGui::Scoped::Combo("##Objective", objectiveStr)) {
+      using enum WaypointOptimizerObjective;
+      for (WaypointOptimizerObjective objective : {TIME, PEAK_CURVATURE}) {
+        const bool isSelected = m_settings.objective == objective;
+        if (ImGui::Selectable(WaypointOptimizerObjectiveToString(objective), isSelected)) {
+          m_settings.objective = objective;
+        }
+      }
+    }
+  }
+  {
+    auto scopedField = ImGui::ScopedField::Builder("Move Positions")
+                           .tooltip("Move waypoints other than the start, end, and linked waypoints")
+                           .build();
+    ImGui::Checkbox("##Move Positions", &m_settings.movePositions);
+  }
+  if (m_settings.movePositions) {
+    auto scopedField = ImGui::ScopedField::Builder("Max Distance")
+                           .tooltip("How far each waypoint may be moved")
+                           .build();
+
+    float maxPositionChange = static_cast<float>(m_settings.maxPositionChange.value());
+    if (ImGui::DragFloat("##Max Distance", &maxPositionChange, 0.01f, 0.01f, 5.f, "%.2f m",
+                         ImGuiSliderFlags_AlwaysClamp)) {
+      m_settings.maxPositionChange = units::meter_t(static_cast<double>(maxPositionChange));
+    }
+  }
+  {
+    auto scopedField = ImGui::ScopedField::Builder("Change Headings").build();
+    ImGui::Checkbox("##Change Headings", &m_settings.changeHeadings);
+  }
+  if (m_settings.changeHeadings) {
+    auto scopedField = ImGui::ScopedField::Builder("Max Heading Change").build();
+
+    float maxHeadingChange = static_cast<float>(m_settings.maxHeadingChange.value());
+    if (ImGui::DragFloat("##Max Heading Change", &maxHeadingChange, 0.5f, 1.f, 180.f, "%.1f°",
+                         ImGuiSliderFlags_AlwaysClamp)) {
+      m_settings.maxHeadingChange = units::degree_t(static_cast<double>(maxHeadingChange));
+    }
+  }
+  {
+    auto scopedField = ImGui::ScopedField::Builder("Change Weights").build();
+    ImGui::Checkbox("##Change Weights", &m_settings.changeWeights);
+  }
+  if (m_settings.changeWeights) {
+    auto scopedField = ImGui::ScopedField::Builder("Max Weight Scale")
+                           .tooltip("Heading weights may be scaled up or down by at most this much")
+                           .build();
+
+    float maxWeightScale = static_cast<float>(m_settings.maxWeightScale);
+    if (ImGui::DragFloat("##Max Weight Scale", &maxWeightScale, 0.01f, 1.f, 10.f, "%.2fx",
+                         ImGuiSliderFlags_AlwaysClamp)) {
+      m_settings.maxWeightScale = static_cast<double>(maxWeightScale);
+    }
+  }
+  {
+    auto scopedField = ImGui::ScopedField::Builder("Time Budget")
+                           .tooltip("How long to search for, using every core")
+                           .build();
+
+    float timeBudget = static_cast<float>(m_settings.timeBudget.value());
+    if (ImGui::DragFloat("##Time Budget", &timeBudget, 0.1f, 0.5f, 120.f, "%.1f s",
+                         ImGuiSliderFlags_AlwaysClamp)) {
+      m_settings.timeBudget = units::second_t(static_cast<double>(timeBudget));
+    }
+  }
+}
+
+void WaypointOptimizerPage::presentResult() {
+  if (!m_result.error.empty()) {
+    ImGui::TextWrapped(ICON_LC_TRIANGLE_ALERT "  Optimization failed: %s", m_result.error.c_str());
+    return;
+  }
+
+  const WaypointOptimizer::Score& original = m_result.originalScore;
+  const WaypointOptimizer::Score& best = m_result.bestScore;
+
+  ImGui::TextDisabled("%zu candidates in %zu rounds, %zu out of bounds", m_result.numEvaluated,
+                      m_result.numRounds, m_result.numOutOfBounds);
+
+  if (!original.isWithinBounds) {
+    ImGui::TextWrapped(ICON_LC_TRIANGLE_ALERT
+                       "  The original trajectory leaves the field or enters a keep-out zone");
+  }
+
+  if (m_result.changes.empty()) {
+    ImGui::TextWrapped("Nothing better than '%s' was found", m_resultTrajectoryName.c_str());
+    return;
+  }
+
+  ImGui::Text("Time: %.2f s " ICON_LC_ARROW_RIGHT " %.2f s", original.totalTime.value(),
+              best.totalTime.value());
+  ImGui::Text("Peak Curvature: %.2f " ICON_LC_ARROW_RIGHT " %.2f", original.peakCurvature,
+              best.peakCurvature);
+  ImGui::TextDisabled("The best trajectory is previewed in the editor");
+
+  ImGui::Spacing();
+
+  if (ImGui::Button(ICON_LC_CHECK "  Apply")) {
+    applyResult();
+  }
+  ImGui::SameLine();
+  if (ImGui::Button(ICON_LC_X "  Discard")) {
+    discardResult();
+  }
+}
+
+void WaypointOptimizerPage::startOptimizing(const ThunderAutoProjectState& state) {
+  const std::string& trajectoryName = state.editorState.trajectoryEditorState.currentTrajectoryName;
+
+  ThunderAutoLogger::Info("Optimize waypoints of trajectory '{}'", trajectoryName);
+
+  discardResult();
+
+  std::shared_ptr<const WaypointOptimizerBounds> bounds =
+      WaypointOptimizerBounds::Make(m_documentManager.settings(), m_documentManager.keepOutZones());
+
+  m_optimizerTrajectoryName = trajectoryName;
+  m_optimizerTrajectoryVersion = m_history.trajectoryVersion(trajectoryName);
+  m_previewGeneration = 0;
+  m_optimizer =
+      std::make_unique<WaypointOptimizer>(state.currentTrajectory(), m_settings, std::move(bounds));
+}
+
+void WaypointOptimizerPage::applyResult() {
+  ThunderAutoProjectState state = m_history.currentState();
+
+  auto trajectoryIt = state.trajectories.find(m_resultTrajectoryName);
+  if (trajectoryIt == state.trajectories.end()) {
+    ThunderAutoLogger::Warn("Trajectory '{}' no longer exists", m_resultTrajectoryName);
+    discardResult();
+    return;
+  }
+
+  ThunderAutoTrajectorySkeleton& skeleton = trajectoryIt->second;
+
+  if (m_history.trajectoryVersion(m_resultTrajectoryName) != m_resultTrajectoryVersion) {
+    ThunderAutoLogger::Warn("Trajectory '{}' changed since it was optimized", m_resultTrajectoryName);
+    discardResult();
+    return;
+  }
+
+  ThunderAutoLogger::Info("Apply optimized waypoints to trajectory '{}'", m_resultTrajectoryName);
+
+  WaypointOptimizer::ApplyChanges(skeleton, m_result.changes);
+  m_history.addState(state);
+
+  discardResult();
+}
+
+void WaypointOptimizerPage::discardResult() {
+  m_result = {};
+  m_resultTrajectoryName.clear();
+  m_resultTrajectoryVersion = 0;
+  m_hasResult = false;
+  m_previewPath.clear();
+  m_editorPage.clearGhostPath();
+}
@@ -0,0 +1,94 @@
+#include <ThunderAuto/PlaybackTimeline.hpp>
+
+#include <ThunderAuto/Error.hpp>
+#include <algorithm>
+
+// Past this many segments, jump straight to a binary search instead of stepping from the last lookup.
+static constexpr size_t kMaxCursorSteps = 8;
+
+void PlaybackTimeline::clear() noexcept {
+  m_trajectories.clear();
+  m_trajectoryStartTimes.clear();
+  m_totalTime = units::second_t(0.0);
+  m_segments.clear();
+  m_markers.clear();
+  m_cursor = 0;
+}
+
+void PlaybackTimeline::addTrajectory(const ThunderAutoOutputTrajectory& trajectory) {
+  const uint32_t trajectoryIndex = static_cast<uint32_t>(m_trajectories.size());
+  const units::second_t startTime = m_totalTime;
+
+  m_trajectories.push_back(&trajectory);
+  m_trajectoryStartTimes.push_back(startTime);
+  m_totalTime += trajectory.totalTime;
+
+  const size_t numPoints = trajectory.points.size();
+  if (numPoints == 0)
+    return;
+
+  // A trajectory with a single point still gets a segment, so that it can be sampled.
+  const size_t numSegments = std::max<size_t>(numPoints - 1, 1);
+
+  m_segments.reserve(m_segments.size() + numSegments);
+  for (size_t i = 0; i < numSegments; i++) {
+    m_segments.push_back(Segment{
+        .startTime = startTime + trajectory.points[i].time,
+        .trajectoryIndex = trajectoryIndex,
+        .pointIndex = static_cast<uint32_t>(i),
+    });
+  }
+}
+
+void PlaybackTimeline::addMarker(Marker::Type type, units::second_t time, std::string label) {
+  Marker marker{.type = type, .time = time, .label = std::move(label)};
+
+  auto it = std::upper_bound(m_markers.begin(), m_markers.end(), time,
+                             [](units::second_t time, const Marker& marker) { return time < marker.time; });
+  m_markers.insert(it, std::move(marker));
+}
+
+PlaybackTimeline::Sample PlaybackTimeline::sample(units::second_t time) const {
+  ThunderAutoAssert(!m_segments.empty(), "Playback timeline is empty");
+
+  time = std::clamp(time, units::second_t(0.0), m_totalTime);
+
+  const Segment& segment = m_segments[findSegment(time)];
+  const ThunderAutoOutputTrajectory& trajectory = *m_trajectories[segment.trajectoryIndex];
+
+  const size_t upperPointIndex = std::min<size_t>(segment.pointIndex + 1, trajectory.points.size() - 1);
+
+  Sample sample;
+  sample.lowerPoint = &trajectory.points[segment.pointIndex];
+  sample.upperPoint = &trajectory.points[upperPointIndex];
+
+  const units::second_t localTime = time - m_trajectoryStartTimes[segment.trajectoryIndex];
+  const units::second_t dt = sample.upperPoint->time - sample.lowerPoint->time;
+  sample.t = dt > units::second_t(0.01) ? (localTime - sample.lowerPoint->time).value() / dt.value() : 0.0;
+  sample.t = std::clamp(sample.t, 0.0, 1.0);
+
+  return sample;
+}
+
+size_t PlaybackTimeline::findSegment(units::second_t time) const {
+  // The segment that contains a time is the last one that starts at or before it.
+  auto containsTime = [&](size_t index) {
+    return m_segments[index].startTime <= time &&
+           (index + 1 == m_segments.size() || time < m_segments[index + 1].startTime);
+  };
+
+  // Playback moves forward a little each frame, so try stepping from the last lookup first.
+  if (m_cursor < m_segments.size() && m_segments[m_cursor].startTime <= time) {
+    for (size_t steps = 0; steps < kMaxCursorSteps && m_cursor < m_segments.size(); steps++, m_cursor++) {
+      if (containsTime(m_cursor))
+        return m_cursor;
+    }
+  }
+
+  auto it = std::upper_bound(
+      m_segments.begin(), m_segments.end(), time,
+      [](units::second_t time, const Segment& segment) { return time < segment.startTime; });
+
+  m_cursor = (it == m_segments.begin()) ? 0 : static_cast<size_t>(std::distance(m_segments.begin(), it)) - 1;
+  return m_cursor;
+}
@@ -0,0 +1,331 @@
+#include <ThunderAuto/PngEncoder.hpp>
+
+#include <ThunderAuto/Error.hpp>
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <fstream>
+#include <span>
+
+namespace {
+
+// Writes bits starting from the least significant bit of each byte, as deflate expects.
+class BitWriter {
+  std::vector<uint8_t>& m_out;
+  uint32_t m_bits = 0;
+  int m_numBits = 0;
+
+ public:
+  explicit BitWriter(std::vector<uint8_t>& out) : m_out(out) {}
+
+  void write(uint32_t value, int numBits) {
+    m_bits |= value << m_numBits;
+    m_numBits += numBits;
+    while (m_numBits >= 8) {
+      m_out.push_back(static_cast<uint8_t>(m_bits));
+      m_bits >>= 8;
+      m_numBits -= 8;
+    }
+  }
+
+  // Huffman codes are written starting from their most significant bit.
+  void writeCode(uint32_t code, int numBits) {
+    uint32_t reversed = 0;
+    for (int i = 0; i < numBits; i++) {
+      reversed |= ((code >> i) & 1) << (numBits - 1 - i);
+    }
+    write(reversed, numBits);
+  }
+
+  void flush() {
+    if (m_numBits > 0) {
+      m_out.push_back(static_cast<uint8_t>(m_bits));
+      m_bits = 0;
+      m_numBits = 0;
+    }
+  }
+};
+
+constexpr std::array<uint16_t, 29> kLengthBases = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195,
+    227, 258};
+constexpr std::array<uint8_t, 29> kLengthExtraBits = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+
+constexpr std::array<uint16_t, 30> kDistanceBases = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073,
+    4097, 6145, 8193, 12289, 16385, 24577};
+constexpr std::array<uint8_t, 30> kDistanceExtraBits = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+constexpr size_t kWindowSize = 32768;
+constexpr size_t kMinMatch = 3;
+constexpr size_t kMaxMatch = 258;
+constexpr size_t kMaxChainLength = 32;
+constexpr int kHashBits = 15;
+
+// Literal/length symbols, with the fixed Huffman codes from the deflate spec.
+void WriteLiteralLengthSymbol(BitWriter& writer, uint32_t symbol) {
+  if (symbol < 144) {
+    writer.writeCode(0x30 + symbol, 8);
+  } else if (symbol < 256) {
+    writer.writeCode(0x190 + (symbol - 144), 9);
+  } else if (symbol < 280) {
+    writer.writeCode(symbol - 256, 7);
+  } else {
+    writer.writeCode(0xC0 + (symbol - 280), 8);
+  }
+}
+
+void WriteMatch(BitWriter& writer, size_t length, size_t distance) {
+  const size_t lengthCode =
+      std::upper_bound(kLengthBases.begin(), kLengthBases.end(), length) - kLengthBases.begin() - 1;
+  WriteLiteralLengthSymbol(writer, static_cast<uint32_t>(257 + lengthCode));
+  writer.write(static_cast<uint32_t>(length - kLengthBases[lengthCode]), kLengthExtraBits[lengthCode]);
+
+  const size_t distanceCode =
+      std::upper_bound(kDistanceBases.begin(), kDistanceBases.end(), distance) - kDistanceBases.begin() - 1;
+  writer.writeCode(static_cast<uint32_t>(distanceCode), 5);
+  writer.write(static_cast<uint32_t>(distance - kDistanceBases[distanceCode]),
+               kDistanceExtraBits[distanceCode]);
+}
+
+uint32_t Hash(const uint8_t* data) {
+  const uint32_t value = uint32_t(data[0]) | (uint32_t(data[1]) << 8) | (uint32_t(data[2]) << 16);
+  return (value * 2654435761u) >> (32 - kHashBits);
+}
+
+// A single fixed Huffman block, with matches found using hash chains.
+void Deflate(std::span<const uint8_t> data, std::vector<uint8_t>& out) {
+  BitWriter writer(out);
+  writer.write(1, 1);  // Final block.
+  writer.write(1, 2);  // Fixed Huffman codes.
+
+  std::vector<int32_t> head(size_t(1) << kHashBits, -1);
+  std::vector<int32_t> previous(kWindowSize, -1);
+
+  auto insert = [&](size_t position) {
+    const uint32_t hash = Hash(&data[position]);
+    previous[position % kWindowSize] = head[hash];
+    head[hash] = static_cast<int32_t>(position);
+  };
+
+  size_t position = 0;
+  while (position < data.size()) {
+    size_t bestLength = 0;
+    size_t bestDistance = 0;
+
+    if (position + kMinMatch <= data.size()) {
+      const size_t maxLength = std::min(kMaxMatch, data.size() - position);
+
+      int32_t candidate = head[Hash(&data[position])];
+      for (size_t chain = 0; chain < kMaxChainLength && candidate >= 0; chain++) {
+        const size_t candidatePosition = static_cast<size_t>(candidate);
+        if (position - candidatePosition > kWindowSize)
+          break;
+
+        size_t length = 0;
+        while (length < maxLength && data[candidatePosition + length] == data[position + length]) {
+          length++;
+        }
+        if (length > bestLength) {
+          bestLength = length;
+          bestDistance = position - candidatePosition;
+          if (length == maxLength)
+            break;
+        }
+
+        const int32_t next = previous[candidatePosition % kWindowSize];
+        // The slot may have been reused by a newer position.
+        if (next >= candidate)
+          break;
+        candidate = next;
+      }
+    }
+
+    if (bestLength >= kMinMatch) {
+      WriteMatch(writer, bestLength, bestDistance);
+      for (size_t i = 0; i < bestLength; i++, position++) {
+        if (position + kMinMatch <= data.size()) {
+          insert(position);
+        }
+      }
+    } else {
+      WriteLiteralLengthSymbol(writer, data[position]);
+      if (position + kMinMatch <= data.size()) {
+        insert(position);
+      }
+      position++;
+    }
+  }
+
+  WriteLiteralLengthSymbol(writer, 256);  // End of block.
+  writer.flush();
+}
+
+uint32_t Adler32(std::span<const uint8_t> data) {
+  uint32_t a = 1, b = 0;
+  for (size_t i = 0; i < data.size();) {
+    // The sums can't overflow within this many bytes.
+    const size_t end = std::min(data.size(), i + 5552);
+    for (; i < end; i++) {
+      a += data[i];
+      b += a;
+    }
+    a %= 65521;
+    b %= 65521;
+  }
+  return (b << 16) | a;
+}
+
+uint32_t Crc32(std::span<const uint8_t> data, uint32_t crc = 0) {
+  static const std::array<uint32_t, 256> kTable = [] {
+    std::array<uint32_t, 256> table;
+    for (uint32_t i = 0; i < 256; i++) {
+      uint32_t value = i;
+      for (int bit = 0; bit < 8; bit++) {
+        value = (value & 1) ? (0xEDB88320u ^ (value >> 1)) : (value >> 1);
+      }
+      table[i] = value;
+    }
+    return table;
+  }();
+
+  crc = ~crc;
+  for (uint8_t byte : data) {
+    crc = kTable[(crc ^ byte) & 0xFF] ^ (crc >> 8);
+  }
+  return ~crc;
+}
+
+void WriteBigEndian(std::vector<uint8_t>& out, uint32_t value) {
+  out.push_back(static_cast<uint8_t>(value >> 24));
+  out.push_back(static_cast<uint8_t>(value >> 16));
+  out.push_back(static_cast<uint8_t>(value >> 8));
+  out.push_back(static_cast<uint8_t>(value));
+}
+
+void WriteChunk(std::vector<uint8_t>& out, const char (&type)[5], std::span<const uint8_t> data) {
+  WriteBigEndian(out, static_cast<uint32_t>(data.size()));
+
+  const size_t typeOffset = out.size();
+  out.insert(out.end(), type, type + 4);
+  out.insert(out.end(), data.begin(), data.end());
+
+  WriteBigEndian(out, Crc32(std::span(out).subspan(typeOffset)));
+}
+
+uint8_t Paeth(int a, int b, int c) {
+  const int p = a + b - c;
+  const int pa = std::abs(p - a), pb = std::abs(p - b), pc = std::abs(p - c);
+  if (pa <= pb && pa <= pc)
+    return static_cast<uint8_t>(a);
+  return static_cast<uint8_t>(pb <= pc ? b : c);
+}
+
+// Filters every row, choosing the filter whose output is closest to zero (the usual heuristic), and puts the
+// filter type before each row.
+std::vector<uint8_t> FilterRows(const SoftwareCanvas& canvas) {
+  constexpr size_t kBytesPerPixel = 4;
+  const size_t stride = size_t(canvas.width()) * kBytesPerPixel;
+
+  std::vector<uint8_t> filtered;
+  filtered.reserve((stride + 1) * size_t(canvas.height()));
+
+  std::vector<uint8_t> candidate(stride);
+  std::vector<uint8_t> best(stride);
+  const std::vector<uint8_t> emptyRow(stride, 0);
+
+  for (int y = 0; y < canvas.height(); y++) {
+    const uint8_t* row = canvas.data() + size_t(y) * stride;
+    const uint8_t* above = (y > 0) ? row - stride : emptyRow.data();
+
+    uint8_t bestFilter = 0;
+    uint64_t bestScore = UINT64_MAX;
+
+    for (uint8_t filter = 0; filter < 5; filter++) {
+      uint64_t score = 0;
+      for (size_t i = 0; i < stride; i++) {
+        const int left = (i >= kBytesPerPixel) ? row[i - kBytesPerPixel] : 0;
+        const int up = above[i];
+        const int upLeft = (i >= kBytesPerPixel) ? above[i - kBytesPerPixel] : 0;
+
+        uint8_t predictor = 0;
+        switch (filter) {
+          case 1:
+            predictor = static_cast<uint8_t>(left);
+            break;
+          case 2:
+            predictor = static_cast<uint8_t>(up);
+            break;
+          case 3:
+            predictor = static_cast<uint8_t>((left + up) / 2);
+            break;
+          case 4:
+            predictor = Paeth(left, up, upLeft);
+            break;
+        }
+
+        candidate[i] = static_cast<uint8_t>(row[i] - predictor);
+        score += static_cast<uint64_t>(std::abs(static_cast<int8_t>(candidate[i])));
+      }
+
+      if (score < bestScore) {
+        bestScore = score;
+        bestFilter = filter;
+        std::swap(best, candidate);
+      }
+    }
+
+    filtered.push_back(bestFilter);
+    filtered.insert(filtered.end(), best.begin(), best.end());
+  }
+
+  return filtered;
+}
+
+}  // namespace
+
+std::vector<uint8_t> EncodePNG(const SoftwareCanvas& canvas) {
+  if (canvas.width() <= 0 || canvas.height() <= 0) {
+    throw InvalidArgumentError::Construct("Can't encode an empty image");
+  }
+
+  std::vector<uint8_t> png = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+
+  std::vector<uint8_t> header;
+  WriteBigEndian(header, static_cast<uint32_t>(canvas.width()));
+  WriteBigEndian(header, static_cast<uint32_t>(canvas.height()));
+  header.push_back(8);  // Bit depth.
+  header.push_back(6);  // RGBA.
+  header.push_back(0);  // Deflate.
+  header.push_back(0);  // Adaptive filtering.
+  header.push_back(0);  // Not interlaced.
+  WriteChunk(png, "IHDR", header);
+
+  const std::vector<uint8_t> filtered = FilterRows(canvas);
+
+  std::vector<uint8_t> compressed = {0x78, 0x01};  // zlib header, 32K window.
+  Deflate(filtered, compressed);
+  WriteBigEndian(compressed, Adler32(filtered));
+  WriteChunk(png, "IDAT", compressed);
+
+  WriteChunk(png, "IEND", {});
+
+  return png;
+}
+
+void WritePNG(const std::filesystem::path& path, const SoftwareCanvas& canvas) {
+  const std::vector<uint8_t> png = EncodePNG(canvas);
+
+  std::ofstream file(path, std::ios::binary);
+  if (!file) {
+    throw RuntimeError::Construct("Failed to open image file '{}' for writing", path.string());
+  }
+
+  file.write(reinterpret_cast<const char*>(png.data()), static_cast<std::streamsize>(png.size()));
+
+  if (!file) {
+    throw RuntimeError::Construct("Failed to write image file '{}'", path.string());
+  }
+}
@@ -0,0 +1,54 @@
+#include <ThunderAuto/Popups/ProjectLoadingPopup.hpp>
+#include <imgui.h>
+#include <imgui_raii.h>
+#include <numbers>
+
+static void DrawSpinner(float radius, float thickness) {
+  ImVec2 cursor = ImGui::GetCursorScreenPos();
+  ImVec2 center = ImVec2(cursor.x + radius, cursor.y + radius);
+
+  ImGui::Dummy(ImVec2(radius * 2.f, radius * 2.f));
+
+  constexpr float kPi = std::numbers::pi_v<float>;
+
+  const float startAngle = static_cast<float>(ImGui::GetTime()) * kPi * 2.f;
+  const float endAngle = startAngle + kPi * 1.5f;
+
+  ImDrawList* drawList = ImGui::GetWindowDrawList();
+  drawList->PathArcTo(center, radius - thickness * 0.5f, startAngle, endAngle, 24);
+  drawList->PathStroke(ImGui::GetColorU32(ImGuiCol_ButtonActive), ImDrawFlags_None, thickness);
+}
+
+void ProjectLoadingPopup::present(bool* running) {
+  ImGui::SetNextWindowPos(ImGui::GetMainViewport()->GetCenter(), false, ImVec2(0.5f, 0.5f));
+  ImGui::SetNextWindowSize(ImVec2(GET_UISIZE(PROJECT_LOADING_POPUP_START_WIDTH), 0.f));
+
+  auto scopedPopup = ImGui::Scoped::PopupModal(name(), nullptr, ImGuiWindowFlags_NoMove);
+  if (!scopedPopup || !*running) {
+    return;
+  }
+
+  m_result = Result::NONE;
+
+  const float spinnerRadius = ImGui::GetTextLineHeight();
+  DrawSpinner(spinnerRadius, GET_UISIZE(LINE_THICKNESS) * 2.f);
+
+  ImGui::SameLine();
+
+  ImGui::SetCursorPosY(ImGui::GetCursorPosY() + spinnerRadius - ImGui::GetTextLineHeight() * 0.5f);
+  ImGui::Text("Opening %s...", m_projectName.c_str());
+
+  ImGui::Spacing();
+
+  ImGui::ProgressBar(m_progress, ImVec2(-FLT_MIN, 0.f), m_stage.c_str());
+
+  ImGui::Spacing();
+
+  if (ImGui::Button("Cancel") || ImGui::IsKeyPressed(ImGuiKey_Escape)) {
+    m_result = Result::CANCEL;
+  }
+
+  if (m_result != Result::NONE) {
+    *running = false;
+  }
+}
@@ -0,0 +1,42 @@
+#include <ThunderAuto/Popups/RecoveredEditsPopup.hpp>
+#include <imgui.h>
+#include <imgui_raii.h>
+
+void RecoveredEditsPopup::present(bool* running) {
+  ImGui::SetNextWindowPos(ImGui::GetMainViewport()->GetCenter(), false, ImVec2(0.5f, 0.5f));
+  ImGui::SetNextWindowSize(ImVec2(GET_UISIZE(RECOVERED_EDITS_POPUP_START_WIDTH), -1.f));
+
+  auto scopedPopup = ImGui::Scoped::PopupModal(name(), nullptr, ImGuiWindowFlags_NoMove);
+  if (!scopedPopup || !*running) {
+    m_result = Result::KEEP;
+    return;
+  }
+
+  m_result = Result::NONE;
+
+  ImGui::TextWrapped(
+      "ThunderAuto did not exit normally the last time this project was open. Unsaved changes from that "
+      "session have been restored.");
+
+  ImGui::Spacing();
+
+  ImGui::TextWrapped("The restored changes can be undone, or discarded to go back to the last saved version.");
+
+  ImGui::Spacing();
+  ImGui::Spacing();
+
+  if (ImGui::Button("Discard Changes")) {
+    m_result = Result::DISCARD;
+  }
+
+  ImGui::SameLine();
+
+  if (ImGui::Button("Keep Changes") || ImGui::IsKeyPressed(ImGuiKey_Escape) ||
+      ImGui::IsKeyPressed(ImGuiKey_Enter)) {
+    m_result = Result::KEEP;
+  }
+
+  if (m_result != Result::NONE) {
+    *running = false;
+  }
+}
@@ -0,0 +1,70 @@
+#include <ThunderAuto/PreviewTrajectoryCache.hpp>
+
+#include <ThunderAuto/ThreadPool.hpp>
+#include <ThunderAuto/Logger.hpp>
+#include <ThunderAuto/Error.hpp>
+#include <chrono>
+
+void PreviewTrajectoryCache::invalidateTrajectory(const std::string& trajectoryName) noexcept {
+  auto it = m_entries.find(trajectoryName);
+  if (it != m_entries.end()) {
+    it->second.generation++;
+  }
+}
+
+void PreviewTrajectoryCache::invalidateAll() noexcept {
+  for (auto& [name, entry] : m_entries) {
+    entry.generation++;
+  }
+}
+
+void PreviewTrajectoryCache::clear() noexcept {
+  // Pending builds are left to finish on their own, since they hold on to everything they use.
+  m_entries.clear();
+}
+
+void PreviewTrajectoryCache::update(const ThunderAutoProjectState& state) {
+  std::erase_if(m_entries, [&](const auto& entry) { return !state.trajectories.contains(entry.first); });
+}
+
+std::optional<std::shared_ptr<const ThunderAutoOutputTrajectory>> PreviewTrajectoryCache::request(
+    const std::string& trajectoryName,
+    const ThunderAutoTrajectorySkeleton& skeleton) {
+  Entry& entry = m_entries[trajectoryName];
+
+  if (entry.pendingTrajectory.valid()) {
+    if (entry.pendingTrajectory.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+      return std::nullopt;
+
+    try {
+      std::unique_ptr<ThunderAutoOutputTrajectory> trajectory = entry.pendingTrajectory.get();
+      ThunderAutoAssert(trajectory != nullptr);
+
+      // Drop the result if the trajectory changed while it was being built.
+      if (entry.pendingGeneration == entry.generation) {
+        entry.trajectory = std::move(trajectory);
+        entry.builtGeneration = entry.generation;
+      }
+
+    } catch (const ThunderError& e) {
+      ThunderAutoLogger::Warn("Failed to build preview of trajectory '{}': {}", trajectoryName, e.message());
+      entry.trajectory.reset();
+      entry.builtGeneration = entry.generation;
+
+    } catch (const std::exception& e) {
+      ThunderAutoLogger::Warn("Failed to build preview of trajectory '{}': {}", trajectoryName, e.what());
+      entry.trajectory.reset();
+      entry.builtGeneration = entry.generation;
+    }
+  }
+
+  if (entry.builtGeneration == entry.generation)
+    return entry.trajectory;
+
+  entry.pendingGeneration = entry.generation;
+  entry.pendingTrajectory = ThreadPool::get().submit([skeleton = skeleton] {
+    return BuildThunderAutoOutputTrajectory(skeleton, kPreviewOutputTrajectorySettings);
+  });
+
+  return std::nullopt;
+}
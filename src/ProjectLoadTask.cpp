@@ -0,0 +1,104 @@
+#include <ThunderAuto/ProjectLoadTask.hpp>
+
+#include <ThunderAuto/Pages/EditorPage.hpp>
+#include <ThunderAuto/Logger.hpp>
+#include <ThunderAuto/Error.hpp>
+#include <chrono>
+
+const char* ProjectLoadTask::StageToString(Stage stage) noexcept {
+  switch (stage) {
+    using enum Stage;
+    case LOADING_PROJECT:
+      return "Loading project";
+    case DECODING_FIELD_IMAGE:
+      return "Decoding field image";
+    case BUILDING_TRAJECTORY:
+      return "Building trajectory";
+    case DONE:
+      return "Done";
+    default:
+      ThunderAutoUnreachable("Unknown project load stage");
+  }
+}
+
+ProjectLoadTask::ProjectLoadTask(std::filesystem::path path)
+  : m_path(std::move(path)),
+    m_sharedState(std::make_shared<SharedState>()),
+    m_future(std::async(std::launch::async, &ProjectLoadTask::Run, m_path, m_sharedState)) {}
+
+float ProjectLoadTask::progress() const noexcept {
+  switch (stage()) {
+    using enum Stage;
+    case LOADING_PROJECT:
+      return 0.f;
+    case DECODING_FIELD_IMAGE:
+      return 0.6f;
+    case BUILDING_TRAJECTORY:
+      return 0.8f;
+    case DONE:
+      return 1.f;
+    default:
+      ThunderAutoUnreachable("Unknown project load stage");
+  }
+}
+
+bool ProjectLoadTask::isFinished() const {
+  ThunderAutoAssert(m_future.valid(), "Project load task result was already taken");
+
+  return m_future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+ProjectLoadTask::Result ProjectLoadTask::takeResult() {
+  ThunderAutoAssert(m_future.valid(), "Project load task result was already taken");
+
+  return m_future.get();
+}
+
+ProjectLoadTask::Result ProjectLoadTask::Run(std::filesystem::path path,
+                                             std::shared_ptr<SharedState> sharedState) {
+  Result result;
+
+  auto advanceStage = [&](Stage stage) -> bool {
+    sharedState->stage = stage;
+    if (sharedState->cancelled) {
+      ThunderAutoLogger::Info("Cancelled loading project: {}", path.string());
+      result.cancelled = true;
+      return false;
+    }
+    return true;
+  };
+
+  try {
+    result.loadedProject = DocumentManager::LoadProject(path);
+
+    if (!advanceStage(Stage::DECODING_FIELD_IMAGE))
+      return result;
+
+    const ThunderAutoProjectSettings& settings = result.loadedProject.settings;
+    result.fieldImage = EditorPage::DecodeFieldImage(settings.fieldImage);
+
+    if (!advanceStage(Stage::BUILDING_TRAJECTORY))
+      return result;
+
+    // Recovered edits become the current state once the project is opened, so build from them if there are
+    // any.
+    const DocumentManager::LoadedProject& loadedProject = result.loadedProject;
+    const ThunderAutoProjectState& state =
+        loadedProject.recoveredState ? *loadedProject.recoveredState : loadedProject.state;
+    if (state.editorState.view == ThunderAutoEditorState::View::TRAJECTORY &&
+        !state.editorState.trajectoryEditorState.currentTrajectoryName.empty()) {
+      result.firstTrajectory = EditorPage::BuildPreviewTrajectory(state.currentTrajectory());
+    }
+
+    advanceStage(Stage::DONE);
+
+  } catch (const ThunderError& e) {
+    result.error = e.message();
+  } catch (const std::exception& e) {
+    result.error = e.what();
+  } catch (...) {
+    result.error = "Unknown error ocurred";
+  }
+
+  return result;
+}
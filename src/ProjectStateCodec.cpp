@@ -0,0 +1,66 @@
+#include <ThunderAuto/ProjectStateCodec.hpp>
+
+#include <ThunderAuto/Error.hpp>
+#include <array>
+
+wpi::json ProjectStateToJson(const ThunderAutoProjectState& state) {
+  return wpi::json(state);
+}
+
+ThunderAutoProjectState ProjectStateFromJson(const wpi::json& json) {
+  return json.get<ThunderAutoProjectState>();
+}
+
+std::vector<uint8_t> EncodeProjectJson(const wpi::json& json) {
+  return wpi::json::to_msgpack(json);
+}
+
+wpi::json DecodeProjectJson(std::span<const uint8_t> data) {
+  try {
+    return wpi::json::from_msgpack(data.begin(), data.end());
+  } catch (const wpi::json::exception& e) {
+    throw RuntimeError::Construct("Failed to decode project data: {}", e.what());
+  }
+}
+
+wpi::json DiffProjectJson(const wpi::json& from, const wpi::json& to) {
+  return wpi::json::diff(from, to);
+}
+
+wpi::json PatchProjectJson(const wpi::json& json, const wpi::json& patch) {
+  try {
+    return json.patch(patch);
+  } catch (const wpi::json::exception& e) {
+    throw RuntimeError::Construct("Failed to apply project delta: {}", e.what());
+  }
+}
+
+void PatchProjectJsonInPlace(wpi::json& json, const wpi::json& patch) {
+  try {
+    json.patch_inplace(patch);
+  } catch (const wpi::json::exception& e) {
+    throw RuntimeError::Construct("Failed to apply project delta: {}", e.what());
+  }
+}
+
+static constexpr std::array<uint32_t, 256> MakeCRC32Table() {
+  std::array<uint32_t, 256> table{};
+  for (uint32_t i = 0; i < table.size(); i++) {
+    uint32_t value = i;
+    for (int bit = 0; bit < 8; bit++) {
+      value = (value & 1) ? (0xEDB88320u ^ (value >> 1)) : (value >> 1);
+    }
+    table[i] = value;
+  }
+  return table;
+}
+
+static constexpr std::array<uint32_t, 256> kCRC32Table = MakeCRC32Table();
+
+uint32_t ComputeCRC32(std::span<const uint8_t> data, uint32_t crc) {
+  crc = ~crc;
+  for (uint8_t byte : data) {
+    crc = kCRC32Table[(crc ^ byte) & 0xFF] ^ (crc >> 8);
+  }
+  return ~crc;
+}
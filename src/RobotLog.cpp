@@ -0,0 +1,382 @@
+#include <ThunderAuto/RobotLog.hpp>
+
+#include <ThunderAuto/Error.hpp>
+#include <ThunderAuto/Logger.hpp>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <optional>
+#include <unordered_map>
+
+//
+// WPILib data log layout (see wpiutil's datalog.adoc):
+//
+//   header:  "WPILOG" magic, u16 version, u32 extra header length, extra header
+//   records: u8 field lengths, entry ID (1-4 bytes), payload size (1-4 bytes), timestamp in microseconds
+//            (1-8 bytes), payload
+//
+// The field lengths byte holds (length - 1) of the entry ID in bits 0-1, of the payload size in bits 2-3, and
+// of the timestamp in bits 4-6. Records for entry 0 are control records that start and finish entries. All
+// integers are little endian.
+//
+
+static constexpr std::array<uint8_t, 6> kWPILogMagic = {'W', 'P', 'I', 'L', 'O', 'G'};
+static constexpr size_t kWPILogHeaderSize = 12;
+
+static constexpr uint8_t kWPILogControlStart = 0;
+static constexpr uint8_t kWPILogControlFinish = 1;
+
+static constexpr std::string_view kPose2dStructType = "struct:Pose2d";
+static constexpr std::string_view kDoubleArrayType = "double[]";
+
+struct WPILogRecord {
+  uint32_t entryID;
+  uint64_t timestamp;
+  std::span<const uint8_t> payload;
+  size_t size;  // Including the header.
+};
+
+static uint64_t ReadLE(const uint8_t* data, size_t numBytes) {
+  uint64_t value = 0;
+  for (size_t i = 0; i < numBytes; i++) {
+    value |= static_cast<uint64_t>(data[i]) << (i * 8);
+  }
+  return value;
+}
+
+static double ReadDoubleLE(const uint8_t* data) {
+  return std::bit_cast<double>(ReadLE(data, sizeof(double)));
+}
+
+static std::optional<WPILogRecord> ParseWPILogRecord(std::span<const uint8_t> data, size_t offset) {
+  if (offset >= data.size())
+    return std::nullopt;
+
+  const uint8_t fieldLengths = data[offset];
+  const size_t entryIDSize = (fieldLengths & 0x3) + 1;
+  const size_t payloadSizeSize = ((fieldLengths >> 2) & 0x3) + 1;
+  const size_t timestampSize = ((fieldLengths >> 4) & 0x7) + 1;
+
+  const size_t headerSize = 1 + entryIDSize + payloadSizeSize + timestampSize;
+  if (data.size() - offset < headerSize)
+    return std::nullopt;
+
+  const uint8_t* p = data.data() + offset + 1;
+
+  WPILogRecord record;
+  record.entryID = static_cast<uint32_t>(ReadLE(p, entryIDSize));
+  p += entryIDSize;
+  const size_t payloadSize = static_cast<size_t>(ReadLE(p, payloadSizeSize));
+  p += payloadSizeSize;
+  record.timestamp = ReadLE(p, timestampSize);
+
+  if (data.size() - offset - headerSize < payloadSize)
+    return std::nullopt;
+
+  record.payload = data.subspan(offset + headerSize, payloadSize);
+  record.size = headerSize + payloadSize;
+  return record;
+}
+
+// Reads a u32 length-prefixed string from a control record.
+static bool ReadWPILogString(std::span<const uint8_t> payload, size_t& position, std::string_view& str) {
+  if (payload.size() - position < 4)
+    return false;
+
+  const size_t length = static_cast<size_t>(ReadLE(payload.data() + position, 4));
+  position += 4;
+
+  if (payload.size() - position < length)
+    return false;
+
+  str = std::string_view(reinterpret_cast<const char*>(payload.data() + position), length);
+  position += length;
+  return true;
+}
+
+static bool IsPoseType(std::string_view type) {
+  return type == kPose2dStructType || type == kDoubleArrayType;
+}
+
+static bool IsCSVPadding(char c) {
+  return std::isspace(static_cast<unsigned char>(c)) || c == '"';
+}
+
+static std::string_view TrimCSVField(std::string_view field) {
+  while (!field.empty() && IsCSVPadding(field.front())) {
+    field.remove_prefix(1);
+  }
+  while (!field.empty() && IsCSVPadding(field.back())) {
+    field.remove_suffix(1);
+  }
+  return field;
+}
+
+// Splits a CSV line into fields. Quoted commas aren't supported, pose logs shouldn't have any.
+static std::vector<std::string_view> SplitCSVLine(std::string_view line) {
+  std::vector<std::string_view> fields;
+  while (true) {
+    size_t comma = line.find(',');
+    fields.push_back(TrimCSVField(line.substr(0, comma)));
+    if (comma == std::string_view::npos)
+      break;
+    line.remove_prefix(comma + 1);
+  }
+  return fields;
+}
+
+RobotLog::RobotLog(const std::filesystem::path& path) : m_file(path) {
+  std::string extension = path.extension().string();
+  std::ranges::transform(extension, extension.begin(), [](unsigned char c) { return std::tolower(c); });
+
+  if (extension == ".wpilog") {
+    m_format = Format::WPILOG;
+    indexWPILog();
+  } else if (extension == ".csv") {
+    m_format = Format::CSV;
+    indexCSV(path);
+  } else {
+    throw RuntimeError::Construct("Unsupported robot log file type '{}'", extension);
+  }
+
+  ThunderAutoLogger::Info("Indexed robot log '{}', found {} pose entries", path.string(), m_entries.size());
+}
+
+std::vector<RobotLog::PoseSample> RobotLog::readPoses(size_t entryIndex) const {
+  const Entry& entry = m_entries.at(entryIndex);
+
+  std::vector<PoseSample> samples;
+  samples.reserve(entry.recordOffsets.size());
+
+  for (uint64_t offset : entry.recordOffsets) {
+    PoseSample sample;
+
+    bool ok = false;
+    switch (m_format) {
+      using enum Format;
+      case WPILOG:
+        ok = readWPILogPose(entry, offset, sample);
+        break;
+      case CSV:
+        ok = readCSVPose(offset, sample);
+        break;
+      default:
+        ThunderAutoUnreachable("Unknown robot log format");
+    }
+
+    if (ok) {
+      samples.push_back(sample);
+    }
+  }
+
+  // Records are almost always logged in order, but nothing guarantees it.
+  if (!std::ranges::is_sorted(samples, {}, &PoseSample::time)) {
+    std::ranges::stable_sort(samples, {}, &PoseSample::time);
+  }
+
+  return samples;
+}
+
+void RobotLog::indexWPILog() {
+  std::span<const uint8_t> data = m_file.data();
+
+  if (data.size() < kWPILogHeaderSize ||
+      !std::equal(kWPILogMagic.begin(), kWPILogMagic.end(), data.begin())) {
+    throw RuntimeError::Construct("Not a WPILib data log");
+  }
+
+  const uint16_t version = static_cast<uint16_t>(ReadLE(data.data() + 6, 2));
+  if ((version >> 8) != 1) {
+    throw RuntimeError::Construct("Unsupported WPILib data log version {}.{}", version >> 8, version & 0xFF);
+  }
+
+  const size_t extraHeaderSize = static_cast<size_t>(ReadLE(data.data() + 8, 4));
+  if (data.size() - kWPILogHeaderSize < extraHeaderSize) {
+    throw RuntimeError::Construct("WPILib data log header is cut off");
+  }
+
+  size_t offset = kWPILogHeaderSize + extraHeaderSize;
+
+  // Entry IDs of the pose entries that are currently started, and where they are in m_entries.
+  std::unordered_map<uint32_t, size_t> activeEntries;
+
+  while (std::optional<WPILogRecord> record = ParseWPILogRecord(data, offset)) {
+    const uint64_t recordOffset = offset;
+    offset += record->size;
+
+    if (record->entryID != 0) {
+      auto entryIt = activeEntries.find(record->entryID);
+      if (entryIt != activeEntries.end()) {
+        m_entries[entryIt->second].recordOffsets.push_back(recordOffset);
+      }
+      continue;
+    }
+
+    // Control record.
+
+    std::span<const uint8_t> payload = record->payload;
+    if (payload.size() < 5)
+      continue;
+
+    const uint8_t controlType = payload[0];
+    const uint32_t entryID = static_cast<uint32_t>(ReadLE(payload.data() + 1, 4));
+
+    if (controlType == kWPILogControlStart) {
+      size_t position = 5;
+      std::string_view name, type;
+      if (!ReadWPILogString(payload, position, name) || !ReadWPILogString(payload, position, type))
+        continue;
+
+      if (!IsPoseType(type))
+        continue;
+
+      // An entry that is started again after being finished keeps adding to the same list.
+      auto existingIt = std::ranges::find_if(
+          m_entries, [&](const Entry& entry) { return entry.name == name && entry.type == type; });
+
+      if (existingIt != m_entries.end()) {
+        activeEntries[entryID] = static_cast<size_t>(std::distance(m_entries.begin(), existingIt));
+      } else {
+        activeEntries[entryID] = m_entries.size();
+        m_entries.push_back(Entry{.name = std::string(name), .type = std::string(type)});
+      }
+
+    } else if (controlType == kWPILogControlFinish) {
+      activeEntries.erase(entryID);
+    }
+  }
+
+  if (offset != data.size()) {
+    ThunderAutoLogger::Warn("Robot log ends with an incomplete record, ignoring the last {} bytes",
+                            data.size() - offset);
+  }
+
+  std::erase_if(m_entries, [](const Entry& entry) { return entry.recordOffsets.empty(); });
+}
+
+void RobotLog::indexCSV(const std::filesystem::path& path) {
+  std::span<const uint8_t> data = m_file.data();
+  const std::string_view text(reinterpret_cast<const char*>(data.data()), data.size());
+
+  Entry entry{.name = path.stem().string(), .type = "csv"};
+
+  bool foundHeader = false;
+  size_t lineStart = 0;
+  while (lineStart < text.size()) {
+    size_t lineEnd = text.find('\n', lineStart);
+    if (lineEnd == std::string_view::npos) {
+      lineEnd = text.size();
+    }
+
+    const std::string_view line = TrimCSVField(text.substr(lineStart, lineEnd - lineStart));
+
+    if (!line.empty()) {
+      if (foundHeader) {
+        entry.recordOffsets.push_back(lineStart);
+
+      } else {
+        std::optional<size_t> timeColumn, xColumn, yColumn, rotationColumn;
+
+        const std::vector<std::string_view> fields = SplitCSVLine(line);
+        for (size_t i = 0; i < fields.size(); i++) {
+          std::string field(fields[i]);
+          std::ranges::transform(field, field.begin(), [](unsigned char c) { return std::tolower(c); });
+
+          if (field == "time" || field == "timestamp") {
+            timeColumn = i;
+          } else if (field == "x") {
+            xColumn = i;
+          } else if (field == "y") {
+            yColumn = i;
+          } else if (field == "rotation" || field == "heading" || field == "theta") {
+            rotationColumn = i;
+          }
+        }
+
+        if (!timeColumn || !xColumn || !yColumn || !rotationColumn) {
+          throw RuntimeError::Construct("CSV robot log needs 'time', 'x', 'y', and 'rotation' columns");
+        }
+
+        m_csvTimeColumn = *timeColumn;
+        m_csvXColumn = *xColumn;
+        m_csvYColumn = *yColumn;
+        m_csvRotationColumn = *rotationColumn;
+        foundHeader = true;
+      }
+    }
+
+    lineStart = lineEnd + 1;
+  }
+
+  if (!foundHeader) {
+    throw RuntimeError::Construct("CSV robot log is empty");
+  }
+
+  if (!entry.recordOffsets.empty()) {
+    m_entries.push_back(std::move(entry));
+  }
+}
+
+bool RobotLog::readWPILogPose(const Entry& entry, uint64_t recordOffset, PoseSample& sample) const {
+  std::optional<WPILogRecord> record = ParseWPILogRecord(m_file.data(), static_cast<size_t>(recordOffset));
+  if (!record)
+    return false;
+
+  std::span<const uint8_t> payload = record->payload;
+
+  // Both types start with x and y in meters.
+  if (payload.size() < sizeof(double) * 3)
+    return false;
+
+  const double x = ReadDoubleLE(payload.data());
+  const double y = ReadDoubleLE(payload.data() + sizeof(double));
+  const double rotation = ReadDoubleLE(payload.data() + sizeof(double) * 2);
+
+  sample.time = units::microsecond_t(static_cast<double>(record->timestamp));
+  sample.position = Point2d(units::meter_t(x), units::meter_t(y));
+
+  if (entry.type == kPose2dStructType) {
+    sample.rotation = CanonicalAngle(units::radian_t(rotation));
+  } else {
+    sample.rotation = CanonicalAngle(units::degree_t(rotation));
+  }
+
+  return true;
+}
+
+bool RobotLog::readCSVPose(uint64_t lineOffset, PoseSample& sample) const {
+  std::span<const uint8_t> data = m_file.data();
+  const std::string_view text(reinterpret_cast<const char*>(data.data()), data.size());
+
+  std::string_view line = text.substr(static_cast<size_t>(lineOffset));
+  line = line.substr(0, line.find('\n'));
+
+  const std::vector<std::string_view> fields = SplitCSVLine(TrimCSVField(line));
+
+  auto parseField = [&](size_t column, double& value) {
+    if (column >= fields.size())
+      return false;
+
+    // std::from_chars for doubles isn't available in the libc++ versions that macOS builds target, so parse a
+    // null-terminated copy with strtod instead.
+    const std::string field(fields[column]);
+    char* end = nullptr;
+    errno = 0;
+    value = std::strtod(field.c_str(), &end);
+    return end != field.c_str() && errno != ERANGE;
+  };
+
+  double time, x, y, rotation;
+  if (!parseField(m_csvTimeColumn, time) || !parseField(m_csvXColumn, x) || !parseField(m_csvYColumn, y) ||
+      !parseField(m_csvRotationColumn, rotation)) {
+    return false;
+  }
+
+  sample.time = units::second_t(time);
+  sample.position = Point2d(units::meter_t(x), units::meter_t(y));
+  sample.rotation = CanonicalAngle(units::degree_t(rotation));
+  return true;
+}
@@ -0,0 +1,93 @@
+#include <ThunderAuto/RobotLogReplay.hpp>
+
+#include <ThunderLibCore/Math.hpp>
+#include <algorithm>
+#include <cmath>
+
+// Positions closer than this to the last kept one are dropped from the drawn path.
+static constexpr double kPathDecimationDistance = 0.02;  // m
+
+void RobotLogReplay::open(const std::filesystem::path& path) {
+  auto log = std::make_unique<RobotLog>(path);
+
+  m_path = path;
+  m_log = std::move(log);
+  visible = true;
+
+  selectEntry(0);
+}
+
+void RobotLogReplay::close() noexcept {
+  m_path.clear();
+  m_log.reset();
+  m_entryIndex = 0;
+  m_samples.clear();
+  m_decimatedPath.clear();
+  m_startTime = units::second_t(0.0);
+}
+
+void RobotLogReplay::selectEntry(size_t entryIndex) {
+  m_samples.clear();
+  m_decimatedPath.clear();
+  m_entryIndex = entryIndex;
+
+  if (!m_log || entryIndex >= m_log->poseEntries().size())
+    return;
+
+  m_samples = m_log->readPoses(entryIndex);
+
+  bool droppedLastSample = false;
+  for (const RobotLog::PoseSample& sample : m_samples) {
+    if (!m_decimatedPath.empty()) {
+      const Point2d& last = m_decimatedPath.back();
+      const double dx = (sample.position.x - last.x).value();
+      const double dy = (sample.position.y - last.y).value();
+
+      droppedLastSample = std::hypot(dx, dy) < kPathDecimationDistance;
+      if (droppedLastSample)
+        continue;
+    }
+    m_decimatedPath.push_back(sample.position);
+  }
+
+  // Always end where the robot ended.
+  if (droppedLastSample) {
+    m_decimatedPath.push_back(m_samples.back().position);
+  }
+
+  m_startTime = logStartTime();
+}
+
+units::second_t RobotLogReplay::logStartTime() const noexcept {
+  return m_samples.empty() ? units::second_t(0.0) : m_samples.front().time;
+}
+
+units::second_t RobotLogReplay::logEndTime() const noexcept {
+  return m_samples.empty() ? units::second_t(0.0) : m_samples.back().time;
+}
+
+std::optional<RobotLog::PoseSample> RobotLogReplay::sample(units::second_t playbackTime) const {
+  if (m_samples.empty())
+    return std::nullopt;
+
+  const units::second_t time = m_startTime + playbackTime;
+  if (time < m_samples.front().time || time > m_samples.back().time)
+    return std::nullopt;
+
+  auto upperIt = std::ranges::lower_bound(m_samples, time, {}, &RobotLog::PoseSample::time);
+  if (upperIt == m_samples.begin())
+    return *upperIt;
+
+  const RobotLog::PoseSample& lower = *std::prev(upperIt);
+  const RobotLog::PoseSample& upper = *upperIt;
+
+  const units::second_t dt = upper.time - lower.time;
+  const double t = dt > units::second_t(0.0) ? ((time - lower.time) / dt).value() : 0.0;
+
+  return RobotLog::PoseSample{
+      .time = time,
+      .position = Point2d(Lerp(lower.position.x, upper.position.x, t),
+                          Lerp(lower.position.y, upper.position.y, t)),
+      .rotation = Lerp(lower.rotation, upper.rotation, t),
+  };
+}
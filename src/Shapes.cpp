@@ -1,4 +1,5 @@
 #include <ThunderAuto/Shapes.hpp>
+#include <ThunderAuto/Error.hpp>
 #include <gcem.hpp>
 #include <algorithm>
 #include <numbers>
@@ -77,3 +78,49 @@ void RotatePolygon(TPolyline& points, CanonicalAngle angle) {
 void TranslatePolygon(TPolyline& points, Displacement2d displacement) {
   std::for_each(points.begin(), points.end(), [&displacement](Point2d& point) { point += displacement; });
 }
+
+PolygonSoA PolylineToSoA(const TPolyline& polyline) {
+  PolygonSoA polygon;
+  polygon.x.reserve(polyline.size());
+  polygon.y.reserve(polyline.size());
+
+  for (const Point2d& point : polyline) {
+    polygon.x.push_back(static_cast<float>(point.x.value()));
+    polygon.y.push_back(static_cast<float>(point.y.value()));
+  }
+
+  return polygon;
+}
+
+PolygonTransform PolygonTransform::FromPose(const Point2d& position, const CanonicalAngle& rotation) {
+  return PolygonTransform{
+      .x = static_cast<float>(position.x.value()),
+      .y = static_cast<float>(position.y.value()),
+      .cos = static_cast<float>(rotation.cos()),
+      .sin = static_cast<float>(rotation.sin()),
+  };
+}
+
+void TransformPolygonBatch(const PolygonSoA& polygon,
+                           std::span<const PolygonTransform> transforms,
+                           std::span<float> outX,
+                           std::span<float> outY) {
+  const size_t numVertices = polygon.size();
+  ThunderAutoAssert(outX.size() >= transforms.size() * numVertices);
+  ThunderAutoAssert(outY.size() >= transforms.size() * numVertices);
+
+  const float* vertexX = polygon.x.data();
+  const float* vertexY = polygon.y.data();
+
+  for (size_t i = 0; i < transforms.size(); i++) {
+    const PolygonTransform transform = transforms[i];
+
+    float* destX = outX.data() + i * numVertices;
+    float* destY = outY.data() + i * numVertices;
+
+    for (size_t j = 0; j < numVertices; j++) {
+      destX[j] = transform.x + vertexX[j] * transform.cos - vertexY[j] * transform.sin;
+      destY[j] = transform.y + vertexX[j] * transform.sin + vertexY[j] * transform.cos;
+    }
+  }
+}
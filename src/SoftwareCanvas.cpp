@@ -0,0 +1,267 @@
+#include <ThunderAuto/SoftwareCanvas.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+static float ColorChannel(ImU32 color, int shift) noexcept {
+  return static_cast<float>((color >> shift) & 0xFF) / 255.f;
+}
+
+// Distance from a point to the segment between a and b.
+static float DistanceToSegment(ImVec2 point, ImVec2 a, ImVec2 b) noexcept {
+  const ImVec2 ab(b.x - a.x, b.y - a.y);
+  const ImVec2 ap(point.x - a.x, point.y - a.y);
+
+  const float lengthSquared = ab.x * ab.x + ab.y * ab.y;
+  float t = 0.f;
+  if (lengthSquared > 0.f) {
+    t = std::clamp((ap.x * ab.x + ap.y * ab.y) / lengthSquared, 0.f, 1.f);
+  }
+
+  const float dx = ap.x - ab.x * t;
+  const float dy = ap.y - ab.y * t;
+  return std::sqrt(dx * dx + dy * dy);
+}
+
+SoftwareCanvas::SoftwareCanvas(int width, int height) {
+  resize(width, height);
+}
+
+void SoftwareCanvas::resize(int width, int height) {
+  width = std::max(width, 0);
+  height = std::max(height, 0);
+
+  if (width == m_width && height == m_height)
+    return;
+
+  std::vector<uint8_t> pixels(size_t(width) * size_t(height) * 4, 0);
+
+  const int keptWidth = std::min(width, m_width);
+  const int keptHeight = std::min(height, m_height);
+  for (int y = 0; y < keptHeight; y++) {
+    std::memcpy(&pixels[size_t(y) * size_t(width) * 4], &m_pixels[size_t(y) * size_t(m_width) * 4],
+                size_t(keptWidth) * 4);
+  }
+
+  m_width = width;
+  m_height = height;
+  m_pixels = std::move(pixels);
+}
+
+void SoftwareCanvas::clear(ImU32 color) noexcept {
+  fillRect(0, 0, m_width, m_height, color);
+}
+
+void SoftwareCanvas::fillRect(int x, int y, int width, int height, ImU32 color) noexcept {
+  const int minX = std::max(x, 0), maxX = std::min(x + width, m_width);
+  const int minY = std::max(y, 0), maxY = std::min(y + height, m_height);
+
+  const uint8_t rgba[4] = {
+      uint8_t(color >> IM_COL32_R_SHIFT),
+      uint8_t(color >> IM_COL32_G_SHIFT),
+      uint8_t(color >> IM_COL32_B_SHIFT),
+      uint8_t(color >> IM_COL32_A_SHIFT),
+  };
+
+  for (int py = minY; py < maxY; py++) {
+    uint8_t* pixel = &m_pixels[(size_t(py) * size_t(m_width) + size_t(minX)) * 4];
+    for (int px = minX; px < maxX; px++, pixel += 4) {
+      std::memcpy(pixel, rgba, 4);
+    }
+  }
+}
+
+void SoftwareCanvas::drawLine(ImVec2 a, ImVec2 b, ImU32 color, float thickness) noexcept {
+  const float halfThickness = thickness / 2.f;
+
+  // Pixels within half a pixel of the line's edge are partially covered.
+  const float reach = halfThickness + 0.5f;
+  const int minX = std::max(static_cast<int>(std::floor(std::min(a.x, b.x) - reach)), 0);
+  const int maxX = std::min(static_cast<int>(std::ceil(std::max(a.x, b.x) + reach)), m_width);
+  const int minY = std::max(static_cast<int>(std::floor(std::min(a.y, b.y) - reach)), 0);
+  const int maxY = std::min(static_cast<int>(std::ceil(std::max(a.y, b.y) + reach)), m_height);
+
+  for (int y = minY; y < maxY; y++) {
+    for (int x = minX; x < maxX; x++) {
+      const ImVec2 pixelCenter(static_cast<float>(x) + 0.5f, static_cast<float>(y) + 0.5f);
+      const float coverage = std::clamp(reach - DistanceToSegment(pixelCenter, a, b), 0.f, 1.f);
+      if (coverage > 0.f) {
+        blendPixel(x, y, color, coverage);
+      }
+    }
+  }
+}
+
+void SoftwareCanvas::drawPolyline(std::span<const ImVec2> points,
+                                  ImU32 color,
+                                  float thickness,
+                                  bool closed) noexcept {
+  for (size_t i = 0; i + 1 < points.size(); i++) {
+    drawLine(points[i], points[i + 1], color, thickness);
+  }
+  if (closed && points.size() > 2) {
+    drawLine(points.back(), points.front(), color, thickness);
+  }
+}
+
+void SoftwareCanvas::fillCircle(ImVec2 center, float radius, ImU32 color) noexcept {
+  // A circle is a line with no length.
+  drawLine(center, center, color, radius * 2.f);
+}
+
+void SoftwareCanvas::fillConvexPolygon(std::span<const ImVec2> points, ImU32 color) noexcept {
+  if (points.size() < 3)
+    return;
+
+  // Twice the signed area, to find which way around the vertices go.
+  float area = 0.f;
+  float minX = points[0].x, maxX = points[0].x;
+  float minY = points[0].y, maxY = points[0].y;
+  for (size_t i = 0; i < points.size(); i++) {
+    const ImVec2& a = points[i];
+    const ImVec2& b = points[(i + 1) % points.size()];
+    area += a.x * b.y - b.x * a.y;
+
+    minX = std::min(minX, a.x), maxX = std::max(maxX, a.x);
+    minY = std::min(minY, a.y), maxY = std::max(maxY, a.y);
+  }
+  if (area == 0.f)
+    return;
+
+  const float direction = area > 0.f ? 1.f : -1.f;
+
+  // Each edge as a line, with a normal pointing into the polygon.
+  struct EdgeLine {
+    float nx, ny, offset;
+  };
+  std::vector<EdgeLine> edges;
+  edges.reserve(points.size());
+  for (size_t i = 0; i < points.size(); i++) {
+    const ImVec2& a = points[i];
+    const ImVec2& b = points[(i + 1) % points.size()];
+
+    const float length = std::sqrt((b.x - a.x) * (b.x - a.x) + (b.y - a.y) * (b.y - a.y));
+    if (length <= 0.f)
+      continue;
+
+    const float nx = -(b.y - a.y) / length * direction;
+    const float ny = (b.x - a.x) / length * direction;
+    edges.push_back(EdgeLine{nx, ny, -(nx * a.x + ny * a.y)});
+  }
+
+  const int pixelMinX = std::max(static_cast<int>(std::floor(minX - 0.5f)), 0);
+  const int pixelMaxX = std::min(static_cast<int>(std::ceil(maxX + 0.5f)), m_width);
+  const int pixelMinY = std::max(static_cast<int>(std::floor(minY - 0.5f)), 0);
+  const int pixelMaxY = std::min(static_cast<int>(std::ceil(maxY + 0.5f)), m_height);
+
+  for (int y = pixelMinY; y < pixelMaxY; y++) {
+    for (int x = pixelMinX; x < pixelMaxX; x++) {
+      const float px = static_cast<float>(x) + 0.5f;
+      const float py = static_cast<float>(y) + 0.5f;
+
+      // The distance inside the nearest edge.
+      float distance = std::numeric_limits<float>::max();
+      for (const EdgeLine& edge : edges) {
+        distance = std::min(distance, edge.nx * px + edge.ny * py + edge.offset);
+      }
+
+      const float coverage = std::clamp(distance + 0.5f, 0.f, 1.f);
+      if (coverage > 0.f) {
+        blendPixel(x, y, color, coverage);
+      }
+    }
+  }
+}
+
+void SoftwareCanvas::drawImage(const uint8_t* pixels,
+                               int width,
+                               int height,
+                               int numChannels,
+                               ImVec2 min,
+                               ImVec2 max) noexcept {
+  if (!pixels || width <= 0 || height <= 0 || numChannels < 1 || numChannels > 4)
+    return;
+  if (max.x <= min.x || max.y <= min.y)
+    return;
+
+  const int pixelMinX = std::max(static_cast<int>(std::floor(min.x)), 0);
+  const int pixelMaxX = std::min(static_cast<int>(std::ceil(max.x)), m_width);
+  const int pixelMinY = std::max(static_cast<int>(std::floor(min.y)), 0);
+  const int pixelMaxY = std::min(static_cast<int>(std::ceil(max.y)), m_height);
+
+  const float scaleX = static_cast<float>(width) / (max.x - min.x);
+  const float scaleY = static_cast<float>(height) / (max.y - min.y);
+
+  auto channel = [&](int x, int y, int c) -> float {
+    const uint8_t* pixel = &pixels[(size_t(y) * size_t(width) + size_t(x)) * size_t(numChannels)];
+    if (numChannels <= 2) {
+      // Gray, and maybe alpha.
+      return (c < 3) ? pixel[0] : (numChannels == 2 ? pixel[1] : 255.f);
+    }
+    return (c < numChannels) ? pixel[c] : 255.f;
+  };
+
+  for (int y = pixelMinY; y < pixelMaxY; y++) {
+    // Bilinear sampling, between the centers of the four nearest source pixels.
+    const float sy = std::clamp((static_cast<float>(y) + 0.5f - min.y) * scaleY - 0.5f, 0.f,
+                                static_cast<float>(height - 1));
+    const int y0 = static_cast<int>(sy);
+    const int y1 = std::min(y0 + 1, height - 1);
+    const float ty = sy - static_cast<float>(y0);
+
+    for (int x = pixelMinX; x < pixelMaxX; x++) {
+      const float sx = std::clamp((static_cast<float>(x) + 0.5f - min.x) * scaleX - 0.5f, 0.f,
+                                  static_cast<float>(width - 1));
+      const int x0 = static_cast<int>(sx);
+      const int x1 = std::min(x0 + 1, width - 1);
+      const float tx = sx - static_cast<float>(x0);
+
+      uint8_t rgba[4];
+      for (int c = 0; c < 4; c++) {
+        const float top = channel(x0, y0, c) * (1.f - tx) + channel(x1, y0, c) * tx;
+        const float bottom = channel(x0, y1, c) * (1.f - tx) + channel(x1, y1, c) * tx;
+        rgba[c] = static_cast<uint8_t>(std::lround(top * (1.f - ty) + bottom * ty));
+      }
+
+      blendPixel(x, y, IM_COL32(rgba[0], rgba[1], rgba[2], rgba[3]), 1.f);
+    }
+  }
+}
+
+void SoftwareCanvas::copyFrom(const SoftwareCanvas& source, int x, int y) noexcept {
+  const int minX = std::max(x, 0), maxX = std::min(x + source.m_width, m_width);
+  const int minY = std::max(y, 0), maxY = std::min(y + source.m_height, m_height);
+  if (minX >= maxX)
+    return;
+
+  for (int py = minY; py < maxY; py++) {
+    const size_t sourceOffset = (size_t(py - y) * size_t(source.m_width) + size_t(minX - x)) * 4;
+    const size_t offset = (size_t(py) * size_t(m_width) + size_t(minX)) * 4;
+    std::memcpy(&m_pixels[offset], &source.m_pixels[sourceOffset], size_t(maxX - minX) * 4);
+  }
+}
+
+void SoftwareCanvas::blendPixel(int x, int y, ImU32 color, float coverage) noexcept {
+  uint8_t* pixel = &m_pixels[(size_t(y) * size_t(m_width) + size_t(x)) * 4];
+
+  const float srcA = ColorChannel(color, IM_COL32_A_SHIFT) * coverage;
+  const float dstA = static_cast<float>(pixel[3]) / 255.f;
+  const float outA = srcA + dstA * (1.f - srcA);
+  if (outA <= 0.f)
+    return;
+
+  // Pixels aren't premultiplied, so the destination color is weighted by its own alpha.
+  auto blend = [&](uint8_t dst, int shift) {
+    const float src = ColorChannel(color, shift);
+    const float out = (src * srcA + (static_cast<float>(dst) / 255.f) * dstA * (1.f - srcA)) / outA;
+    return static_cast<uint8_t>(std::lround(std::clamp(out, 0.f, 1.f) * 255.f));
+  };
+
+  pixel[0] = blend(pixel[0], IM_COL32_R_SHIFT);
+  pixel[1] = blend(pixel[1], IM_COL32_G_SHIFT);
+  pixel[2] = blend(pixel[2], IM_COL32_B_SHIFT);
+  pixel[3] = static_cast<uint8_t>(std::lround(outA * 255.f));
+}
@@ -0,0 +1,418 @@
+#include <ThunderAuto/SpeedConstraintTuner.hpp>
+
+#include <ThunderAuto/ThreadPool.hpp>
+#include <ThunderAuto/Logger.hpp>
+#include <ThunderAuto/Error.hpp>
+#include <ThunderLibCore/Auto/ThunderAutoOutputTrajectory.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <iterator>
+#include <random>
+#include <span>
+
+using Candidate = SpeedConstraintTuner::Candidate;
+
+namespace {
+
+// Lowest speed constraints the tuner will pick, the same as the lowest allowed in the properties page.
+constexpr double kMinLinearVelocity = 0.1;          // m/s
+constexpr double kMinLinearAcceleration = 0.1;      // m/s²
+constexpr double kMinCentripetalAcceleration = 0.1; // m/s²
+constexpr double kMinAngularVelocity = 1.0;         // °/s
+constexpr double kMinAngularAcceleration = 1.0;     // °/s²
+
+// The search stops after this many rounds in a row without a faster candidate.
+constexpr size_t kMaxRoundsWithoutImprovement = 3;
+
+// New candidates are sampled around this many of the fastest candidates.
+constexpr size_t kNumParents = 3;
+
+// Candidates within this fraction of each other's time are considered the same when picking which to show.
+constexpr double kDistinctTimeFraction = 0.005;
+
+/**
+ * Maps between candidates and points in the search space, where every variable goes from 0 to 1.
+ */
+class SearchSpace {
+ public:
+  enum Variable : size_t {
+    LINEAR_VELOCITY = 0,
+    LINEAR_ACCELERATION,
+    CENTRIPETAL_ACCELERATION,
+    ANGULAR_VELOCITY,
+    ANGULAR_ACCELERATION,
+
+    NUM_SETTING_VARIABLES,
+  };
+
+  using Point = std::vector<double>;
+
+ private:
+  const ThunderAutoTrajectorySkeleton& m_skeleton;
+  const SpeedConstraintLimits& m_limits;
+
+  // Indices of the waypoints whose velocity overrides are tuned. Each one is a variable after the settings.
+  std::vector<size_t> m_overrideWaypoints;
+
+ public:
+  SearchSpace(const ThunderAutoTrajectorySkeleton& skeleton, const SpeedConstraintLimits& limits)
+    : m_skeleton(skeleton), m_limits(limits) {
+    if (!limits.tuneVelocityOverrides)
+      return;
+
+    // Stopped waypoints, and the start and end of the trajectory, keep their overrides.
+    size_t waypointIndex = 0;
+    for (auto it = skeleton.begin(); it != skeleton.end(); ++it, ++waypointIndex) {
+      if (waypointIndex == 0 || waypointIndex + 1 == skeleton.numPoints())
+        continue;
+
+      if (it->hasMaxVelocityOverride() && it->maxVelocityOverride().value() > 0_mps) {
+        m_overrideWaypoints.push_back(waypointIndex);
+      }
+    }
+  }
+
+  size_t numVariables() const noexcept { return NUM_SETTING_VARIABLES + m_overrideWaypoints.size(); }
+
+  Candidate toCandidate(const Point& point) const {
+    ThunderAutoAssert(point.size() == numVariables());
+
+    Candidate candidate;
+    candidate.settings = m_skeleton.settings();
+
+    ThunderAutoTrajectorySkeletonSettings& settings = candidate.settings;
+
+    const double linearVelocity =
+        FromNormalized(point[LINEAR_VELOCITY], kMinLinearVelocity, m_limits.maxLinearVelocity.value());
+
+    settings.maxLinearVelocity = units::meters_per_second_t(linearVelocity);
+    settings.maxLinearAcceleration = units::meters_per_second_squared_t(FromNormalized(
+        point[LINEAR_ACCELERATION], kMinLinearAcceleration, m_limits.maxLinearAcceleration.value()));
+    settings.maxCentripetalAcceleration = units::meters_per_second_squared_t(FromNormalized(
+        point[CENTRIPETAL_ACCELERATION], kMinCentripetalAcceleration, m_limits.maxTotalAcceleration.value()));
+    settings.maxAngularVelocity = units::degrees_per_second_t(FromNormalized(
+        point[ANGULAR_VELOCITY], kMinAngularVelocity, m_limits.maxAngularVelocity.value()));
+    settings.maxAngularAcceleration = units::degrees_per_second_squared_t(FromNormalized(
+        point[ANGULAR_ACCELERATION], kMinAngularAcceleration, m_limits.maxAngularAcceleration.value()));
+
+    // Overrides can't be higher than the max velocity.
+    for (size_t i = 0; i < m_overrideWaypoints.size(); i++) {
+      const double velocity =
+          FromNormalized(point[NUM_SETTING_VARIABLES + i], kMinLinearVelocity, linearVelocity);
+      candidate.velocityOverrides.emplace_back(m_overrideWaypoints[i], units::meters_per_second_t(velocity));
+    }
+
+    return candidate;
+  }
+
+  /**
+   * The point of the trajectory as it is now, clamped to the robot's limits.
+   */
+  Point currentPoint() const {
+    const ThunderAutoTrajectorySkeletonSettings& settings = m_skeleton.settings();
+
+    Point point(numVariables());
+    point[LINEAR_VELOCITY] = ToNormalized(settings.maxLinearVelocity.value(), kMinLinearVelocity,
+                                          m_limits.maxLinearVelocity.value());
+    point[LINEAR_ACCELERATION] = ToNormalized(settings.maxLinearAcceleration.value(), kMinLinearAcceleration,
+                                              m_limits.maxLinearAcceleration.value());
+    point[CENTRIPETAL_ACCELERATION] =
+        ToNormalized(settings.maxCentripetalAcceleration.value(), kMinCentripetalAcceleration,
+                     m_limits.maxTotalAcceleration.value());
+    point[ANGULAR_VELOCITY] = ToNormalized(units::degrees_per_second_t(settings.maxAngularVelocity).value(),
+                                           kMinAngularVelocity, m_limits.maxAngularVelocity.value());
+    point[ANGULAR_ACCELERATION] =
+        ToNormalized(units::degrees_per_second_squared_t(settings.maxAngularAcceleration).value(),
+                     kMinAngularAcceleration, m_limits.maxAngularAcceleration.value());
+
+    const double linearVelocity = settings.maxLinearVelocity.value();
+
+    for (size_t i = 0; i < m_overrideWaypoints.size(); i++) {
+      auto waypointIt = std::next(m_skeleton.begin(), static_cast<std::ptrdiff_t>(m_overrideWaypoints[i]));
+      const double velocity = waypointIt->maxVelocityOverride().value().value();
+      point[NUM_SETTING_VARIABLES + i] = ToNormalized(velocity, kMinLinearVelocity, linearVelocity);
+    }
+
+    return point;
+  }
+
+ private:
+  static double FromNormalized(double x, double min, double max) noexcept {
+    if (max <= min)
+      return min;
+
+    return min + std::clamp(x, 0.0, 1.0) * (max - min);
+  }
+
+  static double ToNormalized(double value, double min, double max) noexcept {
+    if (max <= min)
+      return 1.0;
+
+    return std::clamp((value - min) / (max - min), 0.0, 1.0);
+  }
+};
+
+/**
+ * The shortest time a trajectory of this length could take with the given max velocity and acceleration, if
+ * it starts and ends at rest.
+ */
+units::second_t MinimumTime(units::meter_t length,
+                            units::meters_per_second_t maxVelocity,
+                            units::meters_per_second_squared_t maxAcceleration) {
+  const double l = length.value(), v = maxVelocity.value(), a = maxAcceleration.value();
+
+  // Trapezoidal velocity profile, or triangular if max velocity is never reached.
+  if (l >= v * v / a)
+    return units::second_t(l / v + v / a);
+
+  return units::second_t(2.0 * std::sqrt(l / a));
+}
+
+struct Evaluation {
+  Candidate candidate;
+  SearchSpace::Point point;
+
+  bool skipped = false;
+  bool withinLimits = false;
+};
+
+Evaluation Evaluate(const ThunderAutoTrajectorySkeleton& skeleton,
+                    const SpeedConstraintLimits& limits,
+                    Candidate candidate,
+                    SearchSpace::Point point) {
+  Evaluation evaluation{.candidate = std::move(candidate), .point = std::move(point)};
+
+  ThunderAutoTrajectorySkeleton candidateSkeleton = skeleton;
+  SpeedConstraintTuner::ApplyCandidate(candidateSkeleton, evaluation.candidate);
+
+  std::unique_ptr<ThunderAutoOutputTrajectory> trajectory =
+      BuildThunderAutoOutputTrajectory(candidateSkeleton, kPreviewOutputTrajectorySettings);
+  ThunderAutoAssert(trajectory != nullptr);
+
+  std::span<const ThunderAutoOutputTrajectoryPoint> points = trajectory->points;
+
+  // Linear acceleration between points, combined with centripetal acceleration at the point.
+  double peakTotalAcceleration = 0.0;
+  for (size_t i = 1; i < points.size(); i++) {
+    const double dt = (points[i].time - points[i - 1].time).value();
+    if (dt <= 0.0)
+      continue;
+
+    const double linearAcceleration = (points[i].linearVelocity - points[i - 1].linearVelocity).value() / dt;
+    const double centripetalAcceleration = points[i].centripetalAcceleration.value();
+
+    peakTotalAcceleration =
+        std::max(peakTotalAcceleration, std::hypot(linearAcceleration, centripetalAcceleration));
+  }
+
+  evaluation.candidate.totalTime = trajectory->totalTime;
+  evaluation.candidate.peakTotalAcceleration = units::meters_per_second_squared_t(peakTotalAcceleration);
+
+  // A little slack, since acceleration is only approximated between points.
+  evaluation.withinLimits = peakTotalAcceleration <= limits.maxTotalAcceleration.value() * 1.01;
+
+  return evaluation;
+}
+
+}  // namespace
+
+SpeedConstraintTuner::SpeedConstraintTuner(ThunderAutoTrajectorySkeleton skeleton,
+                                           SpeedConstraintLimits limits)
+  : m_sharedState(std::make_shared<SharedState>()),
+    m_future(std::async(std::launch::async,
+                        &SpeedConstraintTuner::Run,
+                        std::move(skeleton),
+                        limits,
+                        m_sharedState)) {}
+
+float SpeedConstraintTuner::progress() const noexcept {
+  return static_cast<float>(m_sharedState->numFinishedRounds) / static_cast<float>(kMaxRounds);
+}
+
+bool SpeedConstraintTuner::isFinished() const {
+  ThunderAutoAssert(m_future.valid(), "Speed constraint tuner result was already taken");
+
+  return m_future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+SpeedConstraintTuner::Result SpeedConstraintTuner::takeResult() {
+  ThunderAutoAssert(m_future.valid(), "Speed constraint tuner result was already taken");
+
+  return m_future.get();
+}
+
+void SpeedConstraintTuner::ApplyCandidate(ThunderAutoTrajectorySkeleton& skeleton,
+                                          const Candidate& candidate) {
+  // Only the tuned fields, so that other settings changed since tuning started are kept.
+  ThunderAutoTrajectorySkeletonSettings& settings = skeleton.settings();
+  settings.maxLinearVelocity = candidate.settings.maxLinearVelocity;
+  settings.maxLinearAcceleration = candidate.settings.maxLinearAcceleration;
+  settings.maxCentripetalAcceleration = candidate.settings.maxCentripetalAcceleration;
+  settings.maxAngularVelocity = candidate.settings.maxAngularVelocity;
+  settings.maxAngularAcceleration = candidate.settings.maxAngularAcceleration;
+
+  for (const auto& [waypointIndex, velocity] : candidate.velocityOverrides) {
+    ThunderAutoAssert(waypointIndex < skeleton.numPoints());
+
+    auto waypointIt = std::next(skeleton.begin(), static_cast<std::ptrdiff_t>(waypointIndex));
+    waypointIt->setMaxVelocityOverride(velocity);
+  }
+}
+
+SpeedConstraintTuner::Result SpeedConstraintTuner::Run(ThunderAutoTrajectorySkeleton skeleton,
+                                                       SpeedConstraintLimits limits,
+                                                       std::shared_ptr<SharedState> sharedState) {
+  Result result;
+
+  try {
+    const SearchSpace space(skeleton, limits);
+
+    std::unique_ptr<ThunderAutoOutputTrajectory> originalTrajectory =
+        BuildThunderAutoOutputTrajectory(skeleton, kPreviewOutputTrajectorySettings);
+    ThunderAutoAssert(originalTrajectory != nullptr);
+
+    result.originalTime = originalTrajectory->totalTime;
+
+    // The path itself doesn't depend on the speed constraints, only how fast it is followed.
+    units::meter_t pathLength = 0_m;
+    bool startsAndEndsAtRest = false;
+    if (!originalTrajectory->points.empty()) {
+      const ThunderAutoOutputTrajectoryPoint& firstPoint = originalTrajectory->points.front();
+      const ThunderAutoOutputTrajectoryPoint& lastPoint = originalTrajectory->points.back();
+
+      pathLength = lastPoint.distance;
+      startsAndEndsAtRest = firstPoint.linearVelocity == 0_mps && lastPoint.linearVelocity == 0_mps;
+    }
+
+    std::vector<Evaluation> evaluations;  // Only those within limits, fastest first.
+    units::second_t bestTime = units::second_t(std::numeric_limits<double>::infinity());
+
+    std::mt19937 rng(1511);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+    const size_t batchSize = std::max<size_t>(8, 2 * ThreadPool::get().numWorkers());
+    double stepSize = 0.25;
+    size_t roundsWithoutImprovement = 0;
+
+    for (size_t round = 0; round < kMaxRounds && !sharedState->cancelled; round++) {
+      // Pick the points to try this round.
+
+      std::vector<SearchSpace::Point> points;
+
+      if (round == 0) {
+        // Start from where the user left off, and from every constraint at the robot's limits.
+        points.push_back(space.currentPoint());
+        points.push_back(SearchSpace::Point(space.numVariables(), 1.0));
+
+        while (points.size() < batchSize) {
+          SearchSpace::Point& point = points.emplace_back(space.numVariables());
+          std::generate(point.begin(), point.end(), [&] { return uniform(rng); });
+        }
+
+      } else {
+        std::normal_distribution<double> step(0.0, stepSize);
+
+        const size_t numParents = std::min(kNumParents, evaluations.size());
+
+        for (size_t i = 0; i < batchSize; i++) {
+          SearchSpace::Point point =
+              numParents ? evaluations[i % numParents].point : SearchSpace::Point(space.numVariables(), 0.5);
+
+          for (double& x : point) {
+            x = std::clamp(x + step(rng), 0.0, 1.0);
+          }
+          points.push_back(std::move(point));
+        }
+      }
+
+      // Build them all in parallel.
+
+      std::vector<std::future<Evaluation>> futures;
+      for (SearchSpace::Point& point : points) {
+        Candidate candidate = space.toCandidate(point);
+
+        futures.push_back(ThreadPool::get().submit(
+            [&skeleton, &limits, &sharedState, candidate = std::move(candidate), point = std::move(point),
+             bestTime, pathLength, startsAndEndsAtRest]() mutable {
+              // No need to build candidates that can't be faster than the best one so far.
+              const bool cantBeFaster =
+                  startsAndEndsAtRest && MinimumTime(pathLength, candidate.settings.maxLinearVelocity,
+                                                     candidate.settings.maxLinearAcceleration) >= bestTime;
+
+              if (sharedState->cancelled || cantBeFaster) {
+                return Evaluation{
+                    .candidate = std::move(candidate),
+                    .point = std::move(point),
+                    .skipped = true,
+                };
+              }
+
+              return Evaluate(skeleton, limits, std::move(candidate), std::move(point));
+            }));
+      }
+
+      bool improved = false;
+
+      for (Evaluation& evaluation : ThreadPool::GetAll(futures)) {
+        if (evaluation.skipped) {
+          result.numSkipped++;
+          continue;
+        }
+        result.numEvaluated++;
+
+        if (!evaluation.withinLimits)
+          continue;
+
+        if (evaluation.candidate.totalTime < bestTime) {
+          bestTime = evaluation.candidate.totalTime;
+          improved = true;
+        }
+        evaluations.push_back(std::move(evaluation));
+      }
+
+      std::sort(evaluations.begin(), evaluations.end(), [](const Evaluation& a, const Evaluation& b) {
+        return a.candidate.totalTime < b.candidate.totalTime;
+      });
+
+      sharedState->numFinishedRounds++;
+
+      // Narrow the search around the best candidates once they stop improving.
+      if (improved || round == 0) {
+        roundsWithoutImprovement = 0;
+      } else {
+        stepSize /= 2.0;
+        if (++roundsWithoutImprovement >= kMaxRoundsWithoutImprovement)
+          break;
+      }
+    }
+
+    result.cancelled = sharedState->cancelled;
+
+    // Show the fastest few candidates that aren't practically the same.
+    for (Evaluation& evaluation : evaluations) {
+      if (result.candidates.size() >= kMaxCandidatesShown)
+        break;
+
+      const double time = evaluation.candidate.totalTime.value();
+      const bool isDistinct =
+          std::none_of(result.candidates.begin(), result.candidates.end(), [&](const Candidate& candidate) {
+            const double otherTime = candidate.totalTime.value();
+            return std::abs(otherTime - time) < otherTime * kDistinctTimeFraction;
+          });
+      if (isDistinct) {
+        result.candidates.push_back(std::move(evaluation.candidate));
+      }
+    }
+
+  } catch (const ThunderError& e) {
+    result.error = e.message();
+  } catch (const std::exception& e) {
+    result.error = e.what();
+  } catch (...) {
+    result.error = "Unknown error ocurred";
+  }
+
+  return result;
+}
@@ -0,0 +1,77 @@
+#include <ThunderAuto/StartupTimeline.hpp>
+
+#include <ThunderAuto/Logger.hpp>
+#include <ThunderAuto/Error.hpp>
+
+const char* StartupTimeline::PhaseToString(Phase phase) noexcept {
+  switch (phase) {
+    using enum Phase;
+    case WINDOW_CREATION:
+      return "Window creation";
+    case GRAPHICS_LOAD:
+      return "Graphics API load";
+    case FONT_ATLAS:
+      return "Font atlas";
+    case INI_PARSE:
+      return "Ini parse";
+    case PROJECT_LOAD:
+      return "Project load";
+    case FIELD_TEXTURE_DECODE:
+      return "Field texture decode";
+    case FIRST_TRAJECTORY_BUILD:
+      return "First trajectory build";
+    case FIRST_FRAME:
+      return "First frame";
+    default:
+      ThunderAutoUnreachable("Unknown startup phase");
+  }
+}
+
+void StartupTimeline::beginPhase(Phase phase) noexcept {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  PhaseRecord& record = m_phases.at(static_cast<size_t>(phase));
+  if (record.begin.has_value())
+    return;
+
+  record.begin = Clock::now();
+}
+
+void StartupTimeline::endPhase(Phase phase) noexcept {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  PhaseRecord& record = m_phases.at(static_cast<size_t>(phase));
+  if (!record.begin.has_value() || record.end.has_value())
+    return;
+
+  record.end = Clock::now();
+}
+
+bool StartupTimeline::isPhaseRecorded(Phase phase) const noexcept {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  return m_phases.at(static_cast<size_t>(phase)).end.has_value();
+}
+
+void StartupTimeline::logSummary() const noexcept {
+  using Milliseconds = std::chrono::duration<double, std::milli>;
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  ThunderAutoLogger::Info("Startup timeline:");
+
+  for (size_t i = 0; i < m_phases.size(); i++) {
+    const PhaseRecord& record = m_phases[i];
+    const char* phaseName = PhaseToString(static_cast<Phase>(i));
+
+    if (!record.begin.has_value() || !record.end.has_value()) {
+      ThunderAutoLogger::Info("  {:<24} not recorded", phaseName);
+      continue;
+    }
+
+    const double startOffset = Milliseconds(*record.begin - m_launchTime).count();
+    const double duration = Milliseconds(*record.end - *record.begin).count();
+
+    ThunderAutoLogger::Info("  {:<24} +{:>9.2f} ms  {:>9.2f} ms", phaseName, startOffset, duration);
+  }
+}
@@ -0,0 +1,77 @@
+#include <ThunderAuto/StateChangeSet.hpp>
+
+#include <wpi/json.h>
+
+// Entities are compared through their JSON form, the same one that's written to project files.
+template <typename EntityMap>
+static void CompareEntities(const EntityMap& from, const EntityMap& to, std::set<std::string>& changedNames) {
+  for (const auto& [name, fromEntity] : from) {
+    auto toIt = to.find(name);
+    if (toIt == to.end() || wpi::json(fromEntity) != wpi::json(toIt->second)) {
+      changedNames.insert(name);
+    }
+  }
+  for (const auto& [name, toEntity] : to) {
+    if (!from.contains(name)) {
+      changedNames.insert(name);
+    }
+  }
+}
+
+StateChangeSet StateChangeSet::Compute(const ThunderAutoProjectState& from,
+                                       const ThunderAutoProjectState& to) {
+  StateChangeSet changes;
+
+  CompareEntities(from.trajectories, to.trajectories, changes.trajectories);
+  CompareEntities(from.autoModes, to.autoModes, changes.autoModes);
+  CompareEntities(from.actions, to.actions, changes.actions);
+
+  changes.actionsOrder = from.actionsOrder != to.actionsOrder;
+  changes.waypointLinks = from.waypointLinks != to.waypointLinks;
+  changes.trajectoryEndBehaviorLinks = from.trajectoryEndBehaviorLinks != to.trajectoryEndBehaviorLinks;
+
+  const ThunderAutoEditorState& fromEditor = from.editorState;
+  const ThunderAutoEditorState& toEditor = to.editorState;
+
+  changes.editorView = fromEditor.view != toEditor.view;
+
+  const ThunderAutoTrajectoryEditorState& fromTrajectoryEditor = fromEditor.trajectoryEditorState;
+  const ThunderAutoTrajectoryEditorState& toTrajectoryEditor = toEditor.trajectoryEditorState;
+
+  changes.currentTrajectory =
+      fromTrajectoryEditor.currentTrajectoryName != toTrajectoryEditor.currentTrajectoryName;
+  changes.trajectorySelection =
+      fromTrajectoryEditor.trajectorySelection != toTrajectoryEditor.trajectorySelection ||
+      fromTrajectoryEditor.selectionIndex != toTrajectoryEditor.selectionIndex;
+
+  const ThunderAutoModeEditorState& fromAutoModeEditor = fromEditor.autoModeEditorState;
+  const ThunderAutoModeEditorState& toAutoModeEditor = toEditor.autoModeEditorState;
+
+  changes.currentAutoMode = fromAutoModeEditor.currentAutoModeName != toAutoModeEditor.currentAutoModeName;
+  changes.autoModeStepSelection = fromAutoModeEditor.selectedStepPath != toAutoModeEditor.selectedStepPath;
+
+  return changes;
+}
+
+void StateChangeSet::merge(const StateChangeSet& other) {
+  everything |= other.everything;
+
+  trajectories.insert(other.trajectories.begin(), other.trajectories.end());
+  autoModes.insert(other.autoModes.begin(), other.autoModes.end());
+  actions.insert(other.actions.begin(), other.actions.end());
+
+  actionsOrder |= other.actionsOrder;
+  waypointLinks |= other.waypointLinks;
+  trajectoryEndBehaviorLinks |= other.trajectoryEndBehaviorLinks;
+
+  editorView |= other.editorView;
+  currentTrajectory |= other.currentTrajectory;
+  trajectorySelection |= other.trajectorySelection;
+  currentAutoMode |= other.currentAutoMode;
+  autoModeStepSelection |= other.autoModeStepSelection;
+}
+
+bool StateChangeSet::empty() const noexcept {
+  return !everything && trajectories.empty() && autoModes.empty() && actions.empty() && !actionsOrder &&
+         !waypointLinks && !trajectoryEndBehaviorLinks && !affectsEditorState();
+}
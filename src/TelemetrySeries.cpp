@@ -0,0 +1,178 @@
+#include <ThunderAuto/TelemetrySeries.hpp>
+
+#include <ThunderAuto/Error.hpp>
+#include <units/angular_velocity.h>
+#include <algorithm>
+
+const char* TelemetrySeries::ChannelToString(Channel channel) noexcept {
+  switch (channel) {
+    using enum Channel;
+    case LINEAR_VELOCITY:
+      return "Linear Velocity";
+    case LINEAR_ACCELERATION:
+      return "Linear Acceleration";
+    case CENTRIPETAL_ACCELERATION:
+      return "Centripetal Acceleration";
+    case ANGULAR_VELOCITY:
+      return "Angular Velocity";
+    case CURVATURE:
+      return "Curvature";
+    default:
+      ThunderAutoUnreachable("Unknown telemetry channel");
+  }
+}
+
+const char* TelemetrySeries::ChannelUnits(Channel channel) noexcept {
+  switch (channel) {
+    using enum Channel;
+    case LINEAR_VELOCITY:
+      return "m/s";
+    case LINEAR_ACCELERATION:
+    case CENTRIPETAL_ACCELERATION:
+      return "m/s²";
+    case ANGULAR_VELOCITY:
+      return "deg/s";
+    case CURVATURE:
+      return "1/m";
+    default:
+      ThunderAutoUnreachable("Unknown telemetry channel");
+  }
+}
+
+void TelemetrySeries::addTrajectory(const ThunderAutoOutputTrajectory& trajectory) {
+  const float startTime = m_times.empty() ? 0.f : m_times.back();
+  const float startDistance = m_distances.empty() ? 0.f : m_distances.back();
+
+  const size_t numPoints = trajectory.points.size();
+
+  m_times.reserve(m_times.size() + numPoints);
+  m_distances.reserve(m_distances.size() + numPoints);
+  for (ChannelData& channel : m_channels) {
+    channel.values.reserve(channel.values.size() + numPoints);
+  }
+
+  auto channelValues = [&](Channel channel) -> std::vector<float>& {
+    return m_channels[static_cast<size_t>(channel)].values;
+  };
+
+  for (size_t i = 0; i < numPoints; i++) {
+    const ThunderAutoOutputTrajectoryPoint& point = trajectory.points[i];
+
+    // The output trajectory doesn't store the linear acceleration, so take it from the neighboring points.
+    const ThunderAutoOutputTrajectoryPoint& previousPoint = trajectory.points[i > 0 ? i - 1 : i];
+    const ThunderAutoOutputTrajectoryPoint& nextPoint = trajectory.points[i + 1 < numPoints ? i + 1 : i];
+    const double dt = (nextPoint.time - previousPoint.time).value();
+    const double acceleration =
+        dt > 0.0 ? (nextPoint.linearVelocity - previousPoint.linearVelocity).value() / dt : 0.0;
+
+    m_times.push_back(startTime + static_cast<float>(point.time()));
+    m_distances.push_back(startDistance + static_cast<float>(point.distance()));
+
+    channelValues(Channel::LINEAR_VELOCITY).push_back(static_cast<float>(point.linearVelocity()));
+    channelValues(Channel::LINEAR_ACCELERATION).push_back(static_cast<float>(acceleration));
+    channelValues(Channel::CENTRIPETAL_ACCELERATION)
+        .push_back(static_cast<float>(point.centripetalAcceleration()));
+    channelValues(Channel::ANGULAR_VELOCITY)
+        .push_back(static_cast<float>(units::degrees_per_second_t(point.angularVelocity)()));
+    channelValues(Channel::CURVATURE).push_back(static_cast<float>(point.curvature()));
+  }
+}
+
+void TelemetrySeries::build() {
+  for (ChannelData& channel : m_channels) {
+    channel.levels.clear();
+
+    // First level, from the values.
+    if (channel.values.size() < 2)
+      continue;
+
+    std::vector<Range>& firstLevel = channel.levels.emplace_back();
+    firstLevel.reserve((channel.values.size() + 1) / 2);
+    for (size_t i = 0; i < channel.values.size(); i += 2) {
+      const float a = channel.values[i];
+      const float b = channel.values[std::min(i + 1, channel.values.size() - 1)];
+      firstLevel.push_back(Range{std::min(a, b), std::max(a, b)});
+    }
+
+    // Every other level, from the one below it.
+    while (channel.levels.back().size() > 1) {
+      const std::vector<Range>& lowerLevel = channel.levels.back();
+
+      std::vector<Range> level;
+      level.reserve((lowerLevel.size() + 1) / 2);
+      for (size_t i = 0; i < lowerLevel.size(); i += 2) {
+        const Range& a = lowerLevel[i];
+        const Range& b = lowerLevel[std::min(i + 1, lowerLevel.size() - 1)];
+        level.push_back(Range{std::min(a.min, b.min), std::max(a.max, b.max)});
+      }
+
+      channel.levels.push_back(std::move(level));
+    }
+  }
+}
+
+std::pair<size_t, size_t> TelemetrySeries::findSamples(Axis axis, float min, float max) const {
+  const std::vector<float>& values = axisValues(axis);
+
+  auto beginIt = std::lower_bound(values.begin(), values.end(), min);
+  auto endIt = std::lower_bound(beginIt, values.end(), max);
+
+  return {static_cast<size_t>(std::distance(values.begin(), beginIt)),
+          static_cast<size_t>(std::distance(values.begin(), endIt))};
+}
+
+TelemetrySeries::Range TelemetrySeries::channelRange(Channel channel, size_t begin, size_t end) const {
+  const ChannelData& data = m_channels.at(static_cast<size_t>(channel));
+  ThunderAutoAssert(begin < end && end <= data.values.size());
+
+  Range range{data.values[begin], data.values[begin]};
+
+  auto include = [&](const Range& other) {
+    range.min = std::min(range.min, other.min);
+    range.max = std::max(range.max, other.max);
+  };
+
+  // Take single samples at either end until both are on an even boundary, then move up a level and repeat.
+  // Each level covers the middle of the range with half as many entries as the one below it.
+  size_t lo = begin, hi = end;
+  for (size_t level = 0; lo < hi; level++) {
+    auto entry = [&](size_t index) -> Range {
+      if (level == 0) {
+        return Range{data.values[index], data.values[index]};
+      }
+      return data.levels[level - 1][index];
+    };
+
+    if (lo & 1) {
+      include(entry(lo++));
+    }
+    if (hi & 1) {
+      include(entry(--hi));
+    }
+    lo >>= 1;
+    hi >>= 1;
+  }
+
+  return range;
+}
+
+float TelemetrySeries::convertAxisValue(Axis from, Axis to, float value) const {
+  const std::vector<float>& fromValues = axisValues(from);
+  const std::vector<float>& toValues = axisValues(to);
+
+  if (fromValues.empty())
+    return 0.f;
+
+  auto it = std::lower_bound(fromValues.begin(), fromValues.end(), value);
+  if (it == fromValues.begin())
+    return toValues.front();
+  if (it == fromValues.end())
+    return toValues.back();
+
+  const size_t upper = static_cast<size_t>(std::distance(fromValues.begin(), it));
+  const size_t lower = upper - 1;
+
+  const float span = fromValues[upper] - fromValues[lower];
+  const float t = span > 0.f ? (value - fromValues[lower]) / span : 0.f;
+  return toValues[lower] + (toValues[upper] - toValues[lower]) * t;
+}
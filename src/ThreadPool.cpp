@@ -0,0 +1,87 @@
+#include <ThunderAuto/ThreadPool.hpp>
+
+#include <algorithm>
+
+ThreadPool::ThreadPool() {
+  // Leave a core for the main thread.
+  const size_t numWorkers = std::max<size_t>(std::thread::hardware_concurrency(), 2) - 1;
+
+  for (size_t i = 0; i < numWorkers; i++) {
+    m_queues.push_back(std::make_unique<WorkerQueue>());
+  }
+
+  for (size_t i = 0; i < numWorkers; i++) {
+    m_workers.emplace_back(&ThreadPool::workerMain, this, i);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stopping = true;
+  }
+  m_condition.notify_all();
+
+  for (std::thread& worker : m_workers) {
+    worker.join();
+  }
+}
+
+void ThreadPool::push(Task task) {
+  WorkerQueue& queue = *m_queues[m_nextQueue.fetch_add(1, std::memory_order_relaxed) % m_queues.size()];
+  {
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.tasks.push_back(std::move(task));
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_numQueuedTasks++;
+  }
+  m_condition.notify_one();
+}
+
+bool ThreadPool::tryPop(size_t workerIndex, Task& task) {
+  for (size_t i = 0; i < m_queues.size(); i++) {
+    WorkerQueue& queue = *m_queues[(workerIndex + i) % m_queues.size()];
+
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty())
+      continue;
+
+    // Take the oldest task from our own queue, or steal the newest task from someone else's.
+    if (i == 0) {
+      task = std::move(queue.tasks.front());
+      queue.tasks.pop_front();
+    } else {
+      task = std::move(queue.tasks.back());
+      queue.tasks.pop_back();
+    }
+    return true;
+  }
+  return false;
+}
+
+void ThreadPool::workerMain(size_t workerIndex) {
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_condition.wait(lock, [this] { return m_stopping || m_numQueuedTasks > 0; });
+
+      // Anything still queued is dropped, which breaks the promises of their futures.
+      if (m_stopping)
+        return;
+
+      // Claim a task. It's already in one of the queues, though another worker may take that exact one, in
+      // which case there's another to take instead.
+      m_numQueuedTasks--;
+    }
+
+    Task task;
+    while (!tryPop(workerIndex, task)) {
+      std::this_thread::yield();
+    }
+
+    task();
+  }
+}
@@ -0,0 +1,385 @@
+#include <ThunderAuto/TrajectoryExport.hpp>
+
+#include <ThunderAuto/BinaryTrajectoryReader.hpp>
+#include <ThunderAuto/Logger.hpp>
+#include <ThunderAuto/Error.hpp>
+#include <wpi/json.h>
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <fstream>
+#include <iterator>
+
+const char* TrajectoryExportFormatToString(TrajectoryExportFormat format) noexcept {
+  switch (format) {
+    using enum TrajectoryExportFormat;
+    case CSV:
+      return "CSV";
+    case BINARY:
+      return "Binary";
+    default:
+      ThunderAutoUnreachable("Unknown trajectory export format");
+  }
+}
+
+const char* TrajectoryExportFormatFileExtension(TrajectoryExportFormat format) noexcept {
+  switch (format) {
+    using enum TrajectoryExportFormat;
+    case CSV:
+      return ".csv";
+    case BINARY:
+      return ".tatraj";
+    default:
+      ThunderAutoUnreachable("Unknown trajectory export format");
+  }
+}
+
+std::filesystem::path TrajectoryExportFormatPathForProject(const std::filesystem::path& projectPath) {
+  std::filesystem::path formatPath = projectPath;
+  formatPath += ".export.json";
+  return formatPath;
+}
+
+TrajectoryExportFormat LoadTrajectoryExportFormat(const std::filesystem::path& projectPath) {
+  const std::filesystem::path formatPath = TrajectoryExportFormatPathForProject(projectPath);
+
+  std::error_code ec;
+  if (!std::filesystem::exists(formatPath, ec))
+    return TrajectoryExportFormat::CSV;
+
+  std::ifstream file(formatPath);
+  if (!file) {
+    throw RuntimeError::Construct("Failed to open export settings file '{}'", formatPath.string());
+  }
+
+  const std::string data{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+
+  std::string formatStr;
+  try {
+    formatStr = wpi::json::parse(data).at("format").get<std::string>();
+  } catch (const wpi::json::exception& e) {
+    throw RuntimeError::Construct("Export settings file '{}' is not valid: {}", formatPath.string(),
+                                  e.what());
+  }
+
+  if (formatStr == "csv")
+    return TrajectoryExportFormat::CSV;
+  if (formatStr == "binary")
+    return TrajectoryExportFormat::BINARY;
+
+  throw RuntimeError::Construct("Unknown export format '{}' in '{}'", formatStr, formatPath.string());
+}
+
+void SaveTrajectoryExportFormat(const std::filesystem::path& projectPath, TrajectoryExportFormat format) {
+  const std::filesystem::path formatPath = TrajectoryExportFormatPathForProject(projectPath);
+
+  if (format == TrajectoryExportFormat::CSV) {
+    std::error_code ec;
+    std::filesystem::remove(formatPath, ec);
+    return;
+  }
+
+  std::ofstream file(formatPath);
+  if (!file) {
+    throw RuntimeError::Construct("Failed to open export settings file '{}' for writing",
+                                  formatPath.string());
+  }
+
+  const wpi::json json = {
+      {"format", "binary"},
+  };
+  file << json.dump(2) << '\n';
+
+  if (!file) {
+    throw RuntimeError::Construct("Failed to write export settings file '{}'", formatPath.string());
+  }
+}
+
+namespace {
+
+// Values are collected into a buffer this big before being written to the file.
+constexpr size_t kWriteBufferSize = 64 * 1024;
+
+uint64_t AlignUp(uint64_t value, uint64_t alignment) {
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+// Writes little endian values to a file through a buffer, whatever the byte order of this machine.
+class LittleEndianFileWriter {
+  std::ofstream m_file;
+  const std::filesystem::path& m_path;
+
+  std::vector<uint8_t> m_buffer;
+  uint64_t m_position = 0;
+
+ public:
+  explicit LittleEndianFileWriter(const std::filesystem::path& path)
+    : m_file(path, std::ios::binary), m_path(path) {
+    if (!m_file) {
+      throw RuntimeError::Construct("Failed to open trajectory file '{}' for writing", path.string());
+    }
+    m_buffer.reserve(kWriteBufferSize);
+  }
+
+  uint64_t position() const noexcept { return m_position; }
+
+  void write(uint64_t value, size_t numBytes) {
+    for (size_t i = 0; i < numBytes; i++) {
+      m_buffer.push_back(static_cast<uint8_t>(value >> (i * 8)));
+    }
+    m_position += numBytes;
+
+    if (m_buffer.size() >= kWriteBufferSize) {
+      flush();
+    }
+  }
+
+  void writeU16(uint16_t value) { write(value, sizeof(value)); }
+  void writeU32(uint32_t value) { write(value, sizeof(value)); }
+  void writeU64(uint64_t value) { write(value, sizeof(value)); }
+  void writeF64(double value) { write(std::bit_cast<uint64_t>(value), sizeof(value)); }
+
+  // Writes zeros up to a position.
+  void padTo(uint64_t position) {
+    ThunderAutoAssert(position >= m_position);
+    while (m_position < position) {
+      write(0, 1);
+    }
+  }
+
+  void flush() {
+    m_file.write(reinterpret_cast<const char*>(m_buffer.data()),
+                 static_cast<std::streamsize>(m_buffer.size()));
+    m_buffer.clear();
+
+    if (!m_file) {
+      throw RuntimeError::Construct("Failed to write trajectory file '{}'", m_path.string());
+    }
+  }
+};
+
+// The columns to write for a set of CSV export properties, in the order they are written.
+std::vector<BinaryTrajectoryColumnID> ColumnsToExport(const ThunderAutoCSVExportProperties& properties) {
+  using enum BinaryTrajectoryColumnID;
+
+  // Always written, since the file can't be sampled without it.
+  std::vector<BinaryTrajectoryColumnID> columns = {TIME};
+
+  if (properties.position) {
+    columns.push_back(POSITION_X);
+    columns.push_back(POSITION_Y);
+  }
+  if (properties.linearVelocity) {
+    columns.push_back(LINEAR_VELOCITY);
+  }
+  if (properties.componentVelocities) {
+    columns.push_back(VELOCITY_X);
+    columns.push_back(VELOCITY_Y);
+  }
+  if (properties.heading) {
+    columns.push_back(HEADING);
+  }
+  if (properties.rotation) {
+    columns.push_back(ROTATION);
+  }
+  if (properties.angularVelocity) {
+    columns.push_back(ANGULAR_VELOCITY);
+  }
+  if (properties.actionsBitField) {
+    columns.push_back(ACTIONS);
+  }
+  if (properties.distance) {
+    columns.push_back(DISTANCE);
+  }
+  if (properties.curvature) {
+    columns.push_back(CURVATURE);
+  }
+  if (properties.centripetalAcceleration) {
+    columns.push_back(CENTRIPETAL_ACCELERATION);
+  }
+
+  return columns;
+}
+
+double ColumnValue(BinaryTrajectoryColumnID column, const ThunderAutoOutputTrajectoryPoint& point) {
+  switch (column) {
+    using enum BinaryTrajectoryColumnID;
+    case TIME:
+      return point.time.value();
+    case POSITION_X:
+      return point.position.x.value();
+    case POSITION_Y:
+      return point.position.y.value();
+    case LINEAR_VELOCITY:
+      return units::meters_per_second_t(point.linearVelocity).value();
+    case VELOCITY_X:
+      return units::meters_per_second_t(point.linearVelocity).value() *
+             std::cos(point.heading.radians().value());
+    case VELOCITY_Y:
+      return units::meters_per_second_t(point.linearVelocity).value() *
+             std::sin(point.heading.radians().value());
+    case HEADING:
+      return point.heading.radians().value();
+    case ROTATION:
+      return point.rotation.radians().value();
+    case ANGULAR_VELOCITY:
+      return units::radians_per_second_t(point.angularVelocity).value();
+    case DISTANCE:
+      return point.distance.value();
+    case CURVATURE:
+      return point.curvature.value();
+    case CENTRIPETAL_ACCELERATION:
+      return point.centripetalAcceleration.value();
+    default:
+      ThunderAutoUnreachable("Not a FLOAT64 trajectory column");
+  }
+}
+
+// The actions bit field of every point, with the same actions as a CSV export (start, along the path, at
+// stopped waypoints, and end). Bit i is action i of the project's actions.
+std::vector<uint64_t> PointActions(const ThunderAutoOutputTrajectory& trajectory,
+                                   const ThunderAutoTrajectorySkeleton& skeleton,
+                                   std::span<const std::string> actionsOrder) {
+  std::vector<uint64_t> actions(trajectory.points.size(), 0);
+
+  auto addAction = [&](size_t pointIndex, const std::string& actionName) {
+    auto actionIt = std::find(actionsOrder.begin(), actionsOrder.end(), actionName);
+    if (actionIt == actionsOrder.end()) {
+      ThunderAutoLogger::Warn("Action '{}' does not exist, leaving it out of the actions bit field",
+                              actionName);
+      return;
+    }
+
+    const size_t bit = static_cast<size_t>(std::distance(actionsOrder.begin(), actionIt));
+    if (bit >= 64) {
+      ThunderAutoLogger::Warn("Action '{}' is past the 64th action, leaving it out of the actions bit field",
+                              actionName);
+      return;
+    }
+
+    actions.at(pointIndex) |= uint64_t(1) << bit;
+  };
+
+  if (skeleton.hasStartAction()) {
+    addAction(0, skeleton.startAction());
+  }
+  for (const auto& [positionInTrajectory, action] : skeleton.actions()) {
+    addAction(trajectory.trajectoryPositionToPointIndex(positionInTrajectory), action.action);
+  }
+  if (skeleton.numPoints() > 2) {
+    size_t waypointIndex = 1;
+    for (auto waypointIt = std::next(skeleton.begin()); waypointIt != std::prev(skeleton.end());
+         ++waypointIt, ++waypointIndex) {
+      if (waypointIt->isStopped() && waypointIt->hasStopAction()) {
+        const ThunderAutoTrajectoryPosition waypointPosition(static_cast<double>(waypointIndex));
+        addAction(trajectory.trajectoryPositionToPointIndex(waypointPosition), waypointIt->stopAction());
+      }
+    }
+  }
+  if (skeleton.hasEndAction()) {
+    addAction(actions.size() - 1, skeleton.endAction());
+  }
+
+  return actions;
+}
+
+}  // namespace
+
+void BinaryExportThunderAutoOutputTrajectory(const ThunderAutoOutputTrajectory& trajectory,
+                                             const ThunderAutoTrajectorySkeleton& skeleton,
+                                             std::span<const std::string> actionsOrder,
+                                             const std::filesystem::path& path,
+                                             const ThunderAutoCSVExportProperties& properties) {
+  std::span<const ThunderAutoOutputTrajectoryPoint> points = trajectory.points;
+  if (points.empty()) {
+    throw InvalidArgumentError::Construct("Trajectory has no points");
+  }
+
+  const std::vector<BinaryTrajectoryColumnID> columns = ColumnsToExport(properties);
+
+  std::vector<uint64_t> actions;
+  if (properties.actionsBitField) {
+    actions = PointActions(trajectory, skeleton, actionsOrder);
+  }
+
+  // Lay out the columns.
+
+  const uint64_t numPoints = points.size();
+  const uint32_t columnTableOffset = sizeof(BinaryTrajectoryHeader);
+
+  std::vector<uint64_t> columnOffsets;
+  uint64_t offset = columnTableOffset + columns.size() * sizeof(BinaryTrajectoryColumn);
+  for (size_t i = 0; i < columns.size(); i++) {
+    offset = AlignUp(offset, kBinaryTrajectoryColumnAlignment);
+    columnOffsets.push_back(offset);
+    offset += numPoints * sizeof(uint64_t);
+  }
+  const uint64_t fileSize = offset;
+
+  LittleEndianFileWriter writer(path);
+
+  // Header.
+
+  for (char c : kBinaryTrajectoryMagic) {
+    writer.write(static_cast<uint8_t>(c), 1);
+  }
+  writer.writeU16(kBinaryTrajectoryVersionMajor);
+  writer.writeU16(kBinaryTrajectoryVersionMinor);
+  writer.writeU32(sizeof(BinaryTrajectoryHeader));
+  writer.writeU32(static_cast<uint32_t>(columns.size()));
+  writer.writeU32(columnTableOffset);
+  writer.writeU64(numPoints);
+  writer.writeU64(fileSize);
+  writer.writeF64(trajectory.totalTime.value());
+  writer.padTo(sizeof(BinaryTrajectoryHeader));
+
+  // Column table.
+
+  for (size_t i = 0; i < columns.size(); i++) {
+    writer.writeU32(static_cast<uint32_t>(columns[i]));
+    writer.writeU32(static_cast<uint32_t>(BinaryTrajectoryColumnTypeOf(columns[i])));
+    writer.writeU64(columnOffsets[i]);
+  }
+
+  // Column values.
+
+  for (size_t i = 0; i < columns.size(); i++) {
+    writer.padTo(columnOffsets[i]);
+
+    if (columns[i] == BinaryTrajectoryColumnID::ACTIONS) {
+      for (uint64_t pointActions : actions) {
+        writer.writeU64(pointActions);
+      }
+    } else {
+      for (const ThunderAutoOutputTrajectoryPoint& point : points) {
+        writer.writeF64(ColumnValue(columns[i], point));
+      }
+    }
+  }
+
+  ThunderAutoAssert(writer.position() == fileSize);
+
+  writer.flush();
+}
+
+void BuildAndExportThunderAutoOutputTrajectory(const ThunderAutoTrajectorySkeleton& skeleton,
+                                               const std::vector<std::string>& actionsOrder,
+                                               const std::filesystem::path& path,
+                                               const ThunderAutoCSVExportProperties& properties,
+                                               TrajectoryExportFormat format) {
+  switch (format) {
+    using enum TrajectoryExportFormat;
+    case CSV:
+      BuildAndCSVExportThunderAutoOutputTrajectory(skeleton, kHighResOutputTrajectorySettings, actionsOrder,
+                                                   path, properties);
+      break;
+    case BINARY: {
+      std::unique_ptr<ThunderAutoOutputTrajectory> trajectory =
+          BuildThunderAutoOutputTrajectory(skeleton, kHighResOutputTrajectorySettings);
+      BinaryExportThunderAutoOutputTrajectory(*trajectory, skeleton, actionsOrder, path, properties);
+      break;
+    }
+    default:
+      ThunderAutoUnreachable("Unknown trajectory export format");
+  }
+}
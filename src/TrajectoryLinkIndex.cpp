@@ -0,0 +1,251 @@
+#include <ThunderAuto/TrajectoryLinkIndex.hpp>
+
+#include <ThunderAuto/Error.hpp>
+#include <algorithm>
+#include <iterator>
+
+using LinkedWaypoint = TrajectoryLinkIndex::LinkedWaypoint;
+using LinkedTrajectoryEnd = TrajectoryLinkIndex::LinkedTrajectoryEnd;
+using TrajectoryEnd = TrajectoryLinkIndex::TrajectoryEnd;
+
+// The fallbacks in ThunderAutoProjectState don't say what they changed, so any trajectory might have.
+static void AddAllTrajectories(const ThunderAutoProjectState& state, StateChangeSet* changes) {
+  if (!changes)
+    return;
+
+  for (const auto& [trajectoryName, skeleton] : state.trajectories) {
+    changes->trajectories.insert(trajectoryName);
+  }
+}
+
+// Whether every indexed waypoint still exists in the state and has the link.
+static bool IndexMatchesState(const ThunderAutoProjectState& state,
+                              const std::string& linkName,
+                              std::span<const LinkedWaypoint> waypoints) {
+  return std::all_of(waypoints.begin(), waypoints.end(), [&](const LinkedWaypoint& linked) {
+    auto trajectoryIt = state.trajectories.find(linked.trajectoryName);
+    if (trajectoryIt == state.trajectories.end())
+      return false;
+
+    const ThunderAutoTrajectorySkeleton& skeleton = trajectoryIt->second;
+    if (linked.waypointIndex >= skeleton.numPoints())
+      return false;
+
+    auto waypointIt = std::next(skeleton.begin(), static_cast<std::ptrdiff_t>(linked.waypointIndex));
+    return waypointIt->isLinked() && waypointIt->linkName() == linkName;
+  });
+}
+
+// Whether every indexed trajectory end still exists in the state and has the link.
+static bool IndexMatchesState(const ThunderAutoProjectState& state,
+                              const std::string& linkName,
+                              std::span<const LinkedTrajectoryEnd> trajectoryEnds) {
+  return std::all_of(trajectoryEnds.begin(), trajectoryEnds.end(), [&](const LinkedTrajectoryEnd& linked) {
+    auto trajectoryIt = state.trajectories.find(linked.trajectoryName);
+    if (trajectoryIt == state.trajectories.end())
+      return false;
+
+    const ThunderAutoTrajectorySkeleton& skeleton = trajectoryIt->second;
+    if (linked.end == TrajectoryEnd::START)
+      return skeleton.hasStartBehaviorLink() && skeleton.startBehaviorLinkName() == linkName;
+
+    return skeleton.hasEndBehaviorLink() && skeleton.endBehaviorLinkName() == linkName;
+  });
+}
+
+void TrajectoryLinkIndex::rebuild(const ThunderAutoProjectState& state) {
+  clear();
+
+  for (const auto& [trajectoryName, skeleton] : state.trajectories) {
+    addTrajectory(trajectoryName, skeleton);
+  }
+}
+
+void TrajectoryLinkIndex::update(const ThunderAutoProjectState& state, const StateChangeSet& changes) {
+  if (changes.everything) {
+    rebuild(state);
+    return;
+  }
+
+  for (const std::string& trajectoryName : changes.trajectories) {
+    removeTrajectory(trajectoryName);
+
+    auto trajectoryIt = state.trajectories.find(trajectoryName);
+    if (trajectoryIt != state.trajectories.end()) {
+      addTrajectory(trajectoryName, trajectoryIt->second);
+    }
+  }
+}
+
+void TrajectoryLinkIndex::clear() noexcept {
+  m_waypointLinks.clear();
+  m_endBehaviorLinks.clear();
+  m_trajectoryLinks.clear();
+}
+
+std::span<const LinkedWaypoint> TrajectoryLinkIndex::linkedWaypoints(
+    const std::string& linkName) const noexcept {
+  auto it = m_waypointLinks.find(linkName);
+  if (it == m_waypointLinks.end())
+    return {};
+
+  return it->second;
+}
+
+std::span<const LinkedTrajectoryEnd> TrajectoryLinkIndex::linkedTrajectoryEnds(
+    const std::string& linkName) const noexcept {
+  auto it = m_endBehaviorLinks.find(linkName);
+  if (it == m_endBehaviorLinks.end())
+    return {};
+
+  return it->second;
+}
+
+void TrajectoryLinkIndex::updateLinkedWaypointPositionsFromSelectedWaypoint(ThunderAutoProjectState& state,
+                                                                            StateChangeSet* changes) const {
+  const ThunderAutoTrajectoryEditorState& editorState = state.editorState.trajectoryEditorState;
+
+  const ThunderAutoTrajectorySkeletonWaypoint& selectedWaypoint = state.currentTrajectorySelectedWaypoint();
+  if (!selectedWaypoint.isLinked())
+    return;
+
+  const std::string linkName(selectedWaypoint.linkName());
+  std::span<const LinkedWaypoint> linkedWaypoints = this->linkedWaypoints(linkName);
+
+  if (!IndexMatchesState(state, linkName, linkedWaypoints)) {
+    state.trajectoryUpdateAllLinkedWaypointPositionsFromSelectedWaypoint();
+    AddAllTrajectories(state, changes);
+    return;
+  }
+
+  const Point2d position = selectedWaypoint.position();
+
+  for (const LinkedWaypoint& linked : linkedWaypoints) {
+    if (linked.trajectoryName == editorState.currentTrajectoryName &&
+        linked.waypointIndex == static_cast<size_t>(editorState.selectionIndex))
+      continue;
+
+    ThunderAutoTrajectorySkeleton& skeleton = state.trajectories.at(linked.trajectoryName);
+    skeleton.getPoint(linked.waypointIndex).setPosition(position);
+
+    if (changes) {
+      changes->trajectories.insert(linked.trajectoryName);
+    }
+  }
+}
+
+void TrajectoryLinkIndex::updateLinkedTrajectoryEndBehaviorsFromCurrentTrajectory(
+    ThunderAutoProjectState& state,
+    bool start,
+    bool end,
+    StateChangeSet* changes) const {
+  const std::string& currentTrajectoryName = state.editorState.trajectoryEditorState.currentTrajectoryName;
+  const ThunderAutoTrajectorySkeleton& currentSkeleton = state.currentTrajectory();
+
+  struct Source {
+    TrajectoryEnd end;
+    std::string linkName;
+    CanonicalAngle rotation;
+  };
+
+  std::vector<Source> sources;
+  if (start && currentSkeleton.hasStartBehaviorLink()) {
+    sources.push_back({TrajectoryEnd::START, currentSkeleton.startBehaviorLinkName(),
+                       currentSkeleton.startRotation()});
+  }
+  if (end && currentSkeleton.hasEndBehaviorLink()) {
+    sources.push_back(
+        {TrajectoryEnd::END, currentSkeleton.endBehaviorLinkName(), currentSkeleton.endRotation()});
+  }
+
+  for (const Source& source : sources) {
+    if (!IndexMatchesState(state, source.linkName, linkedTrajectoryEnds(source.linkName))) {
+      state.trajectoryUpdateAllLinkedTrajectoryEndBehaviorsFromCurrentTrajectoryEndBehavior(start, end);
+      AddAllTrajectories(state, changes);
+      return;
+    }
+  }
+
+  for (const Source& source : sources) {
+    for (const LinkedTrajectoryEnd& linked : linkedTrajectoryEnds(source.linkName)) {
+      if (linked.trajectoryName == currentTrajectoryName && linked.end == source.end)
+        continue;
+
+      ThunderAutoTrajectorySkeleton& skeleton = state.trajectories.at(linked.trajectoryName);
+      if (linked.end == TrajectoryEnd::START) {
+        skeleton.setStartRotation(source.rotation);
+      } else {
+        skeleton.setEndRotation(source.rotation);
+      }
+
+      if (changes) {
+        changes->trajectories.insert(linked.trajectoryName);
+      }
+    }
+  }
+}
+
+void TrajectoryLinkIndex::addTrajectory(const std::string& trajectoryName,
+                                        const ThunderAutoTrajectorySkeleton& skeleton) {
+  TrajectoryLinks& trajectoryLinks = m_trajectoryLinks[trajectoryName];
+
+  size_t waypointIndex = 0;
+  for (auto it = skeleton.begin(); it != skeleton.end(); ++it, ++waypointIndex) {
+    if (!it->isLinked())
+      continue;
+
+    std::string linkName(it->linkName());
+    m_waypointLinks[linkName].push_back({trajectoryName, waypointIndex});
+    trajectoryLinks.waypointLinkNames.push_back(std::move(linkName));
+  }
+
+  if (skeleton.hasStartBehaviorLink()) {
+    trajectoryLinks.startBehaviorLinkName = skeleton.startBehaviorLinkName();
+    m_endBehaviorLinks[trajectoryLinks.startBehaviorLinkName].push_back(
+        {trajectoryName, TrajectoryEnd::START});
+  }
+  if (skeleton.hasEndBehaviorLink()) {
+    trajectoryLinks.endBehaviorLinkName = skeleton.endBehaviorLinkName();
+    m_endBehaviorLinks[trajectoryLinks.endBehaviorLinkName].push_back({trajectoryName, TrajectoryEnd::END});
+  }
+
+  if (trajectoryLinks.waypointLinkNames.empty() && trajectoryLinks.startBehaviorLinkName.empty() &&
+      trajectoryLinks.endBehaviorLinkName.empty()) {
+    m_trajectoryLinks.erase(trajectoryName);
+  }
+}
+
+void TrajectoryLinkIndex::removeTrajectory(const std::string& trajectoryName) {
+  auto trajectoryIt = m_trajectoryLinks.find(trajectoryName);
+  if (trajectoryIt == m_trajectoryLinks.end())
+    return;
+
+  const TrajectoryLinks& trajectoryLinks = trajectoryIt->second;
+
+  for (const std::string& linkName : trajectoryLinks.waypointLinkNames) {
+    auto linkIt = m_waypointLinks.find(linkName);
+    if (linkIt == m_waypointLinks.end())
+      continue;
+
+    std::erase_if(linkIt->second,
+                  [&](const LinkedWaypoint& linked) { return linked.trajectoryName == trajectoryName; });
+    if (linkIt->second.empty()) {
+      m_waypointLinks.erase(linkIt);
+    }
+  }
+
+  for (const std::string* linkName : {&trajectoryLinks.startBehaviorLinkName,
+                                      &trajectoryLinks.endBehaviorLinkName}) {
+    auto linkIt = m_endBehaviorLinks.find(*linkName);
+    if (linkIt == m_endBehaviorLinks.end())
+      continue;
+
+    std::erase_if(linkIt->second,
+                  [&](const LinkedTrajectoryEnd& linked) { return linked.trajectoryName == trajectoryName; });
+    if (linkIt->second.empty()) {
+      m_endBehaviorLinks.erase(linkIt);
+    }
+  }
+
+  m_trajectoryLinks.erase(trajectoryIt);
+}
@@ -0,0 +1,425 @@
+#include <ThunderAuto/TrajectoryThumbnails.hpp>
+
+#include <ThunderAuto/AutoModeStepIndex.hpp>
+#include <ThunderAuto/ColorPalette.hpp>
+#include <ThunderAuto/ThreadPool.hpp>
+#include <ThunderAuto/Logger.hpp>
+#include <ThunderAuto/Error.hpp>
+#include <ThunderAuto/Types.hpp>
+#include <ThunderLibCore/Auto/ThunderAutoOutputTrajectory.hpp>
+#include <algorithm>
+#include <chrono>
+
+static const ImU32 kPathColor = ThunderAutoColorPalette::kBlueHigh;
+static const ImU32 kHiddenPathColor = ThunderAutoColorPalette::kBlueLow;
+static const ImU32 kStartPointColor = ThunderAutoColorPalette::kGreenHigh;
+static const ImU32 kEndPointColor = ThunderAutoColorPalette::kRedHigh;
+static const ImU32 kTileBackgroundColor = ThunderAutoColorPalette::kBackground;
+
+static constexpr float kPathThickness = 1.5f;
+static constexpr float kEndPointRadius = 2.f;
+static constexpr float kTilePadding = 3.f;
+
+// Paths are drawn with at most this many points, since a tile is only a few dozen pixels across.
+static constexpr size_t kMaxPathPoints = 128;
+
+using Tile = TrajectoryThumbnails::Tile;
+
+static ImVec2 ToTilePoint(const Point2d& position, Measurement2d fieldSize) {
+  const float tileWidth = static_cast<float>(TrajectoryThumbnails::kTileWidth);
+  const float tileHeight = static_cast<float>(TrajectoryThumbnails::kTileHeight);
+
+  const ImVec2 field = ToImVec2(fieldSize);
+  if (field.x <= 0.f || field.y <= 0.f)
+    return ImVec2(tileWidth / 2.f, tileHeight / 2.f);
+
+  // The whole field fits in the tile, centered.
+  const float scale =
+      std::min((tileWidth - kTilePadding * 2.f) / field.x, (tileHeight - kTilePadding * 2.f) / field.y);
+  const ImVec2 offset((tileWidth - field.x * scale) / 2.f, (tileHeight - field.y * scale) / 2.f);
+
+  const ImVec2 pt = ToImVec2(position);
+  return ImVec2(offset.x + pt.x * scale, tileHeight - (offset.y + pt.y * scale));
+}
+
+static void DrawPath(SoftwareCanvas& canvas, std::span<const ImVec2> path, bool isHidden) {
+  if (path.empty())
+    return;
+
+  canvas.drawPolyline(path, isHidden ? kHiddenPathColor : kPathColor, kPathThickness);
+
+  if (!isHidden) {
+    canvas.fillCircle(path.front(), kEndPointRadius, kStartPointColor);
+    canvas.fillCircle(path.back(), kEndPointRadius, kEndPointColor);
+  }
+}
+
+void TrajectoryThumbnails::invalidateTrajectory(const std::string& trajectoryName) noexcept {
+  auto it = m_trajectories.find(trajectoryName);
+  if (it != m_trajectories.end()) {
+    it->second.generation++;
+  }
+}
+
+void TrajectoryThumbnails::invalidateAutoMode(const std::string& autoModeName) noexcept {
+  auto it = m_autoModes.find(autoModeName);
+  if (it != m_autoModes.end()) {
+    it->second.generation++;
+  }
+}
+
+void TrajectoryThumbnails::invalidateAll() noexcept {
+  for (auto& [name, entry] : m_trajectories) {
+    entry.generation++;
+  }
+  for (auto& [name, entry] : m_autoModes) {
+    entry.generation++;
+  }
+}
+
+void TrajectoryThumbnails::clear() noexcept {
+  // Pending thumbnails are left to finish on their own, since they hold on to everything they use.
+  m_trajectories.clear();
+  m_autoModes.clear();
+
+  m_numTiles = 0;
+  m_freeTiles.clear();
+
+  m_atlas = SoftwareCanvas();
+  m_isAtlasChanged = false;
+}
+
+void TrajectoryThumbnails::update(const ThunderAutoProjectState& state,
+                                  PreviewTrajectoryCache& previewTrajectories,
+                                  Measurement2d fieldSize) {
+  if (fieldSize != m_fieldSize) {
+    m_fieldSize = fieldSize;
+    invalidateAll();
+  }
+
+  updateTrajectories(state, previewTrajectories);
+  updateAutoModes(state);
+
+  if (m_isAtlasChanged) {
+    uploadAtlas();
+  }
+}
+
+void TrajectoryThumbnails::updateTrajectories(const ThunderAutoProjectState& state,
+                                              PreviewTrajectoryCache& previewTrajectories) {
+  for (auto it = m_trajectories.begin(); it != m_trajectories.end();) {
+    if (state.trajectories.contains(it->first)) {
+      ++it;
+      continue;
+    }
+
+    freeTile(it->second.tileIndex);
+    invalidateAutoModesUsing(it->first);
+    it = m_trajectories.erase(it);
+  }
+
+  for (const auto& [trajectoryName, skeleton] : state.trajectories) {
+    auto [entryIt, isNew] = m_trajectories.try_emplace(trajectoryName);
+    TrajectoryEntry& entry = entryIt->second;
+
+    if (isNew) {
+      entry.tileIndex = allocateTile();
+    }
+
+    if (entry.pendingResult.valid()) {
+      if (entry.pendingResult.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        continue;
+
+      try {
+        TrajectoryResult result = entry.pendingResult.get();
+
+        // Drop the result if the trajectory changed while it was being drawn.
+        if (entry.pendingGeneration == entry.generation) {
+          entry.path = std::move(result.path);
+          setTile(entry.tileIndex, result.tile);
+          entry.drawnGeneration = entry.generation;
+          invalidateAutoModesUsing(trajectoryName);
+        }
+
+      } catch (const ThunderError& e) {
+        ThunderAutoLogger::Warn("Failed to draw thumbnail of trajectory '{}': {}", trajectoryName,
+                                e.message());
+        entry.path.reset();
+        setTile(entry.tileIndex, SoftwareCanvas(kTileWidth, kTileHeight));
+        entry.drawnGeneration = entry.generation;
+
+      } catch (const std::exception& e) {
+        ThunderAutoLogger::Warn("Failed to draw thumbnail of trajectory '{}': {}", trajectoryName, e.what());
+        entry.path.reset();
+        setTile(entry.tileIndex, SoftwareCanvas(kTileWidth, kTileHeight));
+        entry.drawnGeneration = entry.generation;
+      }
+    }
+
+    if (entry.drawnGeneration == entry.generation)
+      continue;
+
+    std::optional<std::shared_ptr<const ThunderAutoOutputTrajectory>> trajectory =
+        previewTrajectories.request(trajectoryName, skeleton);
+    if (!trajectory)
+      continue;
+
+    // The cache has already said why it failed.
+    if (!*trajectory) {
+      entry.path.reset();
+      setTile(entry.tileIndex, SoftwareCanvas(kTileWidth, kTileHeight));
+      entry.drawnGeneration = entry.generation;
+      invalidateAutoModesUsing(trajectoryName);
+      continue;
+    }
+
+    entry.pendingGeneration = entry.generation;
+    entry.pendingResult = ThreadPool::get().submit(
+        [trajectory = std::move(*trajectory), fieldSize = m_fieldSize] {
+          return DrawTrajectory(*trajectory, fieldSize);
+        });
+  }
+}
+
+void TrajectoryThumbnails::updateAutoModes(const ThunderAutoProjectState& state) {
+  for (auto it = m_autoModes.begin(); it != m_autoModes.end();) {
+    if (state.autoModes.contains(it->first)) {
+      ++it;
+      continue;
+    }
+
+    freeTile(it->second.tileIndex);
+    it = m_autoModes.erase(it);
+  }
+
+  AutoModeStepIndex stepIndex;
+
+  for (const auto& [autoModeName, autoMode] : state.autoModes) {
+    auto [entryIt, isNew] = m_autoModes.try_emplace(autoModeName);
+    AutoModeEntry& entry = entryIt->second;
+
+    if (isNew) {
+      entry.tileIndex = allocateTile();
+    }
+
+    if (entry.trajectoryStepsGeneration != entry.generation) {
+      stepIndex.rebuild(autoMode);
+
+      entry.trajectorySteps.clear();
+      for (size_t entryIndex : stepIndex.editorOrder()) {
+        const AutoModeStepIndex::Entry& step = stepIndex.entries()[entryIndex];
+        if (step.type == ThunderAutoModeStepType::TRAJECTORY) {
+          entry.trajectorySteps.emplace_back(step.itemName, step.isActive);
+        }
+      }
+      entry.trajectoryStepsGeneration = entry.generation;
+    }
+
+    if (entry.pendingTile.valid()) {
+      if (entry.pendingTile.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        continue;
+
+      try {
+        SoftwareCanvas tile = entry.pendingTile.get();
+
+        // Drop the result if the auto mode changed while it was being drawn.
+        if (entry.pendingGeneration == entry.generation) {
+          setTile(entry.tileIndex, tile);
+          entry.drawnGeneration = entry.generation;
+        }
+
+      } catch (const ThunderError& e) {
+        ThunderAutoLogger::Warn("Failed to draw thumbnail of auto mode '{}': {}", autoModeName, e.message());
+        setTile(entry.tileIndex, SoftwareCanvas(kTileWidth, kTileHeight));
+        entry.drawnGeneration = entry.generation;
+
+      } catch (const std::exception& e) {
+        ThunderAutoLogger::Warn("Failed to draw thumbnail of auto mode '{}': {}", autoModeName, e.what());
+        setTile(entry.tileIndex, SoftwareCanvas(kTileWidth, kTileHeight));
+        entry.drawnGeneration = entry.generation;
+      }
+    }
+
+    if (entry.drawnGeneration == entry.generation)
+      continue;
+
+    std::vector<std::pair<std::shared_ptr<const Path>, bool>> trajectorySteps;
+    trajectorySteps.reserve(entry.trajectorySteps.size());
+
+    // Wait until the trajectories have been drawn once, rather than drawing the auto mode again as each one
+    // finishes.
+    bool isWaitingForTrajectory = false;
+    for (const auto& [trajectoryName, isActive] : entry.trajectorySteps) {
+      auto trajectoryIt = m_trajectories.find(trajectoryName);
+      if (trajectoryIt == m_trajectories.end())
+        continue;
+
+      if (!trajectoryIt->second.drawnGeneration) {
+        isWaitingForTrajectory = true;
+        break;
+      }
+      trajectorySteps.emplace_back(trajectoryIt->second.path, isActive);
+    }
+    if (isWaitingForTrajectory)
+      continue;
+
+    entry.pendingGeneration = entry.generation;
+    entry.pendingTile = ThreadPool::get().submit(
+        [trajectorySteps = std::move(trajectorySteps)] { return DrawAutoMode(trajectorySteps); });
+  }
+}
+
+void TrajectoryThumbnails::invalidateAutoModesUsing(const std::string& trajectoryName) noexcept {
+  for (auto& [name, entry] : m_autoModes) {
+    const bool usesTrajectory =
+        std::any_of(entry.trajectorySteps.begin(), entry.trajectorySteps.end(),
+                    [&](const auto& trajectoryStep) { return trajectoryStep.first == trajectoryName; });
+    if (usesTrajectory) {
+      entry.generation++;
+    }
+  }
+}
+
+size_t TrajectoryThumbnails::allocateTile() {
+  if (!m_freeTiles.empty()) {
+    const size_t tileIndex = m_freeTiles.back();
+    m_freeTiles.pop_back();
+    return tileIndex;
+  }
+
+  const size_t tileIndex = m_numTiles++;
+
+  // The atlas grows a row at a time. New rows are only uploaded once a tile in them is drawn.
+  const int numRows = static_cast<int>((m_numTiles + kAtlasColumns - 1) / kAtlasColumns);
+  if (m_atlas.height() < numRows * kTileHeight) {
+    m_atlas.resize(kAtlasColumns * kTileWidth, numRows * kTileHeight);
+  }
+
+  return tileIndex;
+}
+
+void TrajectoryThumbnails::freeTile(size_t tileIndex) noexcept {
+  const int x = static_cast<int>(tileIndex % kAtlasColumns) * kTileWidth;
+  const int y = static_cast<int>(tileIndex / kAtlasColumns) * kTileHeight;
+  m_atlas.fillRect(x, y, kTileWidth, kTileHeight, IM_COL32(0, 0, 0, 0));
+
+  m_freeTiles.push_back(tileIndex);
+}
+
+void TrajectoryThumbnails::setTile(size_t tileIndex, const SoftwareCanvas& tile) {
+  const int x = static_cast<int>(tileIndex % kAtlasColumns) * kTileWidth;
+  const int y = static_cast<int>(tileIndex / kAtlasColumns) * kTileHeight;
+  m_atlas.copyFrom(tile, x, y);
+
+  m_isAtlasChanged = true;
+}
+
+void TrajectoryThumbnails::uploadAtlas() {
+  m_isAtlasChanged = false;
+
+  if (m_atlas.width() == 0 || m_atlas.height() == 0)
+    return;
+
+  if (!m_texture) {
+    m_texture = PlatformTexture::make();
+  }
+
+  try {
+    m_texture->loadFromPixels(m_atlas.data(), m_atlas.width(), m_atlas.height(), 4);
+
+  } catch (const ThunderError& e) {
+    ThunderAutoLogger::Warn("Failed to upload trajectory thumbnails: {}", e.message());
+  }
+}
+
+std::optional<Tile> TrajectoryThumbnails::trajectoryTile(const std::string& trajectoryName) const noexcept {
+  auto it = m_trajectories.find(trajectoryName);
+  if (it == m_trajectories.end() || !it->second.drawnGeneration)
+    return std::nullopt;
+
+  return tile(it->second.tileIndex);
+}
+
+std::optional<Tile> TrajectoryThumbnails::autoModeTile(const std::string& autoModeName) const noexcept {
+  auto it = m_autoModes.find(autoModeName);
+  if (it == m_autoModes.end() || !it->second.drawnGeneration)
+    return std::nullopt;
+
+  return tile(it->second.tileIndex);
+}
+
+std::optional<Tile> TrajectoryThumbnails::tile(size_t tileIndex) const noexcept {
+  if (!m_texture)
+    return std::nullopt;
+
+  const float textureWidth = static_cast<float>(m_texture->width());
+  const float textureHeight = static_cast<float>(m_texture->height());
+
+  const int x = static_cast<int>(tileIndex % kAtlasColumns) * kTileWidth;
+  const int y = static_cast<int>(tileIndex / kAtlasColumns) * kTileHeight;
+
+  // The tile may have been drawn after the last upload failed.
+  if (x + kTileWidth > m_texture->width() || y + kTileHeight > m_texture->height())
+    return std::nullopt;
+
+  return Tile{
+      .texture = m_texture->id(),
+      .uv0 = ImVec2(static_cast<float>(x) / textureWidth, static_cast<float>(y) / textureHeight),
+      .uv1 = ImVec2(static_cast<float>(x + kTileWidth) / textureWidth,
+                    static_cast<float>(y + kTileHeight) / textureHeight),
+  };
+}
+
+void TrajectoryThumbnails::DrawTileInRow(ImDrawList* drawList,
+                                         const Tile& tile,
+                                         ImVec2 rowMin,
+                                         ImVec2 rowMax) {
+  const float height = rowMax.y - rowMin.y;
+  const float width = height * static_cast<float>(kTileWidth) / static_cast<float>(kTileHeight);
+
+  // Leave room for the row's label.
+  if (width * 2.f > rowMax.x - rowMin.x)
+    return;
+
+  const ImVec2 min(rowMax.x - width, rowMin.y);
+  drawList->AddRectFilled(min, rowMax, kTileBackgroundColor, ImGui::GetStyle().FrameRounding);
+  drawList->AddImage(tile.texture, min, rowMax, tile.uv0, tile.uv1);
+}
+
+TrajectoryThumbnails::TrajectoryResult TrajectoryThumbnails::DrawTrajectory(
+    const ThunderAutoOutputTrajectory& trajectory,
+    Measurement2d fieldSize) {
+  const std::vector<ThunderAutoOutputTrajectoryPoint>& points = trajectory.points;
+
+  auto path = std::make_shared<Path>();
+  if (!points.empty()) {
+    const size_t stride = std::max<size_t>(1, (points.size() + kMaxPathPoints - 1) / kMaxPathPoints);
+    path->reserve(points.size() / stride + 2);
+
+    for (size_t i = 0; i < points.size(); i += stride) {
+      path->push_back(ToTilePoint(points[i].position, fieldSize));
+    }
+    if ((points.size() - 1) % stride != 0) {
+      path->push_back(ToTilePoint(points.back().position, fieldSize));
+    }
+  }
+
+  SoftwareCanvas tile(kTileWidth, kTileHeight);
+  DrawPath(tile, *path, false);
+
+  return TrajectoryResult{std::move(path), std::move(tile)};
+}
+
+SoftwareCanvas TrajectoryThumbnails::DrawAutoMode(
+    const std::vector<std::pair<std::shared_ptr<const Path>, bool>>& trajectorySteps) {
+  SoftwareCanvas tile(kTileWidth, kTileHeight);
+
+  // Steps are in the order the editor draws them, so the displayed branches end up on top.
+  for (const auto& [path, isActive] : trajectorySteps) {
+    if (path) {
+      DrawPath(tile, *path, !isActive);
+    }
+  }
+
+  return tile;
+}
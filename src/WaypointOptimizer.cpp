@@ -0,0 +1,506 @@
+#include <ThunderAuto/WaypointOptimizer.hpp>
+
+#include <ThunderAuto/ThreadPool.hpp>
+#include <ThunderAuto/Logger.hpp>
+#include <ThunderAuto/Error.hpp>
+#include <ThunderLibCore/Auto/ThunderAutoOutputTrajectory.hpp>
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <span>
+
+using WaypointChange = WaypointOptimizer::WaypointChange;
+using Score = WaypointOptimizer::Score;
+
+const char* WaypointOptimizerObjectiveToString(WaypointOptimizerObjective objective) noexcept {
+  switch (objective) {
+    using enum WaypointOptimizerObjective;
+    case TIME:
+      return "Time";
+    case PEAK_CURVATURE:
+      return "Peak Curvature";
+    default:
+      ThunderAutoUnreachable("Unknown waypoint optimizer objective");
+  }
+}
+
+std::shared_ptr<const WaypointOptimizerBounds> WaypointOptimizerBounds::Make(
+    const ThunderAutoProjectSettings& settings,
+    const KeepOutZoneList& keepOutZones) {
+  auto bounds = std::make_shared<WaypointOptimizerBounds>();
+  bounds->fieldSize = settings.fieldImage.fieldSize();
+
+  // The same footprint the collision checker uses.
+  constexpr size_t kNumPointsPerCorner = 4;
+  bounds->footprint = PolylineToSoA(
+      CreateRoundedRectangle(settings.robotSize, settings.robotCornerRadius, kNumPointsPerCorner));
+
+  auto geometry = std::make_shared<const KeepOutGeometry>(keepOutZones);
+  if (!geometry->empty()) {
+    bounds->keepOutGeometry = std::move(geometry);
+  }
+
+  return bounds;
+}
+
+namespace {
+
+// Candidates are sampled this far from their parent (in the normalized search space) at the start, and again
+// whenever the search area gets smaller than kMinStepSize.
+constexpr double kInitialStepSize = 0.5;
+constexpr double kMinStepSize = 0.02;
+
+// New candidates are sampled around this many of the best candidates.
+constexpr size_t kNumParents = 3;
+
+/**
+ * Maps between points in the search space, where every variable goes from -1 to 1 and 0 is where the user
+ * left it, and trajectories.
+ */
+class SearchSpace {
+ public:
+  using Point = std::vector<double>;
+
+ private:
+  enum class VariableKind {
+    POSITION_X,
+    POSITION_Y,
+    HEADING,  // Both headings together, for waypoints that aren't stopped (or are at the ends).
+    INCOMING_HEADING,
+    OUTGOING_HEADING,
+    INCOMING_WEIGHT,
+    OUTGOING_WEIGHT,
+  };
+
+  struct Variable {
+    size_t waypointIndex;
+    VariableKind kind;
+  };
+
+  const ThunderAutoTrajectorySkeleton& m_skeleton;
+  const WaypointOptimizerSettings& m_settings;
+
+  std::vector<Variable> m_variables;
+
+  // Indices of the waypoints that have at least one variable.
+  std::vector<size_t> m_waypoints;
+
+ public:
+  SearchSpace(const ThunderAutoTrajectorySkeleton& skeleton, const WaypointOptimizerSettings& settings)
+    : m_skeleton(skeleton), m_settings(settings) {
+    const size_t numPoints = skeleton.numPoints();
+
+    size_t waypointIndex = 0;
+    for (auto it = skeleton.begin(); it != skeleton.end(); ++it, ++waypointIndex) {
+      const ThunderAutoTrajectorySkeletonWaypoint& waypoint = *it;
+      if (waypoint.isEditorLocked())
+        continue;
+
+      const bool isFirst = waypointIndex == 0;
+      const bool isLast = waypointIndex + 1 == numPoints;
+      const size_t numVariablesBefore = m_variables.size();
+
+      // The ends of the trajectory and linked waypoints are where other trajectories start or end.
+      if (settings.movePositions && !isFirst && !isLast && !waypoint.isLinked()) {
+        m_variables.push_back({waypointIndex, VariableKind::POSITION_X});
+        m_variables.push_back({waypointIndex, VariableKind::POSITION_Y});
+      }
+
+      if (settings.changeHeadings) {
+        if (waypoint.isStopped() && !isFirst && !isLast) {
+          m_variables.push_back({waypointIndex, VariableKind::INCOMING_HEADING});
+          m_variables.push_back({waypointIndex, VariableKind::OUTGOING_HEADING});
+        } else {
+          m_variables.push_back({waypointIndex, VariableKind::HEADING});
+        }
+      }
+
+      if (settings.changeWeights && settings.maxWeightScale > 1.0) {
+        if (!isFirst) {
+          m_variables.push_back({waypointIndex, VariableKind::INCOMING_WEIGHT});
+        }
+        if (!isLast) {
+          m_variables.push_back({waypointIndex, VariableKind::OUTGOING_WEIGHT});
+        }
+      }
+
+      if (m_variables.size() != numVariablesBefore) {
+        m_waypoints.push_back(waypointIndex);
+      }
+    }
+  }
+
+  size_t numVariables() const noexcept { return m_variables.size(); }
+
+  ThunderAutoTrajectorySkeleton toSkeleton(const Point& point) const {
+    ThunderAutoAssert(point.size() == numVariables());
+
+    ThunderAutoTrajectorySkeleton skeleton = m_skeleton;
+
+    const double logMaxWeightScale = std::log(m_settings.maxWeightScale);
+
+    // Variables of the same waypoint are next to each other.
+    for (size_t i = 0; i < m_variables.size();) {
+      const size_t waypointIndex = m_variables[i].waypointIndex;
+
+      auto waypointIt = std::next(skeleton.begin(), static_cast<std::ptrdiff_t>(waypointIndex));
+      ThunderAutoTrajectorySkeletonWaypoint& waypoint = *waypointIt;
+
+      Point2d position = waypoint.position();
+      ThunderAutoTrajectorySkeletonWaypoint::HeadingAngles headings = waypoint.headings();
+      ThunderAutoTrajectorySkeletonWaypoint::HeadingWeights weights = waypoint.headingWeights();
+
+      for (; i < m_variables.size() && m_variables[i].waypointIndex == waypointIndex; i++) {
+        const double x = std::clamp(point[i], -1.0, 1.0);
+
+        switch (m_variables[i].kind) {
+          using enum VariableKind;
+          case POSITION_X:
+            position = Point2d(position.x() + m_settings.maxPositionChange * x, position.y());
+            break;
+          case POSITION_Y:
+            position = Point2d(position.x(), position.y() + m_settings.maxPositionChange * x);
+            break;
+          case HEADING:
+            headings.setOutgoingAngle(
+                CanonicalAngle(headings.outgoingAngle().degrees() + m_settings.maxHeadingChange * x), true);
+            break;
+          case INCOMING_HEADING:
+            headings.setIncomingAngle(
+                CanonicalAngle(headings.incomingAngle().degrees() + m_settings.maxHeadingChange * x), false);
+            break;
+          case OUTGOING_HEADING:
+            headings.setOutgoingAngle(
+                CanonicalAngle(headings.outgoingAngle().degrees() + m_settings.maxHeadingChange * x), false);
+            break;
+          case INCOMING_WEIGHT:
+            weights.setIncomingWeight(weights.incomingWeight() * std::exp(logMaxWeightScale * x));
+            break;
+          case OUTGOING_WEIGHT:
+            weights.setOutgoingWeight(weights.outgoingWeight() * std::exp(logMaxWeightScale * x));
+            break;
+          default:
+            ThunderAutoUnreachable("Unknown waypoint optimizer variable");
+        }
+      }
+
+      waypoint.setPosition(position);
+      waypoint.setHeadings(headings);
+      waypoint.setHeadingWeights(weights);
+    }
+
+    return skeleton;
+  }
+
+  std::vector<WaypointChange> toChanges(const Point& point) const {
+    const ThunderAutoTrajectorySkeleton skeleton = toSkeleton(point);
+
+    std::vector<WaypointChange> changes;
+    changes.reserve(m_waypoints.size());
+
+    for (size_t waypointIndex : m_waypoints) {
+      auto waypointIt = std::next(skeleton.begin(), static_cast<std::ptrdiff_t>(waypointIndex));
+
+      changes.push_back(WaypointChange{
+          .waypointIndex = waypointIndex,
+          .position = waypointIt->position(),
+          .headings = waypointIt->headings(),
+          .headingWeights = waypointIt->headingWeights(),
+      });
+    }
+
+    return changes;
+  }
+};
+
+/**
+ * Scores a trajectory built with kPreviewOutputTrajectorySettings.
+ */
+Score ScoreTrajectory(const ThunderAutoOutputTrajectory& trajectory, const WaypointOptimizerBounds& bounds) {
+  Score score;
+  score.totalTime = trajectory.totalTime;
+
+  std::span<const ThunderAutoOutputTrajectoryPoint> points = trajectory.points;
+
+  for (const ThunderAutoOutputTrajectoryPoint& point : points) {
+    score.peakCurvature = std::max(score.peakCurvature, std::abs(static_cast<double>(point.curvature())));
+  }
+
+  // Inside the field.
+
+  const size_t numVertices = bounds.footprint.size();
+
+  std::vector<PolygonTransform> transforms;
+  transforms.reserve(points.size());
+  for (const ThunderAutoOutputTrajectoryPoint& point : points) {
+    transforms.push_back(PolygonTransform::FromPose(point.position, point.rotation));
+  }
+
+  std::vector<float> outlineX(transforms.size() * numVertices), outlineY(transforms.size() * numVertices);
+  TransformPolygonBatch(bounds.footprint, transforms, outlineX, outlineY);
+
+  const float fieldX = static_cast<float>(bounds.fieldSize.x());
+  const float fieldY = static_cast<float>(bounds.fieldSize.y());
+
+  if (!outlineX.empty()) {
+    const auto [minX, maxX] = std::minmax_element(outlineX.begin(), outlineX.end());
+    const auto [minY, maxY] = std::minmax_element(outlineY.begin(), outlineY.end());
+
+    if (*minX < 0.f || *maxX > fieldX || *minY < 0.f || *maxY > fieldY)
+      return score;
+  }
+
+  // Out of the keep-out zones.
+
+  if (bounds.keepOutGeometry &&
+      !CollisionChecker::CheckTrajectory(trajectory, *bounds.keepOutGeometry, bounds.footprint).empty())
+    return score;
+
+  score.isWithinBounds = true;
+  return score;
+}
+
+double ObjectiveValue(const Score& score, WaypointOptimizerObjective objective) {
+  switch (objective) {
+    using enum WaypointOptimizerObjective;
+    case TIME:
+      return score.totalTime.value();
+    case PEAK_CURVATURE:
+      return score.peakCurvature;
+    default:
+      ThunderAutoUnreachable("Unknown waypoint optimizer objective");
+  }
+}
+
+std::vector<Point2d> TrajectoryPath(const ThunderAutoOutputTrajectory& trajectory) {
+  std::vector<Point2d> path;
+  path.reserve(trajectory.points.size());
+  for (const ThunderAutoOutputTrajectoryPoint& point : trajectory.points) {
+    path.push_back(point.position);
+  }
+  return path;
+}
+
+struct Evaluation {
+  SearchSpace::Point point;
+  Score score;
+  std::vector<Point2d> path;  // Only if within bounds.
+
+  bool skipped = false;
+};
+
+}  // namespace
+
+WaypointOptimizer::WaypointOptimizer(ThunderAutoTrajectorySkeleton skeleton,
+                                     WaypointOptimizerSettings settings,
+                                     std::shared_ptr<const WaypointOptimizerBounds> bounds)
+  : m_sharedState(std::make_shared<SharedState>()),
+    m_startTime(std::chrono::steady_clock::now()),
+    m_timeBudget(settings.timeBudget) {
+  const auto deadline =
+      m_startTime + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                        std::chrono::duration<double>(settings.timeBudget.value()));
+
+  m_future = std::async(std::launch::async, &WaypointOptimizer::Run, std::move(skeleton), settings,
+                        std::move(bounds), deadline, m_sharedState);
+}
+
+float WaypointOptimizer::progress() const noexcept {
+  if (m_timeBudget <= 0_s)
+    return 1.f;
+
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - m_startTime;
+  return static_cast<float>(std::min(elapsed.count() / m_timeBudget.value(), 1.0));
+}
+
+bool WaypointOptimizer::bestPathSoFar(size_t& generation, std::vector<Point2d>& path) const {
+  std::lock_guard<std::mutex> lock(m_sharedState->bestPathMutex);
+
+  if (m_sharedState->bestPathGeneration == generation)
+    return false;
+
+  generation = m_sharedState->bestPathGeneration;
+  path = m_sharedState->bestPath;
+  return true;
+}
+
+bool WaypointOptimizer::isFinished() const {
+  ThunderAutoAssert(m_future.valid(), "Waypoint optimizer result was already taken");
+
+  return m_future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+WaypointOptimizer::Result WaypointOptimizer::takeResult() {
+  ThunderAutoAssert(m_future.valid(), "Waypoint optimizer result was already taken");
+
+  return m_future.get();
+}
+
+void WaypointOptimizer::ApplyChanges(ThunderAutoTrajectorySkeleton& skeleton,
+                                     const std::vector<WaypointChange>& changes) {
+  for (const WaypointChange& change : changes) {
+    ThunderAutoAssert(change.waypointIndex < skeleton.numPoints());
+
+    auto waypointIt = std::next(skeleton.begin(), static_cast<std::ptrdiff_t>(change.waypointIndex));
+    waypointIt->setPosition(change.position);
+    waypointIt->setHeadings(change.headings);
+    waypointIt->setHeadingWeights(change.headingWeights);
+  }
+}
+
+WaypointOptimizer::Result WaypointOptimizer::Run(ThunderAutoTrajectorySkeleton skeleton,
+                                                 WaypointOptimizerSettings settings,
+                                                 std::shared_ptr<const WaypointOptimizerBounds> bounds,
+                                                 std::chrono::steady_clock::time_point deadline,
+                                                 std::shared_ptr<SharedState> sharedState) {
+  Result result;
+
+  try {
+    const SearchSpace space(skeleton, settings);
+
+    std::unique_ptr<ThunderAutoOutputTrajectory> originalTrajectory =
+        BuildThunderAutoOutputTrajectory(skeleton, kPreviewOutputTrajectorySettings);
+    ThunderAutoAssert(originalTrajectory != nullptr);
+
+    result.originalScore = ScoreTrajectory(*originalTrajectory, *bounds);
+    result.bestScore = result.originalScore;
+
+    if (space.numVariables() == 0)
+      return result;
+
+    // If the original trajectory is out of bounds, anything within bounds is better.
+    double bestValue = result.originalScore.isWithinBounds
+                           ? ObjectiveValue(result.originalScore, settings.objective)
+                           : std::numeric_limits<double>::infinity();
+
+    std::vector<Evaluation> evaluations;  // Only those better than the original, best first.
+
+    std::mt19937 rng(1511);
+
+    const size_t batchSize = std::max<size_t>(8, 2 * ThreadPool::get().numWorkers());
+    double stepSize = kInitialStepSize;
+
+    auto isOutOfTime = [&] {
+      return sharedState->cancelled || std::chrono::steady_clock::now() >= deadline;
+    };
+
+    while (!isOutOfTime()) {
+      // Pick the points to try this round, around the best ones so far (or the original).
+
+      std::normal_distribution<double> step(0.0, stepSize);
+
+      const size_t numParents = std::min(kNumParents, evaluations.size());
+
+      std::vector<SearchSpace::Point> points;
+      for (size_t i = 0; i < batchSize; i++) {
+        SearchSpace::Point point =
+            numParents ? evaluations[i % numParents].point : SearchSpace::Point(space.numVariables(), 0.0);
+
+        for (double& x : point) {
+          x = std::clamp(x + step(rng), -1.0, 1.0);
+        }
+        points.push_back(std::move(point));
+      }
+
+      // Build them all in parallel.
+
+      std::vector<std::future<Evaluation>> futures;
+      for (SearchSpace::Point& point : points) {
+        futures.push_back(ThreadPool::get().submit(
+            [&space, &bounds, &isOutOfTime, &sharedState, point = std::move(point)]() mutable {
+              if (isOutOfTime())
+                return Evaluation{.point = std::move(point), .skipped = true};
+
+              const ThunderAutoTrajectorySkeleton candidateSkeleton = space.toSkeleton(point);
+
+              std::unique_ptr<ThunderAutoOutputTrajectory> trajectory =
+                  BuildThunderAutoOutputTrajectory(candidateSkeleton, kPreviewOutputTrajectorySettings);
+              ThunderAutoAssert(trajectory != nullptr);
+
+              Evaluation evaluation{
+                  .point = std::move(point),
+                  .score = ScoreTrajectory(*trajectory, *bounds),
+              };
+              if (evaluation.score.isWithinBounds) {
+                evaluation.path = TrajectoryPath(*trajectory);
+              }
+
+              sharedState->numEvaluated++;
+              return evaluation;
+            }));
+      }
+
+      bool improved = false;
+
+      for (Evaluation& evaluation : ThreadPool::GetAll(futures)) {
+        if (evaluation.skipped)
+          continue;
+
+        result.numEvaluated++;
+
+        if (!evaluation.score.isWithinBounds) {
+          result.numOutOfBounds++;
+          continue;
+        }
+
+        const double value = ObjectiveValue(evaluation.score, settings.objective);
+        if (value >= bestValue)
+          continue;
+
+        bestValue = value;
+        improved = true;
+
+        evaluations.push_back(std::move(evaluation));
+      }
+
+      std::sort(evaluations.begin(), evaluations.end(), [&](const Evaluation& a, const Evaluation& b) {
+        return ObjectiveValue(a.score, settings.objective) < ObjectiveValue(b.score, settings.objective);
+      });
+
+      // Only the parents are needed from here on.
+      if (evaluations.size() > kNumParents) {
+        evaluations.resize(kNumParents);
+      }
+
+      if (improved) {
+        std::lock_guard<std::mutex> lock(sharedState->bestPathMutex);
+        sharedState->bestPath = evaluations.front().path;
+        sharedState->bestPathGeneration++;
+      }
+
+      result.numRounds++;
+
+      // Narrow the search around the best candidates while it keeps failing to improve, then look wide again
+      // once the steps are too small to matter.
+      if (improved) {
+        stepSize = std::min(stepSize * 1.5, kInitialStepSize);
+      } else {
+        stepSize /= 2.0;
+        if (stepSize < kMinStepSize) {
+          stepSize = kInitialStepSize;
+        }
+      }
+    }
+
+    result.cancelled = sharedState->cancelled;
+
+    if (!evaluations.empty()) {
+      Evaluation& best = evaluations.front();
+
+      result.bestScore = best.score;
+      result.bestPath = std::move(best.path);
+      result.changes = space.toChanges(best.point);
+    }
+
+  } catch (const ThunderError& e) {
+    result.error = e.message();
+  } catch (const std::exception& e) {
+    result.error = e.what();
+  } catch (...) {
+    result.error = "Unknown error ocurred";
+  }
+
+  return result;
+}
@@ -1,28 +1,80 @@
 #include <ThunderAuto/App.hpp>
+#include <ThunderAuto/DocumentManager.hpp>
+#include <ThunderAuto/ImageExport.hpp>
 #include <ThunderAuto/Logger.hpp>
 #include <ThunderAuto/FontLibrary.hpp>
 #include <ThunderAuto/Graphics/Graphics.hpp>
 #include <ThunderAuto/Platform/Platform.hpp>
+#include <ThunderAuto/StartupTimeline.hpp>
 #include <imgui.h>
 #include <imgui_internal.h>
+#include <string_view>
+#include <vector>
 
-// Returns the path to the project file to open if provided as the first command line argument.
+static constexpr std::string_view kFastLaunchFlag = "--fast-launch";
+
+// Exports images of the start project's trajectories and auto modes to a directory, then exits without
+// opening a window.
+static constexpr std::string_view kExportImagesFlag = "--export-images";
+static constexpr std::string_view kExportFramesFlag = "--export-frames";
+
+// Returns whether a flag without a value was provided.
+static bool HasFlag(int argc, char** argv, std::string_view flag) {
+  for (int i = 1; i < argc; i++) {
+    if (argv[i] == flag) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Returns whether the fast launch flag was provided. When fast launching, the window is shown right away and
+// the start project is opened in the background.
+static bool IsFastLaunch(int argc, char** argv) {
+  return HasFlag(argc, argv, kFastLaunchFlag);
+}
+
+// Returns the directory to export images to if the export images flag was provided.
+static std::optional<std::filesystem::path> GetExportImagesDirectory(int argc, char** argv) {
+  for (int i = 1; i < argc; i++) {
+    if (argv[i] != kExportImagesFlag)
+      continue;
+
+    if (i + 1 >= argc) {
+      ThunderAutoLogger::Error("Expected a directory after '{}'", kExportImagesFlag);
+      return std::nullopt;
+    }
+    return std::filesystem::path(argv[i + 1]);
+  }
+  return std::nullopt;
+}
+
+// Returns the path to the project file to open if provided as the first non-flag command line argument.
 static std::optional<std::filesystem::path> GetStartProjectPath(int argc, char** argv) {
-  if (argc <= 1) {
+  std::vector<const char*> fileArgs;
+  for (int i = 1; i < argc; i++) {
+    if (argv[i] == kExportImagesFlag) {
+      i++;  // Skip the directory.
+    } else if (argv[i] != kFastLaunchFlag && argv[i] != kExportFramesFlag) {
+      fileArgs.push_back(argv[i]);
+    }
+  }
+
+  if (fileArgs.empty()) {
     return std::nullopt;
   }
 
-  std::filesystem::path path(argv[1]);
+  std::filesystem::path path(fileArgs.front());
   if (path.extension() != ".thunderauto") {
-    ThunderAutoLogger::Error("File '{}' does not have a .thunderauto extension", argv[1]);
+    ThunderAutoLogger::Error("File '{}' does not have a .thunderauto extension", fileArgs.front());
     return std::nullopt;
 
   } else if (!std::filesystem::exists(path)) {
-    ThunderAutoLogger::Error("Project file '{}' does not exist", argv[1]);
+    ThunderAutoLogger::Error("Project file '{}' does not exist", fileArgs.front());
     return std::nullopt;
   }
 
-  if (argc > 2) {
+  if (fileArgs.size() > 1) {
     ThunderAutoLogger::Warn("Received more than one argument, ignoring all but the first file path");
   }
 
@@ -30,6 +82,43 @@ static std::optional<std::filesystem::path> GetStartProjectPath(int argc, char**
   return startProjectPath;
 }
 
+// Exports images of a project without opening a window, see ImageExport.
+static int ExportImages(const std::filesystem::path& projectPath,
+                        const std::filesystem::path& outputDirectory,
+                        bool exportFrames) {
+  ThunderAutoLogger::Info("Export images of '{}' to '{}'", projectPath.string(), outputDirectory.string());
+
+  ImageExport::Options options;
+  options.exportFrames = exportFrames;
+
+  ImageExport::Result result;
+  try {
+    DocumentManager::LoadedProject project = DocumentManager::LoadProject(projectPath);
+
+    ImageExport imageExport(std::move(project.state), std::move(project.settings), outputDirectory, options);
+    result = imageExport.takeResult();
+
+  } catch (const ThunderError& e) {
+    ThunderAutoLogger::Error("Failed to export images of '{}': {}", projectPath.string(), e.message());
+    return 1;
+  } catch (const std::exception& e) {
+    ThunderAutoLogger::Error("Failed to export images of '{}': {}", projectPath.string(), e.what());
+    return 1;
+  }
+
+  if (!result.error.empty()) {
+    ThunderAutoLogger::Error("Image export failed: {}", result.error);
+    return 1;
+  }
+
+  for (const std::string& failure : result.failures) {
+    ThunderAutoLogger::Error("{}", failure);
+  }
+
+  ThunderAutoLogger::Info("Exported {} images to '{}'", result.numImages, outputDirectory.string());
+  return result.failures.empty() ? 0 : 1;
+}
+
 // Tell ImGui to use App to load and save data from/to the imgui.ini file.
 static void SetupDataHandler(App& app) {
   ImGuiIO& io = ImGui::GetIO();
@@ -75,20 +164,44 @@ static void SetupDataHandler(App& app) {
 
   ImGuiContext* context = ImGui::GetCurrentContext();
   context->SettingsHandlers.push_back(iniHandler);
+
+  // ImGui would otherwise load the ini file lazily during the first frame, load it now so that it can be timed.
+  if (io.IniFilename) {
+    StartupTimeline::ScopedPhase scopedPhase(StartupTimeline::Phase::INI_PARSE);
+    ImGui::LoadIniSettingsFromDisk(io.IniFilename);
+  }
 }
 
 // The real main function that handles all the important stuff.
 static int main2(int argc, char** argv) {
+  StartupTimeline::get();  // Start the clock.
+
   std::optional<std::filesystem::path> startProjectPath = GetStartProjectPath(argc, argv);
+  bool fastLaunch = IsFastLaunch(argc, argv);
   int exitCode = 0;
 
+  if (HasFlag(argc, argv, kExportImagesFlag)) {
+    std::optional<std::filesystem::path> exportDirectory = GetExportImagesDirectory(argc, argv);
+    if (!startProjectPath || !exportDirectory) {
+      ThunderAutoLogger::Error("Usage: ThunderAuto <project file> {} <directory> [{}]", kExportImagesFlag,
+                               kExportFramesFlag);
+      return 1;
+    }
+
+    return ExportImages(*startProjectPath, *exportDirectory, HasFlag(argc, argv, kExportFramesFlag));
+  }
+
   App app;
   getPlatformGraphics().init(app);
 
   SetupDataHandler(app);
 
   if (startProjectPath.has_value()) {
-    app.openFromPath(startProjectPath.value().string());
+    if (fastLaunch) {
+      app.openFromPathAsync(startProjectPath.value());
+    } else {
+      app.openFromPath(startProjectPath.value().string());
+    }
   }
 
   //
@@ -122,6 +235,11 @@ static int main2(int argc, char** argv) {
       std::this_thread::sleep_for(std::chrono::milliseconds(1000 / 60));
     }
 
+    const bool isFirstFrame = !StartupTimeline::get().isPhaseRecorded(StartupTimeline::Phase::FIRST_FRAME);
+    if (isFirstFrame) {
+      StartupTimeline::get().beginPhase(StartupTimeline::Phase::FIRST_FRAME);
+    }
+
     // New Frame.
     getPlatformGraphics().beginFrame();
 
@@ -170,10 +288,16 @@ static int main2(int argc, char** argv) {
 
     // Render frame.
     getPlatformGraphics().endFrame();
+
+    if (isFirstFrame) {
+      StartupTimeline::get().endPhase(StartupTimeline::Phase::FIRST_FRAME);
+    }
   }
 
   getPlatformGraphics().deinit();
 
+  StartupTimeline::get().logSummary();
+
   return exitCode;
 }
 